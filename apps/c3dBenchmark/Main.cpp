@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures how fast C3DReader decodes motion capture data and how much memory
+// it needs. Without a file argument, a synthetic recording with one million
+// frames is written to the working directory and removed afterwards.
+//
+// Usage: c3dBenchmark [<file.c3d>] [-f <number of frames>]
+//                     [-m <number of markers>] [-t <number of threads>]
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dart/common/ThreadPool.h"
+#include "dart/utils/C3D.h"
+#include "dart/utils/C3DReader.h"
+
+using namespace dart;
+
+/// Number of frames that are decoded at a time
+const size_t CHUNK_SIZE = 65536;
+
+//==============================================================================
+/// Returns the peak resident set size of the process in megabytes
+double getPeakMemory()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024.0;
+}
+
+//==============================================================================
+/// Returns the number of seconds since _start
+double getElapsedTime(const std::chrono::steady_clock::time_point& _start)
+{
+  return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - _start).count();
+}
+
+//==============================================================================
+/// Writes a C3D file with floating point markers that move along circles. The
+/// frames are written one at a time, so the recording is never held in memory.
+bool writeSyntheticFile(const std::string& _path, size_t _numFrames,
+                        size_t _numMarkers)
+{
+  std::FILE* file = std::fopen(_path.c_str(), "wb");
+  if(!file)
+    return false;
+
+  utils::c3d_head header;
+  std::memset(&header, 0, sizeof(header));
+  header.prec_start = 2;
+  header.key = 80;
+  header.pnt_cnt = static_cast<short>(_numMarkers);
+  header.start_frame = 1;
+  // The frame numbers wrap around, which C3DReader detects from the file size
+  header.end_frame = static_cast<short>(_numFrames);
+  header.scale = -1.0f;
+  header.rec_start = 3;
+  header.a_frames = 1;
+  header.freq = 120.0f;
+  std::fwrite(&header, C3D_REC_SIZE, 1, file);
+
+  utils::c3d_param param;
+  std::memset(&param, 0, sizeof(param));
+  param.ftype = 84;
+  std::fwrite(&param, C3D_REC_SIZE, 1, file);
+
+  std::vector<utils::c3d_frame> frame(_numMarkers);
+  for(size_t i = 0; i < _numFrames; ++i)
+  {
+    const double angle = 2.0 * M_PI * i / 120.0;
+    for(size_t j = 0; j < _numMarkers; ++j)
+    {
+      frame[j].x = static_cast<float>(100.0 * j);
+      frame[j].y = static_cast<float>(500.0 * std::cos(angle + j));
+      frame[j].z = static_cast<float>(500.0 * std::sin(angle + j));
+      frame[j].residual = 0.0f;
+    }
+
+    if(std::fwrite(frame.data(), sizeof(utils::c3d_frame), _numMarkers, file)
+       != _numMarkers)
+    {
+      std::fclose(file);
+      return false;
+    }
+  }
+
+  return std::fclose(file) == 0;
+}
+
+//==============================================================================
+/// Decodes the whole file in chunks and returns the number of frames decoded
+/// per second
+double measureSequentialDecoding(const utils::C3DReader& _reader,
+                                 common::ThreadPool* _threadPool,
+                                 double& _checksum)
+{
+  utils::C3DFrames frames;
+
+  const auto start = std::chrono::steady_clock::now();
+  _checksum = 0.0;
+  for(size_t first = 0; first < _reader.getNumFrames(); first += CHUNK_SIZE)
+  {
+    const size_t count = std::min(CHUNK_SIZE, _reader.getNumFrames() - first);
+    _reader.readFrames(first, count, frames, _threadPool);
+    _checksum += frames.mX.back();
+  }
+
+  return _reader.getNumFrames() / getElapsedTime(start);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::string path;
+  size_t numFrames = 1000000;
+  size_t numMarkers = 40;
+  size_t numThreads = 0;
+  for(int i=1; i<argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if(arg == "-f" && i+1 < argc)
+      numFrames = std::stoul(argv[++i]);
+    else if(arg == "-m" && i+1 < argc)
+      numMarkers = std::stoul(argv[++i]);
+    else if(arg == "-t" && i+1 < argc)
+      numThreads = std::stoul(argv[++i]);
+    else if(path.empty() && arg[0] != '-')
+      path = arg;
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [<file.c3d>] "
+                << "[-f <number of frames>] [-m <number of markers>] "
+                << "[-t <number of threads>]" << std::endl;
+      return 1;
+    }
+  }
+
+  const bool synthetic = path.empty();
+  if(synthetic)
+  {
+    path = "c3dBenchmark.c3d";
+    std::cout << "Writing " << numFrames << " frames of " << numMarkers
+              << " markers to '" << path << "'" << std::endl;
+    if(!writeSyntheticFile(path, numFrames, numMarkers))
+    {
+      std::cerr << "Failed writing '" << path << "'" << std::endl;
+      return 1;
+    }
+  }
+
+  const double initialMemory = getPeakMemory();
+
+  auto start = std::chrono::steady_clock::now();
+  utils::C3DReader reader;
+  if(!reader.open(path))
+    return 1;
+  const double openTime = getElapsedTime(start);
+
+  numFrames = reader.getNumFrames();
+  numMarkers = reader.getNumMarkers();
+
+  double serialChecksum;
+  const double serialRate =
+      measureSequentialDecoding(reader, nullptr, serialChecksum);
+
+  common::ThreadPool threadPool(numThreads);
+  double parallelChecksum;
+  const double parallelRate =
+      measureSequentialDecoding(reader, &threadPool, parallelChecksum);
+
+  // Random access to single markers
+  const size_t numLookups = 1000000;
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<size_t> frameDistribution(0, numFrames - 1);
+  std::uniform_int_distribution<size_t> markerDistribution(0, numMarkers - 1);
+  Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+  start = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < numLookups; ++i)
+  {
+    sum += reader.getPosition(frameDistribution(generator),
+                              markerDistribution(generator));
+  }
+  const double lookupTime = getElapsedTime(start);
+
+  const double peakMemory = getPeakMemory();
+
+  // Memory that loadC3DFile needs to hold the whole recording
+  const double residentMemory = numFrames
+      * (sizeof(Eigen::EIGEN_V_VEC3D) + numMarkers * sizeof(Eigen::Vector3d))
+      / (1024.0 * 1024.0);
+
+  std::cout << "Frames:  " << numFrames << "\n"
+            << "Markers: " << numMarkers << "\n"
+            << "Open:    " << openTime * 1e3 << " ms\n"
+            << "Sequential decoding (1 thread):  " << serialRate
+            << " frames/s\n"
+            << "Sequential decoding (" << threadPool.getNumThreads()
+            << " threads): " << parallelRate << " frames/s"
+            << (serialChecksum == parallelChecksum ? "" : " (MISMATCH)")
+            << "\n"
+            << "Random access: " << numLookups / lookupTime
+            << " markers/s (checksum " << sum.sum() << ")\n"
+            << "Peak memory: " << peakMemory << " MB, of which "
+            << peakMemory - initialMemory << " MB while reading, including "
+            << "mapped pages of the file\n"
+            << "Decoded chunk: " << CHUNK_SIZE * numMarkers * 3
+               * sizeof(double) / (1024.0 * 1024.0) << " MB\n"
+            << "Fully loaded recording would need: " << residentMemory
+            << " MB" << std::endl;
+
+  if(synthetic)
+    std::remove(path.c_str());
+
+  return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Converts .skel, .sdf and .urdf files into DART's compiled world format and
+// compares how long it takes to load each version. Without arguments, the
+// Atlas model and the fullbody1 skeleton are compared.
+//
+// Usage: compileWorld [<input file> <output file>] [-n <number of loads>]
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dart/dart.h"
+
+using namespace dart;
+
+//==============================================================================
+std::string getExtension(const std::string& _path)
+{
+  const size_t dot = _path.find_last_of('.');
+  if(dot == std::string::npos)
+    return std::string();
+
+  std::string extension = _path.substr(dot);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 ::tolower);
+  return extension;
+}
+
+//==============================================================================
+simulation::WorldPtr parseWorld(const std::string& _path)
+{
+  const std::string extension = getExtension(_path);
+
+  dynamics::SkeletonPtr skeleton;
+  if(extension == ".skel")
+  {
+    return utils::SkelParser::readWorld(_path);
+  }
+  else if(extension == ".sdf" || extension == ".world")
+  {
+    simulation::WorldPtr world = utils::SdfParser::readSdfFile(_path);
+    if(world)
+      return world;
+
+    // The file describes a single model
+    skeleton = utils::SdfParser::readSkeleton(_path);
+  }
+  else if(extension == ".urdf")
+  {
+    utils::DartLoader loader;
+    skeleton = loader.parseSkeleton(_path);
+  }
+  else
+  {
+    std::cerr << "Unknown file type [" << extension << "] of '" << _path
+              << "'" << std::endl;
+    return nullptr;
+  }
+
+  if(!skeleton)
+    return nullptr;
+
+  simulation::WorldPtr world = std::make_shared<simulation::World>();
+  world->addSkeleton(skeleton);
+  return world;
+}
+
+//==============================================================================
+/// Returns the median time in seconds that _load takes
+double measureLoadTime(const std::function<simulation::WorldPtr()>& _load,
+                       size_t _numLoads)
+{
+  std::vector<double> times;
+  for(size_t i=0; i<_numLoads; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const simulation::WorldPtr world = _load();
+    const auto end = std::chrono::steady_clock::now();
+
+    if(!world)
+      return -1.0;
+
+    times.push_back(std::chrono::duration<double>(end - start).count());
+  }
+
+  std::sort(times.begin(), times.end());
+  return times[times.size()/2];
+}
+
+//==============================================================================
+bool compile(const std::string& _input, const std::string& _output,
+             size_t _numLoads)
+{
+  std::cout << "Compiling '" << _input << "'" << std::endl;
+
+  const simulation::WorldPtr world = parseWorld(_input);
+  if(!world)
+  {
+    std::cerr << "Failed parsing '" << _input << "'" << std::endl;
+    return false;
+  }
+
+  if(!utils::CompiledWorld::writeWorld(world, _output))
+    return false;
+
+  std::cout << "Wrote '" << _output << "'" << std::endl;
+
+  if(_numLoads == 0)
+    return true;
+
+  // Meshes are shared through the MeshCache, so keep one copy of the world
+  // alive to measure both formats without the time it takes to import meshes
+  const double parseTime = measureLoadTime(
+        [&]() { return parseWorld(_input); }, _numLoads);
+  const double compiledTime = measureLoadTime(
+        [&]() { return utils::CompiledWorld::readWorld(_output); }, _numLoads);
+
+  std::cout << "Median load time of " << _numLoads << " loads:\n"
+            << "  parsed:   " << parseTime * 1e3 << " ms\n"
+            << "  compiled: " << compiledTime * 1e3 << " ms\n"
+            << "  speedup:  " << parseTime / compiledTime << "x" << std::endl;
+
+  return true;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> files;
+  size_t numLoads = 20;
+  for(int i=1; i<argc; ++i)
+  {
+    if(std::string(argv[i]) == "-n" && i+1 < argc)
+      numLoads = std::stoul(argv[++i]);
+    else
+      files.push_back(argv[i]);
+  }
+
+  if(files.empty())
+  {
+    files.push_back(DART_DATA_PATH"sdf/atlas/atlas_v3_no_head.sdf");
+    files.push_back("atlas_v3_no_head.dartworld");
+    files.push_back(DART_DATA_PATH"skel/fullbody1.skel");
+    files.push_back("fullbody1.dartworld");
+  }
+
+  if(files.size() % 2 != 0)
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " [<input file> <output file>] [-n <number of loads>]"
+              << std::endl;
+    return 1;
+  }
+
+  bool success = true;
+  for(size_t i=0; i<files.size(); i+=2)
+    success &= compile(files[i], files[i+1], numLoads);
+
+  return success ? 0 : 1;
+}
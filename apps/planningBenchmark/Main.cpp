@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures how the parallel bidirectional RRT of PathPlanner scales with the
+// number of threads. For each number of threads, the median time to the first
+// solution of the planning benchmark world is reported.
+//
+// Usage: planningBenchmark [-n <number of trials>] [-t <maximum threads>]
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dart/dart.h"
+#include "dart/planning/EdgeValidator.h"
+#include "dart/planning/PathPlanner.h"
+
+using namespace dart;
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  size_t numTrials = 20;
+  size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+  for(int i=1; i<argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if(arg == "-n" && i+1 < argc)
+      numTrials = std::max<size_t>(1, std::stoul(argv[++i]));
+    else if(arg == "-t" && i+1 < argc)
+      maxThreads = std::max<size_t>(1, std::stoul(argv[++i]));
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [-n <number of trials>] "
+                << "[-t <maximum threads>]" << std::endl;
+      return 1;
+    }
+  }
+
+  simulation::WorldPtr world = utils::SkelParser::readWorld(
+        DART_DATA_PATH"skel/planning_benchmark.skel");
+  if(!world)
+    return 1;
+  dynamics::SkeletonPtr arm = world->getSkeleton("arm");
+
+  // The arm starts above the shelves and has to get below them
+  const std::vector<size_t> dofs = {0, 1, 2, 3};
+  const Eigen::VectorXd start = Eigen::Vector4d(0.5, 0.0, 0.0, 0.0);
+  const Eigen::VectorXd goal = Eigen::Vector4d(-0.5, 0.0, 0.0, 0.0);
+  const double stepSize = 0.1;
+
+  for(size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    planning::PathPlanner<> planner(world, true, true, stepSize, 1e6);
+    if(numThreads > 1)
+    {
+      planner.edgeValidator = std::make_shared<planning::EdgeValidator>(
+            world, arm, dofs, stepSize, numThreads);
+    }
+
+    std::vector<double> times;
+    size_t numFailures = 0;
+    for(size_t i = 0; i < numTrials; ++i)
+    {
+      std::list<Eigen::VectorXd> path;
+      const auto begin = std::chrono::steady_clock::now();
+      if(!planner.planPath(arm, dofs, start, goal, path))
+        ++numFailures;
+      times.push_back(std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - begin).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    std::cout << "Threads: " << numThreads
+              << "  median time to first solution: " << times[numTrials / 2]
+              << " s";
+    if(numFailures > 0)
+      std::cout << "  (" << numFailures << " failed)";
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
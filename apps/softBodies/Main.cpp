@@ -55,6 +55,10 @@ int main(int argc, char* argv[])
         DART_DATA_PATH"skel/softBodies.skel");
   assert(myWorld != nullptr);
 
+  // The soft bodies are separate Skeletons, so their dynamics can be computed
+  // in parallel
+  myWorld->setNumThreads(0);
+
   for(size_t i=0; i<myWorld->getNumSkeletons(); ++i)
   {
     dart::dynamics::SkeletonPtr skel = myWorld->getSkeleton(i);
@@ -44,6 +44,7 @@ double testForwardKinematicSpeed(dart::dynamics::SkeletonPtr skel,
                                  bool position=true,
                                  bool velocity=true,
                                  bool acceleration=true,
+                                 bool fused=false,
                                  size_t numTests=100000)
 {
   if(nullptr==skel)
@@ -66,6 +67,12 @@ double testForwardKinematicSpeed(dart::dynamics::SkeletonPtr skel,
                           std::min(dof->getPositionUpperLimit(), 1.0)) );
     }
 
+    if(fused)
+    {
+      skel->computeForwardKinematics(position, velocity, acceleration);
+      continue;
+    }
+
     for(size_t i=0; i<skel->getNumBodyNodes(); ++i)
     {
       if(position)
@@ -88,7 +95,8 @@ double testForwardKinematicSpeed(dart::dynamics::SkeletonPtr skel,
 
 void runKinematicsTest(std::vector<double>& results,
                        const std::vector<dart::simulation::WorldPtr>& worlds,
-                       bool position, bool velocity, bool acceleration)
+                       bool position, bool velocity, bool acceleration,
+                       bool fused=false)
 {
   double totalTime = 0;
   std::cout << "Testing: ";
@@ -98,6 +106,8 @@ void runKinematicsTest(std::vector<double>& results,
     std::cout << "Velocity ";
   if(acceleration)
     std::cout << "Acceleration ";
+  if(fused)
+    std::cout << "(fused) ";
   std::cout << "\n";
 
   // Test for updating the whole skeleton
@@ -105,7 +115,8 @@ void runKinematicsTest(std::vector<double>& results,
   {
     dart::simulation::WorldPtr world = worlds[i];
     totalTime += testForwardKinematicSpeed(world->getSkeleton(0),
-                                        position, velocity, acceleration);
+                                        position, velocity, acceleration,
+                                        fused);
   }
   results.push_back(totalTime);
   std::cout << "Result: " << totalTime << "s" << std::endl;
@@ -153,6 +164,51 @@ void runDynamicsTest(std::vector<double>& results,
   std::cout << "Result: " << totalTime << "s" << std::endl;
 }
 
+dart::dynamics::SkeletonPtr createChain(size_t numLinks)
+{
+  dart::dynamics::SkeletonPtr chain = dart::dynamics::Skeleton::create("chain");
+
+  dart::dynamics::BodyNode* bn = nullptr;
+  for(size_t i=0; i<numLinks; ++i)
+  {
+    bn = chain->createJointAndBodyNodePair<dart::dynamics::RevoluteJoint>(
+          bn).second;
+  }
+
+  return chain;
+}
+
+double testNotificationSpeed(dart::dynamics::SkeletonPtr skel,
+                             size_t numTests=10000)
+{
+  dart::dynamics::BodyNode* root = skel->getRootBodyNode();
+  std::chrono::duration<double> elapsed_seconds(0.0);
+
+  for(size_t i=0; i<numTests; ++i)
+  {
+    // Clear the update flags so that the notification travels down the whole
+    // chain instead of stopping at the root
+    skel->computeForwardKinematics(true, true, true);
+
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::system_clock::now();
+    root->notifyTransformUpdate();
+    end = std::chrono::system_clock::now();
+
+    elapsed_seconds += end-start;
+  }
+
+  return elapsed_seconds.count();
+}
+
+void runNotificationTest(std::vector<double>& results,
+                         dart::dynamics::SkeletonPtr skel)
+{
+  double totalTime = testNotificationSpeed(skel);
+  results.push_back(totalTime);
+  std::cout << "Result: " << totalTime << "s" << std::endl;
+}
+
 void print_results(const std::vector<double>& result)
 {
   double sum = std::accumulate(result.begin(), result.end(), 0.0);
@@ -205,10 +261,65 @@ std::vector<dart::simulation::WorldPtr> getWorlds()
 int main(int argc, char* argv[])
 {
   bool test_kinematics = false;
+  bool test_notifications = false;
   for(int i=1; i<argc; ++i)
   {
     if(std::string(argv[i])=="-k")
       test_kinematics = true;
+    else if(std::string(argv[i])=="-n")
+      test_notifications = true;
+  }
+
+  if(test_notifications)
+  {
+    std::cout << "Testing notifyTransformUpdate on a 100-link chain"
+              << std::endl;
+    dart::dynamics::SkeletonPtr chain = createChain(100);
+
+    std::vector<double> unobserved_results;
+    std::vector<double> observed_results;
+    std::vector<double> disabled_results;
+
+    std::vector<dart::common::ScopedConnection> connections;
+    size_t numSlotCalls = 0;
+
+    for(size_t i=0; i<10; ++i)
+    {
+      std::cout << "\nTrial #" << i+1 << std::endl;
+
+      std::cout << "Testing: No slots connected\n";
+      runNotificationTest(unobserved_results, chain);
+
+      for(size_t j=0; j<chain->getNumBodyNodes(); ++j)
+      {
+        connections.push_back(
+              chain->getBodyNode(j)->onTransformUpdated.connect(
+                [&](const dart::dynamics::Entity*) { ++numSlotCalls; }));
+      }
+
+      std::cout << "Testing: One slot connected to each BodyNode\n";
+      runNotificationTest(observed_results, chain);
+
+      std::cout << "Testing: Change signals disabled\n";
+      dart::dynamics::Entity::disableChangeSignals();
+      runNotificationTest(disabled_results, chain);
+      dart::dynamics::Entity::enableChangeSignals();
+
+      connections.clear();
+    }
+
+    std::cout << "\n\n --- Final Notification Results --- \n\n";
+
+    std::cout << "No slots connected\n";
+    print_results(unobserved_results);
+
+    std::cout << "\nOne slot connected to each BodyNode\n";
+    print_results(observed_results);
+
+    std::cout << "\nChange signals disabled\n";
+    print_results(disabled_results);
+
+    return 0;
   }
 
   std::vector<dart::simulation::WorldPtr> worlds = getWorlds();
@@ -219,10 +330,12 @@ int main(int argc, char* argv[])
     std::vector<double> acceleration_results;
     std::vector<double> velocity_results;
     std::vector<double> position_results;
+    std::vector<double> fused_results;
 
     for(size_t i=0; i<10; ++i)
     {
       std::cout << "\nTrial #" << i+1 << std::endl;
+      runKinematicsTest(fused_results, worlds, true, true, true, true);
       runKinematicsTest(acceleration_results, worlds, true, true, true);
       runKinematicsTest(velocity_results, worlds, true, true, false);
       runKinematicsTest(position_results, worlds, true, false, false);
@@ -230,7 +343,10 @@ int main(int argc, char* argv[])
 
     std::cout << "\n\n --- Final Kinematics Results --- \n\n";
 
-    std::cout << "Position, Velocity, Acceleration\n";
+    std::cout << "Position, Velocity, Acceleration (fused)\n";
+    print_results(fused_results);
+
+    std::cout << "\nPosition, Velocity, Acceleration\n";
     print_results(acceleration_results);
 
     std::cout << "\nPosition, Velocity\n";
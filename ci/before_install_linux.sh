@@ -50,7 +50,6 @@ APT=$APT_CORE'
 freeglut3-dev
 libxi-dev
 libxmu-dev
-libflann-dev
 coinor-libipopt-dev
 libtinyxml-dev
 libtinyxml2-dev
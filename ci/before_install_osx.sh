@@ -9,7 +9,6 @@ cmake
 assimp
 fcl
 bullet
-flann
 boost
 eigen
 tinyxml
@@ -43,8 +43,10 @@
 
 #include "dart/common/Console.h"
 #include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/DegreeOfFreedom.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/collision/CollisionNode.h"
+#include "dart/collision/dart/DARTDistance.h"
 
 namespace dart {
 namespace collision {
@@ -128,10 +130,6 @@ void CollisionDetector::addCollisionSkeletonNode(dynamics::BodyNode* _bodyNode,
   // Add the collision node to map (BodyNode -> CollisionNode)
   mBodyCollisionMap[_bodyNode] = collNode;
 
-  // Add collidable pairs for the collision node
-  mCollidablePairs.push_back(
-        std::vector<bool>(mCollisionNodes.size() - 1, true));
-
   if (_isRecursive) {
     for (size_t i = 0; i < _bodyNode->getNumChildBodyNodes(); i++)
       addCollisionSkeletonNode(_bodyNode->getChildBodyNode(i), true);
@@ -164,17 +162,26 @@ void CollisionDetector::removeCollisionSkeletonNode(
   // Remove collNode-_bodyNode pair from mBodyCollisionMap
   mBodyCollisionMap.erase(_bodyNode);
 
-  // Delete collNode
-  delete collNode;
+  // Remove the distance queries that involve collNode
+  for (auto it = mDistanceCache.begin(); it != mDistanceCache.end();)
+  {
+    if (it->first.first == collNode || it->first.second == collNode)
+      it = mDistanceCache.erase(it);
+    else
+      ++it;
+  }
 
-  // Update mCollidablePairs
-  for (size_t i = iCollNode + 1; i < mCollidablePairs.size(); ++i) {
-    for (size_t j = 0; j < iCollNode; ++j)
-      mCollidablePairs[i-1][j] = mCollidablePairs[i][j];
-    for (size_t j = iCollNode + 1; j < mCollidablePairs[i].size(); ++j)
-      mCollidablePairs[i-1][j-1] = mCollidablePairs[i][j];
+  // Remove the disabled pairs that involve collNode
+  for (auto it = mDisabledPairs.begin(); it != mDisabledPairs.end();)
+  {
+    if (it->first == collNode || it->second == collNode)
+      it = mDisabledPairs.erase(it);
+    else
+      ++it;
   }
-  mCollidablePairs.pop_back();
+
+  // Delete collNode
+  delete collNode;
 
   if (_isRecursive) {
     for (size_t i = 0; i < _bodyNode->getNumChildBodyNodes(); i++)
@@ -190,6 +197,235 @@ bool CollisionDetector::detectCollision(dynamics::BodyNode* _node1,
                          _calculateContactPoints);
 }
 
+//==============================================================================
+bool CollisionDetector::checkCollision(
+    const std::vector<dynamics::BodyNode*>& _bodyNodes)
+{
+  setQueryNodes(_bodyNodes);
+
+  for (CollisionNode* collNode1 : mQueryNodes)
+  {
+    for (CollisionNode* collNode2 : mCollisionNodes)
+    {
+      if (isQueryPair(collNode1, collNode2)
+          && detectCollision(collNode1, collNode2, false))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+bool CollisionDetector::checkCollision(const dynamics::SkeletonPtr& _skeleton)
+{
+  return checkCollision(_skeleton->getBodyNodes());
+}
+
+//==============================================================================
+static void addSubtree(dynamics::BodyNode* _bodyNode,
+                       std::vector<dynamics::BodyNode*>& _bodyNodes)
+{
+  _bodyNodes.push_back(_bodyNode);
+  for (size_t i = 0; i < _bodyNode->getNumChildBodyNodes(); ++i)
+    addSubtree(_bodyNode->getChildBodyNode(i), _bodyNodes);
+}
+
+//==============================================================================
+bool CollisionDetector::checkCollision(const dynamics::SkeletonPtr& _skeleton,
+                                       const std::vector<size_t>& _dofs)
+{
+  mQueryBodyNodes.clear();
+  for (size_t dof : _dofs)
+  {
+    dynamics::BodyNode* bodyNode = _skeleton->getDof(dof)->getChildBodyNode();
+
+    // The subtree of this BodyNode may have been added already by another
+    // degree of freedom of the same Joint
+    if (std::find(mQueryBodyNodes.begin(), mQueryBodyNodes.end(), bodyNode)
+        != mQueryBodyNodes.end())
+      continue;
+
+    addSubtree(bodyNode, mQueryBodyNodes);
+  }
+
+  return checkCollision(mQueryBodyNodes);
+}
+
+//==============================================================================
+bool CollisionDetector::computeDistance(dynamics::BodyNode* _bodyNode1,
+                                        dynamics::BodyNode* _bodyNode2,
+                                        DistanceResult& _result,
+                                        double _upperBound)
+{
+  CollisionNode* collNode1 = getCollisionNode(_bodyNode1);
+  CollisionNode* collNode2 = getCollisionNode(_bodyNode2);
+  if (nullptr == collNode1 || nullptr == collNode2)
+    return false;
+
+  return computeDistance(collNode1, collNode2, _result, _upperBound);
+}
+
+//==============================================================================
+bool CollisionDetector::computeDistance(
+    const std::vector<dynamics::BodyNode*>& _bodyNodes,
+    DistanceResult& _result,
+    double _upperBound)
+{
+  setQueryNodes(_bodyNodes);
+
+  bool found = false;
+  for (CollisionNode* collNode1 : mQueryNodes)
+  {
+    for (CollisionNode* collNode2 : mCollisionNodes)
+    {
+      if (isQueryPair(collNode1, collNode2)
+          && computeDistance(collNode1, collNode2, _result, _upperBound))
+      {
+        _upperBound = _result.distance;
+        found = true;
+      }
+    }
+  }
+
+  return found;
+}
+
+//==============================================================================
+bool CollisionDetector::computeDistance(const dynamics::SkeletonPtr& _skeleton,
+                                        DistanceResult& _result,
+                                        double _upperBound)
+{
+  return computeDistance(_skeleton->getBodyNodes(), _result, _upperBound);
+}
+
+//==============================================================================
+size_t CollisionDetector::computeDistances(
+    const std::vector<dynamics::BodyNode*>& _bodyNodes,
+    std::vector<DistanceResult>& _results,
+    double _upperBound)
+{
+  setQueryNodes(_bodyNodes);
+
+  const size_t numResults = _results.size();
+  DistanceResult result;
+  for (CollisionNode* collNode1 : mQueryNodes)
+  {
+    for (CollisionNode* collNode2 : mCollisionNodes)
+    {
+      if (isQueryPair(collNode1, collNode2)
+          && computeDistance(collNode1, collNode2, result, _upperBound))
+        _results.push_back(result);
+    }
+  }
+
+  return _results.size() - numResults;
+}
+
+//==============================================================================
+size_t CollisionDetector::computeDistances(
+    const dynamics::SkeletonPtr& _skeleton,
+    std::vector<DistanceResult>& _results,
+    double _upperBound)
+{
+  return computeDistances(_skeleton->getBodyNodes(), _results, _upperBound);
+}
+
+//==============================================================================
+void CollisionDetector::clearDistanceCache()
+{
+  mDistanceCache.clear();
+}
+
+//==============================================================================
+bool CollisionDetector::computeDistance(CollisionNode* _node1,
+                                        CollisionNode* _node2,
+                                        DistanceResult& _result,
+                                        double _upperBound)
+{
+  dynamics::BodyNode* bodyNode1 = _node1->getBodyNode();
+  dynamics::BodyNode* bodyNode2 = _node2->getBodyNode();
+  const size_t numShapes1 = bodyNode1->getNumCollisionShapes();
+  const size_t numShapes2 = bodyNode2->getNumCollisionShapes();
+
+  std::vector<GJKSimplex>& simplices
+      = mDistanceCache[std::make_pair(_node1, _node2)];
+  if (simplices.size() != numShapes1 * numShapes2)
+    simplices.assign(numShapes1 * numShapes2, GJKSimplex());
+
+  bool found = false;
+  double shapeDistance;
+  Eigen::Vector3d point1;
+  Eigen::Vector3d point2;
+  for (size_t i = 0; i < numShapes1; ++i)
+  {
+    const dynamics::ShapePtr shape1 = bodyNode1->getCollisionShape(i);
+    const Eigen::Isometry3d T1
+        = bodyNode1->getTransform() * shape1->getLocalTransform();
+
+    for (size_t j = 0; j < numShapes2; ++j)
+    {
+      const dynamics::ShapePtr shape2 = bodyNode2->getCollisionShape(j);
+      const Eigen::Isometry3d T2
+          = bodyNode2->getTransform() * shape2->getLocalTransform();
+
+      if (!distance(shape1, T1, shape2, T2, _upperBound, shapeDistance,
+                    point1, point2, &simplices[i * numShapes2 + j]))
+        continue;
+
+      if (shapeDistance >= _upperBound)
+        continue;
+
+      // The closest pair so far bounds the remaining pairs of shapes
+      _upperBound = shapeDistance;
+      found = true;
+
+      _result.distance = shapeDistance;
+      _result.point1 = point1;
+      _result.point2 = point2;
+      _result.bodyNode1 = bodyNode1;
+      _result.bodyNode2 = bodyNode2;
+      _result.shape1 = shape1;
+      _result.shape2 = shape2;
+    }
+  }
+
+  return found;
+}
+
+//==============================================================================
+bool CollisionDetector::isQueryPair(const CollisionNode* _queryNode,
+                                    const CollisionNode* _node)
+{
+  if (_queryNode == _node)
+    return false;
+
+  // A pair of two queried nodes only needs to be visited once
+  if (mQueryMask[_node->getIndex()]
+      && _node->getIndex() < _queryNode->getIndex())
+    return false;
+
+  return isCollidable(_queryNode, _node);
+}
+
+//==============================================================================
+void CollisionDetector::setQueryNodes(
+    const std::vector<dynamics::BodyNode*>& _bodyNodes)
+{
+  mQueryNodes.clear();
+  mQueryMask.assign(mCollisionNodes.size(), false);
+
+  for (dynamics::BodyNode* bodyNode : _bodyNodes)
+  {
+    CollisionNode* collNode = getCollisionNode(bodyNode);
+    if (nullptr == collNode || mQueryMask[collNode->getIndex()])
+      continue;
+
+    mQueryMask[collNode->getIndex()] = true;
+    mQueryNodes.push_back(collNode);
+  }
+}
+
 size_t CollisionDetector::getNumContacts() {
   return mContacts.size();
 }
@@ -215,30 +451,66 @@ void CollisionDetector::enablePair(dynamics::BodyNode* _node1,
   CollisionNode* collisionNode1 = getCollisionNode(_node1);
   CollisionNode* collisionNode2 = getCollisionNode(_node2);
   if (collisionNode1 && collisionNode2)
-    setPairCollidable(collisionNode1, collisionNode2, true);
+    mDisabledPairs.erase(makePairKey(collisionNode1, collisionNode2));
 }
 
 void CollisionDetector::disablePair(dynamics::BodyNode* _node1,
                                     dynamics::BodyNode* _node2) {
   CollisionNode* collisionNode1 = getCollisionNode(_node1);
   CollisionNode* collisionNode2 = getCollisionNode(_node2);
-  if (collisionNode1 && collisionNode2)
-    setPairCollidable(collisionNode1, collisionNode2, false);
+  if (collisionNode1 && collisionNode2 && collisionNode1 != collisionNode2)
+    mDisabledPairs.insert(makePairKey(collisionNode1, collisionNode2));
+}
+
+//==============================================================================
+bool CollisionDetector::isPairDisabled(const dynamics::BodyNode* _node1,
+                                       const dynamics::BodyNode* _node2)
+{
+  CollisionNode* collisionNode1 = getCollisionNode(_node1);
+  CollisionNode* collisionNode2 = getCollisionNode(_node2);
+  if (!collisionNode1 || !collisionNode2 || collisionNode1 == collisionNode2)
+    return false;
+
+  return mDisabledPairs.count(makePairKey(collisionNode1, collisionNode2)) > 0;
+}
+
+//==============================================================================
+std::vector<std::pair<const dynamics::BodyNode*, const dynamics::BodyNode*>>
+CollisionDetector::getDisabledPairs() const
+{
+  std::vector<std::pair<const dynamics::BodyNode*,
+                        const dynamics::BodyNode*>> pairs;
+  pairs.reserve(mDisabledPairs.size());
+  for (const auto& pair : mDisabledPairs)
+  {
+    pairs.push_back(std::make_pair(pair.first->getBodyNode(),
+                                   pair.second->getBodyNode()));
+  }
+
+  return pairs;
 }
 
 //==============================================================================
 bool CollisionDetector::isCollidable(const CollisionNode* _node1,
                                      const CollisionNode* _node2)
 {
+  if (_node1 == _node2)
+    return false;
+
   dynamics::BodyNode* bn1 = _node1->getBodyNode();
   dynamics::BodyNode* bn2 = _node2->getBodyNode();
 
-  if (!getPairCollidable(_node1, _node2))
+  // The collision groups reject most pairs before anything else is looked at
+  if (!bn1->canCollideWith(bn2))
     return false;
 
   if (!bn1->isCollidable() || !bn2->isCollidable())
     return false;
 
+  if (!mDisabledPairs.empty()
+      && mDisabledPairs.count(makePairKey(_node1, _node2)) > 0)
+    return false;
+
   if (bn1->getSkeleton() == bn2->getSkeleton())
   {
     if (bn1->getSkeleton()->isEnabledSelfCollisionCheck())
@@ -271,59 +543,15 @@ bool CollisionDetector::containSkeleton(const dynamics::SkeletonPtr& _skeleton)
   return false;
 }
 
-bool isValidIndex(const std::vector<std::vector<bool>>& _collidablePairs,
-                  const std::size_t _index1,
-                  const std::size_t _index2)
-{
-  assert(_index1 >= _index2);
-
-  if (_collidablePairs.size() > _index1
-      && _collidablePairs[_index1].size() > _index2)
-    return true;
-
-  return false;
-}
-
-bool CollisionDetector::getPairCollidable(const CollisionNode* _node1,
-                                          const CollisionNode* _node2)
-{
-  assert(_node1 != _node2);
-
-  size_t index1 = _node1->getIndex();
-  size_t index2 = _node2->getIndex();
-
-  if (index1 < index2)
-    std::swap(index1, index2);
-
-  // Index validity check. The indices are not valid if the body nodes are not
-  // completely added to the collision detector yet.
-  if (!isValidIndex(mCollidablePairs, index1, index2))
-    return false;
-
-  if (index1 == index2)
-    return false;
-  
-  return mCollidablePairs[index1][index2];
-}
-
-void CollisionDetector::setPairCollidable(const CollisionNode* _node1,
-                                          const CollisionNode* _node2,
-                                          bool _val)
+//==============================================================================
+std::pair<const CollisionNode*, const CollisionNode*>
+CollisionDetector::makePairKey(const CollisionNode* _node1,
+                               const CollisionNode* _node2)
 {
-  assert(_node1 != _node2);
-
-  size_t index1 = _node1->getIndex();
-  size_t index2 = _node2->getIndex();
-
-  if (index1 < index2)
-    std::swap(index1, index2);
-
-  // Index validity check. The indices are not valid if the body nodes are not
-  // completely added to the collision detector yet.
-  if (!isValidIndex(mCollidablePairs, index1, index2))
-    return;
+  if (_node2 < _node1)
+    std::swap(_node1, _node2);
 
-  mCollidablePairs[index1][index2] = _val;
+  return std::make_pair(_node1, _node2);
 }
 
 bool CollisionDetector::isAdjacentBodies(
@@ -38,12 +38,16 @@
 #ifndef DART_COLLISION_COLLISIONDETECTOR_H_
 #define DART_COLLISION_COLLISIONDETECTOR_H_
 
+#include <limits>
 #include <vector>
 #include <map>
+#include <set>
+#include <utility>
 
 #include <Eigen/Dense>
 
 #include "dart/collision/CollisionNode.h"
+#include "dart/collision/GJKSimplex.h"
 #include "dart/dynamics/SmartPointer.h"
 
 namespace dart {
@@ -94,6 +98,32 @@ struct Contact {
   void* userData;
 };
 
+/// Result of a minimum-distance query between two BodyNodes
+struct DistanceResult {
+  /// Minimum distance between the two BodyNodes. It is negative when they
+  /// intersect, in which case its magnitude is the penetration depth.
+  double distance;
+
+  /// Closest point on bodyNode1 w.r.t. the world frame. When the BodyNodes
+  /// intersect, this is the point of bodyNode1 deepest inside bodyNode2.
+  Eigen::Vector3d point1;
+
+  /// Closest point on bodyNode2 w.r.t. the world frame
+  Eigen::Vector3d point2;
+
+  /// First BodyNode
+  dynamics::WeakBodyNodePtr bodyNode1;
+
+  /// Second BodyNode
+  dynamics::WeakBodyNodePtr bodyNode2;
+
+  /// Shape of the first BodyNode that the closest point is on
+  dynamics::ShapePtr shape1;
+
+  /// Shape of the second BodyNode that the closest point is on
+  dynamics::ShapePtr shape2;
+};
+
 /// \brief class CollisionDetector
 class CollisionDetector
 {
@@ -126,12 +156,24 @@ public:
   /// \brief
   virtual CollisionNode* createCollisionNode(dynamics::BodyNode* _bodyNode) = 0;
 
-  /// \brief
+  /// Remove the pair from the exceptions that were added by disablePair()
   void enablePair(dynamics::BodyNode* _node1, dynamics::BodyNode* _node2);
 
-  /// \brief
+  /// Disable collisions between a single pair of BodyNodes. Groups of
+  /// BodyNodes are better filtered by their collision categories and masks,
+  /// see BodyNode::setCollisionCategories().
   void disablePair(dynamics::BodyNode* _node1, dynamics::BodyNode* _node2);
 
+  /// Return true if collisions between the pair were disabled by
+  /// disablePair()
+  bool isPairDisabled(const dynamics::BodyNode* _node1,
+                      const dynamics::BodyNode* _node2);
+
+  /// Get the pairs of BodyNodes whose collisions were disabled by
+  /// disablePair()
+  std::vector<std::pair<const dynamics::BodyNode*, const dynamics::BodyNode*>>
+  getDisabledPairs() const;
+
   /// Return true if there exists at least one contact
   /// \param[in] _checkAllCollision True to detect every collisions
   /// \param[in] _calculateContactPoints True to get contact points
@@ -143,6 +185,77 @@ public:
   bool detectCollision(dynamics::BodyNode* _node1, dynamics::BodyNode* _node2,
                        bool _calculateContactPoints);
 
+  /// Return true if any collidable pair that involves at least one of
+  /// _bodyNodes is in collision. Unlike detectCollision(), no contact points
+  /// are computed, the stored contacts and the colliding flags of the
+  /// BodyNodes are left untouched, and the query returns as soon as it finds
+  /// the first collision. BodyNodes that were not added to this
+  /// CollisionDetector are ignored.
+  virtual bool checkCollision(
+      const std::vector<dynamics::BodyNode*>& _bodyNodes);
+
+  /// Same as checkCollision(const std::vector<dynamics::BodyNode*>&) for all
+  /// the BodyNodes of _skeleton
+  bool checkCollision(const dynamics::SkeletonPtr& _skeleton);
+
+  /// Same as checkCollision(const std::vector<dynamics::BodyNode*>&) for the
+  /// BodyNodes of _skeleton that are moved by the degrees of freedom _dofs,
+  /// i.e. the child BodyNodes of those degrees of freedom and all of their
+  /// descendants. Pairs that involve none of those BodyNodes cannot be
+  /// affected by changes to _dofs, so they are not checked.
+  bool checkCollision(const dynamics::SkeletonPtr& _skeleton,
+                      const std::vector<size_t>& _dofs);
+
+  /// Compute the minimum distance between the collision shapes of
+  /// _bodyNode1 and _bodyNode2, whether or not the pair is collidable.
+  /// \param[in] _upperBound Distances that are not smaller than this need not
+  /// be computed exactly, which lets the query terminate early
+  /// \return True if a distance smaller than _upperBound was found, in which
+  /// case _result holds it. False if the distance is not smaller than
+  /// _upperBound, if either BodyNode was not added to this CollisionDetector,
+  /// or if the distance between their shapes is not supported.
+  bool computeDistance(
+      dynamics::BodyNode* _bodyNode1, dynamics::BodyNode* _bodyNode2,
+      DistanceResult& _result,
+      double _upperBound = std::numeric_limits<double>::infinity());
+
+  /// Compute the minimum distance over the collidable pairs that involve at
+  /// least one of _bodyNodes. The distance found so far is the upper bound of
+  /// the remaining pairs, so most of them terminate early.
+  /// \return Same as computeDistance(dynamics::BodyNode*, dynamics::BodyNode*,
+  /// DistanceResult&, double) for the closest pair
+  bool computeDistance(
+      const std::vector<dynamics::BodyNode*>& _bodyNodes,
+      DistanceResult& _result,
+      double _upperBound = std::numeric_limits<double>::infinity());
+
+  /// Same as computeDistance(const std::vector<dynamics::BodyNode*>&,
+  /// DistanceResult&, double) for all the BodyNodes of _skeleton
+  bool computeDistance(
+      const dynamics::SkeletonPtr& _skeleton,
+      DistanceResult& _result,
+      double _upperBound = std::numeric_limits<double>::infinity());
+
+  /// Compute the minimum distance of every collidable pair that involves at
+  /// least one of _bodyNodes, and append the ones smaller than _upperBound to
+  /// _results
+  /// \return Number of results that were appended
+  size_t computeDistances(
+      const std::vector<dynamics::BodyNode*>& _bodyNodes,
+      std::vector<DistanceResult>& _results,
+      double _upperBound = std::numeric_limits<double>::infinity());
+
+  /// Same as computeDistances(const std::vector<dynamics::BodyNode*>&,
+  /// std::vector<DistanceResult>&, double) for all the BodyNodes of _skeleton
+  size_t computeDistances(
+      const dynamics::SkeletonPtr& _skeleton,
+      std::vector<DistanceResult>& _results,
+      double _upperBound = std::numeric_limits<double>::infinity());
+
+  /// Forget the state that distance queries keep per pair of BodyNodes to
+  /// warm start the next query on the same pair
+  virtual void clearDistanceCache();
+
   /// \brief
   size_t getNumContacts();
 
@@ -166,6 +279,22 @@ protected:
   virtual bool detectCollision(CollisionNode* _node1, CollisionNode* _node2,
                                bool _calculateContactPoints) = 0;
 
+  /// Compute the minimum distance between two CollisionNodes. The default
+  /// implementation runs GJK on the collision shapes of the BodyNodes and
+  /// warm starts each pair of shapes from the simplex of its previous query.
+  /// \return True if a distance smaller than _upperBound was found
+  virtual bool computeDistance(CollisionNode* _node1, CollisionNode* _node2,
+                               DistanceResult& _result, double _upperBound);
+
+  /// Fill mQueryNodes with the CollisionNodes of _bodyNodes and flag their
+  /// indices in mQueryMask
+  void setQueryNodes(const std::vector<dynamics::BodyNode*>& _bodyNodes);
+
+  /// Return true if the pair of _queryNode, which is in mQueryNodes, and
+  /// _node needs to be visited by a query over mQueryNodes
+  bool isQueryPair(const CollisionNode* _queryNode,
+                   const CollisionNode* _node);
+
   /// \brief
   std::vector<Contact> mContacts;
 
@@ -178,18 +307,27 @@ protected:
   /// \brief Skeleton array
   std::vector<dynamics::SkeletonPtr> mSkeletons;
 
+  /// CollisionNodes of the BodyNodes passed to the last checkCollision() query
+  std::vector<CollisionNode*> mQueryNodes;
+
+  /// Whether the CollisionNode with the corresponding index is in mQueryNodes
+  std::vector<bool> mQueryMask;
+
+  /// Cache for the BodyNodes of a checkCollision() query
+  std::vector<dynamics::BodyNode*> mQueryBodyNodes;
+
+  /// GJK simplices of the last distance queries, per pair of CollisionNodes
+  /// and then per pair of their collision shapes
+  std::map<std::pair<const CollisionNode*, const CollisionNode*>,
+           std::vector<GJKSimplex> > mDistanceCache;
+
 private:
   /// \brief Return true if _skeleton is contained
   bool containSkeleton(const dynamics::SkeletonPtr& _skeleton);
 
-  /// \brief
-  bool getPairCollidable(const CollisionNode* _node1,
-                         const CollisionNode* _node2);
-
-  /// \brief
-  void setPairCollidable(const CollisionNode* _node1,
-                         const CollisionNode* _node2,
-                         bool _val);
+  /// Return the key of a pair of CollisionNodes in mDisabledPairs
+  static std::pair<const CollisionNode*, const CollisionNode*> makePairKey(
+      const CollisionNode* _node1, const CollisionNode* _node2);
 
   /// \brief Return true if _bodyNode1 and _bodyNode2 are adjacent bodies
   bool isAdjacentBodies(const dynamics::BodyNode* _bodyNode1,
@@ -201,8 +339,10 @@ private:
   /// \brief
   std::map<const dynamics::BodyNode*, CollisionNode*> mBodyCollisionMap;
 
-  /// \brief
-  std::vector<std::vector<bool> > mCollidablePairs;
+  /// Pairs of CollisionNodes whose collisions were disabled by disablePair(),
+  /// with the smaller pointer first
+  std::set<std::pair<const CollisionNode*, const CollisionNode*> >
+      mDisabledPairs;
 };
 
 }  // namespace collision
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_GJKSIMPLEX_H_
+#define DART_COLLISION_GJKSIMPLEX_H_
+
+#include <cstddef>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace collision {
+
+/// Simplex of a GJK distance query that is kept between two queries on the
+/// same pair of shapes to warm start the second one. Each vertex is stored as
+/// the search direction that produced it, so the simplex is rebuilt from the
+/// current poses (and sizes) of the shapes and always consists of valid
+/// support points.
+struct GJKSimplex
+{
+  GJKSimplex();
+
+  /// Number of vertices of the simplex. Zero means there is nothing to warm
+  /// start from.
+  size_t mSize;
+
+  /// Search directions w.r.t. the world frame that produced the vertices
+  Eigen::Vector3d mDirections[4];
+
+  /// Number of GJK iterations that the last query took
+  size_t mNumIterations;
+};
+
+}  // namespace collision
+}  // namespace dart
+
+#endif  // DART_COLLISION_GJKSIMPLEX_H_
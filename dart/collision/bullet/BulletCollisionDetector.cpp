@@ -38,6 +38,11 @@
 
 #include <vector>
 
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+
 #include "dart/collision/bullet/BulletCollisionNode.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/Skeleton.h"
@@ -105,6 +110,55 @@ struct CollisionFilter : public btOverlapFilterCallback
   }
 };
 
+//==============================================================================
+// Contact callback of the boolean queries that only records whether any
+// penetrating contact point was found
+struct CheckCollisionCallback : public btCollisionWorld::ContactResultCallback
+{
+  CheckCollisionCallback(CollisionNode* _collNode)
+    : mCollNode(_collNode), mCollision(false)
+  {
+  }
+
+  // return true when pairs need collision
+  virtual bool needsCollision(btBroadphaseProxy* _proxy) const
+  {
+    if (mCollision)
+      return false;
+
+    if (!ContactResultCallback::needsCollision(_proxy))
+      return false;
+
+    btCollisionObject* collObj
+        = static_cast<btCollisionObject*>(_proxy->m_clientObject);
+    BulletUserData* userData
+        = static_cast<BulletUserData*>(collObj->getUserPointer());
+
+    CollisionNode* collNode = userData->btCollNode;
+    if (collNode == mCollNode)
+      return false;
+
+    return userData->btCollDet->isCollidable(mCollNode, collNode);
+  }
+
+  virtual btScalar addSingleResult(
+      btManifoldPoint& _cp,
+      const btCollisionObjectWrapper* /*_colObj0Wrap*/,
+      int /*_partId0*/, int /*_index0*/,
+      const btCollisionObjectWrapper* /*_colObj1Wrap*/,
+      int /*_partId1*/, int /*_index1*/)
+  {
+    if (_cp.getDistance() <= 0.0)
+      mCollision = true;
+
+    return 0;
+  }
+
+  CollisionNode* mCollNode;
+
+  bool mCollision;
+};
+
 //==============================================================================
 BulletCollisionDetector::BulletCollisionDetector() : CollisionDetector()
 {
@@ -216,6 +270,126 @@ bool BulletCollisionDetector::detectCollision(bool _checkAllCollisions,
   return !mContacts.empty();
 }
 
+//==============================================================================
+bool BulletCollisionDetector::checkCollision(
+    const std::vector<dynamics::BodyNode*>& _bodyNodes)
+{
+  setQueryNodes(_bodyNodes);
+  if (mQueryNodes.empty())
+    return false;
+
+  // Update all the transformations of the collision nodes
+  for (size_t i = 0; i < mCollisionNodes.size(); ++i)
+    static_cast<BulletCollisionNode*>(
+        mCollisionNodes[i])->updateBulletCollisionObjects();
+  mBulletCollisionWorld->updateAabbs();
+
+  // Test only the objects of the given BodyNodes against the world
+  for (size_t i = 0; i < mQueryNodes.size(); ++i)
+  {
+    BulletCollisionNode* collNode
+        = static_cast<BulletCollisionNode*>(mQueryNodes[i]);
+    CheckCollisionCallback callback(collNode);
+
+    for (int j = 0; j < collNode->getNumBulletCollisionObjects(); ++j)
+    {
+      mBulletCollisionWorld->contactTest(
+            collNode->getBulletCollisionObject(j), callback);
+
+      if (callback.mCollision)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+void BulletCollisionDetector::clearDistanceCache()
+{
+  CollisionDetector::clearDistanceCache();
+  mSeparatingAxes.clear();
+}
+
+//==============================================================================
+bool BulletCollisionDetector::computeDistance(CollisionNode* _node1,
+                                              CollisionNode* _node2,
+                                              DistanceResult& _result,
+                                              double _upperBound)
+{
+  BulletCollisionNode* collNode1 = static_cast<BulletCollisionNode*>(_node1);
+  BulletCollisionNode* collNode2 = static_cast<BulletCollisionNode*>(_node2);
+  collNode1->updateBulletCollisionObjects();
+  collNode2->updateBulletCollisionObjects();
+
+  bool found = false;
+  for (int i = 0; i < collNode1->getNumBulletCollisionObjects(); ++i)
+  {
+    btCollisionObject* collObj1 = collNode1->getBulletCollisionObject(i);
+    if (!collObj1->getCollisionShape()->isConvex())
+      continue;
+
+    for (int j = 0; j < collNode2->getNumBulletCollisionObjects(); ++j)
+    {
+      btCollisionObject* collObj2 = collNode2->getBulletCollisionObject(j);
+      if (!collObj2->getCollisionShape()->isConvex())
+        continue;
+
+      btVoronoiSimplexSolver simplexSolver;
+      btGjkEpaPenetrationDepthSolver penetrationSolver;
+      btGjkPairDetector gjk(
+            static_cast<const btConvexShape*>(collObj1->getCollisionShape()),
+            static_cast<const btConvexShape*>(collObj2->getCollisionShape()),
+            &simplexSolver, &penetrationSolver);
+
+      // Start from the separating axis of the previous query on this pair
+      const std::pair<const btCollisionObject*, const btCollisionObject*> key(
+            collObj1, collObj2);
+      std::map<std::pair<const btCollisionObject*, const btCollisionObject*>,
+          btVector3>::iterator axis = mSeparatingAxes.find(key);
+      if (axis != mSeparatingAxes.end())
+        gjk.setCachedSeperatingAxis(axis->second);
+
+      btDiscreteCollisionDetectorInterface::ClosestPointInput input;
+      input.m_transformA = collObj1->getWorldTransform();
+      input.m_transformB = collObj2->getWorldTransform();
+      if (_upperBound < BT_LARGE_FLOAT)
+        input.m_maximumDistanceSquared = _upperBound * _upperBound;
+
+      btPointCollector output;
+      gjk.getClosestPoints(input, output, nullptr);
+      mSeparatingAxes[key] = gjk.getCachedSeparatingAxis();
+
+      if (!output.m_hasResult || output.m_distance >= _upperBound)
+        continue;
+
+      _upperBound = output.m_distance;
+      found = true;
+
+      // The point is on the second object and the normal points from the
+      // second object to the first one
+      const Eigen::Vector3d point2 = convertVector3(output.m_pointInWorld);
+      const Eigen::Vector3d normal = convertVector3(output.m_normalOnBInWorld);
+
+      BulletUserData* userData1
+          = static_cast<BulletUserData*>(collObj1->getUserPointer());
+      BulletUserData* userData2
+          = static_cast<BulletUserData*>(collObj2->getUserPointer());
+      _result.distance = output.m_distance;
+      _result.point1 = point2 + output.m_distance * normal;
+      _result.point2 = point2;
+      _result.bodyNode1 = userData1->bodyNode;
+      _result.bodyNode2 = userData2->bodyNode;
+      _result.shape1 = std::const_pointer_cast<dynamics::Shape>(
+            userData1->shape);
+      _result.shape2 = std::const_pointer_cast<dynamics::Shape>(
+            userData2->shape);
+    }
+  }
+
+  return found;
+}
+
 //==============================================================================
 bool BulletCollisionDetector::detectCollision(CollisionNode* _node1,
                                               CollisionNode* _node2,
@@ -39,6 +39,7 @@
 
 #include <vector>
 #include <map>
+#include <utility>
 
 #include <btBulletCollisionCommon.h>
 #include <Eigen/Dense>
@@ -68,14 +69,34 @@ public:
   virtual bool detectCollision(bool _checkAllCollisions,
                                bool _calculateContactPoints);
 
+  using CollisionDetector::checkCollision;
+
+  /// \copydoc CollisionDetector::checkCollision
+  virtual bool checkCollision(
+      const std::vector<dynamics::BodyNode*>& _bodyNodes);
+
+  using CollisionDetector::computeDistance;
+
+  /// \copydoc CollisionDetector::clearDistanceCache
+  virtual void clearDistanceCache();
+
 protected:
   // TODO(JS): Not implemented yet.
   /// \copydoc CollisionDetector::detectCollision
   virtual bool detectCollision(CollisionNode* _node1, CollisionNode* _node2,
                                bool _calculateContactPoints);
 
+  /// \copydoc CollisionDetector::computeDistance
+  virtual bool computeDistance(CollisionNode* _node1, CollisionNode* _node2,
+                               DistanceResult& _result, double _upperBound);
+
   /// @brief Bullet collision world
   btCollisionWorld* mBulletCollisionWorld;
+
+  /// Separating axes of the last GJK queries per pair of collision objects,
+  /// which warm start the next query on the same pair
+  std::map<std::pair<const btCollisionObject*, const btCollisionObject*>,
+           btVector3> mSeparatingAxes;
 };
 
 }  // namespace collision
@@ -152,10 +152,14 @@ bool DARTCollisionDetector::detectCollision(CollisionNode* _collNode1,
               BodyNode2->getTransform()
               * BodyNode2->getCollisionShape(j)->getLocalTransform(),
               &contacts);
+
+      // The remaining shape pairs cannot change the result
+      if (!contacts.empty())
+        return true;
     }
   }
 
-  return contacts.size() > 0 ? true : false;
+  return false;
 }
 
 }  // namespace collision
@@ -0,0 +1,830 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/DARTDistance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <assimp/scene.h>
+
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/EllipsoidShape.h"
+#include "dart/dynamics/CylinderShape.h"
+#include "dart/dynamics/PlaneShape.h"
+#include "dart/dynamics/MeshShape.h"
+
+namespace dart {
+namespace collision {
+
+namespace {
+
+/// Maximum number of GJK iterations
+const size_t GJK_MAX_ITERATIONS = 128;
+
+/// GJK stops once the squared distance estimate and its lower bound are
+/// within this fraction of each other
+const double GJK_TOLERANCE = 1e-10;
+
+/// Squared distance below which the shapes are considered touching
+const double GJK_TOUCHING_TOLERANCE = 1e-24;
+
+/// Maximum number of EPA iterations
+const size_t EPA_MAX_ITERATIONS = 1024;
+
+/// EPA stops once the polytope cannot be expanded further than this
+const double EPA_TOLERANCE = 1e-8;
+
+//==============================================================================
+// Vertex of the Minkowski difference of two shapes along with the support
+// points of the shapes that it is made of
+struct SupportPoint
+{
+  // Search direction w.r.t. the world frame
+  Eigen::Vector3d dir;
+
+  // Support point of the first shape w.r.t. the world frame
+  Eigen::Vector3d p0;
+
+  // Support point of the second shape w.r.t. the world frame
+  Eigen::Vector3d p1;
+
+  // Vertex of the Minkowski difference, p0 - p1
+  Eigen::Vector3d w;
+};
+
+//==============================================================================
+// Face of the EPA polytope
+struct EPAFace
+{
+  // Indices of the vertices in counterclockwise order seen from outside
+  size_t v[3];
+
+  // Outward unit normal
+  Eigen::Vector3d normal;
+
+  // Distance of the face plane from the origin
+  double distance;
+};
+
+//==============================================================================
+bool isConvexSupported(const dynamics::Shape* _shape)
+{
+  switch (_shape->getShapeType())
+  {
+    case dynamics::Shape::BOX:
+    case dynamics::Shape::ELLIPSOID:
+    case dynamics::Shape::CYLINDER:
+      return true;
+    case dynamics::Shape::MESH:
+    {
+      const aiScene* scene
+          = static_cast<const dynamics::MeshShape*>(_shape)->getMesh();
+      if (nullptr == scene)
+        return false;
+
+      for (size_t i = 0; i < scene->mNumMeshes; ++i)
+      {
+        if (scene->mMeshes[i]->mNumVertices > 0)
+          return true;
+      }
+
+      return false;
+    }
+    default:
+      return false;
+  }
+}
+
+//==============================================================================
+// Support point of a shape w.r.t. its own frame in direction _dir
+Eigen::Vector3d computeLocalSupport(const dynamics::Shape* _shape,
+                                    const Eigen::Vector3d& _dir)
+{
+  switch (_shape->getShapeType())
+  {
+    case dynamics::Shape::BOX:
+    {
+      const Eigen::Vector3d halfSize
+          = 0.5 * static_cast<const dynamics::BoxShape*>(_shape)->getSize();
+
+      return Eigen::Vector3d(_dir[0] < 0.0 ? -halfSize[0] : halfSize[0],
+                             _dir[1] < 0.0 ? -halfSize[1] : halfSize[1],
+                             _dir[2] < 0.0 ? -halfSize[2] : halfSize[2]);
+    }
+    case dynamics::Shape::ELLIPSOID:
+    {
+      const Eigen::Vector3d radii = 0.5 * static_cast<
+          const dynamics::EllipsoidShape*>(_shape)->getSize();
+      const Eigen::Vector3d scaledDir = radii.cwiseProduct(_dir);
+      const double norm = scaledDir.norm();
+      if (norm == 0.0)
+        return Eigen::Vector3d::Zero();
+
+      return radii.cwiseProduct(scaledDir) / norm;
+    }
+    case dynamics::Shape::CYLINDER:
+    {
+      const dynamics::CylinderShape* cylinder
+          = static_cast<const dynamics::CylinderShape*>(_shape);
+      const double halfHeight = 0.5 * cylinder->getHeight();
+
+      Eigen::Vector3d support(0.0, 0.0,
+                              _dir[2] < 0.0 ? -halfHeight : halfHeight);
+      const double norm = _dir.head<2>().norm();
+      if (norm > 0.0)
+        support.head<2>() = cylinder->getRadius() / norm * _dir.head<2>();
+
+      return support;
+    }
+    case dynamics::Shape::MESH:
+    {
+      const dynamics::MeshShape* mesh
+          = static_cast<const dynamics::MeshShape*>(_shape);
+      const aiScene* scene = mesh->getMesh();
+      const Eigen::Vector3d& scale = mesh->getScale();
+      const Eigen::Vector3d scaledDir = scale.cwiseProduct(_dir);
+
+      double maxDot = -std::numeric_limits<double>::infinity();
+      Eigen::Vector3d support = Eigen::Vector3d::Zero();
+      for (size_t i = 0; i < scene->mNumMeshes; ++i)
+      {
+        const aiMesh* subMesh = scene->mMeshes[i];
+        for (size_t j = 0; j < subMesh->mNumVertices; ++j)
+        {
+          const aiVector3D& vertex = subMesh->mVertices[j];
+          const double dot = vertex.x * scaledDir[0] + vertex.y * scaledDir[1]
+                             + vertex.z * scaledDir[2];
+          if (dot > maxDot)
+          {
+            maxDot = dot;
+            support << vertex.x, vertex.y, vertex.z;
+          }
+        }
+      }
+
+      return scale.cwiseProduct(support);
+    }
+    default:
+      return Eigen::Vector3d::Zero();
+  }
+}
+
+//==============================================================================
+// Support mapping of the Minkowski difference of two posed shapes
+class MinkowskiDifference
+{
+public:
+  MinkowskiDifference(const dynamics::Shape* _shape0,
+                      const Eigen::Isometry3d& _T0,
+                      const dynamics::Shape* _shape1,
+                      const Eigen::Isometry3d& _T1)
+    : mShape0(_shape0), mT0(_T0), mShape1(_shape1), mT1(_T1)
+  {
+  }
+
+  SupportPoint computeSupport(const Eigen::Vector3d& _dir) const
+  {
+    SupportPoint support;
+    support.dir = _dir;
+    support.p0 = mT0 * computeLocalSupport(
+          mShape0, mT0.linear().transpose() * _dir);
+    support.p1 = mT1 * computeLocalSupport(
+          mShape1, -(mT1.linear().transpose() * _dir));
+    support.w = support.p0 - support.p1;
+
+    return support;
+  }
+
+private:
+  const dynamics::Shape* mShape0;
+  const Eigen::Isometry3d& mT0;
+  const dynamics::Shape* mShape1;
+  const Eigen::Isometry3d& mT1;
+};
+
+//==============================================================================
+// Closest point to the origin on a segment. The simplex is reduced to the
+// vertices whose barycentric coordinates are positive.
+Eigen::Vector3d closestOnSegment(SupportPoint* _Y, size_t& _size,
+                                 double* _lambda)
+{
+  const Eigen::Vector3d ab = _Y[1].w - _Y[0].w;
+  const double t = -_Y[0].w.dot(ab);
+  const double denom = ab.squaredNorm();
+
+  if (t <= 0.0 || denom <= 0.0)
+  {
+    _size = 1;
+    _lambda[0] = 1.0;
+    return _Y[0].w;
+  }
+
+  if (t >= denom)
+  {
+    _Y[0] = _Y[1];
+    _size = 1;
+    _lambda[0] = 1.0;
+    return _Y[0].w;
+  }
+
+  _size = 2;
+  _lambda[1] = t / denom;
+  _lambda[0] = 1.0 - _lambda[1];
+  return _Y[0].w + _lambda[1] * ab;
+}
+
+//==============================================================================
+// Reduce the simplex to one of its edges and return the closest point on it
+Eigen::Vector3d reduceToEdge(SupportPoint* _Y, size_t& _size, double* _lambda,
+                             size_t _i, size_t _j)
+{
+  const SupportPoint a = _Y[_i];
+  const SupportPoint b = _Y[_j];
+  _Y[0] = a;
+  _Y[1] = b;
+
+  return closestOnSegment(_Y, _size, _lambda);
+}
+
+//==============================================================================
+// Closest point to the origin on a triangle following the Voronoi region
+// tests of Ericson, "Real-Time Collision Detection", Section 5.1.5
+Eigen::Vector3d closestOnTriangle(SupportPoint* _Y, size_t& _size,
+                                  double* _lambda)
+{
+  const Eigen::Vector3d a = _Y[0].w;
+  const Eigen::Vector3d b = _Y[1].w;
+  const Eigen::Vector3d c = _Y[2].w;
+  const Eigen::Vector3d ab = b - a;
+  const Eigen::Vector3d ac = c - a;
+
+  const double d1 = -ab.dot(a);
+  const double d2 = -ac.dot(a);
+  if (d1 <= 0.0 && d2 <= 0.0)
+  {
+    _size = 1;
+    _lambda[0] = 1.0;
+    return a;
+  }
+
+  const double d3 = -ab.dot(b);
+  const double d4 = -ac.dot(b);
+  if (d3 >= 0.0 && d4 <= d3)
+  {
+    _Y[0] = _Y[1];
+    _size = 1;
+    _lambda[0] = 1.0;
+    return b;
+  }
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return reduceToEdge(_Y, _size, _lambda, 0, 1);
+
+  const double d5 = -ab.dot(c);
+  const double d6 = -ac.dot(c);
+  if (d6 >= 0.0 && d5 <= d6)
+  {
+    _Y[0] = _Y[2];
+    _size = 1;
+    _lambda[0] = 1.0;
+    return c;
+  }
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return reduceToEdge(_Y, _size, _lambda, 0, 2);
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    return reduceToEdge(_Y, _size, _lambda, 1, 2);
+
+  const double denom = va + vb + vc;
+  if (denom <= 0.0)
+  {
+    // Degenerate triangle, so the closest point lies on one of its edges
+    SupportPoint bestY[2];
+    size_t bestSize = 0;
+    double bestLambda[2];
+    Eigen::Vector3d best;
+    const size_t edges[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (size_t i = 0; i < 3; ++i)
+    {
+      SupportPoint edgeY[3] = {_Y[0], _Y[1], _Y[2]};
+      size_t edgeSize = 2;
+      double edgeLambda[2];
+      const Eigen::Vector3d v = reduceToEdge(edgeY, edgeSize, edgeLambda,
+                                             edges[i][0], edges[i][1]);
+      if (0 == bestSize || v.squaredNorm() < best.squaredNorm())
+      {
+        best = v;
+        bestSize = edgeSize;
+        std::copy(edgeY, edgeY + edgeSize, bestY);
+        std::copy(edgeLambda, edgeLambda + edgeSize, bestLambda);
+      }
+    }
+
+    std::copy(bestY, bestY + bestSize, _Y);
+    std::copy(bestLambda, bestLambda + bestSize, _lambda);
+    _size = bestSize;
+    return best;
+  }
+
+  _size = 3;
+  _lambda[1] = vb / denom;
+  _lambda[2] = vc / denom;
+  _lambda[0] = 1.0 - _lambda[1] - _lambda[2];
+  return a + _lambda[1] * ab + _lambda[2] * ac;
+}
+
+//==============================================================================
+// Closest point to the origin on a tetrahedron. The simplex is left untouched
+// when the tetrahedron contains the origin.
+Eigen::Vector3d closestOnTetrahedron(SupportPoint* _Y, size_t& _size,
+                                     double* _lambda)
+{
+  // Each face followed by the vertex opposite to it
+  const size_t faces[4][4] = {{0, 1, 2, 3}, {0, 3, 1, 2},
+                              {0, 2, 3, 1}, {1, 3, 2, 0}};
+
+  SupportPoint bestY[3];
+  size_t bestSize = 0;
+  double bestLambda[3];
+  Eigen::Vector3d best;
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const Eigen::Vector3d& a = _Y[faces[i][0]].w;
+    const Eigen::Vector3d& d = _Y[faces[i][3]].w;
+    const Eigen::Vector3d n
+        = (_Y[faces[i][1]].w - a).cross(_Y[faces[i][2]].w - a);
+    const double originSide = -n.dot(a);
+    const double vertexSide = n.dot(d - a);
+
+    // Skip the faces that have the origin on the same side as the opposite
+    // vertex unless the tetrahedron is too flat to tell
+    const bool degenerate = vertexSide * vertexSide
+        <= 1e-20 * n.squaredNorm() * (d - a).squaredNorm();
+    if (!degenerate && originSide * vertexSide >= 0.0)
+      continue;
+
+    SupportPoint faceY[3]
+        = {_Y[faces[i][0]], _Y[faces[i][1]], _Y[faces[i][2]]};
+    size_t faceSize = 3;
+    double faceLambda[3];
+    const Eigen::Vector3d v = closestOnTriangle(faceY, faceSize, faceLambda);
+    if (0 == bestSize || v.squaredNorm() < best.squaredNorm())
+    {
+      best = v;
+      bestSize = faceSize;
+      std::copy(faceY, faceY + faceSize, bestY);
+      std::copy(faceLambda, faceLambda + faceSize, bestLambda);
+    }
+  }
+
+  if (0 == bestSize)
+    return Eigen::Vector3d::Zero();
+
+  std::copy(bestY, bestY + bestSize, _Y);
+  std::copy(bestLambda, bestLambda + bestSize, _lambda);
+  _size = bestSize;
+  return best;
+}
+
+//==============================================================================
+Eigen::Vector3d closestOnSimplex(SupportPoint* _Y, size_t& _size,
+                                 double* _lambda)
+{
+  switch (_size)
+  {
+    case 1:
+      _lambda[0] = 1.0;
+      return _Y[0].w;
+    case 2:
+      return closestOnSegment(_Y, _size, _lambda);
+    case 3:
+      return closestOnTriangle(_Y, _size, _lambda);
+    default:
+      return closestOnTetrahedron(_Y, _size, _lambda);
+  }
+}
+
+//==============================================================================
+// Grow a simplex that touches the origin into a tetrahedron that contains the
+// origin, possibly on its boundary, so that EPA can start from it
+bool expandToTetrahedron(const MinkowskiDifference& _md, SupportPoint* _Y,
+                         size_t& _size)
+{
+  if (1 == _size)
+  {
+    for (size_t i = 0; i < 6 && 1 == _size; ++i)
+    {
+      const Eigen::Vector3d dir
+          = (i % 2 ? -1.0 : 1.0) * Eigen::Vector3d::Unit(i / 2);
+      const SupportPoint support = _md.computeSupport(dir);
+      if ((support.w - _Y[0].w).squaredNorm() > GJK_TOUCHING_TOLERANCE)
+        _Y[_size++] = support;
+    }
+  }
+
+  if (2 == _size)
+  {
+    const Eigen::Vector3d d = _Y[1].w - _Y[0].w;
+    Eigen::Vector3d::Index axis;
+    d.cwiseAbs().minCoeff(&axis);
+    const Eigen::Vector3d e1 = d.cross(Eigen::Vector3d::Unit(axis));
+    const Eigen::Vector3d e2 = d.cross(e1);
+    const Eigen::Vector3d dirs[4] = {e1, -e1, e2, -e2};
+    for (size_t i = 0; i < 4 && 2 == _size; ++i)
+    {
+      const SupportPoint support = _md.computeSupport(dirs[i]);
+      if (d.cross(support.w - _Y[0].w).squaredNorm()
+          > GJK_TOUCHING_TOLERANCE * d.squaredNorm())
+        _Y[_size++] = support;
+    }
+  }
+
+  if (3 == _size)
+  {
+    const Eigen::Vector3d n = (_Y[1].w - _Y[0].w).cross(_Y[2].w - _Y[0].w);
+    for (size_t i = 0; i < 2 && 3 == _size; ++i)
+    {
+      const SupportPoint support = _md.computeSupport(i ? -n : n);
+      const double height = n.dot(support.w - _Y[0].w);
+      if (height * height > GJK_TOUCHING_TOLERANCE * n.squaredNorm())
+        _Y[_size++] = support;
+    }
+  }
+
+  return 4 == _size;
+}
+
+//==============================================================================
+void addFace(const std::vector<SupportPoint>& _vertices,
+             std::vector<EPAFace>& _faces, size_t _a, size_t _b, size_t _c)
+{
+  const Eigen::Vector3d& a = _vertices[_a].w;
+  Eigen::Vector3d normal
+      = (_vertices[_b].w - a).cross(_vertices[_c].w - a);
+  const double norm = normal.norm();
+  if (norm <= 0.0)
+    return;
+  normal /= norm;
+
+  EPAFace face;
+  face.v[0] = _a;
+  face.v[1] = _b;
+  face.v[2] = _c;
+  face.normal = normal;
+  face.distance = normal.dot(a);
+  _faces.push_back(face);
+}
+
+//==============================================================================
+// Expand the GJK tetrahedron that contains the origin until its face closest
+// to the origin lies on the boundary of the Minkowski difference
+void computePenetration(const MinkowskiDifference& _md, const SupportPoint* _Y,
+                        double& _distance,
+                        Eigen::Vector3d& _point0, Eigen::Vector3d& _point1)
+{
+  std::vector<SupportPoint> vertices(_Y, _Y + 4);
+  if ((vertices[1].w - vertices[0].w).cross(vertices[2].w - vertices[0].w)
+      .dot(vertices[3].w - vertices[0].w) > 0.0)
+  {
+    std::swap(vertices[0], vertices[1]);
+  }
+
+  std::vector<EPAFace> faces;
+  addFace(vertices, faces, 0, 1, 2);
+  addFace(vertices, faces, 0, 3, 1);
+  addFace(vertices, faces, 0, 2, 3);
+  addFace(vertices, faces, 1, 3, 2);
+
+  if (faces.empty())
+  {
+    _distance = 0.0;
+    _point0 = _point1 = 0.5 * (vertices[0].p0 + vertices[0].p1);
+    return;
+  }
+
+  std::vector<EPAFace> keptFaces;
+  std::vector<std::pair<size_t, size_t>> horizon;
+  EPAFace closest;
+  for (size_t iteration = 0; ; ++iteration)
+  {
+    closest = faces[0];
+    for (size_t i = 1; i < faces.size(); ++i)
+    {
+      if (faces[i].distance < closest.distance)
+        closest = faces[i];
+    }
+
+    if (EPA_MAX_ITERATIONS == iteration)
+      break;
+
+    const SupportPoint w = _md.computeSupport(closest.normal);
+    if (closest.normal.dot(w.w) - closest.distance
+        <= EPA_TOLERANCE * std::max(1.0, closest.distance))
+      break;
+
+    const size_t newIndex = vertices.size();
+    vertices.push_back(w);
+
+    // Remove the faces that the new vertex can see. The edges that only one
+    // of them has form the horizon.
+    keptFaces.clear();
+    horizon.clear();
+    for (size_t i = 0; i < faces.size(); ++i)
+    {
+      const EPAFace& face = faces[i];
+      if (face.normal.dot(w.w - vertices[face.v[0]].w) <= 0.0)
+      {
+        keptFaces.push_back(face);
+        continue;
+      }
+
+      for (size_t j = 0; j < 3; ++j)
+      {
+        const std::pair<size_t, size_t> edge(face.v[j], face.v[(j + 1) % 3]);
+        const std::vector<std::pair<size_t, size_t>>::iterator reversed
+            = std::find(horizon.begin(), horizon.end(),
+                        std::make_pair(edge.second, edge.first));
+        if (reversed != horizon.end())
+          horizon.erase(reversed);
+        else
+          horizon.push_back(edge);
+      }
+    }
+    faces.swap(keptFaces);
+
+    for (size_t i = 0; i < horizon.size(); ++i)
+      addFace(vertices, faces, horizon[i].first, horizon[i].second, newIndex);
+
+    if (faces.empty())
+      break;
+  }
+
+  // Barycentric coordinates of the projection of the origin on the face
+  const Eigen::Vector3d& a = vertices[closest.v[0]].w;
+  const Eigen::Vector3d e0 = vertices[closest.v[1]].w - a;
+  const Eigen::Vector3d e1 = vertices[closest.v[2]].w - a;
+  const Eigen::Vector3d e2 = closest.distance * closest.normal - a;
+  const double d00 = e0.dot(e0);
+  const double d01 = e0.dot(e1);
+  const double d11 = e1.dot(e1);
+  const double d20 = e2.dot(e0);
+  const double d21 = e2.dot(e1);
+  const double denom = d00 * d11 - d01 * d01;
+
+  double lambda[3] = {1.0, 0.0, 0.0};
+  if (denom > 0.0)
+  {
+    lambda[1] = (d11 * d20 - d01 * d21) / denom;
+    lambda[2] = (d00 * d21 - d01 * d20) / denom;
+    lambda[0] = 1.0 - lambda[1] - lambda[2];
+  }
+
+  _point0.setZero();
+  _point1.setZero();
+  for (size_t i = 0; i < 3; ++i)
+  {
+    _point0 += lambda[i] * vertices[closest.v[i]].p0;
+    _point1 += lambda[i] * vertices[closest.v[i]].p1;
+  }
+  _distance = -closest.distance;
+}
+
+//==============================================================================
+// Radius of a sphere about the origin of the shape frame that contains the
+// shape, or infinity if no such radius is known without visiting its vertices
+double computeBoundingRadius(const dynamics::Shape* _shape)
+{
+  switch (_shape->getShapeType())
+  {
+    case dynamics::Shape::BOX:
+    case dynamics::Shape::ELLIPSOID:
+    case dynamics::Shape::CYLINDER:
+      // The bounding boxes of these shapes are centered on their origins
+      return 0.5 * _shape->getBoundingBoxDim().norm();
+    default:
+      // The bounding box of a mesh is not necessarily centered on its origin
+      return std::numeric_limits<double>::infinity();
+  }
+}
+
+//==============================================================================
+// Signed distance between a plane and a convex shape
+void computePlaneDistance(const dynamics::PlaneShape* _plane,
+                          const Eigen::Isometry3d& _planeTransform,
+                          const dynamics::Shape* _shape,
+                          const Eigen::Isometry3d& _shapeTransform,
+                          double _upperBound,
+                          double& _distance,
+                          Eigen::Vector3d& _planePoint,
+                          Eigen::Vector3d& _shapePoint)
+{
+  const Eigen::Vector3d normal
+      = (_planeTransform.linear() * _plane->getNormal()).normalized();
+  const double offset = _plane->getOffset() / _plane->getNormal().norm()
+                        + normal.dot(_planeTransform.translation());
+
+  // Like the GJK query, stop once the distance is proven to be at least the
+  // upper bound. The bounding sphere of the shape provides the proof without
+  // computing its support point.
+  if (_upperBound >= 0.0)
+  {
+    const double radius = computeBoundingRadius(_shape);
+    const double lowerBound
+        = normal.dot(_shapeTransform.translation()) - offset - radius;
+    if (lowerBound >= _upperBound)
+    {
+      _distance = lowerBound;
+      _shapePoint = _shapeTransform.translation() - radius * normal;
+      _planePoint = _shapePoint - _distance * normal;
+      return;
+    }
+  }
+
+  _shapePoint = _shapeTransform * computeLocalSupport(
+        _shape, -(_shapeTransform.linear().transpose() * normal));
+  _distance = normal.dot(_shapePoint) - offset;
+  _planePoint = _shapePoint - _distance * normal;
+}
+
+}  // anonymous namespace
+
+//==============================================================================
+bool distance(const dynamics::ConstShapePtr& _shape0,
+              const Eigen::Isometry3d& _T0,
+              const dynamics::ConstShapePtr& _shape1,
+              const Eigen::Isometry3d& _T1,
+              double _upperBound,
+              double& _distance,
+              Eigen::Vector3d& _point0,
+              Eigen::Vector3d& _point1,
+              GJKSimplex* _simplex)
+{
+  const dynamics::Shape* shape0 = _shape0.get();
+  const dynamics::Shape* shape1 = _shape1.get();
+
+  if (dynamics::Shape::PLANE == shape0->getShapeType()
+      && isConvexSupported(shape1))
+  {
+    computePlaneDistance(static_cast<const dynamics::PlaneShape*>(shape0), _T0,
+                         shape1, _T1, _upperBound, _distance, _point0, _point1);
+    return true;
+  }
+
+  if (dynamics::Shape::PLANE == shape1->getShapeType()
+      && isConvexSupported(shape0))
+  {
+    computePlaneDistance(static_cast<const dynamics::PlaneShape*>(shape1), _T1,
+                         shape0, _T0, _upperBound, _distance, _point1, _point0);
+    return true;
+  }
+
+  if (!isConvexSupported(shape0) || !isConvexSupported(shape1))
+    return false;
+
+  const MinkowskiDifference md(shape0, _T0, shape1, _T1);
+
+  SupportPoint Y[4];
+  size_t size = 0;
+  double lambda[4];
+
+  // Rebuild the simplex of the previous query, or start from the direction
+  // between the origins of the shapes
+  if (_simplex)
+  {
+    for (size_t i = 0; i < _simplex->mSize && i < 4; ++i)
+      Y[size++] = md.computeSupport(_simplex->mDirections[i]);
+  }
+
+  if (0 == size)
+  {
+    Eigen::Vector3d dir = _T1.translation() - _T0.translation();
+    if (dir.squaredNorm() == 0.0)
+      dir = Eigen::Vector3d::UnitX();
+    Y[size++] = md.computeSupport(dir);
+  }
+
+  Eigen::Vector3d v;
+  bool intersecting = false;
+  bool bounded = false;
+  double lowerBound = 0.0;
+  size_t numIterations = 0;
+  while (true)
+  {
+    v = closestOnSimplex(Y, size, lambda);
+    if (4 == size)
+    {
+      intersecting = true;
+      break;
+    }
+
+    // The shapes touch or intersect if the simplex touches the origin
+    const double vv = v.squaredNorm();
+    if (vv <= GJK_TOUCHING_TOLERANCE)
+    {
+      intersecting = expandToTetrahedron(md, Y, size);
+      break;
+    }
+
+    if (GJK_MAX_ITERATIONS == numIterations)
+      break;
+    ++numIterations;
+
+    const SupportPoint w = md.computeSupport(-v);
+    const double vw = v.dot(w.w);
+
+    // v.w/|v| is a lower bound of the distance
+    if (_upperBound >= 0.0 && vw > 0.0
+        && vw * vw >= _upperBound * _upperBound * vv)
+    {
+      bounded = true;
+      lowerBound = vw / std::sqrt(vv);
+      break;
+    }
+
+    if (vv - vw <= GJK_TOLERANCE * vv)
+      break;
+
+    bool isDuplicate = false;
+    for (size_t i = 0; i < size; ++i)
+    {
+      if ((Y[i].w - w.w).squaredNorm() <= GJK_TOLERANCE * vv)
+      {
+        isDuplicate = true;
+        break;
+      }
+    }
+    if (isDuplicate)
+      break;
+
+    Y[size++] = w;
+  }
+
+  if (intersecting)
+  {
+    computePenetration(md, Y, _distance, _point0, _point1);
+  }
+  else
+  {
+    _point0.setZero();
+    _point1.setZero();
+    for (size_t i = 0; i < size; ++i)
+    {
+      _point0 += lambda[i] * Y[i].p0;
+      _point1 += lambda[i] * Y[i].p1;
+    }
+    _distance = bounded ? lowerBound : v.norm();
+  }
+
+  if (_simplex)
+  {
+    _simplex->mSize = size;
+    for (size_t i = 0; i < size; ++i)
+      _simplex->mDirections[i] = Y[i].dir;
+    _simplex->mNumIterations = numIterations;
+  }
+
+  return true;
+}
+
+}  // namespace collision
+}  // namespace dart
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DARTDISTANCE_H_
+#define DART_COLLISION_DART_DARTDISTANCE_H_
+
+#include <Eigen/Dense>
+
+#include "dart/collision/GJKSimplex.h"
+#include "dart/dynamics/Shape.h"
+
+namespace dart {
+namespace collision {
+
+/// Compute the signed distance between two shapes with GJK, and the
+/// penetration depth with EPA when they intersect. Boxes, ellipsoids,
+/// cylinders and meshes are supported, where a mesh is represented by the
+/// convex hull of its vertices. Planes are supported against any of those.
+///
+/// \param[in] _upperBound The query stops as soon as the distance is proven to
+/// be at least this large, in which case _distance is a lower bound that is
+/// not smaller than _upperBound and the points are only estimates.
+/// \param[out] _distance Minimum distance between the shapes, or the negative
+/// penetration depth if they intersect
+/// \param[out] _point0 Closest point on _shape0 w.r.t. the world frame. If the
+/// shapes intersect, it is the point of _shape0 deepest inside _shape1.
+/// \param[out] _point1 Closest point on _shape1 w.r.t. the world frame
+/// \param[in,out] _simplex Optional simplex of the previous query on the same
+/// pair of shapes to start from. It is updated with the final simplex.
+/// \return False if the distance between the given types of shapes is not
+/// supported
+bool distance(const dynamics::ConstShapePtr& _shape0,
+              const Eigen::Isometry3d& _T0,
+              const dynamics::ConstShapePtr& _shape1,
+              const Eigen::Isometry3d& _T1,
+              double _upperBound,
+              double& _distance,
+              Eigen::Vector3d& _point0,
+              Eigen::Vector3d& _point1,
+              GJKSimplex* _simplex = nullptr);
+
+}  // namespace collision
+}  // namespace dart
+
+#endif  // DART_COLLISION_DART_DARTDISTANCE_H_
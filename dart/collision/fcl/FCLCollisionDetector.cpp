@@ -39,6 +39,8 @@
 
 #include <vector>
 
+#include <fcl/distance.h>
+
 #include "dart/dynamics/Shape.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/Skeleton.h"
@@ -103,6 +105,33 @@ bool collisionCallBack(fcl::CollisionObject* _o1,
   return cdata->done;
 }
 
+//==============================================================================
+// Collision callback of the boolean queries. Only the existence of a collision
+// is of interest, so the iteration stops at the first colliding pair.
+bool checkCollisionCallBack(fcl::CollisionObject* _o1,
+                            fcl::CollisionObject* _o2,
+                            void* _cdata)
+{
+  CollisionData* cdata = static_cast<CollisionData*>(_cdata);
+  FCLCollisionDetector* cd = cdata->collisionDetector;
+
+  if (cdata->done)
+    return true;
+
+  // Filtering
+  FCLCollisionNode* collNode1 = cd->findCollisionNode(_o1);
+  FCLCollisionNode* collNode2 = cd->findCollisionNode(_o2);
+  if (collNode1 == collNode2 || !cd->isCollidable(collNode1, collNode2))
+    return false;
+
+  // Perform narrow-phase detection
+  fcl::collide(_o1, _o2, cdata->request, cdata->result);
+
+  cdata->done = cdata->result.isCollision();
+
+  return cdata->done;
+}
+
 //==============================================================================
 FCLCollisionDetector::FCLCollisionDetector()
   : CollisionDetector(),
@@ -219,6 +248,40 @@ bool FCLCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
   return !mContacts.empty();
 }
 
+//==============================================================================
+bool FCLCollisionDetector::checkCollision(
+    const std::vector<dynamics::BodyNode*>& _bodyNodes)
+{
+  setQueryNodes(_bodyNodes);
+  if (mQueryNodes.empty())
+    return false;
+
+  // Update all the transformations of the collision nodes
+  for (auto& collNode : mCollisionNodes)
+    static_cast<FCLCollisionNode*>(collNode)->updateFCLCollisionObjects();
+  mBroadPhaseAlg->update();
+
+  CollisionData collData;
+  collData.request.enable_contact = false;
+  collData.request.num_max_contacts = 1;
+  collData.collisionDetector = this;
+
+  // Query the broad-phase only with the objects of the given BodyNodes
+  for (auto& collNode : mQueryNodes)
+  {
+    FCLCollisionNode* fclCollNode = static_cast<FCLCollisionNode*>(collNode);
+    for (size_t i = 0; i < fclCollNode->getNumCollisionObjects(); ++i)
+    {
+      mBroadPhaseAlg->collide(fclCollNode->getCollisionObject(i), &collData,
+                              checkCollisionCallBack);
+      if (collData.done)
+        return true;
+    }
+  }
+
+  return false;
+}
+
 //==============================================================================
 bool FCLCollisionDetector::detectCollision(CollisionNode* _node1,
                                            CollisionNode* _node2,
@@ -229,6 +292,98 @@ bool FCLCollisionDetector::detectCollision(CollisionNode* _node1,
   return false;
 }
 
+//==============================================================================
+bool FCLCollisionDetector::computeDistance(CollisionNode* _node1,
+                                           CollisionNode* _node2,
+                                           DistanceResult& _result,
+                                           double _upperBound)
+{
+  FCLCollisionNode* collNode1 = static_cast<FCLCollisionNode*>(_node1);
+  FCLCollisionNode* collNode2 = static_cast<FCLCollisionNode*>(_node2);
+  collNode1->updateFCLCollisionObjects();
+  collNode2->updateFCLCollisionObjects();
+
+  bool found = false;
+  for (size_t i = 0; i < collNode1->getNumCollisionObjects(); ++i)
+  {
+    fcl::CollisionObject* o1 = collNode1->getCollisionObject(i);
+
+    for (size_t j = 0; j < collNode2->getNumCollisionObjects(); ++j)
+    {
+      fcl::CollisionObject* o2 = collNode2->getCollisionObject(j);
+
+      // The distance between the bounding boxes is a lower bound
+      if (o1->getAABB().distance(o2->getAABB()) >= _upperBound)
+        continue;
+
+      fcl::DistanceRequest request(true);
+      fcl::DistanceResult result;
+      fcl::distance(o1, o2, request, result);
+
+      double distance = result.min_distance;
+      Eigen::Vector3d point1 = FCLTypes::convertVector3(
+            result.nearest_points[0]);
+      Eigen::Vector3d point2 = FCLTypes::convertVector3(
+            result.nearest_points[1]);
+
+      if (distance <= 0.0)
+      {
+        // FCL does not compute the penetration depth in distance queries, so
+        // take the deepest contact of a collision query instead
+        fcl::CollisionRequest collRequest;
+        collRequest.enable_contact = true;
+        collRequest.num_max_contacts = getNumMaxContacts();
+        fcl::CollisionResult collResult;
+        fcl::collide(o1, o2, collRequest, collResult);
+
+        distance = 0.0;
+        for (size_t m = 0; m < collResult.numContacts(); ++m)
+        {
+          const fcl::Contact& contact = collResult.getContact(m);
+          if (-contact.penetration_depth >= distance)
+            continue;
+
+          // The normal points from o1 to o2
+          const Eigen::Vector3d point = FCLTypes::convertVector3(contact.pos);
+          const Eigen::Vector3d normal
+              = FCLTypes::convertVector3(contact.normal);
+          distance = -contact.penetration_depth;
+          point1 = point - 0.5 * distance * normal;
+          point2 = point + 0.5 * distance * normal;
+        }
+      }
+
+      if (distance >= _upperBound)
+        continue;
+
+      _upperBound = distance;
+      found = true;
+
+      FCLUserData* userData1 = static_cast<FCLUserData*>(o1->getUserData());
+      FCLUserData* userData2 = static_cast<FCLUserData*>(o2->getUserData());
+      _result.distance = distance;
+      _result.point1 = point1;
+      _result.point2 = point2;
+      _result.bodyNode1 = userData1->bodyNode;
+      _result.bodyNode2 = userData2->bodyNode;
+      _result.shape1 = nullptr;
+      _result.shape2 = nullptr;
+      for (size_t k = 0; k < userData1->bodyNode->getNumCollisionShapes(); ++k)
+      {
+        if (userData1->bodyNode->getCollisionShape(k).get() == userData1->shape)
+          _result.shape1 = userData1->bodyNode->getCollisionShape(k);
+      }
+      for (size_t k = 0; k < userData2->bodyNode->getNumCollisionShapes(); ++k)
+      {
+        if (userData2->bodyNode->getCollisionShape(k).get() == userData2->shape)
+          _result.shape2 = userData2->bodyNode->getCollisionShape(k);
+      }
+    }
+  }
+
+  return found;
+}
+
 //==============================================================================
 CollisionNode* FCLCollisionDetector::findCollisionNode(
     const fcl::CollisionGeometry* _fclCollGeom) const
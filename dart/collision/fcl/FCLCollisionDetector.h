@@ -63,6 +63,14 @@ public:
   virtual bool detectCollision(bool _checkAllCollisions,
                                bool _calculateContactPoints) override;
 
+  using CollisionDetector::checkCollision;
+
+  using CollisionDetector::computeDistance;
+
+  // Documentation inherited
+  virtual bool checkCollision(
+      const std::vector<dynamics::BodyNode*>& _bodyNodes) override;
+
   // Documentation inherited
   virtual CollisionNode* createCollisionNode(dynamics::BodyNode* _bodyNode)
   override;
@@ -80,6 +88,11 @@ protected:
   virtual bool detectCollision(CollisionNode* _node1, CollisionNode* _node2,
                                bool _calculateContactPoints) override;
 
+  // Documentation inherited
+  virtual bool computeDistance(CollisionNode* _node1, CollisionNode* _node2,
+                               DistanceResult& _result,
+                               double _upperBound) override;
+
   /// Broad-phase collision checker of FCL
   fcl::DynamicAABBTreeCollisionManager* mBroadPhaseAlg;
 };
@@ -47,6 +47,7 @@
 #include "dart/dynamics/PlaneShape.h"
 #include "dart/dynamics/Shape.h"
 #include "dart/dynamics/MeshShape.h"
+#include "dart/dynamics/SoftBodyNode.h"
 #include "dart/dynamics/SoftMeshShape.h"
 #include "dart/collision/fcl/FCLTypes.h"
 
@@ -298,26 +299,29 @@ fcl::BVHModel<BV>* createMesh(float _scaleX, float _scaleY, float _scaleZ,
 
 //==============================================================================
 template<class BV>
-fcl::BVHModel<BV>* createSoftMesh(const aiMesh* _mesh,
+fcl::BVHModel<BV>* createSoftMesh(const dynamics::SoftMeshShape* _shape,
                                   const fcl::Transform3f& _transform)
 {
-  // Create FCL mesh from Assimp mesh
+  // Create FCL mesh from the vertex buffer of the soft body
+
+  assert(_shape);
+  const std::vector<Eigen::Vector3d>& vertices = _shape->getVertices();
+  const dynamics::SoftBodyNode* softBodyNode = _shape->getSoftBodyNode();
 
-  assert(_mesh);
   fcl::BVHModel<BV>* model = new fcl::BVHModel<BV>;
   model->beginModel();
 
-  for (size_t i = 0; i < _mesh->mNumFaces; i++)
+  for (size_t i = 0; i < softBodyNode->getNumFaces(); i++)
   {
-    fcl::Vec3f vertices[3];
+    const Eigen::Vector3i& face = softBodyNode->getFace(i);
+    fcl::Vec3f triangle[3];
     for (size_t j = 0; j < 3; j++)
     {
-      const aiVector3D& vertex
-          = _mesh->mVertices[_mesh->mFaces[i].mIndices[j]];
-      vertices[j] = fcl::Vec3f(vertex.x, vertex.y, vertex.z);
-      vertices[j] = _transform.transform(vertices[j]);
+      const Eigen::Vector3d& vertex = vertices[face[j]];
+      triangle[j] = _transform.transform(
+            fcl::Vec3f(vertex[0], vertex[1], vertex[2]));
     }
-    model->addTriangle(vertices[0], vertices[1], vertices[2]);
+    model->addTriangle(triangle[0], triangle[1], triangle[2]);
   }
 
   model->endModel();
@@ -330,7 +334,8 @@ FCLUserData::FCLUserData(FCLCollisionNode* _fclCollNode,
                          dynamics::Shape* _shape)
   : fclCollNode(_fclCollNode),
     bodyNode(_bodyNode),
-    shape(_shape)
+    shape(_shape),
+    vertexVersion(0)
 {
   // Do nothing
 }
@@ -430,7 +435,7 @@ FCLCollisionNode::FCLCollisionNode(dynamics::BodyNode* _bodyNode)
         SoftMeshShape* softMeshShape = static_cast<SoftMeshShape*>(shape.get());
         fclCollGeom.reset(
             createSoftMesh<fcl::OBBRSS>(
-                softMeshShape->getAssimpMesh(),
+                softMeshShape,
                 FCLTypes::convertTransform(Eigen::Isometry3d::Identity())));
 
         break;
@@ -513,14 +518,20 @@ void FCLCollisionNode::updateFCLCollisionObjects()
     fclCollObj->setTransform(FCLTypes::convertTransform(W));
     fclCollObj->computeAABB();
 
-    // Update soft-body's vertices
+    // Update soft-body's vertices, unless they have not moved
     if (shape->getShapeType() == Shape::SOFT_MESH)
     {
       assert(dynamic_cast<SoftMeshShape*>(shape));
       SoftMeshShape* softMeshShape = static_cast<SoftMeshShape*>(shape);
 
-      const aiMesh* mesh = softMeshShape->getAssimpMesh();
-      softMeshShape->update();
+      if (userData->vertexVersion == softMeshShape->getVertexVersion())
+        continue;
+      userData->vertexVersion = softMeshShape->getVertexVersion();
+
+      const std::vector<Eigen::Vector3d>& vertices
+          = softMeshShape->getVertices();
+      const dynamics::SoftBodyNode* softBodyNode
+          = softMeshShape->getSoftBodyNode();
 #if FCL_VERSION_AT_LEAST(0,3,0)
       fcl::CollisionGeometry* collGeom
           = const_cast<fcl::CollisionGeometry*>(
@@ -535,18 +546,19 @@ void FCLCollisionNode::updateFCLCollisionObjects()
           = static_cast<fcl::BVHModel<fcl::OBBRSS>*>(collGeom);
 
       bvhModel->beginUpdateModel();
-      for (size_t j = 0; j < mesh->mNumFaces; j++)
+      for (size_t j = 0; j < softBodyNode->getNumFaces(); j++)
       {
-        fcl::Vec3f vertices[3];
+        const Eigen::Vector3i& face = softBodyNode->getFace(j);
+        fcl::Vec3f triangle[3];
         for (size_t k = 0; k < 3; k++)
         {
-          const aiVector3D& vertex
-              = mesh->mVertices[mesh->mFaces[j].mIndices[k]];
-          vertices[k] = fcl::Vec3f(vertex.x, vertex.y, vertex.z);
+          const Eigen::Vector3d& vertex = vertices[face[k]];
+          triangle[k] = fcl::Vec3f(vertex[0], vertex[1], vertex[2]);
         }
-        bvhModel->updateTriangle(vertices[0], vertices[1], vertices[2]);
+        bvhModel->updateTriangle(triangle[0], triangle[1], triangle[2]);
       }
       bvhModel->endUpdateModel();
+      fclCollObj->computeAABB();
     }
   }
 }
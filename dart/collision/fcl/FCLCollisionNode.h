@@ -65,6 +65,9 @@ struct FCLUserData
   dynamics::BodyNode* bodyNode;
   dynamics::Shape* shape;
 
+  /// Vertex version of a soft mesh shape when its BVH was last updated
+  size_t vertexVersion;
+
   FCLUserData(FCLCollisionNode* _fclCollNode,
               dynamics::BodyNode* _bodyNode,
               dynamics::Shape* _shape);
@@ -140,6 +140,18 @@ bool FCLMeshCollisionDetector::detectCollision(CollisionNode* _node1,
         mNumMaxContacts);
 }
 
+//==============================================================================
+bool FCLMeshCollisionDetector::checkCollision(
+    const std::vector<dynamics::BodyNode*>& _bodyNodes)
+{
+  // The meshes of all the nodes need to be up to date because the queried
+  // nodes are tested against every other node
+  for (size_t i = 0; i < mCollisionNodes.size(); i++)
+    static_cast<FCLMeshCollisionNode*>(mCollisionNodes[i])->updateShape();
+
+  return CollisionDetector::checkCollision(_bodyNodes);
+}
+
 //==============================================================================
 void FCLMeshCollisionDetector::draw()
 {
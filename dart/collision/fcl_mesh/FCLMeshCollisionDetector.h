@@ -70,6 +70,12 @@ public:
   virtual bool detectCollision(CollisionNode* _node1, CollisionNode* _node2,
                                bool _calculateContactPoints);
 
+  using CollisionDetector::checkCollision;
+
+  // Documentation inherited
+  virtual bool checkCollision(
+      const std::vector<dynamics::BodyNode*>& _bodyNodes);
+
   ///
   void draw();
 };
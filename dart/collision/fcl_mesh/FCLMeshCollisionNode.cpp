@@ -50,6 +50,7 @@
 #include "dart/dynamics/MeshShape.h"
 #include "dart/dynamics/EllipsoidShape.h"
 #include "dart/dynamics/CylinderShape.h"
+#include "dart/dynamics/SoftBodyNode.h"
 #include "dart/dynamics/SoftMeshShape.h"
 #include "dart/renderer/LoadOpengl.h"
 #include "dart/collision/fcl_mesh/CollisionShapes.h"
@@ -126,8 +127,8 @@ FCLMeshCollisionNode::FCLMeshCollisionNode(dynamics::BodyNode* _bodyNode)
       case dynamics::Shape::SOFT_MESH:
       {
         SoftMeshShape* softMeshShape = static_cast<SoftMeshShape*>(shape.get());
-        mMeshes.push_back(createSoftMesh<fcl::OBBRSS>(
-                            softMeshShape->getAssimpMesh(), shapeT));
+        mMeshes.push_back(createSoftMesh<fcl::OBBRSS>(softMeshShape, shapeT));
+        mSoftMeshVersions[softMeshShape] = softMeshShape->getVertexVersion();
         break;
       }
       default:
@@ -316,22 +317,31 @@ void FCLMeshCollisionNode::updateShape()
       case dynamics::Shape::SOFT_MESH:
       {
         SoftMeshShape* softMeshShape = static_cast<SoftMeshShape*>(shape.get());
-        const aiMesh* mesh = softMeshShape->getAssimpMesh();
-        softMeshShape->update();
+
+        // The BVH only needs to be refit if the vertices have moved
+        size_t& version = mSoftMeshVersions[softMeshShape];
+        if (version == softMeshShape->getVertexVersion())
+          break;
+        version = softMeshShape->getVertexVersion();
+
+        const std::vector<Eigen::Vector3d>& vertices
+            = softMeshShape->getVertices();
+        const dynamics::SoftBodyNode* softBodyNode
+            = softMeshShape->getSoftBodyNode();
 
         mMeshes[i]->beginUpdateModel();
 
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++)
+        for (size_t j = 0; j < softBodyNode->getNumFaces(); j++)
         {
-          fcl::Vec3f vertices[3];
-          for (unsigned int k = 0; k < 3; k++)
+          const Eigen::Vector3i& face = softBodyNode->getFace(j);
+          fcl::Vec3f triangle[3];
+          for (size_t k = 0; k < 3; k++)
           {
-            const aiVector3D& vertex
-                = mesh->mVertices[mesh->mFaces[j].mIndices[k]];
-            vertices[k] = fcl::Vec3f(vertex.x, vertex.y, vertex.z);
-            vertices[k] = shapeT.transform(vertices[k]);
+            const Eigen::Vector3d& vertex = vertices[face[k]];
+            triangle[k] = shapeT.transform(
+                  fcl::Vec3f(vertex[0], vertex[1], vertex[2]));
           }
-          mMeshes[i]->updateTriangle(vertices[0], vertices[1], vertices[2]);
+          mMeshes[i]->updateTriangle(triangle[0], triangle[1], triangle[2]);
         }
 
         mMeshes[i]->endUpdateModel();
@@ -454,24 +464,27 @@ void FCLMeshCollisionNode::drawCollisionSkeletonNode(bool _bTrans)
 
 //==============================================================================
 template<class BV>
-fcl::BVHModel<BV>* createSoftMesh(const aiMesh* _mesh,
+fcl::BVHModel<BV>* createSoftMesh(const dynamics::SoftMeshShape* _shape,
                                   const fcl::Transform3f& _transform)
 {
-  assert(_mesh);
+  assert(_shape);
+  const std::vector<Eigen::Vector3d>& vertices = _shape->getVertices();
+  const dynamics::SoftBodyNode* softBodyNode = _shape->getSoftBodyNode();
+
   fcl::BVHModel<BV>* model = new fcl::BVHModel<BV>;
   model->beginModel();
 
-  for (unsigned int i = 0; i < _mesh->mNumFaces; i++)
+  for (size_t i = 0; i < softBodyNode->getNumFaces(); i++)
   {
-    fcl::Vec3f vertices[3];
-    for (unsigned int j = 0; j < 3; j++)
+    const Eigen::Vector3i& face = softBodyNode->getFace(i);
+    fcl::Vec3f triangle[3];
+    for (size_t j = 0; j < 3; j++)
     {
-      const aiVector3D& vertex
-          = _mesh->mVertices[_mesh->mFaces[i].mIndices[j]];
-      vertices[j] = fcl::Vec3f(vertex.x, vertex.y, vertex.z);
-      vertices[j] = _transform.transform(vertices[j]);
+      const Eigen::Vector3d& vertex = vertices[face[j]];
+      triangle[j] = _transform.transform(
+            fcl::Vec3f(vertex[0], vertex[1], vertex[2]));
     }
-    model->addTriangle(vertices[0], vertices[1], vertices[2]);
+    model->addTriangle(triangle[0], triangle[1], triangle[2]);
   }
 
   model->endModel();
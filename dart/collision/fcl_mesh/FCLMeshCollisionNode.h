@@ -38,6 +38,7 @@
 #ifndef DART_COLLISION_FCLMESH_FCLMESHCOLLISIONNODE_H_
 #define DART_COLLISION_FCLMESH_FCLMESHCOLLISIONNODE_H_
 
+#include <unordered_map>
 #include <vector>
 
 #include <assimp/mesh.h>
@@ -52,6 +53,7 @@
 namespace dart {
 namespace dynamics {
 class BodyNode;
+class SoftMeshShape;
 }  // namespace dynamics
 }  // namespace dart
 
@@ -119,11 +121,15 @@ private:
 
   ///
   static double triArea(fcl::Vec3f p1, fcl::Vec3f p2, fcl::Vec3f p3);
+
+  /// Vertex version of each soft mesh when its BVH was last updated
+  std::unordered_map<const dynamics::SoftMeshShape*, size_t>
+      mSoftMeshVersions;
 };
 
 ///
 template<class BV>
-fcl::BVHModel<BV>* createSoftMesh(const aiMesh* _mesh,
+fcl::BVHModel<BV>* createSoftMesh(const dynamics::SoftMeshShape* _shape,
                                   const fcl::Transform3f& _transform);
 
 //==============================================================================
@@ -34,9 +34,16 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <iostream>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "dart/common/Console.h"
 #include "LocalResource.h"
 
@@ -45,19 +52,34 @@ namespace common {
 
 //==============================================================================
 LocalResource::LocalResource(const std::string& _path)
-  : mFile(std::fopen(_path.c_str(), "rb"))
+  : mFile(std::fopen(_path.c_str(), "rb")),
+    mData(nullptr),
+    mSize(0u),
+    mOffset(0u)
 {
   if(!mFile)
   {
     dtwarn << "[LocalResource::constructor] Failed opening file '"
            << _path << "' for reading: "
            << std::strerror(errno) << "\n";
+    return;
+  }
+
+  if(map())
+  {
+    std::fclose(mFile);
+    mFile = nullptr;
   }
 }
 
 //==============================================================================
 LocalResource::~LocalResource()
 {
+#ifndef _WIN32
+  if (mData)
+    munmap(const_cast<char*>(mData), mSize);
+#endif
+
   if (!mFile)
     return;
 
@@ -71,12 +93,15 @@ LocalResource::~LocalResource()
 //==============================================================================
 bool LocalResource::isGood() const
 {
-  return !!mFile;
+  return mFile || mData;
 }
 
 //==============================================================================
 size_t LocalResource::getSize()
 {
+  if(mData)
+    return mSize;
+
   if(!mFile)
     return 0;
 
@@ -133,6 +158,9 @@ size_t LocalResource::getSize()
 //==============================================================================
 size_t LocalResource::tell()
 {
+  if(mData)
+    return mOffset;
+
   if(!mFile)
     return 0;
   
@@ -161,6 +189,40 @@ size_t LocalResource::tell()
 //==============================================================================
 bool LocalResource::seek(ptrdiff_t _offset, SeekType _mode)
 {
+  if(mData)
+  {
+    ptrdiff_t position;
+    switch(_mode)
+    {
+    case Resource::SEEKTYPE_CUR:
+      position = static_cast<ptrdiff_t>(mOffset) + _offset;
+      break;
+
+    case Resource::SEEKTYPE_END:
+      position = static_cast<ptrdiff_t>(mSize) + _offset;
+      break;
+
+    case Resource::SEEKTYPE_SET:
+      position = _offset;
+      break;
+
+    default:
+      dtwarn << "[LocalResource::seek] Invalid origin. Expected"
+                " SEEKTYPE_CUR, SEEKTYPE_END, or SEEKTYPE_SET.\n";
+      return false;
+    }
+
+    if(position < 0 || position > static_cast<ptrdiff_t>(mSize))
+    {
+      dtwarn << "[LocalResource::seek] Failed seeking: The position is"
+                " outside of the file.\n";
+      return false;
+    }
+
+    mOffset = static_cast<size_t>(position);
+    return true;
+  }
+
   int origin;
   switch(_mode)
   {
@@ -195,6 +257,18 @@ bool LocalResource::seek(ptrdiff_t _offset, SeekType _mode)
 //==============================================================================
 size_t LocalResource::read(void *_buffer, size_t _size, size_t _count)
 {
+  if (mData)
+  {
+    if (_size == 0)
+      return 0;
+
+    // Only read full blocks, like fread does
+    const size_t count = std::min(_count, (mSize - mOffset) / _size);
+    std::memcpy(_buffer, mData + mOffset, count * _size);
+    mOffset += count * _size;
+    return count;
+  }
+
   if (!mFile)
     return 0;
 
@@ -207,5 +281,33 @@ size_t LocalResource::read(void *_buffer, size_t _size, size_t _count)
   return result;
 }
 
+//==============================================================================
+const char* LocalResource::getData()
+{
+  return mData;
+}
+
+//==============================================================================
+bool LocalResource::map()
+{
+#ifdef _WIN32
+  return false;
+#else
+  struct stat status;
+  if(fstat(fileno(mFile), &status) != 0 || !S_ISREG(status.st_mode)
+     || status.st_size <= 0)
+    return false;
+
+  void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE,
+                    fileno(mFile), 0);
+  if(data == MAP_FAILED)
+    return false;
+
+  mData = static_cast<const char*>(data);
+  mSize = status.st_size;
+  return true;
+#endif
+}
+
 } // namespace common
 } // namespace dart
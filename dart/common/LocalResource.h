@@ -37,11 +37,19 @@
 #ifndef DART_COMMON_LOCALRESOURCE_H_
 #define DART_COMMON_LOCALRESOURCE_H_
 
+#include <cstdio>
+#include <string>
+
 #include "dart/common/Resource.h"
 
 namespace dart {
 namespace common {
 
+/// LocalResource provides access to a file on the local filesystem. Where the
+/// platform supports it, regular files are mapped into memory, so getData()
+/// gives direct access to their content and reading does not go through the
+/// C standard library. Other files are read with the standard C file
+/// manipulation functions.
 class LocalResource : public virtual Resource
 {
 public:
@@ -66,8 +74,26 @@ public:
   // Documentation inherited.
   size_t read(void* _buffer, size_t _size, size_t _count) override;
 
+  // Documentation inherited. Returns nullptr if the file is not mapped into
+  // memory.
+  const char* getData() override;
+
 private:
+  /// Map the open file into memory. Returns false if that is not possible, in
+  /// which case mFile is used instead.
+  bool map();
+
+  /// The open file, unless it has been mapped into memory
   std::FILE* mFile;
+
+  /// Content of the file if it has been mapped into memory
+  const char* mData;
+
+  /// Size of the mapped file
+  size_t mSize;
+
+  /// Position indicator of the mapped file
+  size_t mOffset;
 };
 
 } // namespace common
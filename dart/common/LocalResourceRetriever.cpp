@@ -44,6 +44,14 @@
 namespace dart {
 namespace common {
 
+//==============================================================================
+std::shared_ptr<LocalResourceRetriever> LocalResourceRetriever::getDefault()
+{
+  static const std::shared_ptr<LocalResourceRetriever> retriever
+      = std::make_shared<LocalResourceRetriever>();
+  return retriever;
+}
+
 //==============================================================================
 bool LocalResourceRetriever::exists(const Uri& _uri)
 {
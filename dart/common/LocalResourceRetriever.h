@@ -49,6 +49,11 @@ class LocalResourceRetriever : public virtual ResourceRetriever
 public:
   virtual ~LocalResourceRetriever() = default;
 
+  /// Get the LocalResourceRetriever that the parsers and loaders use when they
+  /// are not given a retriever. Resources that are cached per retriever, such
+  /// as the meshes of the MeshCache, are then shared between all of them.
+  static std::shared_ptr<LocalResourceRetriever> getDefault();
+
   // Documentation inherited.
   bool exists(const Uri& _uri) override;
 
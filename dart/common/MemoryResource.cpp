@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/MemoryResource.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "dart/common/Console.h"
+
+namespace dart {
+namespace common {
+
+//==============================================================================
+MemoryResource::MemoryResource(
+    const std::shared_ptr<const std::string>& _content)
+  : mContent(_content ? _content : std::make_shared<const std::string>()),
+    mOffset(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+size_t MemoryResource::getSize()
+{
+  return mContent->size();
+}
+
+//==============================================================================
+size_t MemoryResource::tell()
+{
+  return mOffset;
+}
+
+//==============================================================================
+bool MemoryResource::seek(ptrdiff_t _offset, SeekType _origin)
+{
+  ptrdiff_t position;
+  switch(_origin)
+  {
+  case Resource::SEEKTYPE_CUR:
+    position = static_cast<ptrdiff_t>(mOffset) + _offset;
+    break;
+
+  case Resource::SEEKTYPE_END:
+    position = static_cast<ptrdiff_t>(mContent->size()) + _offset;
+    break;
+
+  case Resource::SEEKTYPE_SET:
+    position = _offset;
+    break;
+
+  default:
+    dtwarn << "[MemoryResource::seek] Invalid origin. Expected"
+              " SEEKTYPE_CUR, SEEKTYPE_END, or SEEKTYPE_SET.\n";
+    return false;
+  }
+
+  if(position < 0 || position > static_cast<ptrdiff_t>(mContent->size()))
+  {
+    dtwarn << "[MemoryResource::seek] Failed seeking: The position is outside"
+              " of the resource.\n";
+    return false;
+  }
+
+  mOffset = static_cast<size_t>(position);
+  return true;
+}
+
+//==============================================================================
+size_t MemoryResource::read(void* _buffer, size_t _size, size_t _count)
+{
+  if(_size == 0)
+    return 0;
+
+  // Only read full blocks, like fread does
+  const size_t count = std::min(_count, (mContent->size() - mOffset) / _size);
+  std::memcpy(_buffer, mContent->data() + mOffset, count * _size);
+  mOffset += count * _size;
+  return count;
+}
+
+//==============================================================================
+const char* MemoryResource::getData()
+{
+  return mContent->data();
+}
+
+} // namespace common
+} // namespace dart
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_MEMORYRESOURCE_H_
+#define DART_COMMON_MEMORYRESOURCE_H_
+
+#include <memory>
+#include <string>
+
+#include "dart/common/Resource.h"
+
+namespace dart {
+namespace common {
+
+/// MemoryResource provides access to content that is held in memory. The
+/// content is shared rather than copied, so any number of resources can be
+/// created for the same content, e.g. by a cache.
+class MemoryResource : public virtual Resource
+{
+public:
+  /// Constructor
+  explicit MemoryResource(const std::shared_ptr<const std::string>& _content);
+
+  virtual ~MemoryResource() = default;
+
+  // Documentation inherited.
+  size_t getSize() override;
+
+  // Documentation inherited.
+  size_t tell() override;
+
+  // Documentation inherited.
+  bool seek(ptrdiff_t _offset, SeekType _origin) override;
+
+  // Documentation inherited.
+  size_t read(void* _buffer, size_t _size, size_t _count) override;
+
+  // Documentation inherited.
+  const char* getData() override;
+
+private:
+  /// The shared content
+  std::shared_ptr<const std::string> mContent;
+
+  /// Position indicator
+  size_t mOffset;
+};
+
+} // namespace common
+} // namespace dart
+
+#endif // ifndef DART_COMMON_MEMORYRESOURCE_H_
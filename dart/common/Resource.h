@@ -80,6 +80,12 @@ public:
   /// \param[in] _count Number of elements, each of _size bytes.
   /// \note This method has the same API as the standard fread function.
   virtual size_t read(void *_buffer, size_t _size, size_t _count) = 0; 
+
+  /// \brief Return a pointer to the whole content of the resource, or nullptr
+  /// if the resource cannot provide direct access to its content. The pointer
+  /// remains valid for the lifetime of the resource and does not depend on the
+  /// position indicator. The default implementation returns nullptr.
+  virtual const char* getData() { return nullptr; }
 };
 
 using ResourcePtr = std::shared_ptr<Resource>;
@@ -39,7 +39,7 @@
 
 #include <functional>
 #include <memory>
-#include <set>
+#include <vector>
 
 #include "dart/common/Deprecated.h"
 #include "dart/common/detail/ConnectionBody.h"
@@ -120,9 +120,8 @@ public:
   using SignalType    = Signal<_Res(_ArgTypes...), Combiner>;
 
   using ConnectionBodyType = signal::detail::ConnectionBody<SlotType>;
-  using ConnectionSetType
-    = std::set<std::shared_ptr<ConnectionBodyType>,
-               std::owner_less<std::shared_ptr<ConnectionBodyType>>>;
+  using ConnectionBodyContainerType
+    = std::vector<std::shared_ptr<ConnectionBodyType>>;
 
   /// Constructor
   Signal();
@@ -146,12 +145,18 @@ public:
   /// \warning Deprecated. Please use cleanupConnections() instead.
   DEPRECATED(5.1) void clenaupConnections();
 
-  /// Cleanup all the disconnected connections
+  /// Cleanup all the disconnected connections. While the signal is being
+  /// raised, the cleanup is deferred until the outermost raise() returns.
   void cleanupConnections();
 
   /// Get the number of connections
   size_t getNumConnections() const;
 
+  /// Return true if no slot has been connected to this signal since it was
+  /// last cleaned up. This is cheap enough to be checked before preparing any
+  /// expensive arguments for raise().
+  bool isEmpty() const;
+
   /// Raise the signal
   template <typename... ArgTypes>
   ResultType raise(ArgTypes&&... _args);
@@ -161,8 +166,20 @@ public:
   ResultType operator()(ArgTypes&&... _args);
 
 private:
-  /// Connection set
-  ConnectionSetType mConnectionBodies;
+  /// Called when a raise() returns or throws. Runs the deferred cleanup once
+  /// the outermost raise() is done.
+  void finishRaise();
+
+  /// Connection bodies in the order that they were connected. A contiguous
+  /// container keeps raise() cheap, especially when it is empty.
+  ConnectionBodyContainerType mConnectionBodies;
+
+  /// Number of raise() calls that are currently iterating over the
+  /// connection bodies. Slots may raise the signal again.
+  size_t mRaiseDepth;
+
+  /// True if disconnected bodies were found while the signal was being raised
+  bool mNeedsCleanup;
 };
 
 /// Signal implements a signal/slot mechanism for the slots don't return a value
@@ -174,9 +191,8 @@ public:
   using SignalType = Signal<void(_ArgTypes...)>;
 
   using ConnectionBodyType = signal::detail::ConnectionBody<SlotType>;
-  using ConnectionSetType
-    = std::set<std::shared_ptr<ConnectionBodyType>,
-               std::owner_less<std::shared_ptr<ConnectionBodyType>>>;
+  using ConnectionBodyContainerType
+    = std::vector<std::shared_ptr<ConnectionBodyType>>;
 
   /// Constructor
   Signal();
@@ -200,12 +216,18 @@ public:
   /// \warning Deprecated. Please use cleanupConnections() instead.
   DEPRECATED(5.1) void clenaupConnections();
 
-  /// Cleanup all the disconnected connections
+  /// Cleanup all the disconnected connections. While the signal is being
+  /// raised, the cleanup is deferred until the outermost raise() returns.
   void cleanupConnections();
 
   /// Get the number of connections
   size_t getNumConnections() const;
 
+  /// Return true if no slot has been connected to this signal since it was
+  /// last cleaned up. This is cheap enough to be checked before preparing any
+  /// expensive arguments for raise().
+  bool isEmpty() const;
+
   /// Raise the signal
   template <typename... ArgTypes>
   void raise(ArgTypes&&... _args);
@@ -215,8 +237,20 @@ public:
   void operator()(ArgTypes&&... _args);
 
 private:
-  /// Connection set
-  ConnectionSetType mConnectionBodies;
+  /// Called when a raise() returns or throws. Runs the deferred cleanup once
+  /// the outermost raise() is done.
+  void finishRaise();
+
+  /// Connection bodies in the order that they were connected. A contiguous
+  /// container keeps raise() cheap, especially when it is empty.
+  ConnectionBodyContainerType mConnectionBodies;
+
+  /// Number of raise() calls that are currently iterating over the
+  /// connection bodies. Slots may raise the signal again.
+  size_t mRaiseDepth;
+
+  /// True if disconnected bodies were found while the signal was being raised
+  bool mNeedsCleanup;
 };
 
 /// SlotRegister can be used as a public member for connecting slots to a
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/ThreadPool.h"
+
+namespace dart {
+namespace common {
+
+//==============================================================================
+ThreadPool::ThreadPool(size_t _numThreads)
+  : mNumActiveTasks(0),
+    mStopping(false)
+{
+  if(0 == _numThreads)
+    _numThreads = std::thread::hardware_concurrency();
+
+  // hardware_concurrency() is allowed to return 0 if it cannot tell
+  if(0 == _numThreads)
+    _numThreads = 1;
+
+  mThreads.reserve(_numThreads);
+  for(size_t i=0; i < _numThreads; ++i)
+    mThreads.emplace_back(&ThreadPool::run, this);
+}
+
+//==============================================================================
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mTaskAvailable.notify_all();
+
+  for(std::thread& thread : mThreads)
+    thread.join();
+}
+
+//==============================================================================
+size_t ThreadPool::getNumThreads() const
+{
+  return mThreads.size();
+}
+
+//==============================================================================
+void ThreadPool::wait()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mAllTasksDone.wait(lock, [=]()
+  {
+    return mTasks.empty() && 0 == mNumActiveTasks;
+  });
+}
+
+//==============================================================================
+void ThreadPool::enqueue(std::function<void()>&& _task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTasks.push_back(std::move(_task));
+  }
+  mTaskAvailable.notify_one();
+}
+
+//==============================================================================
+void ThreadPool::run()
+{
+  while(true)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mTaskAvailable.wait(lock, [=]() { return mStopping || !mTasks.empty(); });
+
+      // Queued tasks are drained before the thread is allowed to quit
+      if(mTasks.empty())
+        return;
+
+      task = std::move(mTasks.front());
+      mTasks.pop_front();
+      ++mNumActiveTasks;
+    }
+
+    task();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      --mNumActiveTasks;
+      if(mTasks.empty() && 0 == mNumActiveTasks)
+        mAllTasksDone.notify_all();
+    }
+  }
+}
+
+} // namespace common
+} // namespace dart
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_THREADPOOL_H_
+#define DART_COMMON_THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dart {
+namespace common {
+
+/// ThreadPool runs submitted tasks on a fixed set of worker threads. The
+/// threads are created once, when the pool is constructed, so submitting a
+/// task does not pay the cost of spawning a thread. Tasks are started in the
+/// order that they were submitted.
+class ThreadPool
+{
+public:
+
+  /// Create a pool with _numThreads worker threads. Passing in 0 will use the
+  /// number of hardware threads reported by the system.
+  explicit ThreadPool(size_t _numThreads = 0);
+
+  /// Copying is not allowed
+  ThreadPool(const ThreadPool&) = delete;
+
+  /// Assignment is not allowed
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Destructor. Any tasks that are still queued will be run before the worker
+  /// threads are joined.
+  virtual ~ThreadPool();
+
+  /// Get the number of worker threads in this pool
+  size_t getNumThreads() const;
+
+  /// Queue up a task to be run by one of the worker threads. The returned
+  /// future can be used to wait for the task and to retrieve its result. If the
+  /// task throws an exception, the exception will be rethrown by the future.
+  template <typename Func>
+  std::future<typename std::result_of<Func()>::type> submit(Func&& _task);
+
+  /// Block until every task that has been submitted has finished running
+  void wait();
+
+protected:
+
+  /// Add a task to the queue and wake up a worker thread
+  void enqueue(std::function<void()>&& _task);
+
+  /// Main loop of the worker threads
+  void run();
+
+  /// Worker threads of this pool
+  std::vector<std::thread> mThreads;
+
+  /// Tasks that are waiting for a worker thread
+  std::deque<std::function<void()>> mTasks;
+
+  /// Protects mTasks, mNumActiveTasks, and mStopping
+  std::mutex mMutex;
+
+  /// Notified when a task is added or the pool is stopping
+  std::condition_variable mTaskAvailable;
+
+  /// Notified when a worker finishes a task and nothing else is queued
+  std::condition_variable mAllTasksDone;
+
+  /// Number of tasks that are currently being run by the worker threads
+  size_t mNumActiveTasks;
+
+  /// True when the pool is being destroyed
+  bool mStopping;
+};
+
+} // namespace common
+} // namespace dart
+
+#include "dart/common/detail/ThreadPool.h"
+
+#endif // DART_COMMON_THREADPOOL_H_
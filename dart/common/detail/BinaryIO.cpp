@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/detail/BinaryIO.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace dart {
+namespace common {
+namespace detail {
+
+//==============================================================================
+bool BinaryWriter::saveToFile(const std::string& _path) const
+{
+  std::stringstream tempPath;
+  tempPath << _path << ".tmp";
+#ifndef _WIN32
+  tempPath << "." << getpid();
+#endif
+  tempPath << "." << std::this_thread::get_id();
+
+  {
+    std::ofstream file(tempPath.str(), std::ios::binary | std::ios::trunc);
+    if(!file)
+      return false;
+
+    file.write(mBuffer.data(), mBuffer.size());
+    if(!file)
+    {
+      file.close();
+      std::remove(tempPath.str().c_str());
+      return false;
+    }
+  }
+
+#ifdef _WIN32
+  // std::rename() does not replace existing files on Windows
+  std::remove(_path.c_str());
+#endif
+
+  if(std::rename(tempPath.str().c_str(), _path.c_str()) != 0)
+  {
+    std::remove(tempPath.str().c_str());
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace detail
+} // namespace common
+} // namespace dart
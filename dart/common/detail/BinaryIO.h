@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_DETAIL_BINARYIO_H_
+#define DART_COMMON_DETAIL_BINARYIO_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace dart {
+namespace common {
+namespace detail {
+
+/// BinaryWriter collects plain-old-data values into a buffer in native byte
+/// order. It is used for DART's compiled file formats, which are caches for a
+/// particular machine rather than portable interchange formats.
+class BinaryWriter
+{
+public:
+  /// Append the bytes of _value
+  template <typename T>
+  void write(const T& _value)
+  {
+    write(&_value, sizeof(T));
+  }
+
+  /// Append _size bytes of _data
+  void write(const void* _data, size_t _size)
+  {
+    mBuffer.append(static_cast<const char*>(_data), _size);
+  }
+
+  /// Append the length of _string followed by its characters
+  void writeString(const std::string& _string)
+  {
+    write(static_cast<uint32_t>(_string.size()));
+    write(_string.data(), _string.size());
+  }
+
+  /// Get the bytes that have been written so far
+  const std::string& getBuffer() const
+  {
+    return mBuffer;
+  }
+
+  /// Save the buffer to _path. The buffer is first written to a temporary file
+  /// that is then renamed, so a concurrent reader never sees a partial file.
+  bool saveToFile(const std::string& _path) const;
+
+private:
+  /// The bytes that have been written
+  std::string mBuffer;
+};
+
+/// BinaryReader reads the values that were written by a BinaryWriter from a
+/// block of memory, which it does not own. Every read is bounds-checked, so a
+/// truncated or corrupted file makes the reads fail instead of overrunning the
+/// buffer.
+class BinaryReader
+{
+public:
+  /// Constructor
+  BinaryReader(const char* _data, size_t _size)
+    : mData(_data), mSize(_size), mPosition(0)
+  {
+    // Do nothing
+  }
+
+  /// Read the bytes of _value. Returns false if not enough bytes are left.
+  template <typename T>
+  bool read(T& _value)
+  {
+    return read(&_value, sizeof(T));
+  }
+
+  /// Read _size bytes into _data. Returns false if not enough bytes are left.
+  bool read(void* _data, size_t _size)
+  {
+    if(_size > mSize - mPosition)
+      return false;
+
+    std::memcpy(_data, mData + mPosition, _size);
+    mPosition += _size;
+    return true;
+  }
+
+  /// Read a string that was written by BinaryWriter::writeString()
+  bool readString(std::string& _string)
+  {
+    uint32_t size;
+    if(!read(size) || !canRead(size, 1))
+      return false;
+
+    _string.assign(mData + mPosition, size);
+    mPosition += size;
+    return true;
+  }
+
+  /// Returns whether _count elements of _size bytes can still be read. This
+  /// should be checked before allocating memory for them.
+  bool canRead(size_t _count, size_t _size) const
+  {
+    return _size == 0 || _count <= (mSize - mPosition) / _size;
+  }
+
+  /// Returns whether the whole buffer has been read
+  bool isAtEnd() const
+  {
+    return mPosition == mSize;
+  }
+
+private:
+  /// The memory that is read
+  const char* mData;
+
+  /// Size of the memory in bytes
+  size_t mSize;
+
+  /// Offset of the next byte to read
+  size_t mPosition;
+};
+
+} // namespace detail
+} // namespace common
+} // namespace dart
+
+#endif // DART_COMMON_DETAIL_BINARYIO_H_
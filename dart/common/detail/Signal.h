@@ -37,6 +37,7 @@
 #ifndef DART_COMMON_DETAIL_SIGNAL_H_
 #define DART_COMMON_DETAIL_SIGNAL_H_
 
+#include <algorithm>
 #include <vector>
 
 namespace dart {
@@ -45,6 +46,8 @@ namespace common {
 //==============================================================================
 template <typename _Res, typename... _ArgTypes, template<class> class Combiner>
 Signal<_Res (_ArgTypes...), Combiner>::Signal()
+  : mRaiseDepth(0),
+    mNeedsCleanup(false)
 {
   // Do nothing
 }
@@ -61,7 +64,7 @@ template <typename _Res, typename... _ArgTypes, template<class> class Combiner>
 Connection Signal<_Res (_ArgTypes...), Combiner>::connect(const SlotType& _slot)
 {
   auto newConnectionBody = std::make_shared<ConnectionBodyType>(_slot);
-  mConnectionBodies.insert(newConnectionBody);
+  mConnectionBodies.push_back(newConnectionBody);
 
   return Connection(std::move(newConnectionBody));
 }
@@ -72,7 +75,7 @@ Connection Signal<_Res (_ArgTypes...), Combiner>::connect(SlotType&& _slot)
 {
   auto newConnectionBody
       = std::make_shared<ConnectionBodyType>(std::forward<SlotType>(_slot));
-  mConnectionBodies.insert(newConnectionBody);
+  mConnectionBodies.push_back(newConnectionBody);
 
   return Connection(std::move(newConnectionBody));
 }
@@ -103,12 +106,22 @@ void Signal<_Res (_ArgTypes...), Combiner>::clenaupConnections()
 template <typename _Res, typename... _ArgTypes, template<class> class Combiner>
 void Signal<_Res (_ArgTypes...), Combiner>::cleanupConnections()
 {
-  // Counts all the connected conection bodies
-  for (const auto& connectionBody : mConnectionBodies)
+  // Compacting the container would shift the bodies under the index of a
+  // raise() that is still iterating over them
+  if (mRaiseDepth > 0)
   {
-    if (!connectionBody->isConnected())
-      mConnectionBodies.erase(connectionBody);
+    mNeedsCleanup = true;
+    return;
   }
+
+  mNeedsCleanup = false;
+
+  // Removes all the disconnected connection bodies
+  mConnectionBodies.erase(
+        std::remove_if(mConnectionBodies.begin(), mConnectionBodies.end(),
+                       [](const std::shared_ptr<ConnectionBodyType>& _body)
+                       { return !_body->isConnected(); }),
+        mConnectionBodies.end());
 }
 
 //==============================================================================
@@ -127,28 +140,55 @@ size_t Signal<_Res (_ArgTypes...), Combiner>::getNumConnections() const
   return numConnections;
 }
 
+//==============================================================================
+template <typename _Res, typename... _ArgTypes, template<class> class Combiner>
+bool Signal<_Res (_ArgTypes...), Combiner>::isEmpty() const
+{
+  return mConnectionBodies.empty();
+}
+
 //==============================================================================
 template <typename _Res, typename... _ArgTypes, template<class> class Combiner>
 template <typename... ArgTypes>
 _Res Signal<_Res (_ArgTypes...), Combiner>::raise(ArgTypes&&... _args)
 {
-  std::vector<ResultType> res(mConnectionBodies.size());
-  auto resIt = res.begin();
+  std::vector<ResultType> res;
+  res.reserve(mConnectionBodies.size());
 
-  for (auto itr = mConnectionBodies.begin(); itr != mConnectionBodies.end(); )
+  // Slots may raise this signal again, so the disconnected bodies are only
+  // removed once the outermost raise() is done, even if a slot throws
+  struct RaiseGuard
   {
-    if ((*itr)->isConnected())
-    {
-      *(resIt++) = (*itr)->getSlot()(std::forward<ArgTypes>(_args)...);
-      ++itr;
-    }
+    SignalType* mSignal;
+    ~RaiseGuard() { mSignal->finishRaise(); }
+  };
+  ++mRaiseDepth;
+  RaiseGuard guard{this};
+
+  // Slots are allowed to connect new slots to this signal, which may
+  // reallocate the container, so we index into it and hold onto each
+  // connection body while its slot is being called.
+  for (size_t i = 0; i < mConnectionBodies.size(); ++i)
+  {
+    const std::shared_ptr<ConnectionBodyType> body = mConnectionBodies[i];
+
+    if (body->isConnected())
+      res.push_back(body->getSlot()(std::forward<ArgTypes>(_args)...));
     else
-    {
-      mConnectionBodies.erase(itr++);
-    }
+      mNeedsCleanup = true;
   }
 
-  return Combiner<ResultType>::process(res.begin(), resIt);
+  return Combiner<ResultType>::process(res.begin(), res.end());
+}
+
+//==============================================================================
+template <typename _Res, typename... _ArgTypes, template<class> class Combiner>
+void Signal<_Res (_ArgTypes...), Combiner>::finishRaise()
+{
+  --mRaiseDepth;
+
+  if (mRaiseDepth == 0 && mNeedsCleanup)
+    cleanupConnections();
 }
 
 //==============================================================================
@@ -162,6 +202,8 @@ _Res Signal<_Res (_ArgTypes...), Combiner>::operator()(ArgTypes&&... _args)
 //==============================================================================
 template <typename... _ArgTypes>
 Signal<void (_ArgTypes...)>::Signal()
+  : mRaiseDepth(0),
+    mNeedsCleanup(false)
 {
   // Do nothing
 }
@@ -178,7 +220,7 @@ template <typename... _ArgTypes>
 Connection Signal<void (_ArgTypes...)>::connect(const SlotType& _slot)
 {
   auto newConnectionBody = std::make_shared<ConnectionBodyType>(_slot);
-  mConnectionBodies.insert(newConnectionBody);
+  mConnectionBodies.push_back(newConnectionBody);
 
   return Connection(std::move(newConnectionBody));
 }
@@ -189,7 +231,7 @@ Connection Signal<void (_ArgTypes...)>::connect(SlotType&& _slot)
 {
   auto newConnectionBody
       = std::make_shared<ConnectionBodyType>(std::forward<SlotType>(_slot));
-  mConnectionBodies.insert(newConnectionBody);
+  mConnectionBodies.push_back(newConnectionBody);
 
   return Connection(std::move(newConnectionBody));
 }
@@ -220,12 +262,22 @@ void Signal<void (_ArgTypes...)>::clenaupConnections()
 template <typename... _ArgTypes>
 void Signal<void (_ArgTypes...)>::cleanupConnections()
 {
-  // Counts all the connected conection bodies
-  for (const auto& connectionBody : mConnectionBodies)
+  // Compacting the container would shift the bodies under the index of a
+  // raise() that is still iterating over them
+  if (mRaiseDepth > 0)
   {
-    if (!connectionBody->isConnected())
-      mConnectionBodies.erase(connectionBody);
+    mNeedsCleanup = true;
+    return;
   }
+
+  mNeedsCleanup = false;
+
+  // Removes all the disconnected connection bodies
+  mConnectionBodies.erase(
+        std::remove_if(mConnectionBodies.begin(), mConnectionBodies.end(),
+                       [](const std::shared_ptr<ConnectionBodyType>& _body)
+                       { return !_body->isConnected(); }),
+        mConnectionBodies.end());
 }
 
 //==============================================================================
@@ -244,25 +296,55 @@ size_t Signal<void (_ArgTypes...)>::getNumConnections() const
   return numConnections;
 }
 
+//==============================================================================
+template <typename... _ArgTypes>
+bool Signal<void (_ArgTypes...)>::isEmpty() const
+{
+  return mConnectionBodies.empty();
+}
+
 //==============================================================================
 template <typename... _ArgTypes>
 template <typename... ArgTypes>
 void Signal<void (_ArgTypes...)>::raise(ArgTypes&&... _args)
 {
-  for (auto itr = mConnectionBodies.begin(); itr != mConnectionBodies.end(); )
+  if (mConnectionBodies.empty())
+    return;
+
+  // Slots may raise this signal again, so the disconnected bodies are only
+  // removed once the outermost raise() is done, even if a slot throws
+  struct RaiseGuard
   {
-    if ((*itr)->isConnected())
-    {
-      (*itr)->getSlot()(std::forward<ArgTypes>(_args)...);
-      ++itr;
-    }
+    SignalType* mSignal;
+    ~RaiseGuard() { mSignal->finishRaise(); }
+  };
+  ++mRaiseDepth;
+  RaiseGuard guard{this};
+
+  // Slots are allowed to connect new slots to this signal, which may
+  // reallocate the container, so we index into it and hold onto each
+  // connection body while its slot is being called.
+  for (size_t i = 0; i < mConnectionBodies.size(); ++i)
+  {
+    const std::shared_ptr<ConnectionBodyType> body = mConnectionBodies[i];
+
+    if (body->isConnected())
+      body->getSlot()(std::forward<ArgTypes>(_args)...);
     else
-    {
-      mConnectionBodies.erase(itr++);
-    }
+      mNeedsCleanup = true;
   }
 }
 
+//==============================================================================
+template <typename... _ArgTypes>
+void Signal<void (_ArgTypes...)>::finishRaise()
+{
+  --mRaiseDepth;
+
+  if (mRaiseDepth == 0 && mNeedsCleanup)
+    cleanupConnections();
+}
+
 //==============================================================================
 template <typename... _ArgTypes>
 template <typename... ArgTypes>
@@ -360,6 +360,18 @@ void ConstraintSolver::updateConstraints()
     delete softContactConstraint;
   mSoftContactConstraints.clear();
 
+  // Reset the colliding state of the point masses once, rather than once per
+  // soft contact
+  for (const auto& skeleton : mSkeletons)
+  {
+    for (size_t i = 0; i < skeleton->getNumSoftBodyNodes(); ++i)
+    {
+      dynamics::SoftBodyNode* softBodyNode = skeleton->getSoftBodyNode(i);
+      for (size_t j = 0; j < softBodyNode->getNumPointMasses(); ++j)
+        softBodyNode->getPointMass(j)->setColliding(false);
+    }
+  }
+
   // Create new contact constraints
   for (size_t i = 0; i < mCollisionDetector->getNumContacts(); ++i)
   {
@@ -89,25 +89,17 @@ SoftContactConstraint::SoftContactConstraint(
   // TODO(JS): Assumed single contact
   mContacts.push_back(&_contact);
 
-  // Set the colliding state of body nodes and point masses to false
-  if (mSoftBodyNode1)
-  {
-    for (size_t i = 0; i < mSoftBodyNode1->getNumPointMasses(); ++i)
-      mSoftBodyNode1->getPointMass(i)->setColliding(false);
-  }
-  if (mSoftBodyNode2)
-  {
-    for (size_t i = 0; i < mSoftBodyNode2->getNumPointMasses(); ++i)
-      mSoftBodyNode2->getPointMass(i)->setColliding(false);
-  }
-
-  // Select colling point mass based on trimesh ID
+  // Select colling point mass based on trimesh ID. The colliding state of the
+  // point masses is reset by the ConstraintSolver before the soft contact
+  // constraints are created.
   if (mSoftBodyNode1)
   {
     if (_contact.shape1->getShapeType() == dynamics::Shape::SOFT_MESH)
     {
       mPointMass1 = selectCollidingPointMass(mSoftBodyNode1, _contact.point,
                                              _contact.triID1);
+      if (mPointMass1)
+        mPointMass1->setColliding(true);
     }
   }
   if (mSoftBodyNode2)
@@ -116,6 +108,8 @@ SoftContactConstraint::SoftContactConstraint(
     {
       mPointMass2 = selectCollidingPointMass(mSoftBodyNode2, _contact.point,
                                              _contact.triID2);
+      if (mPointMass2)
+        mPointMass2->setColliding(true);
     }
   }
 
@@ -1009,6 +1003,14 @@ static PointMassT selectCollidingPointMassT(
 {
   PointMassT pointMass = nullptr;
 
+  // Contacts that do not come from a triangle of the soft mesh fall back to a
+  // search over all the point masses
+  if (_faceId < 0
+      || static_cast<size_t>(_faceId) >= _softBodyNode->getNumFaces())
+  {
+    return _softBodyNode->getNearestPointMass(_point);
+  }
+
   const Eigen::Vector3i& face = _softBodyNode->getFace(_faceId);
 
   PointMassT pm0 = _softBodyNode->getPointMass(face[0]);
@@ -156,7 +156,8 @@ private:
   Eigen::MatrixXd getTangentBasisMatrixODE(const Eigen::Vector3d& _n);
 
   /// Find the nearest point mass from _point in a face, of which id is _faceId
-  /// in _softBodyNode.
+  /// in _softBodyNode. If _faceId is not a valid face, the nearest point mass
+  /// of the whole _softBodyNode is found through its spatial index.
   dynamics::PointMass* selectCollidingPointMass(
       dynamics::SoftBodyNode* _softBodyNode,
       const Eigen::Vector3d& _point,
@@ -128,10 +128,13 @@ BodyNode::UniqueProperties::UniqueProperties(
     const Inertia& _inertia,
     const std::vector<ShapePtr>& _collisionShapes,
     bool _isCollidable, double _frictionCoeff,
-    double _restitutionCoeff, bool _gravityMode)
+    double _restitutionCoeff, bool _gravityMode,
+    uint32_t _collisionCategories, uint32_t _collisionMask)
   : mInertia(_inertia),
     mColShapes(_collisionShapes),
     mIsCollidable(_isCollidable),
+    mCollisionCategories(_collisionCategories),
+    mCollisionMask(_collisionMask),
     mFrictionCoeff(_frictionCoeff),
     mRestitutionCoeff(_restitutionCoeff),
     mGravityMode(_gravityMode)
@@ -178,6 +181,8 @@ void BodyNode::setProperties(const UniqueProperties& _properties)
   setGravityMode(_properties.mGravityMode);
   setFrictionCoeff(_properties.mFrictionCoeff);
   setRestitutionCoeff(_properties.mRestitutionCoeff);
+  setCollisionCategories(_properties.mCollisionCategories);
+  setCollisionMask(_properties.mCollisionMask);
 
   removeAllCollisionShapes();
   for(size_t i=0; i<_properties.mColShapes.size(); ++i)
@@ -287,6 +292,37 @@ void BodyNode::setCollidable(bool _isCollidable)
   mBodyP.mIsCollidable = _isCollidable;
 }
 
+//==============================================================================
+void BodyNode::setCollisionCategories(uint32_t _categories)
+{
+  mBodyP.mCollisionCategories = _categories;
+}
+
+//==============================================================================
+uint32_t BodyNode::getCollisionCategories() const
+{
+  return mBodyP.mCollisionCategories;
+}
+
+//==============================================================================
+void BodyNode::setCollisionMask(uint32_t _mask)
+{
+  mBodyP.mCollisionMask = _mask;
+}
+
+//==============================================================================
+uint32_t BodyNode::getCollisionMask() const
+{
+  return mBodyP.mCollisionMask;
+}
+
+//==============================================================================
+bool BodyNode::canCollideWith(const BodyNode* _other) const
+{
+  return (mBodyP.mCollisionCategories & _other->mBodyP.mCollisionMask)
+      && (_other->mBodyP.mCollisionCategories & mBodyP.mCollisionMask);
+}
+
 //==============================================================================
 void BodyNode::setMass(double _mass)
 {
@@ -1375,6 +1411,44 @@ void BodyNode::updatePartialAcceleration() const
   mIsPartialAccelerationDirty = false;
 }
 
+//==============================================================================
+void BodyNode::updateKinematics(bool _updateTransform,
+                                bool _updateVelocity,
+                                bool _updateAcceleration)
+{
+  const Eigen::Isometry3d& relTf = mParentJoint->getLocalTransform();
+
+  if (_updateTransform && mNeedTransformUpdate)
+  {
+    mWorldTransform = mParentFrame->getWorldTransform()*relTf;
+    mNeedTransformUpdate = false;
+    assert(math::verifyTransform(mWorldTransform));
+  }
+
+  if (_updateVelocity)
+  {
+    if (mNeedVelocityUpdate)
+    {
+      mVelocity = math::AdInvT(relTf, mParentFrame->getSpatialVelocity())
+                  + mParentJoint->getLocalSpatialVelocity();
+      mNeedVelocityUpdate = false;
+      assert(!math::isNan(mVelocity));
+    }
+
+    if (mIsPartialAccelerationDirty)
+      BodyNode::updatePartialAcceleration();
+  }
+
+  if (_updateAcceleration && mNeedAccelerationUpdate)
+  {
+    mAcceleration = math::AdInvT(relTf, mParentFrame->getSpatialAcceleration())
+                    + mParentJoint->getLocalPrimaryAcceleration()
+                    + getPartialAcceleration();
+    mNeedAccelerationUpdate = false;
+    assert(!math::isNan(mAcceleration));
+  }
+}
+
 //==============================================================================
 void BodyNode::updateAccelerationID()
 {
@@ -38,6 +38,7 @@
 #ifndef DART_DYNAMICS_BODYNODE_H_
 #define DART_DYNAMICS_BODYNODE_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -59,6 +60,8 @@
 
 const double DART_DEFAULT_FRICTION_COEFF = 1.0;
 const double DART_DEFAULT_RESTITUTION_COEFF = 0.0;
+const uint32_t DART_DEFAULT_COLLISION_CATEGORIES = 0x00000001u;
+const uint32_t DART_DEFAULT_COLLISION_MASK = 0xFFFFFFFFu;
 
 namespace dart {
 namespace renderer {
@@ -108,6 +111,12 @@ public:
     /// Indicates whether this node is collidable;
     bool mIsCollidable;
 
+    /// Bit set of the collision categories that this node belongs to
+    uint32_t mCollisionCategories;
+
+    /// Bit set of the collision categories that this node collides with
+    uint32_t mCollisionMask;
+
     /// Coefficient of friction
     double mFrictionCoeff;
 
@@ -127,7 +136,9 @@ public:
         bool _isCollidable = true,
         double _frictionCoeff = DART_DEFAULT_FRICTION_COEFF,
         double _restitutionCoeff = DART_DEFAULT_RESTITUTION_COEFF,
-        bool _gravityMode = true);
+        bool _gravityMode = true,
+        uint32_t _collisionCategories = DART_DEFAULT_COLLISION_CATEGORIES,
+        uint32_t _collisionMask = DART_DEFAULT_COLLISION_MASK);
 
     virtual ~UniqueProperties() = default;
 
@@ -187,6 +198,26 @@ public:
   /// \param[in] _isCollidable True to enable collisions
   void setCollidable(bool _isCollidable);
 
+  /// Set the bit set of collision categories that this body node belongs to.
+  /// Two body nodes are only checked for collision if the categories of each
+  /// one intersect the collision mask of the other.
+  void setCollisionCategories(uint32_t _categories);
+
+  /// Get the bit set of collision categories that this body node belongs to
+  uint32_t getCollisionCategories() const;
+
+  /// Set the bit set of collision categories that this body node collides
+  /// with
+  void setCollisionMask(uint32_t _mask);
+
+  /// Get the bit set of collision categories that this body node collides
+  /// with
+  uint32_t getCollisionMask() const;
+
+  /// Return true if the collision categories and masks of this body node and
+  /// _other allow them to collide
+  bool canCollideWith(const BodyNode* _other) const;
+
   /// Set the mass of the bodynode
   void setMass(double _mass);
 
@@ -866,6 +897,16 @@ protected:
   /// Update partial spatial body acceleration due to parent joint's velocity.
   virtual void updatePartialAcceleration() const;
 
+  /// Update the requested kinematic quantities of this BodyNode in a single
+  /// step. This is equivalent to calling updateTransform(), updateVelocity(),
+  /// updatePartialAcceleration(), and updateAccelerationID(), except that the
+  /// relative transform of the parent joint is only looked up once and each
+  /// quantity is only recomputed if it is out of date. The parent Frame should
+  /// be up to date already for this to be efficient.
+  virtual void updateKinematics(bool _updateTransform,
+                                bool _updateVelocity,
+                                bool _updateAcceleration);
+
   /// Update articulated body inertia for forward dynamics.
   /// \param[in] _timeStep Rquired for implicit joint stiffness and damping.
   virtual void updateArtInertia(double _timeStep) const;
@@ -47,6 +47,9 @@ namespace dynamics {
 //==============================================================================
 typedef std::set<Entity*> EntityPtrSet;
 
+//==============================================================================
+std::atomic<bool> Entity::mChangeSignalsEnabled(true);
+
 //==============================================================================
 Entity::Properties::Properties(const std::string& _name,
                                const std::vector<ShapePtr>& _vizShapes)
@@ -78,12 +81,14 @@ Entity::Entity(Frame* _refFrame, const std::string& _name, bool _quiet)
     mNameChangedSignal(),
     mVizShapeAddedSignal(),
     mTransformUpdatedSignal(),
+    mTransformInvalidatedSignal(),
     mVelocityChangedSignal(),
     mAccelerationChangedSignal(),
     onFrameChanged(mFrameChangedSignal),
     onNameChanged(mNameChangedSignal),
     onVizShapeAdded(mVizShapeAddedSignal),
     onTransformUpdated(mTransformUpdatedSignal),
+    onTransformInvalidated(mTransformInvalidatedSignal),
     onVelocityChanged(mVelocityChangedSignal),
     onAccelerationChanged(mAccelerationChangedSignal),
     mAmQuiet(_quiet),
@@ -328,7 +333,12 @@ void Entity::notifyTransformUpdate()
 
   // The actual transform hasn't updated yet. But when its getter is called,
   // the transformation will be updated automatically.
-  mTransformUpdatedSignal.raise(this);
+  if(mChangeSignalsEnabled)
+    mTransformUpdatedSignal.raise(this);
+
+  // Caches that depend on the transform are invalidated even while the change
+  // signals are disabled
+  mTransformInvalidatedSignal.raise(this);
 }
 
 //==============================================================================
@@ -344,7 +354,8 @@ void Entity::notifyVelocityUpdate()
 
   // The actual velocity hasn't updated yet. But when its getter is called,
   // the velocity will be updated automatically.
-  mVelocityChangedSignal.raise(this);
+  if(mChangeSignalsEnabled)
+    mVelocityChangedSignal.raise(this);
 }
 
 //==============================================================================
@@ -360,7 +371,8 @@ void Entity::notifyAccelerationUpdate()
 
   // The actual acceleration hasn't updated yet. But when its getter is called,
   // the acceleration will be updated automatically.
-  mAccelerationChangedSignal.raise(this);
+  if(mChangeSignalsEnabled)
+    mAccelerationChangedSignal.raise(this);
 }
 
 //==============================================================================
@@ -369,6 +381,24 @@ bool Entity::needsAccelerationUpdate() const
   return mNeedAccelerationUpdate;
 }
 
+//==============================================================================
+void Entity::enableChangeSignals()
+{
+  mChangeSignalsEnabled = true;
+}
+
+//==============================================================================
+void Entity::disableChangeSignals()
+{
+  mChangeSignalsEnabled = false;
+}
+
+//==============================================================================
+bool Entity::isEnabledChangeSignals()
+{
+  return mChangeSignalsEnabled;
+}
+
 //==============================================================================
 Entity::Entity(ConstructFrame_t)
   : mParentFrame(nullptr),
@@ -379,12 +409,14 @@ Entity::Entity(ConstructFrame_t)
     mNameChangedSignal(),
     mVizShapeAddedSignal(),
     mTransformUpdatedSignal(),
+    mTransformInvalidatedSignal(),
     mVelocityChangedSignal(),
     mAccelerationChangedSignal(),
     onFrameChanged(mFrameChangedSignal),
     onNameChanged(mNameChangedSignal),
     onVizShapeAdded(mVizShapeAddedSignal),
     onTransformUpdated(mTransformUpdatedSignal),
+    onTransformInvalidated(mTransformInvalidatedSignal),
     onVelocityChanged(mVelocityChangedSignal),
     onAccelerationChanged(mAccelerationChangedSignal),
     mAmQuiet(false),
@@ -399,6 +431,7 @@ Entity::Entity(ConstructAbstract_t)
     onNameChanged(mNameChangedSignal),
     onVizShapeAdded(mVizShapeAddedSignal),
     onTransformUpdated(mTransformUpdatedSignal),
+    onTransformInvalidated(mTransformInvalidatedSignal),
     onVelocityChanged(mVelocityChangedSignal),
     onAccelerationChanged(mAccelerationChangedSignal),
     mAmQuiet(false)
@@ -38,6 +38,7 @@
 #define DART_DYNAMICS_ENTITY_H_
 
 #include <Eigen/Core>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -202,6 +203,26 @@ public:
   /// Returns true iff an acceleration update is needed for this Entity
   bool needsAccelerationUpdate() const;
 
+  /// Enable the transform, velocity, and acceleration changed signals of all
+  /// Entities. These signals are enabled by default.
+  static void enableChangeSignals();
+
+  /// Disable the transform, velocity, and acceleration changed signals of all
+  /// Entities. Raising a signal that has no connected slots is nearly free, but
+  /// a batch simulation that has slots connected (e.g. by a viewer) yet does not
+  /// need them to be called on every kinematic update can use this to skip
+  /// them altogether.
+  ///
+  /// This only silences the slots of onTransformUpdated, onVelocityChanged,
+  /// and onAccelerationChanged. The slots of onTransformInvalidated, which
+  /// invalidate internal caches such as the ones of InverseKinematics, are
+  /// still called, so those caches stay correct while the signals are off.
+  static void disableChangeSignals();
+
+  /// Returns true iff the transform, velocity, and acceleration changed signals
+  /// of the Entities are enabled
+  static bool isEnabledChangeSignals();
+
 protected:
 
   /// Used when constructing a Frame class, because the Frame constructor will
@@ -251,12 +272,20 @@ protected:
   /// Transform changed signal
   EntitySignal mTransformUpdatedSignal;
 
+  /// Transform changed signal that is raised even while the change signals
+  /// are disabled
+  EntitySignal mTransformInvalidatedSignal;
+
   /// Velocity changed signal
   EntitySignal mVelocityChangedSignal;
 
   /// Acceleration changed signal
   EntitySignal mAccelerationChangedSignal;
 
+  /// Whether the transform, velocity, and acceleration changed signals are
+  /// raised by the Entities
+  static std::atomic<bool> mChangeSignalsEnabled;
+
 public:
   //----------------------------------------------------------------------------
   /// \{ \name Slot registers
@@ -274,6 +303,11 @@ public:
   /// Slot register for transform updated signal
   common::SlotRegister<EntitySignal> onTransformUpdated;
 
+  /// Slot register for the transform updated signal that is raised regardless
+  /// of isEnabledChangeSignals(). It is meant for invalidating caches that
+  /// depend on the transform of this Entity, so its slots should be cheap.
+  common::SlotRegister<EntitySignal> onTransformInvalidated;
+
   /// Slot register for velocity updated signal
   common::SlotRegister<EntitySignal> onVelocityChanged;
 
@@ -471,7 +471,12 @@ void Frame::notifyTransformUpdate()
 
   // Always trigger the signal, in case a new subscriber has registered in the
   // time since the last signal
-  mTransformUpdatedSignal.raise(this);
+  if(mChangeSignalsEnabled)
+    mTransformUpdatedSignal.raise(this);
+
+  // Caches that depend on the transform are invalidated even while the change
+  // signals are disabled
+  mTransformInvalidatedSignal.raise(this);
 
   // If we already know we need to update, just quit
   if(mNeedTransformUpdate)
@@ -490,7 +495,8 @@ void Frame::notifyVelocityUpdate()
 
   // Always trigger the signal, in case a new subscriber has registered in the
   // time since the last signal
-  mVelocityChangedSignal.raise(this);
+  if(mChangeSignalsEnabled)
+    mVelocityChangedSignal.raise(this);
 
   // If we already know we need to update, just quit
   if(mNeedVelocityUpdate)
@@ -507,7 +513,8 @@ void Frame::notifyAccelerationUpdate()
 {
   // Always trigger the signal, in case a new subscriber has registered in the
   // time since the last signal
-  mAccelerationChangedSignal.raise(this);
+  if(mChangeSignalsEnabled)
+    mAccelerationChangedSignal.raise(this);
 
   // If we already know we need to update, just quit
   if(mNeedAccelerationUpdate)
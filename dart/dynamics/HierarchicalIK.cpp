@@ -34,15 +34,24 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
+#include <chrono>
+#include <limits>
+
 #include "dart/dynamics/DegreeOfFreedom.h"
 #include "dart/dynamics/HierarchicalIK.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/EndEffector.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/optimizer/LevenbergMarquardtSolver.h"
 
 namespace dart {
 namespace dynamics {
 
+//==============================================================================
+static std::atomic<InverseKinematics::SolverType> sDefaultHierarchicalSolverType(
+    InverseKinematics::GRADIENT_DESCENT_SOLVER);
+
 //==============================================================================
 bool HierarchicalIK::solve(bool _applySolution)
 {
@@ -89,6 +98,37 @@ bool HierarchicalIK::solve(bool _applySolution)
 
   refreshIKHierarchy();
 
+  if(std::dynamic_pointer_cast<optimizer::LevenbergMarquardtSolver>(mSolver))
+  {
+    // The residuals of every level are stacked into a single least-squares
+    // problem, so the levels below the first one would compete with it
+    // instead of being confined to its null space
+    size_t numActiveLevels = 0;
+    for(const std::vector< std::shared_ptr<InverseKinematics> >& level
+        : mHierarchy)
+    {
+      for(const std::shared_ptr<InverseKinematics>& ik : level)
+      {
+        if(ik->isActive())
+        {
+          ++numActiveLevels;
+          break;
+        }
+      }
+    }
+
+    if(numActiveLevels > 1)
+    {
+      dterr << "[HierarchicalIK::solve] A LevenbergMarquardtSolver cannot "
+            << "preserve the priorities of a hierarchy, but the HierarchicalIK "
+            << "module associated with [" << skel->getName() << "] has ["
+            << numActiveLevels << "] levels with active modules. Use a "
+            << "GradientDescentSolver instead, or put all the modules on the "
+            << "same level.\n";
+      return false;
+    }
+  }
+
   if(_applySolution)
   {
     bool wasSolved = mSolver->solve();
@@ -194,6 +234,18 @@ void HierarchicalIK::setSolver(
   mSolver->setProblem(mProblem);
 }
 
+//==============================================================================
+void HierarchicalIK::setDefaultSolverType(InverseKinematics::SolverType _type)
+{
+  sDefaultHierarchicalSolverType = _type;
+}
+
+//==============================================================================
+InverseKinematics::SolverType HierarchicalIK::getDefaultSolverType()
+{
+  return sDefaultHierarchicalSolverType;
+}
+
 //==============================================================================
 const std::shared_ptr<optimizer::Solver>& HierarchicalIK::getSolver()
 {
@@ -212,6 +264,16 @@ const IKHierarchy& HierarchicalIK::getIKHierarchy() const
   return mHierarchy;
 }
 
+//==============================================================================
+HierarchicalIK::LevelStats::LevelStats()
+  : mNumComputations(0),
+    mTotalTime(0.0),
+    mLastTime(0.0),
+    mRank(0)
+{
+  // Do nothing
+}
+
 //==============================================================================
 const std::vector<Eigen::MatrixXd>& HierarchicalIK::computeNullSpaces() const
 {
@@ -239,29 +301,81 @@ const std::vector<Eigen::MatrixXd>& HierarchicalIK::computeNullSpaces() const
   // are available. The version should account for information about changes in
   // indexing and changes in Joint / BodyNode properties.
 
+  const IKHierarchy& hierarchy = getIKHierarchy();
+
+  // Modules may have been activated, deactivated, or moved to other levels
+  size_t index = 0;
+  for(size_t i=0; i < hierarchy.size() && !recompute; ++i)
+  {
+    const std::vector< std::shared_ptr<InverseKinematics> >& level =
+        hierarchy[i];
+
+    for(size_t j=0; j < level.size() && !recompute; ++j)
+    {
+      if(!level[j]->isActive())
+        continue;
+
+      if(index >= mLastActiveModules.size()
+         || mLastActiveModules[index] != level[j].get())
+        recompute = true;
+
+      ++index;
+    }
+
+    if(index >= mLastActiveModules.size()
+       || mLastActiveModules[index] != nullptr)
+      recompute = true;
+
+    ++index;
+  }
+
+  if(index != mLastActiveModules.size())
+    recompute = true;
+
   if(!recompute)
+  {
+    ++mNumNullSpaceCacheHits;
     return mNullSpaceCache;
+  }
 
-  const IKHierarchy& hierarchy = getIKHierarchy();
+  mLastPositions = skel->getPositions();
+  mLastActiveModules.clear();
 
   mNullSpaceCache.resize(hierarchy.size());
-  bool zeroedNullSpace = false;
+  mLevelStats.resize(hierarchy.size());
+  size_t remainingDofs = nDofs;
   for(size_t i=0; i < hierarchy.size(); ++i)
   {
+    const std::chrono::steady_clock::time_point startTime =
+        std::chrono::steady_clock::now();
+
     const std::vector< std::shared_ptr<InverseKinematics> >& level =
         hierarchy[i];
 
+    size_t numActive = 0;
+    for(size_t j=0; j < level.size(); ++j)
+    {
+      if(level[j]->isActive())
+      {
+        mLastActiveModules.push_back(level[j].get());
+        ++numActive;
+      }
+    }
+    mLastActiveModules.push_back(nullptr);
+
     Eigen::MatrixXd& NS = mNullSpaceCache[i];
+    LevelStats& stats = mLevelStats[i];
+    stats.mRank = 0;
+
     if(i == 0)
     {
       // Start with an identity null space
       NS = Eigen::MatrixXd::Identity(nDofs, nDofs);
     }
-    else if(zeroedNullSpace)
+    else if(0 == remainingDofs)
     {
       // If the null space has been zeroed out, just keep propogating the zeroes
       NS.setZero(nDofs, nDofs);
-      continue;
     }
     else
     {
@@ -269,44 +383,96 @@ const std::vector<Eigen::MatrixXd>& HierarchicalIK::computeNullSpaces() const
       NS = mNullSpaceCache[i-1];
     }
 
-    mJacCache.resize(6, nDofs);
-    for(size_t j=0; j < level.size(); ++j)
+    if(numActive > 0 && remainingDofs > 0)
     {
-      const std::shared_ptr<InverseKinematics>& ik = level[j];
+      // Stack the transposed Jacobians of this level into the columns of the
+      // Skeleton's degrees of freedom
+      mProjectedJacCache.setZero(nDofs, 6*numActive);
+      size_t col = 0;
+      for(size_t j=0; j < level.size(); ++j)
+      {
+        const std::shared_ptr<InverseKinematics>& ik = level[j];
 
-      if(!ik->isActive())
-        continue;
+        if(!ik->isActive())
+          continue;
 
-      const math::Jacobian& J = ik->computeJacobian();
-      const std::vector<size_t>& dofs = ik->getDofs();
+        const math::Jacobian& J = ik->computeJacobian();
+        const std::vector<size_t>& dofs = ik->getDofs();
+        for(size_t d=0; d < dofs.size(); ++d)
+          mProjectedJacCache.block<1,6>(dofs[d], col) = J.col(d).transpose();
 
-      mJacCache.setZero();
-      for(size_t d=0; d < dofs.size(); ++d)
-      {
-        size_t k = dofs[d];
-        mJacCache.block<6,1>(0,k) = J.block<6,1>(0,d);
+        col += 6;
       }
 
-      mSVDCache.compute(mJacCache, Eigen::ComputeFullV);
-      math::extractNullSpace(mSVDCache, mPartialNullspaceCache);
-
-      if(mPartialNullspaceCache.rows() > 0 && mPartialNullspaceCache.cols() > 0)
+      // Directions that are already constrained by the previous levels cannot
+      // be claimed again, so only the projection of this level's Jacobians into
+      // the previous null space is decomposed
+      const double scale = mProjectedJacCache.colwise().norm().maxCoeff();
+      if(i > 0)
+        mProjectedJacCache = NS * mProjectedJacCache;
+
+      mQRCache.compute(mProjectedJacCache);
+
+      // The pivoting sorts the diagonal of R by decreasing magnitude. The same
+      // relative threshold as math::extractNullSpace() is used to decide the
+      // rank, measured against the unprojected Jacobians.
+      const double threshold = std::max(scale*1e-10,
+                                        std::numeric_limits<double>::min());
+      const Eigen::MatrixXd& QR = mQRCache.matrixQR();
+      const size_t maxRank = std::min(QR.rows(), QR.cols());
+      size_t rank = 0;
+      while(rank < maxRank && std::abs(QR(rank, rank)) > threshold)
+        ++rank;
+
+      rank = std::min(rank, remainingDofs);
+      if(rank > 0)
       {
-        NS *= mPartialNullspaceCache * mPartialNullspaceCache.transpose();
+        mRangeCache.setIdentity(nDofs, rank);
+        mRangeCache.applyOnTheLeft(mQRCache.householderQ());
+        NS.noalias() -= mRangeCache * mRangeCache.transpose();
       }
-      else
+
+      stats.mRank = rank;
+      remainingDofs -= rank;
+      if(0 == remainingDofs)
       {
         // There no longer exists a null space for this or any lower level
         NS.setZero();
-        zeroedNullSpace = true;
-        break;
       }
     }
+
+    const double elapsed = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - startTime).count();
+    ++stats.mNumComputations;
+    stats.mTotalTime += elapsed;
+    stats.mLastTime = elapsed;
   }
 
   return mNullSpaceCache;
 }
 
+//==============================================================================
+const std::vector<HierarchicalIK::LevelStats>&
+HierarchicalIK::getLevelStats() const
+{
+  return mLevelStats;
+}
+
+//==============================================================================
+void HierarchicalIK::resetLevelStats()
+{
+  for(LevelStats& stats : mLevelStats)
+    stats = LevelStats();
+
+  mNumNullSpaceCacheHits = 0;
+}
+
+//==============================================================================
+size_t HierarchicalIK::getNumNullSpaceCacheHits() const
+{
+  return mNumNullSpaceCacheHits;
+}
+
 //==============================================================================
 Eigen::VectorXd HierarchicalIK::getPositions() const
 {
@@ -495,6 +661,10 @@ void HierarchicalIK::Constraint::evalGradient(
   const IKHierarchy& hierarchy = hik->getIKHierarchy();
   const SkeletonPtr& skel = hik->getSkeleton();
   const size_t nDofs = skel->getNumDofs();
+
+  // The null spaces must be computed for _x. This also lets the Objective
+  // reuse them when it gets evaluated at the same configuration.
+  hik->setPositions(_x);
   const std::vector<Eigen::MatrixXd>& nullspaces = hik->computeNullSpaces();
 
   _grad.setZero();
@@ -539,9 +709,134 @@ void HierarchicalIK::Constraint::evalGradient(
   }
 }
 
+//==============================================================================
+size_t HierarchicalIK::Constraint::getNumResiduals() const
+{
+  const std::shared_ptr<HierarchicalIK>& hik = mIK.lock();
+  if(nullptr == hik)
+    return 0;
+
+  const IKHierarchy& hierarchy = hik->getIKHierarchy();
+
+  size_t numResiduals = 0;
+  for(size_t i=0; i < hierarchy.size(); ++i)
+  {
+    const std::vector< std::shared_ptr<InverseKinematics> >& level =
+        hierarchy[i];
+
+    for(size_t j=0; j < level.size(); ++j)
+    {
+      if(level[j]->isActive())
+        numResiduals += 6;
+    }
+  }
+
+  return numResiduals;
+}
+
+//==============================================================================
+void HierarchicalIK::Constraint::evalResidual(
+    const Eigen::VectorXd& _x, Eigen::VectorXd& _residual)
+{
+  const std::shared_ptr<HierarchicalIK>& hik = mIK.lock();
+  if(nullptr == hik)
+  {
+    dterr << "[HierarchicalIK::Constraint::evalResidual] Attempting to use a "
+          << "Constraint function of an expired HierarchicalIK module!\n";
+    assert(false);
+    _residual.resize(0);
+    return;
+  }
+
+  const IKHierarchy& hierarchy = hik->getIKHierarchy();
+
+  _residual.resize(getNumResiduals());
+  size_t row = 0;
+  for(size_t i=0; i < hierarchy.size(); ++i)
+  {
+    const std::vector< std::shared_ptr<InverseKinematics> >& level =
+        hierarchy[i];
+
+    for(size_t j=0; j < level.size(); ++j)
+    {
+      const std::shared_ptr<InverseKinematics>& ik = level[j];
+
+      if(!ik->isActive())
+        continue;
+
+      const std::vector<size_t>& dofs = ik->getDofs();
+      Eigen::VectorXd q(dofs.size());
+      for(size_t k=0; k < dofs.size(); ++k)
+        q[k] = _x[dofs[k]];
+
+      _residual.segment<6>(row) = ik->getErrorMethod().evalUnclampedError(q);
+      row += 6;
+    }
+  }
+}
+
+//==============================================================================
+void HierarchicalIK::Constraint::evalJacobian(
+    const Eigen::VectorXd& _x, Eigen::MatrixXd& _jacobian)
+{
+  const std::shared_ptr<HierarchicalIK>& hik = mIK.lock();
+  if(nullptr == hik)
+  {
+    dterr << "[HierarchicalIK::Constraint::evalJacobian] Attempting to use a "
+          << "Constraint function of an expired HierarchicalIK module!\n";
+    assert(false);
+    _jacobian.resize(0, _x.size());
+    return;
+  }
+
+  const IKHierarchy& hierarchy = hik->getIKHierarchy();
+
+  _jacobian.setZero(getNumResiduals(), _x.size());
+  size_t row = 0;
+  for(size_t i=0; i < hierarchy.size(); ++i)
+  {
+    const std::vector< std::shared_ptr<InverseKinematics> >& level =
+        hierarchy[i];
+
+    for(size_t j=0; j < level.size(); ++j)
+    {
+      const std::shared_ptr<InverseKinematics>& ik = level[j];
+
+      if(!ik->isActive())
+        continue;
+
+      const std::vector<size_t>& dofs = ik->getDofs();
+      Eigen::VectorXd q(dofs.size());
+      for(size_t k=0; k < dofs.size(); ++k)
+        q[k] = _x[dofs[k]];
+
+      // Weight the rows of this module's Jacobian like its error vector, and
+      // scatter its columns into the columns of the Skeleton's degrees of
+      // freedom. Components without any bounds never produce any error.
+      InverseKinematics::ErrorMethod& method = ik->getErrorMethod();
+      method.evalUnclampedError(q);
+      const Eigen::Vector6d& weights = method.getErrorWeights();
+      const InverseKinematics::ErrorMethod::Bounds& bounds =
+          method.getBounds();
+      const math::Jacobian& J = ik->computeJacobian();
+      for(size_t r=0; r < 6; ++r)
+      {
+        if(std::isinf(bounds.first[r]) && std::isinf(bounds.second[r]))
+          continue;
+
+        for(size_t k=0; k < dofs.size(); ++k)
+          _jacobian(row + r, dofs[k]) = weights[r]*J(r, k);
+      }
+
+      row += 6;
+    }
+  }
+}
+
 //==============================================================================
 HierarchicalIK::HierarchicalIK(const SkeletonPtr& _skeleton)
-  : mSkeleton(_skeleton)
+  : mSkeleton(_skeleton),
+    mNumNullSpaceCacheHits(0)
 {
   // initialize MUST be called immediately after the construction of any
   // directly inheriting classes.
@@ -558,10 +853,7 @@ void HierarchicalIK::initialize(const std::shared_ptr<HierarchicalIK> my_ptr)
   mProblem = std::make_shared<optimizer::Problem>();
   resetProblem();
 
-  std::shared_ptr<optimizer::GradientDescentSolver> solver =
-      std::make_shared<optimizer::GradientDescentSolver>(mProblem);
-  solver->setStepSize(1.0);
-  mSolver = solver;
+  mSolver = InverseKinematics::createSolver(getDefaultSolverType(), mProblem);
 }
 
 //==============================================================================
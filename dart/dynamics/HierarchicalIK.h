@@ -39,6 +39,8 @@
 
 #include <unordered_set>
 
+#include <Eigen/QR>
+
 #include "dart/dynamics/InverseKinematics.h"
 
 namespace dart {
@@ -74,6 +76,11 @@ public:
   /// solved joint positions. If you pass in false for _applySolution, then the
   /// joint positions will be return to their original positions after the
   /// problem is solved.
+  ///
+  /// If the Solver is an optimizer::LevenbergMarquardtSolver and more than one
+  /// level of the hierarchy has an active module, this prints an error and
+  /// returns false without solving, because the least-squares Solver would
+  /// lose the priorities of the levels.
   bool solve(bool _applySolution = true);
 
   /// Same as solve(bool), but the positions vector will be filled with the
@@ -149,15 +156,67 @@ public:
   /// Get the Solver that is being used by this IK module.
   std::shared_ptr<const optimizer::Solver> getSolver() const;
 
+  /// Set the kind of Solver that HierarchicalIK modules will be created with
+  /// from now on. Modules that already exist keep their Solver. The default is
+  /// InverseKinematics::GRADIENT_DESCENT_SOLVER.
+  ///
+  /// A least-squares Solver has no notion of the priorities of the hierarchy,
+  /// so solve() refuses to use a LevenbergMarquardtSolver when more than one
+  /// level of the hierarchy has an active module.
+  static void setDefaultSolverType(InverseKinematics::SolverType _type);
+
+  /// Get the kind of Solver that new HierarchicalIK modules are created with
+  static InverseKinematics::SolverType getDefaultSolverType();
+
   /// Refresh the IK hierarchy of this IK module
   virtual void refreshIKHierarchy() = 0;
 
   /// Get the IK hierarchy of this IK module
   const IKHierarchy& getIKHierarchy() const;
 
-  /// Compute the null spaces of each level of the hierarchy
+  /// Statistics about the null space computations of a level of the hierarchy
+  struct LevelStats
+  {
+    /// Default constructor
+    LevelStats();
+
+    /// Number of times the null space of this level has been computed
+    size_t mNumComputations;
+
+    /// Total time spent computing the null space of this level, in seconds
+    double mTotalTime;
+
+    /// Time spent by the most recent computation, in seconds
+    double mLastTime;
+
+    /// Number of independent directions that the Jacobians of this level
+    /// claimed from the null space of the levels above it in the most recent
+    /// computation
+    size_t mRank;
+  };
+
+  /// Compute the null spaces of each level of the hierarchy. Entry i is the
+  /// projector onto the null space of the Jacobians of levels 0 through i.
+  ///
+  /// The result is cached until the joint positions of the Skeleton or the
+  /// set of active modules change, so the Objective and Constraint of this
+  /// module share a single computation for each configuration. Each level is
+  /// built on the previous one: the Jacobians of the level are projected into
+  /// the previous null space, and a rank-revealing QR decomposition of the
+  /// projection provides the directions that get removed from it.
   const std::vector<Eigen::MatrixXd>& computeNullSpaces() const;
 
+  /// Get the statistics of the null space computations for each level of the
+  /// hierarchy
+  const std::vector<LevelStats>& getLevelStats() const;
+
+  /// Reset the statistics of the null space computations
+  void resetLevelStats();
+
+  /// Get the number of times that computeNullSpaces() was able to return its
+  /// cached result since the last call to resetLevelStats()
+  size_t getNumNullSpaceCacheHits() const;
+
   /// Get the current joint positions of the Skeleton associated with this
   /// IK module.
   Eigen::VectorXd getPositions() const;
@@ -226,7 +285,13 @@ protected:
   /// of this HierarchicalIK module. This class is not meant to be extended or
   /// instantiated by a user. Call HierarchicalIK::resetProblem() to set
   /// the constraint of the module's Problem to an HierarchicalIK::Constraint.
-  class Constraint final : public Function, public optimizer::Function
+  ///
+  /// The residual of the Constraint stacks the error vectors of every active
+  /// module, so a least-squares Solver such as
+  /// optimizer::LevenbergMarquardtSolver can solve a hierarchy that has a
+  /// single level. See solve() for hierarchies with several levels.
+  class Constraint final : public Function,
+                           public optimizer::LeastSquaresFunction
   {
   public:
 
@@ -247,6 +312,17 @@ protected:
     void evalGradient(const Eigen::VectorXd& _x,
                       Eigen::Map<Eigen::VectorXd> _grad) override;
 
+    // Documentation inherited
+    size_t getNumResiduals() const override;
+
+    // Documentation inherited
+    void evalResidual(const Eigen::VectorXd& _x,
+                      Eigen::VectorXd& _residual) override;
+
+    // Documentation inherited
+    void evalJacobian(const Eigen::VectorXd& _x,
+                      Eigen::MatrixXd& _jacobian) override;
+
   protected:
 
     /// Pointer to this Constraint's HierarchicalIK module
@@ -293,17 +369,29 @@ protected:
   /// Cache for the last positions
   mutable Eigen::VectorXd mLastPositions;
 
+  /// The active modules of each level when the null spaces were last computed.
+  /// A nullptr marks the end of a level.
+  mutable std::vector<const InverseKinematics*> mLastActiveModules;
+
   /// Cache for null space computations
   mutable std::vector<Eigen::MatrixXd> mNullSpaceCache;
 
-  /// Cache for a partial null space computation
-  mutable Eigen::MatrixXd mPartialNullspaceCache;
+  /// Cache for the stacked Jacobians of a level, projected into the null space
+  /// of the previous levels and transposed
+  mutable Eigen::MatrixXd mProjectedJacCache;
+
+  /// Cache for the rank-revealing decomposition of mProjectedJacCache
+  mutable Eigen::ColPivHouseholderQR<Eigen::MatrixXd> mQRCache;
+
+  /// Cache for the orthonormal directions that a level removes from the null
+  /// space
+  mutable Eigen::MatrixXd mRangeCache;
 
-  /// Cache for the null space SVD
-  mutable Eigen::JacobiSVD<math::Jacobian> mSVDCache;
+  /// Statistics for each level of the hierarchy
+  mutable std::vector<LevelStats> mLevelStats;
 
-  /// Cache for Jacobians
-  mutable math::Jacobian mJacCache;
+  /// Number of times that the null space cache was reused
+  mutable size_t mNumNullSpaceCacheHits;
 };
 
 /// The CompositeIK class allows you to specify an arbitrary hierarchy of
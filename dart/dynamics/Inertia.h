@@ -123,6 +123,15 @@ public:
   bool verify(bool _printWarnings = true,
               double _tolerance = 1e-8) const;
 
+  /// Compute the spatial inertia tensor from the inertial parameters for any
+  /// scalar type, e.g. float or a forward-mode automatic differentiation type.
+  /// The moment of inertia is taken about the center of mass.
+  template <typename Scalar>
+  static math::Matrix6<Scalar> computeSpatialTensor(
+      const Scalar& _mass,
+      const Eigen::Matrix<Scalar, 3, 1>& _com,
+      const Eigen::Matrix<Scalar, 3, 3>& _moment);
+
 protected:
 
   /// Compute the spatial tensor based on the inertial parameters
@@ -151,4 +160,6 @@ public:
 } // namespace dynamics
 } // namespace dart
 
+#include "dart/dynamics/detail/Inertia.h"
+
 #endif // DART_DYNAMICS_INERTIA_H_
@@ -34,10 +34,17 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
+#include <limits>
+#include <mutex>
+
 #include "dart/dynamics/InverseKinematics.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/DegreeOfFreedom.h"
+#include "dart/dynamics/EndEffector.h"
 #include "dart/dynamics/SimpleFrame.h"
+#include "dart/dynamics/Skeleton.h"
+#include "dart/optimizer/LevenbergMarquardtSolver.h"
 
 namespace dart {
 namespace dynamics {
@@ -77,20 +84,7 @@ bool InverseKinematics::solve(bool _applySolution)
     return false;
   }
 
-  mProblem->setDimension(mDofs.size());
-
-  mProblem->setInitialGuess(getPositions());
-
-  const SkeletonPtr& skel = getNode()->getSkeleton();
-
-  Eigen::VectorXd bounds(mDofs.size());
-  for(size_t i=0; i < mDofs.size(); ++i)
-    bounds[i] = skel->getDof(mDofs[i])->getPositionLowerLimit();
-  mProblem->setLowerBounds(bounds);
-
-  for(size_t i=0; i < mDofs.size(); ++i)
-    bounds[i] = skel->getDof(mDofs[i])->getPositionUpperLimit();
-  mProblem->setUpperBounds(bounds);
+  prepareProblem();
 
   if(_applySolution)
   {
@@ -113,6 +107,18 @@ bool InverseKinematics::solve(Eigen::VectorXd& positions, bool _applySolution)
   return wasSolved;
 }
 
+//==============================================================================
+InverseKinematics::ParallelProperties::ParallelProperties(
+    size_t _numThreads,
+    size_t _numAttempts,
+    ParallelPolicy _policy)
+  : mNumThreads(_numThreads),
+    mNumAttempts(_numAttempts),
+    mPolicy(_policy)
+{
+  // Do nothing
+}
+
 //==============================================================================
 static std::shared_ptr<optimizer::Function> cloneIkFunc(
     const std::shared_ptr<optimizer::Function>& _function,
@@ -127,6 +133,215 @@ static std::shared_ptr<optimizer::Function> cloneIkFunc(
   return _function;
 }
 
+//==============================================================================
+bool InverseKinematics::solveParallel(bool _applySolution)
+{
+  Eigen::VectorXd positions;
+  return solveParallel(positions, _applySolution);
+}
+
+//==============================================================================
+bool InverseKinematics::solveParallel(
+    Eigen::VectorXd& positions, bool _applySolution)
+{
+  if(nullptr == mSolver)
+  {
+    dtwarn << "[InverseKinematics::solveParallel] The Solver for an "
+           << "InverseKinematics module associated with [" << mNode->getName()
+           << "] is a nullptr. You must reset the module's Solver before you "
+           << "can use it.\n";
+    return false;
+  }
+
+  if(nullptr == mProblem)
+  {
+    dtwarn << "[InverseKinematics::solveParallel] The Problem for an "
+           << "InverseKinematics module associated with [" << mNode->getName()
+           << "] is a nullptr. You must reset the module's Problem before you "
+           << "can use it.\n";
+    return false;
+  }
+
+  prepareProblem();
+
+  const SkeletonPtr& skel = getNode()->getSkeleton();
+  if(mParallelWorkers.empty()
+     || mParallelWorkers[0].mSkeleton->getNumDofs() != skel->getNumDofs())
+  {
+    if(!resetParallelWorkers())
+      return false;
+  }
+
+  // Bring the workers up to date with this module and its Skeleton
+  const Eigen::VectorXd skelPositions = skel->getPositions();
+  for(ParallelWorker& worker : mParallelWorkers)
+  {
+    worker.mSkeleton->setPositions(skelPositions);
+
+    const InverseKinematicsPtr& ik = worker.mIK;
+    if(ik->getDofs() != mDofs)
+      ik->setDofs(mDofs);
+
+    if(ik->getOffset() != mOffset)
+      ik->setOffset(mOffset);
+
+    if(ik->getTarget() != mTarget)
+      ik->setTarget(mTarget);
+
+    if(worker.mConfigurationVersion != mConfigurationVersion)
+      configureParallelWorker(worker);
+  }
+
+  // The target is shared by all the workers, so its transform must be computed
+  // before the workers start reading it
+  mTarget->getWorldTransform();
+
+  const Eigen::VectorXd initialPositions = getPositions();
+  const std::vector<Eigen::VectorXd>& seeds = mProblem->getSeeds();
+  const Eigen::VectorXd& lower = mProblem->getLowerBounds();
+  const Eigen::VectorXd& upper = mProblem->getUpperBounds();
+  const size_t numAttempts = mParallelProperties.mNumAttempts;
+  const ParallelPolicy policy = mParallelProperties.mPolicy;
+
+  std::atomic<size_t> nextAttempt(0);
+  std::atomic<bool> cancelled(false);
+  std::mutex resultMutex;
+
+  // Raising the cancelled flag also stops the attempts that are in progress
+  for(ParallelWorker& worker : mParallelWorkers)
+    worker.mIK->getSolver()->setStopFlag(&cancelled);
+
+  bool solved = false;
+  double bestValue = std::numeric_limits<double>::infinity();
+  Eigen::VectorXd bestSolution;
+
+  std::vector<std::future<void>> results;
+  results.reserve(mParallelWorkers.size());
+  for(size_t w=0; w < mParallelWorkers.size(); ++w)
+  {
+    results.push_back(mThreadPool->submit([&, w]()
+    {
+      try
+      {
+        ParallelWorker& worker = mParallelWorkers[w];
+        std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        Eigen::VectorXd q;
+        while(!cancelled.load())
+        {
+          const size_t attempt = nextAttempt++;
+          if(attempt >= numAttempts)
+            break;
+
+          if(0 == attempt)
+          {
+            q = initialPositions;
+          }
+          else if(attempt-1 < seeds.size())
+          {
+            q = seeds[attempt-1];
+          }
+          else
+          {
+            // DOFs without finite limits are randomized within half a turn of
+            // their initial position
+            q = initialPositions;
+            for(int i=0; i < q.size(); ++i)
+            {
+              const double r = distribution(worker.mRNG);
+              if(std::isfinite(lower[i]) && std::isfinite(upper[i]))
+                q[i] = lower[i] + r*(upper[i] - lower[i]);
+              else
+                q[i] += (2.0*r - 1.0)*DART_PI;
+            }
+          }
+
+          worker.mIK->setPositions(q);
+          if(!worker.mIK->solve(true))
+            continue;
+
+          const std::shared_ptr<optimizer::Problem>& problem =
+              worker.mIK->getProblem();
+
+          std::lock_guard<std::mutex> lock(resultMutex);
+          if(FIRST_SOLUTION == policy)
+          {
+            if(!solved)
+            {
+              solved = true;
+              bestValue = problem->getOptimumValue();
+              bestSolution = problem->getOptimalSolution();
+            }
+
+            cancelled = true;
+          }
+          else if(!solved || problem->getOptimumValue() < bestValue)
+          {
+            solved = true;
+            bestValue = problem->getOptimumValue();
+            bestSolution = problem->getOptimalSolution();
+          }
+        }
+      }
+      catch(...)
+      {
+        // Stop the other workers before the exception reaches the caller
+        cancelled = true;
+        throw;
+      }
+    }));
+  }
+
+  // The workers refer to the local variables of this function, so every one
+  // of them must be finished before an exception is passed on to the caller
+  for(std::future<void>& result : results)
+    result.wait();
+
+  for(ParallelWorker& worker : mParallelWorkers)
+    worker.mIK->getSolver()->setStopFlag(nullptr);
+
+  for(std::future<void>& result : results)
+    result.get();
+
+  if(!solved)
+  {
+    positions = initialPositions;
+    return false;
+  }
+
+  mProblem->setOptimalSolution(bestSolution);
+  mProblem->setOptimumValue(bestValue);
+
+  if(_applySolution)
+    setPositions(bestSolution);
+
+  positions = bestSolution;
+  return true;
+}
+
+//==============================================================================
+void InverseKinematics::setParallelProperties(
+    const ParallelProperties& _properties)
+{
+  if(_properties.mNumThreads != mParallelProperties.mNumThreads)
+    clearParallelWorkers();
+
+  mParallelProperties = _properties;
+}
+
+//==============================================================================
+const InverseKinematics::ParallelProperties&
+InverseKinematics::getParallelProperties() const
+{
+  return mParallelProperties;
+}
+
+//==============================================================================
+void InverseKinematics::clearParallelWorkers()
+{
+  mParallelWorkers.clear();
+  mThreadPool.reset();
+}
+
 //==============================================================================
 InverseKinematicsPtr InverseKinematics::clone(JacobianNode* _newNode) const
 {
@@ -184,11 +399,35 @@ InverseKinematics::ErrorMethod::ErrorMethod(
   : mIK(_ik),
     mMethodName(_methodName),
     mLastError(Eigen::Vector6d::Constant(std::nan(""))),
+    mLastUnclampedError(Eigen::Vector6d::Constant(std::nan(""))),
     mProperties(_properties)
 {
   // Do nothing
 }
 
+//==============================================================================
+Eigen::Vector6d InverseKinematics::ErrorMethod::computeUnclampedError()
+{
+  return computeError();
+}
+
+//==============================================================================
+/// Returns true if the positions match the cached ones
+static bool isCachedPositions(const Eigen::VectorXd& _q,
+                              const Eigen::VectorXd& _lastPositions)
+{
+  if(_q.size() != _lastPositions.size())
+    return false;
+
+  for(int i=0; i<_lastPositions.size(); ++i)
+  {
+    if(_q[i] != _lastPositions[i])
+      return false;
+  }
+
+  return true;
+}
+
 //==============================================================================
 const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalError(
     const Eigen::VectorXd& _q)
@@ -211,21 +450,8 @@ const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalError(
     return mLastError;
   }
 
-  if(_q.size() == mLastPositions.size())
-  {
-    bool repeat = true;
-    for(int i=0; i<mLastPositions.size(); ++i)
-    {
-      if(_q[i] != mLastPositions[i])
-      {
-        repeat = false;
-        break;
-      }
-    }
-
-    if(repeat)
-      return mLastError;
-  }
+  if(isCachedPositions(_q, mLastPositions))
+    return mLastError;
 
   mIK->setPositions(_q);
   mLastPositions = _q;
@@ -234,6 +460,38 @@ const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalError(
   return mLastError;
 }
 
+//==============================================================================
+const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalUnclampedError(
+    const Eigen::VectorXd& _q)
+{
+  if(_q.size() != static_cast<int>(mIK->getDofs().size()))
+  {
+    dterr << "[InverseKinematics::ErrorMethod::evalUnclampedError] Mismatch "
+          << "between joint positions size [" << _q.size() << "] and the "
+          << "available degrees of freedom [" << mIK->getDofs().size() <<"]."
+          << "\nSkeleton name: " << mIK->getNode()->getSkeleton()->getName()
+          << "\nBody name: " << mIK->getNode()->getName()
+          << "\nMethod name: " << mMethodName << "\n";
+    mLastUnclampedError.setZero();
+    return mLastUnclampedError;
+  }
+
+  if(_q.size() == 0)
+  {
+    mLastUnclampedError.setZero();
+    return mLastUnclampedError;
+  }
+
+  if(isCachedPositions(_q, mLastUnclampedPositions))
+    return mLastUnclampedError;
+
+  mIK->setPositions(_q);
+  mLastUnclampedPositions = _q;
+
+  mLastUnclampedError = computeUnclampedError();
+  return mLastUnclampedError;
+}
+
 //==============================================================================
 const std::string& InverseKinematics::ErrorMethod::getMethodName() const
 {
@@ -375,6 +633,7 @@ void InverseKinematics::ErrorMethod::clearCache()
   // This will force the error to be recomputed the next time computeError is
   // called
   mLastPositions.resize(0);
+  mLastUnclampedPositions.resize(0);
 }
 
 //==============================================================================
@@ -398,6 +657,19 @@ InverseKinematics::TaskSpaceRegion::clone(InverseKinematics* _newIK) const
 
 //==============================================================================
 Eigen::Vector6d InverseKinematics::TaskSpaceRegion::computeError()
+{
+  Eigen::Vector6d error = computeUnclampedError();
+
+  // The clamp does not depend on the frame of the error, since the frame is
+  // only ever rotated
+  if(error.norm() > mProperties.mErrorLengthClamp)
+    error = error.normalized()*mProperties.mErrorLengthClamp;
+
+  return error;
+}
+
+//==============================================================================
+Eigen::Vector6d InverseKinematics::TaskSpaceRegion::computeUnclampedError()
 {
   // This is a slightly modified implementation of the Berenson et al Task Space
   // Region method found in "Task Space Regions: A Framework for
@@ -475,9 +747,6 @@ Eigen::Vector6d InverseKinematics::TaskSpaceRegion::computeError()
 
   error = error.cwiseProduct(mProperties.mErrorWeights);
 
-  if(error.norm() > mProperties.mErrorLengthClamp)
-    error = error.normalized()*mProperties.mErrorLengthClamp;
-
   if(!mIK->getTarget()->getParentFrame()->isWorld())
   {
     // Transform the error term into the world frame if it's not already
@@ -618,7 +887,10 @@ void InverseKinematics::GradientMethod::clearCache()
 InverseKinematics::JacobianDLS::JacobianDLS(
     InverseKinematics* _ik, double _clamp, double _damping)
   : GradientMethod(_ik, "JacobianDLS", _clamp),
-    mDamping(_damping)
+    mDamping(_damping),
+    mReuseFactorization(false),
+    mReuseTolerance(0.0),
+    mFactorizationValid(false)
 {
   // Do nothing
 }
@@ -627,8 +899,12 @@ InverseKinematics::JacobianDLS::JacobianDLS(
 std::unique_ptr<InverseKinematics::GradientMethod>
 InverseKinematics::JacobianDLS::clone(InverseKinematics* _newIK) const
 {
-  return std::unique_ptr<GradientMethod>(
+  std::unique_ptr<JacobianDLS> newMethod(
         new JacobianDLS(_newIK, mComponentWiseClamp, mDamping));
+  newMethod->setFactorizationReuse(mReuseFactorization);
+  newMethod->setFactorizationReuseTolerance(mReuseTolerance);
+
+  return std::unique_ptr<GradientMethod>(std::move(newMethod));
 }
 
 //==============================================================================
@@ -636,18 +912,30 @@ void InverseKinematics::JacobianDLS::computeGradient(
     const Eigen::Vector6d& _error,
     Eigen::VectorXd& _grad)
 {
-  const math::Jacobian& J = mIK->computeJacobian();
+  const math::Jacobian* J;
+  if(mReuseFactorization && isFactorizationReusable())
+  {
+    J = &mFactorizedJacobian;
+  }
+  else
+  {
+    J = &mIK->computeJacobian();
+    factorize(*J);
+  }
 
-  int rows = J.rows(), cols = J.cols();
-  if(rows <= cols)
+  // The damped least squares step is J^T*(J*J^T + d^2*I)^-1*e, or equivalently
+  // (J^T*J + d^2*I)^-1*J^T*e, whichever one has the smaller system to solve
+  if(J->rows() <= J->cols())
   {
-    _grad = J.transpose()*(pow(mDamping,2)*Eigen::MatrixXd::Identity(rows, rows)
-            + J*J.transpose() ).inverse() * _error;
+    mSolution = _error;
+    mFactorization.solveInPlace(mSolution);
+    _grad.noalias() = J->transpose()*mSolution;
   }
   else
   {
-    _grad = ( pow(mDamping,2)*Eigen::MatrixXd::Identity(cols, cols) +
-            J.transpose()*J).inverse() * J.transpose() * _error;
+    mSolution.noalias() = J->transpose()*_error;
+    mFactorization.solveInPlace(mSolution);
+    _grad = mSolution;
   }
 
   applyWeights(_grad);
@@ -658,6 +946,7 @@ void InverseKinematics::JacobianDLS::computeGradient(
 void InverseKinematics::JacobianDLS::setDampingCoefficient(double _damping)
 {
   mDamping = _damping;
+  clearFactorization();
 }
 
 //==============================================================================
@@ -666,6 +955,96 @@ double InverseKinematics::JacobianDLS::getDampingCoefficient() const
   return mDamping;
 }
 
+//==============================================================================
+void InverseKinematics::JacobianDLS::setFactorizationReuse(bool _reuse)
+{
+  mReuseFactorization = _reuse;
+  clearFactorization();
+}
+
+//==============================================================================
+bool InverseKinematics::JacobianDLS::getFactorizationReuse() const
+{
+  return mReuseFactorization;
+}
+
+//==============================================================================
+void InverseKinematics::JacobianDLS::setFactorizationReuseTolerance(
+    double _tolerance)
+{
+  mReuseTolerance = std::abs(_tolerance);
+}
+
+//==============================================================================
+double InverseKinematics::JacobianDLS::getFactorizationReuseTolerance() const
+{
+  return mReuseTolerance;
+}
+
+//==============================================================================
+void InverseKinematics::JacobianDLS::clearFactorization()
+{
+  mFactorizationValid = false;
+}
+
+//==============================================================================
+bool InverseKinematics::JacobianDLS::isFactorizationReusable() const
+{
+  if(!mFactorizationValid)
+    return false;
+
+  const std::vector<size_t>& dofs = mIK->getDofs();
+  if(static_cast<int>(dofs.size()) != mFactorizedPositions.size())
+    return false;
+
+  const ConstSkeletonPtr skel = mIK->getNode()->getSkeleton();
+  for(size_t i=0; i < dofs.size(); ++i)
+  {
+    if(std::abs(skel->getPosition(dofs[i]) - mFactorizedPositions[i])
+       > mReuseTolerance)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+void InverseKinematics::JacobianDLS::factorize(const math::Jacobian& _J)
+{
+  const double damping = mDamping*mDamping;
+
+  // Only the lower triangle of the damped system is used by the LDLT
+  if(_J.rows() <= _J.cols())
+  {
+    mDampedSystem.resize(_J.rows(), _J.rows());
+    mDampedSystem.setZero();
+    mDampedSystem.diagonal().setConstant(damping);
+    mDampedSystem.selfadjointView<Eigen::Lower>().rankUpdate(_J);
+  }
+  else
+  {
+    mDampedSystem.resize(_J.cols(), _J.cols());
+    mDampedSystem.setZero();
+    mDampedSystem.diagonal().setConstant(damping);
+    mDampedSystem.selfadjointView<Eigen::Lower>().rankUpdate(_J.transpose());
+  }
+
+  mFactorization.compute(mDampedSystem);
+
+  if(!mReuseFactorization)
+    return;
+
+  // Remember where this factorization was computed so that it can be reused
+  const std::vector<size_t>& dofs = mIK->getDofs();
+  const ConstSkeletonPtr skel = mIK->getNode()->getSkeleton();
+  mFactorizedPositions.resize(dofs.size());
+  for(size_t i=0; i < dofs.size(); ++i)
+    mFactorizedPositions[i] = skel->getPosition(dofs[i]);
+
+  mFactorizedJacobian = _J;
+  mFactorizationValid = true;
+}
+
 //==============================================================================
 InverseKinematics::JacobianTranspose::JacobianTranspose(
     InverseKinematics* _ik, double _clamp)
@@ -784,6 +1163,7 @@ void InverseKinematics::setObjective(
     const std::shared_ptr<optimizer::Function>& _objective)
 {
   mObjective = _objective;
+  ++mConfigurationVersion;
 }
 
 //==============================================================================
@@ -804,6 +1184,7 @@ void InverseKinematics::setNullSpaceObjective(
     const std::shared_ptr<optimizer::Function>& _nsObjective)
 {
   mNullSpaceObjective = _nsObjective;
+  ++mConfigurationVersion;
 }
 
 //==============================================================================
@@ -883,12 +1264,42 @@ void InverseKinematics::setSolver(
     const std::shared_ptr<optimizer::Solver>& _newSolver)
 {
   mSolver = _newSolver;
+  ++mConfigurationVersion;
   if(nullptr == mSolver)
     return;
 
   mSolver->setProblem(getProblem());
 }
 
+//==============================================================================
+static std::atomic<InverseKinematics::SolverType> sDefaultSolverType(
+    InverseKinematics::GRADIENT_DESCENT_SOLVER);
+
+//==============================================================================
+void InverseKinematics::setDefaultSolverType(SolverType _type)
+{
+  sDefaultSolverType = _type;
+}
+
+//==============================================================================
+InverseKinematics::SolverType InverseKinematics::getDefaultSolverType()
+{
+  return sDefaultSolverType;
+}
+
+//==============================================================================
+std::shared_ptr<optimizer::Solver> InverseKinematics::createSolver(
+    SolverType _type, const std::shared_ptr<optimizer::Problem>& _problem)
+{
+  if(LEVENBERG_MARQUARDT_SOLVER == _type)
+    return std::make_shared<optimizer::LevenbergMarquardtSolver>(_problem);
+
+  std::shared_ptr<optimizer::GradientDescentSolver> solver =
+      std::make_shared<optimizer::GradientDescentSolver>(_problem);
+  solver->setStepSize(1.0);
+  return solver;
+}
+
 //==============================================================================
 const std::shared_ptr<optimizer::Solver>& InverseKinematics::getSolver()
 {
@@ -978,10 +1389,7 @@ const JacobianNode* InverseKinematics::getAffiliation() const
 //==============================================================================
 const math::Jacobian& InverseKinematics::computeJacobian() const
 {
-  // TODO(MXG): Test whether we can safely use a const reference here instead of
-  // just a regular const
-  const math::Jacobian fullJacobian = hasOffset()?
-        getNode()->getWorldJacobian(mOffset) : getNode()->getWorldJacobian();
+  const math::Jacobian& fullJacobian = getNode()->getWorldJacobian();
 
   mJacobian.setZero(6, getDofs().size());
 
@@ -992,6 +1400,16 @@ const math::Jacobian& InverseKinematics::computeJacobian() const
       mJacobian.block<6,1>(0,j) = fullJacobian.block<6,1>(0,i);
   }
 
+  // This gives the same result as getWorldJacobian(mOffset), but it shifts the
+  // columns in place instead of creating a new Jacobian
+  if(hasOffset())
+  {
+    const Eigen::Vector3d offset =
+        getNode()->getWorldTransform().linear() * mOffset;
+    for(int j=0; j < mJacobian.cols(); ++j)
+      mJacobian.block<3,1>(3,j) += mJacobian.block<3,1>(0,j).cross(offset);
+  }
+
   return mJacobian;
 }
 
@@ -1134,13 +1552,66 @@ void InverseKinematics::Constraint::evalGradient(
   mIK->getGradientMethod().evalGradient(_x, _grad);
 }
 
+//==============================================================================
+size_t InverseKinematics::Constraint::getNumResiduals() const
+{
+  return 6;
+}
+
+//==============================================================================
+void InverseKinematics::Constraint::evalResidual(
+    const Eigen::VectorXd& _x, Eigen::VectorXd& _residual)
+{
+  if(nullptr == mIK)
+  {
+    dterr << "[InverseKinematics::Constraint::evalResidual] Attempting to use "
+          << "a Constraint function of an expired InverseKinematics module!\n";
+    assert(false);
+    _residual.setZero(6);
+    return;
+  }
+
+  _residual = mIK->getErrorMethod().evalUnclampedError(_x);
+}
+
+//==============================================================================
+void InverseKinematics::Constraint::evalJacobian(
+    const Eigen::VectorXd& _x, Eigen::MatrixXd& _jacobian)
+{
+  if(nullptr == mIK)
+  {
+    dterr << "[InverseKinematics::Constraint::evalJacobian] Attempting to use "
+          << "a Constraint function of an expired InverseKinematics module!\n";
+    assert(false);
+    _jacobian.setZero(6, _x.size());
+    return;
+  }
+
+  // The error vector is weighted component-wise, and the components that have
+  // no bounds at all never produce any error
+  ErrorMethod& method = mIK->getErrorMethod();
+  method.evalUnclampedError(_x);
+  const Eigen::Vector6d& weights = method.getErrorWeights();
+  const ErrorMethod::Bounds& bounds = method.getBounds();
+
+  _jacobian = mIK->computeJacobian();
+  for(size_t i=0; i < 6; ++i)
+  {
+    if(std::isinf(bounds.first[i]) && std::isinf(bounds.second[i]))
+      _jacobian.row(i).setZero();
+    else
+      _jacobian.row(i) *= weights[i];
+  }
+}
+
 //==============================================================================
 InverseKinematics::InverseKinematics(JacobianNode* _node)
   : mActive(true),
     mHierarchyLevel(0),
     mOffset(Eigen::Vector3d::Zero()),
     mHasOffset(false),
-    mNode(_node)
+    mNode(_node),
+    mConfigurationVersion(0)
 {
   initialize();
 }
@@ -1174,18 +1645,109 @@ void InverseKinematics::initialize()
   // By default, we use the linkage when performing IK
   useChain();
 
-  // Default to the native DART gradient descent solver
-  std::shared_ptr<optimizer::GradientDescentSolver> solver =
-      std::make_shared<optimizer::GradientDescentSolver>(mProblem);
-  solver->setStepSize(1.0);
-  mSolver = solver;
+  // Default to one of the native DART solvers
+  mSolver = createSolver(getDefaultSolverType(), mProblem);
+}
+
+//==============================================================================
+void InverseKinematics::prepareProblem()
+{
+  mProblem->setDimension(mDofs.size());
+
+  mProblem->setInitialGuess(getPositions());
+
+  const SkeletonPtr& skel = getNode()->getSkeleton();
+
+  Eigen::VectorXd bounds(mDofs.size());
+  for(size_t i=0; i < mDofs.size(); ++i)
+    bounds[i] = skel->getDof(mDofs[i])->getPositionLowerLimit();
+  mProblem->setLowerBounds(bounds);
+
+  for(size_t i=0; i < mDofs.size(); ++i)
+    bounds[i] = skel->getDof(mDofs[i])->getPositionUpperLimit();
+  mProblem->setUpperBounds(bounds);
+}
+
+//==============================================================================
+bool InverseKinematics::resetParallelWorkers()
+{
+  clearParallelWorkers();
+
+  const SkeletonPtr& skel = getNode()->getSkeleton();
+  const BodyNode* bn = dynamic_cast<const BodyNode*>(getNode());
+  const EndEffector* ee = dynamic_cast<const EndEffector*>(getNode());
+  if(nullptr == bn && nullptr == ee)
+  {
+    dterr << "[InverseKinematics::resetParallelWorkers] The node ["
+          << mNode->getName() << "] of this IK module is neither a BodyNode "
+          << "nor an EndEffector, so it cannot be located in a clone of its "
+          << "Skeleton.\n";
+    return false;
+  }
+
+  mThreadPool.reset(new common::ThreadPool(mParallelProperties.mNumThreads));
+
+  std::random_device rd;
+  mParallelWorkers.resize(mThreadPool->getNumThreads());
+  for(ParallelWorker& worker : mParallelWorkers)
+  {
+    worker.mSkeleton = skel->clone();
+
+    JacobianNode* node = nullptr;
+    if(bn)
+      node = worker.mSkeleton->getBodyNode(bn->getIndexInSkeleton());
+    else
+      node = worker.mSkeleton->getEndEffector(ee->getIndexInSkeleton());
+
+    worker.mIK = clone(node);
+
+    // The seeds are handed out to the workers by solveParallel()
+    worker.mIK->getProblem()->clearAllSeeds();
+
+    worker.mRNG.seed(rd());
+
+    configureParallelWorker(worker);
+  }
+
+  return true;
+}
+
+//==============================================================================
+void InverseKinematics::configureParallelWorker(ParallelWorker& _worker)
+{
+  const InverseKinematicsPtr& ik = _worker.mIK;
+  ik->mErrorMethod = mErrorMethod->clone(ik.get());
+  ik->mGradientMethod = mGradientMethod->clone(ik.get());
+  ik->setObjective(cloneIkFunc(mObjective, ik.get()));
+  ik->setNullSpaceObjective(cloneIkFunc(mNullSpaceObjective, ik.get()));
+
+  const std::shared_ptr<optimizer::Solver> solver = mSolver->clone();
+  optimizer::Solver::Properties solverProperties =
+      solver->getSolverProperties();
+  solverProperties.mProblem = ik->getProblem();
+  // Progress printouts from concurrent workers would be interleaved
+  solverProperties.mIterationsPerPrint = 0;
+  solverProperties.mPrintFinalResult = false;
+  solverProperties.mResultFile = "";
+  solver->setProperties(solverProperties);
+
+  // The seeds are handed out to the workers by solveParallel(), so each
+  // worker should only make a single attempt per solve
+  std::shared_ptr<optimizer::GradientDescentSolver> gradientSolver =
+      std::dynamic_pointer_cast<optimizer::GradientDescentSolver>(solver);
+  if(gradientSolver)
+    gradientSolver->setMaxAttempts(1);
+
+  ik->setSolver(solver);
+
+  _worker.mConfigurationVersion = mConfigurationVersion;
 }
 
 //==============================================================================
 void InverseKinematics::resetTargetConnection()
 {
   mTargetConnection.disconnect();
-  mTargetConnection = mTarget->onTransformUpdated.connect(
+  mTargetConnection = mTarget->onTransformInvalidated.connect(
         [=](const Entity*)
         { this->clearCaches(); } );
   clearCaches();
@@ -1195,7 +1757,7 @@ void InverseKinematics::resetTargetConnection()
 void InverseKinematics::resetNodeConnection()
 {
   mNodeConnection.disconnect();
-  mNodeConnection = mNode->onTransformUpdated.connect(
+  mNodeConnection = mNode->onTransformInvalidated.connect(
         [=](const Entity*)
         { this->clearCaches(); } );
   clearCaches();
@@ -38,12 +38,15 @@
 #define DART_DYNAMICS_INVERSEKINEMATICS_H_
 
 #include <memory>
+#include <random>
 
+#include <Eigen/Cholesky>
 #include <Eigen/SVD>
 
 #include "dart/common/sub_ptr.h"
 #include "dart/common/Signal.h"
 #include "dart/common/Subject.h"
+#include "dart/common/ThreadPool.h"
 #include "dart/math/Geometry.h"
 #include "dart/optimizer/Solver.h"
 #include "dart/optimizer/GradientDescentSolver.h"
@@ -100,6 +103,77 @@ public:
   /// solved positions.
   bool solve(Eigen::VectorXd& positions, bool _applySolution = true);
 
+  /// The ParallelPolicy decides which solution solveParallel() will return
+  enum ParallelPolicy
+  {
+    /// Use the first attempt that converges and cancel the remaining attempts
+    FIRST_SOLUTION = 0,
+
+    /// Run every attempt and use the converged solution that has the lowest
+    /// objective value
+    BEST_SOLUTION
+  };
+
+  struct ParallelProperties
+  {
+    /// Number of worker threads that solveParallel() will use. Use 0 for the
+    /// number of hardware threads reported by the system.
+    size_t mNumThreads;
+
+    /// Total number of starting configurations that solveParallel() will try.
+    /// The first attempt starts from the current joint positions, the next
+    /// attempts start from the seeds of the Problem, and any remaining attempts
+    /// start from randomized configurations.
+    size_t mNumAttempts;
+
+    /// Which solution to return when more than one attempt converges
+    ParallelPolicy mPolicy;
+
+    ParallelProperties(size_t _numThreads = 0,
+                       size_t _numAttempts = 16,
+                       ParallelPolicy _policy = FIRST_SOLUTION);
+  };
+
+  /// Solve the IK Problem by running several attempts from different starting
+  /// configurations at the same time. Each worker thread operates on its own
+  /// clone of the Skeleton and of this IK module, so the Skeleton of this
+  /// module is only touched once the attempts are finished. The clones are
+  /// created by the first call and then reused. Every call brings their DOFs,
+  /// offset, target, and joint positions up to date with this module. Their
+  /// ErrorMethod, GradientMethod, objectives, and Solver are only cloned again
+  /// after one of them has been replaced through its setter, so call
+  /// clearParallelWorkers() after reconfiguring any of them in place or after
+  /// changing the constraints of the Problem of this module.
+  ///
+  /// With the FIRST_SOLUTION policy, the first attempt that converges stops
+  /// the attempts that are still running through Solver::setStopFlag(). If an
+  /// attempt throws, the other attempts are stopped and waited for before the
+  /// exception is passed on.
+  ///
+  /// Any optimizer::Function in the Problem that does not inherit
+  /// InverseKinematics::Function is shared by all the workers, so it must be
+  /// safe to evaluate concurrently.
+  ///
+  /// Returns true if any of the attempts converged. If no attempt converges,
+  /// the joint positions of the Skeleton are left unchanged.
+  bool solveParallel(bool _applySolution = true);
+
+  /// Same as solveParallel(bool), but the positions vector will be filled with
+  /// the solved positions. If no attempt converges, it will be filled with the
+  /// original positions.
+  bool solveParallel(Eigen::VectorXd& positions, bool _applySolution = true);
+
+  /// Set the ParallelProperties that will be used by solveParallel()
+  void setParallelProperties(const ParallelProperties& _properties);
+
+  /// Get the ParallelProperties that will be used by solveParallel()
+  const ParallelProperties& getParallelProperties() const;
+
+  /// Discard the worker threads and the Skeleton clones that are used by
+  /// solveParallel(). They will be recreated the next time solveParallel() is
+  /// called.
+  void clearParallelWorkers();
+
   /// Clone this IK module, but targeted at a new Node. Any Functions in the
   /// Problem that inherit InverseKinematics::Function will be adapted to the
   /// new IK module. Any generic optimizer::Function will just be copied over
@@ -190,9 +264,20 @@ public:
     /// an update is needed.
     virtual Eigen::Vector6d computeError() = 0;
 
+    /// Override this function if computeError() limits the length of the
+    /// error vector, and return the error vector without that limit. Solvers
+    /// that control their own step sizes, such as
+    /// optimizer::LevenbergMarquardtSolver, need the true error. By default,
+    /// this returns computeError().
+    virtual Eigen::Vector6d computeUnclampedError();
+
     /// This function is used to handle caching the error vector.
     const Eigen::Vector6d& evalError(const Eigen::VectorXd& _q);
 
+    /// This function is used to handle caching the error vector of
+    /// computeUnclampedError().
+    const Eigen::Vector6d& evalUnclampedError(const Eigen::VectorXd& _q);
+
     /// Get the name of this ErrorMethod.
     const std::string& getMethodName() const;
 
@@ -291,6 +376,12 @@ public:
     /// The last error vector computed by this ErrorMethod
     Eigen::Vector6d mLastError;
 
+    /// The last joint positions passed into evalUnclampedError()
+    Eigen::VectorXd mLastUnclampedPositions;
+
+    /// The last error vector computed by computeUnclampedError()
+    Eigen::Vector6d mLastUnclampedError;
+
     /// The properties of this ErrorMethod
     Properties mProperties;
 
@@ -320,6 +411,9 @@ public:
     // Documentation inherited
     Eigen::Vector6d computeError() override;
 
+    // Documentation inherited
+    Eigen::Vector6d computeUnclampedError() override;
+
     /// Setting this to true (which is default) will tell it to compute the
     /// error based on the center of the Task Space Region instead of the edge
     /// of the Task Space Region. This often results in faster convergence, as
@@ -461,10 +555,73 @@ public:
     /// Get the damping coefficient.
     double getDampingCoefficient() const;
 
+    /// Allow the Jacobian and the factorization of its damped system to be
+    /// reused by later gradient computations, as long as none of the joint
+    /// positions have moved by more than getFactorizationReuseTolerance()
+    /// since the factorization was computed. This is disabled by default.
+    void setFactorizationReuse(bool _reuse);
+
+    /// Returns true if the factorization may be reused between gradient
+    /// computations.
+    bool getFactorizationReuse() const;
+
+    /// Set how far any joint position may move before the factorization must
+    /// be recomputed. With a tolerance of zero, the factorization is only
+    /// reused for identical joint positions. A small positive tolerance lets
+    /// the short steps of a line search share one factorization, but the
+    /// gradients computed from it will only be approximate.
+    void setFactorizationReuseTolerance(double _tolerance);
+
+    /// Get the tolerance for reusing the factorization.
+    double getFactorizationReuseTolerance() const;
+
+    /// Force the next gradient computation to recompute the Jacobian and its
+    /// factorization. Call this after changing the DOFs or the offset of the
+    /// IK module while factorization reuse is enabled.
+    void clearFactorization();
+
   protected:
 
+    /// Returns true if the stored factorization may be used for the current
+    /// joint positions.
+    bool isFactorizationReusable() const;
+
+    /// Compute the damped system of _J and factorize it
+    void factorize(const math::Jacobian& _J);
+
     /// Damping coefficient
     double mDamping;
+
+    /// True if the factorization may be reused between gradient computations
+    bool mReuseFactorization;
+
+    /// Largest change in any joint position that allows the factorization to
+    /// be reused
+    double mReuseTolerance;
+
+    /// True if mFactorizedJacobian and mFactorization hold a valid
+    /// factorization that may be reused
+    bool mFactorizationValid;
+
+    /// Joint positions that the stored factorization was computed for
+    Eigen::VectorXd mFactorizedPositions;
+
+    /// Jacobian that the stored factorization was computed for
+    math::Jacobian mFactorizedJacobian;
+
+    /// Workspace for the damped system, either J*J^T or J^T*J with the damping
+    /// added to its diagonal. Only the lower triangle is filled in.
+    Eigen::MatrixXd mDampedSystem;
+
+    /// Factorization of mDampedSystem
+    Eigen::LDLT<Eigen::MatrixXd> mFactorization;
+
+    /// Workspace for the solution of the damped system
+    Eigen::VectorXd mSolution;
+
+  public:
+    // To get byte-aligned Eigen vectors
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   };
 
   /// JacobianTranspose will simply apply the transpose of the Jacobian to the
@@ -628,6 +785,28 @@ public:
   /// Get the Solver that is being used by this IK module.
   std::shared_ptr<const optimizer::Solver> getSolver() const;
 
+  /// The kinds of Solver that new IK modules can be created with
+  enum SolverType
+  {
+    /// optimizer::GradientDescentSolver with a step size of 1
+    GRADIENT_DESCENT_SOLVER = 0,
+
+    /// optimizer::LevenbergMarquardtSolver
+    LEVENBERG_MARQUARDT_SOLVER
+  };
+
+  /// Set the kind of Solver that InverseKinematics modules will be created
+  /// with from now on. Modules that already exist keep their Solver. The
+  /// default is GRADIENT_DESCENT_SOLVER.
+  static void setDefaultSolverType(SolverType _type);
+
+  /// Get the kind of Solver that new InverseKinematics modules are created with
+  static SolverType getDefaultSolverType();
+
+  /// Create a Solver of the given kind for _problem
+  static std::shared_ptr<optimizer::Solver> createSolver(
+      SolverType _type, const std::shared_ptr<optimizer::Problem>& _problem);
+
   /// Inverse kinematics can be performed on any point within the body frame.
   /// The default point is the origin of the body frame. Use this function to
   /// change the point that will be used. _offset must represent the offset of
@@ -751,7 +930,13 @@ protected:
   /// instantiated by a user. Call InverseKinematics::resetProblem() to set the
   /// first equality constraint of the module's Problem to an
   /// InverseKinematics::Constraint.
-  class Constraint final : public Function, public optimizer::Function
+  ///
+  /// The Constraint also exposes the error vector as a residual so that a
+  /// least-squares Solver such as optimizer::LevenbergMarquardtSolver can use
+  /// the Jacobian of the IK module directly. Its value for any other Solver
+  /// remains the norm of the error vector.
+  class Constraint final : public Function,
+                           public optimizer::LeastSquaresFunction
   {
   public:
 
@@ -771,6 +956,17 @@ protected:
     void evalGradient(const Eigen::VectorXd& _x,
                       Eigen::Map<Eigen::VectorXd> _grad) override;
 
+    // Documentation inherited
+    size_t getNumResiduals() const override;
+
+    // Documentation inherited
+    void evalResidual(const Eigen::VectorXd& _x,
+                      Eigen::VectorXd& _residual) override;
+
+    // Documentation inherited
+    void evalJacobian(const Eigen::VectorXd& _x,
+                      Eigen::MatrixXd& _jacobian) override;
+
   protected:
 
     /// Pointer to this Constraint's IK module
@@ -782,9 +978,37 @@ protected:
   /// Constructor that accepts a JacobianNode
   InverseKinematics(JacobianNode* _node);
 
+  /// The state that a worker thread of solveParallel() operates on
+  struct ParallelWorker
+  {
+    /// Clone of the Skeleton that this IK module belongs to
+    SkeletonPtr mSkeleton;
+
+    /// Clone of this IK module, targeted at mSkeleton
+    InverseKinematicsPtr mIK;
+
+    /// Random number generator used for randomized starting configurations
+    std::mt19937 mRNG;
+
+    /// The mConfigurationVersion of this module that mIK was last configured
+    /// for
+    size_t mConfigurationVersion;
+  };
+
   /// Gets called during construction
   void initialize();
 
+  /// Update the dimension, initial guess, and bounds of the Problem based on
+  /// the current state of the Skeleton
+  void prepareProblem();
+
+  /// Create the thread pool and the Skeleton clones for solveParallel()
+  bool resetParallelWorkers();
+
+  /// Give a worker of solveParallel() clones of the ErrorMethod,
+  /// GradientMethod, objectives, and Solver of this module
+  void configureParallelWorker(ParallelWorker& _worker);
+
   /// Reset the signal connection for this IK module's target
   void resetTargetConnection();
 
@@ -842,6 +1066,20 @@ protected:
 
   /// Jacobian cache for the IK module
   mutable math::Jacobian mJacobian;
+
+  /// Incremented whenever the ErrorMethod, GradientMethod, objectives, or
+  /// Solver are replaced, so that solveParallel() knows when its workers need
+  /// new clones of them
+  size_t mConfigurationVersion;
+
+  /// Properties for solveParallel()
+  ParallelProperties mParallelProperties;
+
+  /// Workers for solveParallel()
+  std::vector<ParallelWorker> mParallelWorkers;
+
+  /// Threads that run the workers of solveParallel()
+  std::unique_ptr<common::ThreadPool> mThreadPool;
 };
 
 #include "dart/dynamics/detail/InverseKinematics.h"
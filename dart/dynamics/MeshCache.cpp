@@ -0,0 +1,740 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/MeshCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <assimp/scene.h>
+
+#include "dart/common/Console.h"
+#include "dart/common/detail/BinaryIO.h"
+#include "dart/common/Uri.h"
+#include "dart/dynamics/MeshShape.h"
+
+namespace dart {
+namespace dynamics {
+
+using common::detail::BinaryReader;
+using common::detail::BinaryWriter;
+
+namespace {
+
+/// Identifies a compiled mesh file
+const char COMPILED_MESH_MAGIC[8] = {'D', 'A', 'R', 'T', 'M', 'S', 'H', '\0'};
+
+/// Version of the compiled mesh format
+const uint32_t COMPILED_MESH_VERSION = 1;
+
+/// File extension of the compiled meshes
+const char* const COMPILED_MESH_EXTENSION = ".dartmesh";
+
+/// Flags of the optional per-mesh arrays
+const uint32_t MESH_HAS_NORMALS = 1u << 0;
+const uint32_t MESH_HAS_COLORS = 1u << 1; // Followed by one bit per color set
+
+/// Flags of the optional material properties
+const uint32_t MATERIAL_HAS_DIFFUSE = 1u << 0;
+const uint32_t MATERIAL_HAS_SPECULAR = 1u << 1;
+const uint32_t MATERIAL_HAS_AMBIENT = 1u << 2;
+const uint32_t MATERIAL_HAS_EMISSIVE = 1u << 3;
+const uint32_t MATERIAL_HAS_SHININESS = 1u << 4;
+const uint32_t MATERIAL_HAS_SHININESS_STRENGTH = 1u << 5;
+const uint32_t MATERIAL_HAS_WIREFRAME = 1u << 6;
+const uint32_t MATERIAL_HAS_TWOSIDED = 1u << 7;
+
+//==============================================================================
+void writeMaterial(BinaryWriter& _writer, const aiMaterial* _material)
+{
+  uint32_t flags = 0;
+  aiColor4D diffuse, specular, ambient, emissive;
+  float shininess = 0.0f;
+  float strength = 0.0f;
+  int wireframe = 0;
+  int twoSided = 0;
+  unsigned int max = 1;
+
+  if(AI_SUCCESS == aiGetMaterialColor(_material, AI_MATKEY_COLOR_DIFFUSE,
+                                      &diffuse))
+    flags |= MATERIAL_HAS_DIFFUSE;
+
+  if(AI_SUCCESS == aiGetMaterialColor(_material, AI_MATKEY_COLOR_SPECULAR,
+                                      &specular))
+    flags |= MATERIAL_HAS_SPECULAR;
+
+  if(AI_SUCCESS == aiGetMaterialColor(_material, AI_MATKEY_COLOR_AMBIENT,
+                                      &ambient))
+    flags |= MATERIAL_HAS_AMBIENT;
+
+  if(AI_SUCCESS == aiGetMaterialColor(_material, AI_MATKEY_COLOR_EMISSIVE,
+                                      &emissive))
+    flags |= MATERIAL_HAS_EMISSIVE;
+
+  max = 1;
+  if(AI_SUCCESS == aiGetMaterialFloatArray(_material, AI_MATKEY_SHININESS,
+                                           &shininess, &max))
+    flags |= MATERIAL_HAS_SHININESS;
+
+  max = 1;
+  if(AI_SUCCESS == aiGetMaterialFloatArray(
+       _material, AI_MATKEY_SHININESS_STRENGTH, &strength, &max))
+    flags |= MATERIAL_HAS_SHININESS_STRENGTH;
+
+  max = 1;
+  if(AI_SUCCESS == aiGetMaterialIntegerArray(
+       _material, AI_MATKEY_ENABLE_WIREFRAME, &wireframe, &max))
+    flags |= MATERIAL_HAS_WIREFRAME;
+
+  max = 1;
+  if(AI_SUCCESS == aiGetMaterialIntegerArray(_material, AI_MATKEY_TWOSIDED,
+                                             &twoSided, &max))
+    flags |= MATERIAL_HAS_TWOSIDED;
+
+  _writer.write(flags);
+  _writer.write(diffuse);
+  _writer.write(specular);
+  _writer.write(ambient);
+  _writer.write(emissive);
+  _writer.write(shininess);
+  _writer.write(strength);
+  _writer.write(static_cast<int32_t>(wireframe));
+  _writer.write(static_cast<int32_t>(twoSided));
+}
+
+//==============================================================================
+aiMaterial* readMaterial(BinaryReader& _reader)
+{
+  uint32_t flags;
+  aiColor4D diffuse, specular, ambient, emissive;
+  float shininess;
+  float strength;
+  int32_t wireframe;
+  int32_t twoSided;
+
+  if(!_reader.read(flags) || !_reader.read(diffuse) || !_reader.read(specular)
+     || !_reader.read(ambient) || !_reader.read(emissive)
+     || !_reader.read(shininess) || !_reader.read(strength)
+     || !_reader.read(wireframe) || !_reader.read(twoSided))
+    return nullptr;
+
+  aiMaterial* material = new aiMaterial;
+
+  if(flags & MATERIAL_HAS_DIFFUSE)
+    material->AddProperty(&diffuse, 1, AI_MATKEY_COLOR_DIFFUSE);
+
+  if(flags & MATERIAL_HAS_SPECULAR)
+    material->AddProperty(&specular, 1, AI_MATKEY_COLOR_SPECULAR);
+
+  if(flags & MATERIAL_HAS_AMBIENT)
+    material->AddProperty(&ambient, 1, AI_MATKEY_COLOR_AMBIENT);
+
+  if(flags & MATERIAL_HAS_EMISSIVE)
+    material->AddProperty(&emissive, 1, AI_MATKEY_COLOR_EMISSIVE);
+
+  if(flags & MATERIAL_HAS_SHININESS)
+    material->AddProperty(&shininess, 1, AI_MATKEY_SHININESS);
+
+  if(flags & MATERIAL_HAS_SHININESS_STRENGTH)
+    material->AddProperty(&strength, 1, AI_MATKEY_SHININESS_STRENGTH);
+
+  int value;
+  if(flags & MATERIAL_HAS_WIREFRAME)
+  {
+    value = wireframe;
+    material->AddProperty(&value, 1, AI_MATKEY_ENABLE_WIREFRAME);
+  }
+
+  if(flags & MATERIAL_HAS_TWOSIDED)
+  {
+    value = twoSided;
+    material->AddProperty(&value, 1, AI_MATKEY_TWOSIDED);
+  }
+
+  return material;
+}
+
+//==============================================================================
+bool writeMesh(BinaryWriter& _writer, const aiMesh* _mesh)
+{
+  for(size_t i=0; i<_mesh->mNumFaces; ++i)
+  {
+    if(_mesh->mFaces[i].mNumIndices != 3)
+      return false;
+  }
+
+  uint32_t flags = 0;
+  if(_mesh->mNormals)
+    flags |= MESH_HAS_NORMALS;
+
+  for(size_t i=0; i<AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+  {
+    if(_mesh->mColors[i])
+      flags |= MESH_HAS_COLORS << i;
+  }
+
+  _writer.write(static_cast<uint32_t>(_mesh->mMaterialIndex));
+  _writer.write(static_cast<uint32_t>(_mesh->mNumVertices));
+  _writer.write(static_cast<uint32_t>(_mesh->mNumFaces));
+  _writer.write(flags);
+
+  _writer.write(_mesh->mVertices, _mesh->mNumVertices * sizeof(aiVector3D));
+
+  if(_mesh->mNormals)
+    _writer.write(_mesh->mNormals, _mesh->mNumVertices * sizeof(aiVector3D));
+
+  for(size_t i=0; i<AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+  {
+    if(_mesh->mColors[i])
+      _writer.write(_mesh->mColors[i], _mesh->mNumVertices * sizeof(aiColor4D));
+  }
+
+  for(size_t i=0; i<_mesh->mNumFaces; ++i)
+    _writer.write(_mesh->mFaces[i].mIndices, 3 * sizeof(unsigned int));
+
+  return true;
+}
+
+//==============================================================================
+aiMesh* readMesh(BinaryReader& _reader)
+{
+  uint32_t materialIndex, numVertices, numFaces, flags;
+  if(!_reader.read(materialIndex) || !_reader.read(numVertices)
+     || !_reader.read(numFaces) || !_reader.read(flags))
+    return nullptr;
+
+  if(!_reader.canRead(numVertices, sizeof(aiVector3D))
+     || !_reader.canRead(numFaces, 3 * sizeof(unsigned int)))
+    return nullptr;
+
+  aiMesh* mesh = new aiMesh;
+  mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+  mesh->mMaterialIndex = materialIndex;
+  mesh->mNumVertices = numVertices;
+  mesh->mVertices = new aiVector3D[numVertices];
+  bool good = _reader.read(mesh->mVertices, numVertices * sizeof(aiVector3D));
+
+  if(good && (flags & MESH_HAS_NORMALS))
+  {
+    mesh->mNormals = new aiVector3D[numVertices];
+    good = _reader.read(mesh->mNormals, numVertices * sizeof(aiVector3D));
+  }
+
+  for(size_t i=0; good && i<AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+  {
+    if(flags & (MESH_HAS_COLORS << i))
+    {
+      mesh->mColors[i] = new aiColor4D[numVertices];
+      good = _reader.read(mesh->mColors[i], numVertices * sizeof(aiColor4D));
+    }
+  }
+
+  if(good)
+  {
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    for(size_t i=0; good && i<numFaces; ++i)
+    {
+      aiFace& face = mesh->mFaces[i];
+      face.mNumIndices = 3;
+      face.mIndices = new unsigned int[3];
+      good = _reader.read(face.mIndices, 3 * sizeof(unsigned int));
+
+      for(size_t j=0; good && j<3; ++j)
+        good = face.mIndices[j] < numVertices;
+    }
+  }
+
+  if(!good)
+  {
+    delete mesh;
+    return nullptr;
+  }
+
+  return mesh;
+}
+
+//==============================================================================
+void writeNode(BinaryWriter& _writer, const aiNode* _node)
+{
+  _writer.write(_node->mTransformation);
+  _writer.write(static_cast<uint32_t>(_node->mNumMeshes));
+  for(size_t i=0; i<_node->mNumMeshes; ++i)
+    _writer.write(static_cast<uint32_t>(_node->mMeshes[i]));
+
+  _writer.write(static_cast<uint32_t>(_node->mNumChildren));
+  for(size_t i=0; i<_node->mNumChildren; ++i)
+    writeNode(_writer, _node->mChildren[i]);
+}
+
+//==============================================================================
+aiNode* readNode(BinaryReader& _reader, size_t _numMeshes)
+{
+  aiNode* node = new aiNode;
+
+  uint32_t numMeshes;
+  if(!_reader.read(node->mTransformation) || !_reader.read(numMeshes)
+     || !_reader.canRead(numMeshes, sizeof(uint32_t)))
+  {
+    delete node;
+    return nullptr;
+  }
+
+  node->mNumMeshes = numMeshes;
+  node->mMeshes = new unsigned int[numMeshes];
+  for(size_t i=0; i<numMeshes; ++i)
+  {
+    uint32_t index;
+    if(!_reader.read(index) || index >= _numMeshes)
+    {
+      delete node;
+      return nullptr;
+    }
+    node->mMeshes[i] = index;
+  }
+
+  uint32_t numChildren;
+  if(!_reader.read(numChildren) || !_reader.canRead(numChildren, 1))
+  {
+    delete node;
+    return nullptr;
+  }
+
+  node->mChildren = new aiNode*[numChildren];
+  for(size_t i=0; i<numChildren; ++i)
+  {
+    aiNode* child = readNode(_reader, _numMeshes);
+    if(!child)
+    {
+      delete node;
+      return nullptr;
+    }
+
+    child->mParent = node;
+    node->mChildren[i] = child;
+    node->mNumChildren = i + 1;
+  }
+
+  return node;
+}
+
+//==============================================================================
+aiScene* readScene(BinaryReader& _reader, uint64_t* _sourceHash)
+{
+  char magic[sizeof(COMPILED_MESH_MAGIC)];
+  uint32_t version;
+  uint64_t sourceHash;
+  uint32_t numMeshes, numMaterials;
+
+  if(!_reader.read(magic, sizeof(magic))
+     || std::memcmp(magic, COMPILED_MESH_MAGIC, sizeof(magic)) != 0
+     || !_reader.read(version) || version != COMPILED_MESH_VERSION
+     || !_reader.read(sourceHash) || !_reader.read(numMeshes)
+     || !_reader.read(numMaterials)
+     || !_reader.canRead(numMeshes, 4 * sizeof(uint32_t))
+     || !_reader.canRead(numMaterials, sizeof(uint32_t)))
+    return nullptr;
+
+  aiScene* scene = new aiScene;
+
+  scene->mMaterials = new aiMaterial*[numMaterials];
+  for(size_t i=0; i<numMaterials; ++i)
+  {
+    aiMaterial* material = readMaterial(_reader);
+    if(!material)
+    {
+      delete scene;
+      return nullptr;
+    }
+
+    scene->mMaterials[i] = material;
+    scene->mNumMaterials = i + 1;
+  }
+
+  scene->mMeshes = new aiMesh*[numMeshes];
+  for(size_t i=0; i<numMeshes; ++i)
+  {
+    aiMesh* mesh = readMesh(_reader);
+    if(!mesh || (mesh->mMaterialIndex >= numMaterials
+                 && mesh->mMaterialIndex != static_cast<unsigned int>(-1)))
+    {
+      delete mesh;
+      delete scene;
+      return nullptr;
+    }
+
+    scene->mMeshes[i] = mesh;
+    scene->mNumMeshes = i + 1;
+  }
+
+  scene->mRootNode = readNode(_reader, numMeshes);
+  if(!scene->mRootNode)
+  {
+    delete scene;
+    return nullptr;
+  }
+
+  if(_sourceHash)
+    *_sourceHash = sourceHash;
+
+  return scene;
+}
+
+//==============================================================================
+/// Compute the hash of the content of the resource at _uri. Resources that
+/// provide direct access to their content are hashed without copying it.
+/// Returns false if the resource cannot be read or is empty.
+bool hashResource(const std::string& _uri,
+                  const common::ResourceRetrieverPtr& _retriever,
+                  uint64_t& _hash)
+{
+  if(!_retriever)
+    return false;
+
+  const common::ResourcePtr resource = _retriever->retrieve(_uri);
+  if(!resource)
+    return false;
+
+  const size_t size = resource->getSize();
+  if(size == 0u)
+    return false;
+
+  if(const char* data = resource->getData())
+  {
+    _hash = MeshCache::computeHash(data, size);
+    return true;
+  }
+
+  std::string buffer(size, '\0');
+  if(resource->read(&buffer[0], buffer.size(), 1) != 1)
+    return false;
+
+  _hash = MeshCache::computeHash(buffer.data(), buffer.size());
+  return true;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+size_t MeshCache::KeyHash::operator()(const Key& _key) const
+{
+  return std::hash<std::string>()(_key.first)
+      ^ (std::hash<const common::ResourceRetriever*>()(_key.second) << 1);
+}
+
+//==============================================================================
+MeshCache& MeshCache::getInstance()
+{
+  static MeshCache instance;
+  return instance;
+}
+
+//==============================================================================
+const aiScene* MeshCache::acquire(
+    const std::string& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  const Key key(_uri, _retriever.get());
+  std::promise<const aiScene*> promise;
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    const auto it = mEntries.find(key);
+    if(it != mEntries.end())
+    {
+      ++it->second.mUseCount;
+      return it->second.mScene;
+    }
+
+    const auto loading = mLoading.find(key);
+    if(loading != mLoading.end())
+    {
+      // Another thread is already loading this mesh. It adds our reference
+      // once it is done.
+      ++loading->second.mNumWaiters;
+      const std::shared_future<const aiScene*> future
+          = loading->second.mFuture;
+      lock.unlock();
+      return future.get();
+    }
+
+    mLoading[key] = Loading{promise.get_future().share(), 0u};
+  }
+
+  // Import without holding the lock, so other meshes can be loaded in the
+  // meantime
+  const aiScene* scene = load(_uri, _retriever);
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto loading = mLoading.find(key);
+    if(scene)
+    {
+      mEntries[key] = Entry{scene, 1u + loading->second.mNumWaiters,
+                            _retriever};
+      mKeys[scene] = key;
+    }
+    mLoading.erase(loading);
+  }
+
+  promise.set_value(scene);
+  return scene;
+}
+
+//==============================================================================
+std::shared_future<const aiScene*> MeshCache::acquireAsync(
+    const std::string& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  common::ThreadPool* threadPool;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto it = mEntries.find(Key(_uri, _retriever.get()));
+    if(it != mEntries.end())
+    {
+      ++it->second.mUseCount;
+      std::promise<const aiScene*> promise;
+      promise.set_value(it->second.mScene);
+      return promise.get_future().share();
+    }
+
+    if(!mThreadPool)
+      mThreadPool.reset(new common::ThreadPool);
+    threadPool = mThreadPool.get();
+  }
+
+  return threadPool->submit([this, _uri, _retriever]()
+  {
+    return acquire(_uri, _retriever);
+  }).share();
+}
+
+//==============================================================================
+bool MeshCache::release(const aiScene* _scene)
+{
+  if(!_scene)
+    return false;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto it = mKeys.find(_scene);
+    if(it == mKeys.end())
+      return false;
+
+    Entry& entry = mEntries[it->second];
+    if(--entry.mUseCount > 0)
+      return true;
+
+    mEntries.erase(it->second);
+    mKeys.erase(it);
+  }
+
+  delete _scene;
+  return true;
+}
+
+//==============================================================================
+size_t MeshCache::getUseCount(
+    const std::string& _uri,
+    const common::ResourceRetrieverPtr& _retriever) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  const auto it = mEntries.find(Key(_uri, _retriever.get()));
+  if(it == mEntries.end())
+    return 0u;
+
+  return it->second.mUseCount;
+}
+
+//==============================================================================
+size_t MeshCache::getNumMeshes() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+
+//==============================================================================
+void MeshCache::setCompiledMeshDirectory(const std::string& _directory)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mCompiledMeshDirectory = _directory;
+}
+
+//==============================================================================
+std::string MeshCache::getCompiledMeshDirectory() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCompiledMeshDirectory;
+}
+
+//==============================================================================
+void MeshCache::setLoadingMode(LoadingMode _mode)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mLoadingMode = _mode;
+}
+
+//==============================================================================
+MeshCache::LoadingMode MeshCache::getLoadingMode() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mLoadingMode;
+}
+
+//==============================================================================
+bool MeshCache::writeCompiledMesh(const aiScene* _scene,
+                                  const std::string& _path,
+                                  uint64_t _sourceHash)
+{
+  if(!_scene || !_scene->mRootNode)
+    return false;
+
+  BinaryWriter writer;
+  writer.write(COMPILED_MESH_MAGIC, sizeof(COMPILED_MESH_MAGIC));
+  writer.write(COMPILED_MESH_VERSION);
+  writer.write(_sourceHash);
+  writer.write(static_cast<uint32_t>(_scene->mNumMeshes));
+  writer.write(static_cast<uint32_t>(_scene->mNumMaterials));
+
+  for(size_t i=0; i<_scene->mNumMaterials; ++i)
+    writeMaterial(writer, _scene->mMaterials[i]);
+
+  for(size_t i=0; i<_scene->mNumMeshes; ++i)
+  {
+    if(!writeMesh(writer, _scene->mMeshes[i]))
+      return false;
+  }
+
+  writeNode(writer, _scene->mRootNode);
+
+  return writer.saveToFile(_path);
+}
+
+//==============================================================================
+aiScene* MeshCache::readCompiledMesh(const std::string& _path,
+                                     uint64_t* _sourceHash)
+{
+#ifdef _WIN32
+  std::ifstream file(_path, std::ios::binary);
+  if(!file)
+    return nullptr;
+
+  const std::string buffer((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+  BinaryReader reader(buffer.data(), buffer.size());
+  return readScene(reader, _sourceHash);
+#else
+  const int fd = open(_path.c_str(), O_RDONLY);
+  if(fd < 0)
+    return nullptr;
+
+  struct stat status;
+  if(fstat(fd, &status) != 0 || status.st_size <= 0)
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = static_cast<size_t>(status.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if(data == MAP_FAILED)
+    return nullptr;
+
+  BinaryReader reader(static_cast<const char*>(data), size);
+  aiScene* scene = readScene(reader, _sourceHash);
+  munmap(data, size);
+
+  return scene;
+#endif
+}
+
+//==============================================================================
+uint64_t MeshCache::computeHash(const char* _data, size_t _size)
+{
+  // 64-bit FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  for(size_t i=0; i<_size; ++i)
+  {
+    hash ^= static_cast<unsigned char>(_data[i]);
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+//==============================================================================
+const aiScene* MeshCache::load(
+    const std::string& _uri,
+    const common::ResourceRetrieverPtr& _retriever) const
+{
+  const std::string directory = getCompiledMeshDirectory();
+  if(directory.empty())
+    return MeshShape::importMesh(_uri, _retriever);
+
+  uint64_t sourceHash;
+  if(!hashResource(_uri, _retriever, sourceHash))
+    return MeshShape::importMesh(_uri, _retriever);
+
+  std::stringstream path;
+  path << directory << "/" << std::hex << std::setw(16) << std::setfill('0')
+       << computeHash(_uri.data(), _uri.size()) << COMPILED_MESH_EXTENSION;
+
+  uint64_t compiledHash = 0;
+  aiScene* compiled = readCompiledMesh(path.str(), &compiledHash);
+  if(compiled && compiledHash == sourceHash)
+    return compiled;
+
+  delete compiled;
+
+  const aiScene* scene = MeshShape::importMesh(_uri, _retriever);
+  if(scene && !writeCompiledMesh(scene, path.str(), sourceHash))
+  {
+    dtwarn << "[MeshCache::load] Failed writing the compiled copy of mesh '"
+           << _uri << "' to '" << path.str() << "'.\n";
+  }
+
+  return scene;
+}
+
+} // namespace dynamics
+} // namespace dart
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_MESHCACHE_H_
+#define DART_DYNAMICS_MESHCACHE_H_
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "dart/common/ResourceRetriever.h"
+#include "dart/common/ThreadPool.h"
+
+struct aiScene;
+
+namespace dart {
+namespace dynamics {
+
+/// MeshCache shares the meshes that are loaded by MeshShape::loadMesh(), and
+/// therefore by SkelParser, SdfParser and DartLoader, across the whole
+/// process. Meshes are keyed by their URI and the ResourceRetriever that they
+/// are loaded with, because two retrievers may resolve the same URI to
+/// different files. Loading a mesh that is already in the cache returns the
+/// same aiScene again and adds a reference to it. Every
+/// MeshShape gives its reference back when it is destroyed, and the scene is
+/// deleted together with the last reference.
+///
+/// Optionally, the cache keeps a compiled copy of every imported mesh on disk.
+/// The compiled format stores the scene after all of the Assimp
+/// post-processing steps, so loading it skips Assimp entirely. A compiled mesh
+/// is only used while a hash of the source file still matches.
+///
+/// Meshes can also be loaded in the background with acquireAsync(), which
+/// the parsers use to read the kinematic structure of a model while its
+/// meshes are being imported in parallel. A mesh that is requested while it is
+/// still being loaded is only imported once.
+class MeshCache
+{
+public:
+
+  /// How the parsers load the meshes of the models that they read
+  enum LoadingMode
+  {
+    LOAD_IMMEDIATELY = 0, ///< Load every mesh while it is being parsed
+    LOAD_IN_PARALLEL,     ///< Load the meshes in parallel on a thread pool
+    LOAD_VISUALS_LAZILY   ///< Load collision meshes in parallel and visual
+                          ///  meshes when they are first needed
+  };
+
+  /// Returns the cache that is shared by the whole process
+  static MeshCache& getInstance();
+
+  /// Copying is not allowed
+  MeshCache(const MeshCache&) = delete;
+
+  /// Assignment is not allowed
+  MeshCache& operator=(const MeshCache&) = delete;
+
+  /// Returns the mesh at _uri and adds a reference to it, which the caller has
+  /// to give back with release(). The mesh is only imported if it is not in
+  /// the cache yet. Returns a nullptr if the mesh cannot be loaded.
+  const aiScene* acquire(const std::string& _uri,
+                         const common::ResourceRetrieverPtr& _retriever);
+
+  /// Like acquire(), but the mesh is loaded on the thread pool of the cache.
+  /// The returned future becomes ready once the mesh has been loaded, and the
+  /// reference has to be given back with release() as usual.
+  std::shared_future<const aiScene*> acquireAsync(
+      const std::string& _uri, const common::ResourceRetrieverPtr& _retriever);
+
+  /// Gives back a reference to _scene and deletes it once no references are
+  /// left. Returns false if _scene was not loaded by the cache, in which case
+  /// nothing happens.
+  bool release(const aiScene* _scene);
+
+  /// Returns the number of references to the mesh at _uri that was loaded
+  /// with _retriever, which is 0 if the mesh is not in the cache
+  size_t getUseCount(const std::string& _uri,
+                     const common::ResourceRetrieverPtr& _retriever) const;
+
+  /// Returns the number of meshes in the cache
+  size_t getNumMeshes() const;
+
+  /// Set the directory that compiled meshes are written to and read from. The
+  /// directory must exist. Pass in an empty string, which is the default, to
+  /// import every mesh with Assimp.
+  void setCompiledMeshDirectory(const std::string& _directory);
+
+  /// Get the directory of the compiled meshes
+  std::string getCompiledMeshDirectory() const;
+
+  /// Set how the parsers load meshes. The default is LOAD_IN_PARALLEL.
+  void setLoadingMode(LoadingMode _mode);
+
+  /// Get how the parsers load meshes
+  LoadingMode getLoadingMode() const;
+
+  /// Write _scene to _path in the compiled format, together with the hash of
+  /// its source file. Returns false if the scene contains anything other than
+  /// triangles or the file cannot be written.
+  static bool writeCompiledMesh(const aiScene* _scene, const std::string& _path,
+                                uint64_t _sourceHash = 0);
+
+  /// Read a scene in the compiled format from _path. The file is mapped into
+  /// memory and copied into a new aiScene, which the caller owns. If
+  /// _sourceHash is not a nullptr, it is set to the hash of the source file
+  /// that the scene was compiled from. Returns a nullptr on failure.
+  static aiScene* readCompiledMesh(const std::string& _path,
+                                   uint64_t* _sourceHash = nullptr);
+
+  /// Returns the hash of _size bytes of _data that identifies a source file
+  static uint64_t computeHash(const char* _data, size_t _size);
+
+protected:
+
+  /// Identifies a mesh by its URI and its retriever
+  typedef std::pair<std::string, const common::ResourceRetriever*> Key;
+
+  /// Hash of a Key
+  struct KeyHash
+  {
+    size_t operator()(const Key& _key) const;
+  };
+
+  /// A mesh in the cache
+  struct Entry
+  {
+    /// The loaded scene
+    const aiScene* mScene;
+
+    /// The number of references that have been handed out
+    size_t mUseCount;
+
+    /// Keeps the retriever of the Key alive, so that its address cannot be
+    /// reused by another retriever while the mesh is cached
+    common::ResourceRetrieverPtr mRetriever;
+  };
+
+  /// A mesh that is currently being loaded by one of the threads
+  struct Loading
+  {
+    /// Becomes ready when the mesh has been loaded
+    std::shared_future<const aiScene*> mFuture;
+
+    /// The number of other threads that are waiting for the mesh. The loading
+    /// thread adds a reference for each of them.
+    size_t mNumWaiters;
+  };
+
+  /// Constructor
+  MeshCache() = default;
+
+  /// Load the mesh at _uri from its compiled copy or with Assimp
+  const aiScene* load(const std::string& _uri,
+                      const common::ResourceRetrieverPtr& _retriever) const;
+
+  /// Protects all of the members
+  mutable std::mutex mMutex;
+
+  /// The cached meshes by their Key
+  std::unordered_map<Key, Entry, KeyHash> mEntries;
+
+  /// The Keys of the cached meshes
+  std::unordered_map<const aiScene*, Key> mKeys;
+
+  /// The meshes that are currently being loaded by their Key
+  std::unordered_map<Key, Loading, KeyHash> mLoading;
+
+  /// Directory of the compiled meshes. Empty if disabled.
+  std::string mCompiledMeshDirectory;
+
+  /// How the parsers load meshes
+  LoadingMode mLoadingMode = LOAD_IN_PARALLEL;
+
+  /// Runs the tasks of acquireAsync(). It is created when it is first needed,
+  /// and it is declared last so that its queued tasks are finished before the
+  /// other members are destroyed.
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_MESHCACHE_H_
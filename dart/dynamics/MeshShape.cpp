@@ -37,6 +37,7 @@
 
 #include "dart/dynamics/MeshShape.h"
 
+#include <chrono>
 #include <limits>
 #include <string>
 
@@ -47,6 +48,7 @@
 #include "dart/renderer/RenderInterface.h"
 #include "dart/common/Console.h"
 #include "dart/dynamics/AssimpInputResourceAdaptor.h"
+#include "dart/dynamics/MeshCache.h"
 #include "dart/common/LocalResourceRetriever.h"
 #include "dart/common/Uri.h"
 
@@ -135,10 +137,13 @@ MeshShape::MeshShape(const Eigen::Vector3d& _scale, const aiScene* _mesh,
                      const std::string& _path,
                      const common::ResourceRetrieverPtr& _resourceRetriever)
   : Shape(MESH),
+    mMesh(nullptr),
+    mIsReady(true),
     mResourceRetriever(_resourceRetriever),
     mDisplayList(0),
     mColorMode(MATERIAL_COLOR),
-    mColorIndex(0)
+    mColorIndex(0),
+    mHasAlpha(false)
 {
   assert(_scale[0] > 0.0);
   assert(_scale[1] > 0.0);
@@ -149,13 +154,34 @@ MeshShape::MeshShape(const Eigen::Vector3d& _scale, const aiScene* _mesh,
 }
 
 MeshShape::~MeshShape() {
-  delete mMesh;
+  std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+  if(mPendingMesh.valid())
+    MeshCache::getInstance().release(mPendingMesh.get());
+  else if(!MeshCache::getInstance().release(mMesh))
+    delete mMesh;
 }
 
 const aiScene* MeshShape::getMesh() const {
+  _resolveMesh();
   return mMesh;
 }
 
+bool MeshShape::isReady() const {
+  if(mIsReady.load())
+    return true;
+
+  {
+    std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+    if(!mPendingMesh.valid()
+       || mPendingMesh.wait_for(std::chrono::seconds(0))
+          != std::future_status::ready)
+      return mIsReady.load();
+  }
+
+  _resolveMesh();
+  return true;
+}
+
 const std::string& MeshShape::getMeshUri() const
 {
   return mMeshUri;
@@ -167,14 +193,12 @@ void MeshShape::update()
 }
 
 void MeshShape::setAlpha(double _alpha) {
+  Shape::setAlpha(_alpha);
+  mHasAlpha = true;
+}
 
-  for(size_t i=0; i<mMesh->mNumMeshes; ++i)
-  {
-    aiMesh* mesh = mMesh->mMeshes[i];
-    for(size_t j=0; j<mesh->mNumVertices; ++j)
-      mesh->mColors[0][j][3] = _alpha;
-  }
-
+bool MeshShape::hasAlpha() const {
+  return mHasAlpha;
 }
 
 const std::string &MeshShape::getMeshPath() const
@@ -186,7 +210,19 @@ void MeshShape::setMesh(
   const aiScene* _mesh, const std::string& _path,
   const common::ResourceRetrieverPtr& _resourceRetriever)
 {
-  mMesh = _mesh;
+  {
+    std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+    if(mPendingMesh.valid())
+    {
+      MeshCache::getInstance().release(mPendingMesh.get());
+      mPendingMesh = std::shared_future<const aiScene*>();
+    }
+    else if(mMesh != _mesh)
+      MeshCache::getInstance().release(mMesh);
+
+    mMesh = _mesh;
+    mIsReady = true;
+  }
 
   if(nullptr == _mesh) {
     mMeshPath = "";
@@ -195,27 +231,43 @@ void MeshShape::setMesh(
     return;
   }
 
-  common::Uri uri;
-  if(uri.fromString(_path))
-  {
-    mMeshUri = _path;
-
-    if(uri.mScheme.get_value_or("file") == "file")
-      mMeshPath = uri.mPath.get_value_or("");
-  }
-  else
-  {
-    dtwarn << "[MeshShape::setMesh] Failed parsing URI '" << _path << "'.\n";
-    mMeshUri = "";
-    mMeshPath = "";
-  }
-
+  _setMeshUri(_path);
   mResourceRetriever = _resourceRetriever;
 
   _updateBoundingBoxDim();
   computeVolume();
 }
 
+void MeshShape::setMeshAsync(
+  const std::string& _uri,
+  const common::ResourceRetrieverPtr& _resourceRetriever)
+{
+  setMesh(nullptr);
+  mBoundingBoxDim.setZero();
+  mVolume = 0.0;
+  _setMeshUri(_uri);
+  mResourceRetriever = _resourceRetriever;
+
+  std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+  mPendingMesh = MeshCache::getInstance().acquireAsync(
+    _uri, _resourceRetriever);
+  mIsReady = false;
+}
+
+void MeshShape::setMeshLazy(
+  const std::string& _uri,
+  const common::ResourceRetrieverPtr& _resourceRetriever)
+{
+  setMesh(nullptr);
+  mBoundingBoxDim.setZero();
+  mVolume = 0.0;
+  _setMeshUri(_uri);
+  mResourceRetriever = _resourceRetriever;
+
+  std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+  mIsReady = false;
+}
+
 void MeshShape::setScale(const Eigen::Vector3d& _scale) {
   assert(_scale[0] > 0.0);
   assert(_scale[1] > 0.0);
@@ -228,6 +280,23 @@ const Eigen::Vector3d& MeshShape::getScale() const {
   return mScale;
 }
 
+const Eigen::Vector3d& MeshShape::getBoundingBoxDim() const {
+  // The bounding box of a mesh that is not ready may be written by the thread
+  // that resolves the mesh, so it is not read until mIsReady has been set
+  static const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+  if(!mIsReady.load())
+    return zero;
+
+  return mBoundingBoxDim;
+}
+
+double MeshShape::getVolume() const {
+  if(!mIsReady.load())
+    return 0.0;
+
+  return mVolume;
+}
+
 void MeshShape::setColorMode(ColorMode _mode)
 {
   mColorMode = _mode;
@@ -268,15 +337,24 @@ void MeshShape::draw(renderer::RenderInterface* _ri,
     _ri->setPenColor(_color);
   else
     _ri->setPenColor(mColor);
+  const aiScene* mesh = getMesh();
+  if (!mesh)
+    return;
+
   _ri->pushMatrix();
   _ri->transform(mTransform);
 
-  _ri->drawMesh(mScale, mMesh);
+  if (mHasAlpha)
+    _ri->drawMesh(mScale, mesh, mColor[3]);
+  else
+    _ri->drawMesh(mScale, mesh);
 
   _ri->popMatrix();
 }
 
 Eigen::Matrix3d MeshShape::computeInertia(double _mass) const {
+  _resolveMesh();
+
   // use bounding box to represent the mesh
   double l = mScale[0] * mBoundingBoxDim[0];
   double h = mScale[1] * mBoundingBoxDim[1];
@@ -328,8 +406,64 @@ void MeshShape::_updateBoundingBoxDim() {
   mBoundingBoxDim[2] = max_Z - min_Z;
 }
 
+void MeshShape::_setMeshUri(const std::string& _path) {
+  mMeshUri = "";
+  mMeshPath = "";
+
+  common::Uri uri;
+  if(uri.fromString(_path))
+  {
+    mMeshUri = _path;
+
+    if(uri.mScheme.get_value_or("file") == "file")
+      mMeshPath = uri.mPath.get_value_or("");
+  }
+  else
+  {
+    dtwarn << "[MeshShape::setMesh] Failed parsing URI '" << _path << "'.\n";
+  }
+}
+
+void MeshShape::_resolveMesh() const {
+  if(mIsReady.load())
+    return;
+
+  std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+  if(mIsReady.load())
+    return;
+
+  if(mPendingMesh.valid())
+  {
+    mMesh = mPendingMesh.get();
+    mPendingMesh = std::shared_future<const aiScene*>();
+  }
+  else
+  {
+    mMesh = MeshCache::getInstance().acquire(mMeshUri, mResourceRetriever);
+  }
+
+  if(mMesh)
+  {
+    // The bounding box and the volume could not be computed before the mesh
+    // arrived, so they are filled in now. This happens under the lock and
+    // before mIsReady is set, which getBoundingBoxDim() and getVolume() check
+    // before reading them.
+    MeshShape* self = const_cast<MeshShape*>(this);
+    self->_updateBoundingBoxDim();
+    self->computeVolume();
+  }
+
+  mIsReady.store(true);
+}
+
 const aiScene* MeshShape::loadMesh(
   const std::string& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  return MeshCache::getInstance().acquire(_uri, _retriever);
+}
+
+const aiScene* MeshShape::importMesh(
+  const std::string& _uri, const common::ResourceRetrieverPtr& _retriever)
 {
   // Remove points and lines from the import.
   aiPropertyStore* propertyStore = aiCreatePropertyStore();
@@ -361,7 +495,7 @@ const aiScene* MeshShape::loadMesh(
   // necessary because the importer owns the memory that it allocates.
   if(!scene)
   {
-    dtwarn << "[MeshShape::loadMesh] Failed loading mesh '" << _uri << "'.\n";
+    dtwarn << "[MeshShape::importMesh] Failed loading mesh '" << _uri << "'.\n";
     return nullptr;
   }
 
@@ -385,15 +519,15 @@ const aiScene* MeshShape::loadMesh(
   // import process, because we may have changed mTransformation above.
   scene = aiApplyPostProcessing(scene, aiProcess_PreTransformVertices);
   if(!scene)
-    dtwarn << "[MeshShape::loadMesh] Failed pre-transforming vertices.\n";
+    dtwarn << "[MeshShape::importMesh] Failed pre-transforming vertices.\n";
 
   return scene;
 }
 
 const aiScene* MeshShape::loadMesh(const std::string& _fileName)
 {
-  const auto retriever = std::make_shared<common::LocalResourceRetriever>();
-  return loadMesh("file://" + _fileName, retriever);
+  return loadMesh("file://" + _fileName,
+                  common::LocalResourceRetriever::getDefault());
 }
 
 }  // namespace dynamics
@@ -38,6 +38,9 @@
 #ifndef DART_DYNAMICS_MESHSHAPE_H_
 #define DART_DYNAMICS_MESHSHAPE_H_
 
+#include <atomic>
+#include <future>
+#include <mutex>
 #include <string>
 
 #include <assimp/scene.h>
@@ -75,30 +78,62 @@ public:
   /// \brief Destructor.
   virtual ~MeshShape();
 
-  /// \brief
+  /// \brief Get the mesh of this shape. If the mesh is still being loaded,
+  /// this waits for it to arrive, and a deferred mesh is loaded right away.
+  /// Returns a nullptr if the mesh could not be loaded.
   const aiScene* getMesh() const;
 
+  /// Returns true if getMesh() can return without loading or waiting for the
+  /// mesh, i.e. the mesh has arrived or it has failed to load
+  bool isReady() const;
+
   /// Update positions of the vertices or the elements. By default, this does
   /// nothing; you must extend the MeshShape class and implement your own
   /// version of this function if you want the mesh data to get updated before
   /// rendering
   virtual void update();
 
-  // Documentation inherited
+  // Documentation inherited. The alpha is stored in this shape and replaces
+  // the alpha of the vertex colors when the mesh is drawn, so the mesh itself,
+  // which may be shared through the MeshCache, is left untouched.
   void setAlpha(double _alpha) override;
 
-  /// \brief
+  /// Returns true if setAlpha() has been called on this shape
+  bool hasAlpha() const;
+
+  /// \brief Set the mesh of this shape, which takes over the reference to
+  /// _mesh. A previous mesh from the MeshCache is given back to the cache.
   void setMesh(
     const aiScene* _mesh,
     const std::string& path = "",
     const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
 
+  /// \brief Load the mesh at _uri in the background through the MeshCache.
+  /// The shape becomes ready when the mesh arrives. Until then its bounding
+  /// box and volume are zero.
+  void setMeshAsync(
+    const std::string& _uri,
+    const common::ResourceRetrieverPtr& _resourceRetriever);
+
+  /// \brief Defer loading the mesh at _uri through the MeshCache until it is
+  /// first needed, e.g. when the shape is drawn. Until then the bounding box
+  /// and volume of the shape are zero.
+  void setMeshLazy(
+    const std::string& _uri,
+    const common::ResourceRetrieverPtr& _resourceRetriever);
+
   /// \brief URI to the mesh; an empty string if unavailable.
   const std::string &getMeshUri() const;
 
   /// \brief Path to the mesh on disk; an empty string if unavailable.
   const std::string& getMeshPath() const;
 
+  // Documentation inherited. This is zero until the mesh is ready.
+  const Eigen::Vector3d& getBoundingBoxDim() const override;
+
+  // Documentation inherited. This is zero until the mesh is ready.
+  double getVolume() const override;
+
   /// \brief
   void setScale(const Eigen::Vector3d& _scale);
 
@@ -131,13 +166,21 @@ public:
             const Eigen::Vector4d& _col = Eigen::Vector4d::Ones(),
             bool _default = true) const override;
 
-  /// \brief
+  /// \brief Load a mesh from a file on disk through the MeshCache.
   static const aiScene* loadMesh(const std::string& _fileName);
 
-  /// \brief 
+  /// \brief Load a mesh from a URI through the MeshCache. A mesh that has
+  /// already been loaded is shared instead of being imported again. The
+  /// returned reference is handed over to the MeshShape that the mesh is
+  /// passed to, or has to be given back with MeshCache::release().
   static const aiScene* loadMesh(
     const std::string& _uri, const common::ResourceRetrieverPtr& _retriever);
 
+  /// \brief Import a mesh from a URI with Assimp, bypassing the MeshCache. The
+  /// caller owns the returned scene.
+  static const aiScene* importMesh(
+    const std::string& _uri, const common::ResourceRetrieverPtr& _retriever);
+
   // Documentation inherited.
   Eigen::Matrix3d computeInertia(double _mass) const override;
 
@@ -149,9 +192,26 @@ private:
   /// \brief
   void _updateBoundingBoxDim();
 
+  /// \brief Set the URI and path of the mesh from _path
+  void _setMeshUri(const std::string& _path);
+
+  /// \brief Wait for a mesh that is being loaded, or load a deferred mesh
+  void _resolveMesh() const;
+
 protected:
   /// \brief
-  const aiScene* mMesh;
+  mutable const aiScene* mMesh;
+
+  /// \brief The mesh while it is being loaded by setMeshAsync()
+  mutable std::shared_future<const aiScene*> mPendingMesh;
+
+  /// \brief False while the mesh is being loaded or has been deferred
+  mutable std::atomic<bool> mIsReady;
+
+  /// \brief Protects mMesh, mPendingMesh and mIsReady while the mesh is being
+  /// set or resolved. The bounding box and the volume that are computed when
+  /// the mesh is resolved are only read once mIsReady is true.
+  mutable std::mutex mPendingMeshMutex;
 
   /// \brief URI the mesh, if available).
   std::string mMeshUri;
@@ -174,6 +234,9 @@ protected:
   /// Specifies which color index should be used when mColorMode is COLOR_INDEX
   int mColorIndex;
 
+  /// True if the alpha of mColor replaces the alpha of the vertex colors
+  bool mHasAlpha;
+
 public:
   // To get byte-aligned Eigen vectors
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
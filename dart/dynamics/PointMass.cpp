@@ -93,19 +93,14 @@ void PointMass::Properties::setMass(double _mass)
 PointMass::PointMass(SoftBodyNode* _softBodyNode)
   : // mIndexInSkeleton(Eigen::Matrix<size_t, 3, 1>::Zero()),
     mParentSoftBodyNode(_softBodyNode),
-    mPositions(Eigen::Vector3d::Zero()),
     mPositionDeriv(Eigen::Vector3d::Zero()),
-    mVelocities(Eigen::Vector3d::Zero()),
     mVelocitiesDeriv(Eigen::Vector3d::Zero()),
-    mAccelerations(Eigen::Vector3d::Zero()),
     mAccelerationsDeriv(Eigen::Vector3d::Zero()),
-    mForces(Eigen::Vector3d::Zero()),
     mForcesDeriv(Eigen::Vector3d::Zero()),
     mVelocityChanges(Eigen::Vector3d::Zero()),
     // mImpulse(Eigen::Vector3d::Zero()),
     mConstraintImpulses(Eigen::Vector3d::Zero()),
     mW(Eigen::Vector3d::Zero()),
-    mX(Eigen::Vector3d::Zero()),
     mV(Eigen::Vector3d::Zero()),
     mEta(Eigen::Vector3d::Zero()),
     mAlpha(Eigen::Vector3d::Zero()),
@@ -191,6 +186,7 @@ void PointMass::addConnectedPointMass(PointMass* _pointMass)
 
   mParentSoftBodyNode->mSoftP.mPointProps[mIndex].
       mConnectedPointMassIndices.push_back(_pointMass->mIndex);
+  mParentSoftBodyNode->mConnectionsDirty = true;
 }
 
 //==============================================================================
@@ -255,7 +251,7 @@ void PointMass::setPosition(size_t _index, double _position)
 {
   assert(_index < 3);
 
-  mPositions[_index] = _position;
+  mParentSoftBodyNode->mPointStates.mPositions[mIndex][_index] = _position;
   mNotifier->notifyTransformUpdate();
 }
 
@@ -264,26 +260,26 @@ double PointMass::getPosition(size_t _index) const
 {
   assert(_index < 3);
 
-  return mPositions[_index];
+  return mParentSoftBodyNode->mPointStates.mPositions[mIndex][_index];
 }
 
 //==============================================================================
 void PointMass::setPositions(const Vector3d& _positions)
 {
-  mPositions = _positions;
+  mParentSoftBodyNode->mPointStates.mPositions[mIndex] = _positions;
   mNotifier->notifyTransformUpdate();
 }
 
 //==============================================================================
 const Vector3d& PointMass::getPositions() const
 {
-  return mPositions;
+  return mParentSoftBodyNode->mPointStates.mPositions[mIndex];
 }
 
 //==============================================================================
 void PointMass::resetPositions()
 {
-  mPositions.setZero();
+  mParentSoftBodyNode->mPointStates.mPositions[mIndex].setZero();
   mNotifier->notifyTransformUpdate();
 }
 
@@ -292,7 +288,7 @@ void PointMass::setVelocity(size_t _index, double _velocity)
 {
   assert(_index < 3);
 
-  mVelocities[_index] = _velocity;
+  mParentSoftBodyNode->mPointStates.mVelocities[mIndex][_index] = _velocity;
   mNotifier->notifyVelocityUpdate();
 }
 
@@ -301,26 +297,26 @@ double PointMass::getVelocity(size_t _index) const
 {
   assert(_index < 3);
 
-  return mVelocities[_index];
+  return mParentSoftBodyNode->mPointStates.mVelocities[mIndex][_index];
 }
 
 //==============================================================================
 void PointMass::setVelocities(const Vector3d& _velocities)
 {
-  mVelocities = _velocities;
+  mParentSoftBodyNode->mPointStates.mVelocities[mIndex] = _velocities;
   mNotifier->notifyVelocityUpdate();
 }
 
 //==============================================================================
 const Vector3d& PointMass::getVelocities() const
 {
-  return mVelocities;
+  return mParentSoftBodyNode->mPointStates.mVelocities[mIndex];
 }
 
 //==============================================================================
 void PointMass::resetVelocities()
 {
-  mVelocities.setZero();
+  mParentSoftBodyNode->mPointStates.mVelocities[mIndex].setZero();
   mNotifier->notifyVelocityUpdate();
 }
 
@@ -329,7 +325,8 @@ void PointMass::setAcceleration(size_t _index, double _acceleration)
 {
   assert(_index < 3);
 
-  mAccelerations[_index] = _acceleration;
+  mParentSoftBodyNode->mPointStates.mAccelerations[mIndex][_index]
+      = _acceleration;
   mNotifier->notifyAccelerationUpdate();
 }
 
@@ -338,20 +335,20 @@ double PointMass::getAcceleration(size_t _index) const
 {
  assert(_index < 3);
 
- return mAccelerations[_index];
+ return mParentSoftBodyNode->mPointStates.mAccelerations[mIndex][_index];
 }
 
 //==============================================================================
 void PointMass::setAccelerations(const Eigen::Vector3d& _accelerations)
 {
-  mAccelerations = _accelerations;
+  mParentSoftBodyNode->mPointStates.mAccelerations[mIndex] = _accelerations;
   mNotifier->notifyAccelerationUpdate();
 }
 
 //==============================================================================
 const Vector3d& PointMass::getAccelerations() const
 {
-  return mAccelerations;
+  return mParentSoftBodyNode->mPointStates.mAccelerations[mIndex];
 }
 
 //==============================================================================
@@ -365,7 +362,7 @@ const Vector3d& PointMass::getPartialAccelerations() const
 //==============================================================================
 void PointMass::resetAccelerations()
 {
-  mAccelerations.setZero();
+  mParentSoftBodyNode->mPointStates.mAccelerations[mIndex].setZero();
   mNotifier->notifyAccelerationUpdate();
 }
 
@@ -374,7 +371,7 @@ void PointMass::setForce(size_t _index, double _force)
 {
   assert(_index < 3);
 
-  mForces[_index] = _force;
+  mParentSoftBodyNode->mPointStates.mForces[mIndex][_index] = _force;
 }
 
 //==============================================================================
@@ -382,25 +379,25 @@ double PointMass::getForce(size_t _index)
 {
   assert(_index < 3);
 
-  return mForces[_index];
+  return mParentSoftBodyNode->mPointStates.mForces[mIndex][_index];
 }
 
 //==============================================================================
 void PointMass::setForces(const Vector3d& _forces)
 {
-  mForces = _forces;
+  mParentSoftBodyNode->mPointStates.mForces[mIndex] = _forces;
 }
 
 //==============================================================================
 const Vector3d& PointMass::getForces() const
 {
-  return mForces;
+  return mParentSoftBodyNode->mPointStates.mForces[mIndex];
 }
 
 //==============================================================================
 void PointMass::resetForces()
 {
-  mForces.setZero();
+  mParentSoftBodyNode->mPointStates.mForces[mIndex].setZero();
 }
 
 //==============================================================================
@@ -547,7 +544,7 @@ const Eigen::Vector3d& PointMass::getLocalPosition() const
 {
   if(mNotifier->needsTransformUpdate())
     mParentSoftBodyNode->updateTransform();
-  return mX;
+  return mParentSoftBodyNode->mPointPositions[mIndex];
 }
 
 //==============================================================================
@@ -665,16 +662,21 @@ void PointMass::init()
 }
 
 //==============================================================================
-void PointMass::updateTransform() const
+bool PointMass::updateTransform() const
 {
-  // Local translation
-  mX = getPositions() + getRestingPosition();
-  assert(!math::isNan(mX));
+  // Local translation, which lives in the vertex buffer of the SoftBodyNode
+  Eigen::Vector3d& X = mParentSoftBodyNode->mPointPositions[mIndex];
+  const Eigen::Vector3d newX = getPositions() + getRestingPosition();
+  assert(!math::isNan(newX));
+  const bool changed = (X != newX);
+  X = newX;
 
   // World translation
   const Eigen::Isometry3d& parentW = mParentSoftBodyNode->getWorldTransform();
-  mW = parentW.translation() + parentW.linear() * mX;
+  mW = parentW.translation() + parentW.linear() * X;
   assert(!math::isNan(mW));
+
+  return changed;
 }
 
 //==============================================================================
@@ -753,7 +755,7 @@ void PointMass::updateJointForceID(double /*_timeStep*/,
                                    double /*_withSpringForces*/)
 {
   // tau = f
-  mForces = mF;
+  setForces(mF);
   // TODO: need to add spring and damping forces
 }
 
@@ -778,15 +780,15 @@ void PointMass::updateBiasForceFD(double _dt, const Eigen::Vector3d& _gravity)
   double ke = mParentSoftBodyNode->getEdgeSpringStiffness();
   double kd = mParentSoftBodyNode->getDampingCoefficient();
   int nN = getNumConnectedPointMasses();
-  mAlpha = mForces
+  mAlpha = getForces()
            - (kv + nN * ke) * getPositions()
            - (_dt * (kv + nN * ke) + kd) * getVelocities()
            - getMass() * getPartialAccelerations()
            - mB;
   for (size_t i = 0; i < getNumConnectedPointMasses(); ++i)
   {
-    mAlpha += ke * (getConnectedPointMass(i)->mPositions
-                    + _dt * getConnectedPointMass(i)->mVelocities);
+    mAlpha += ke * (getConnectedPointMass(i)->getPositions()
+                    + _dt * getConnectedPointMass(i)->getVelocities());
   }
   assert(!math::isNan(mAlpha));
 
@@ -892,7 +894,7 @@ void PointMass::updateConstrainedTermsFD(double _timeStep)
   setAccelerations( getAccelerations() + mVelocityChanges / _timeStep );
 
   // 3. tau = tau + imp / dt
-  mForces.noalias() += mConstraintImpulses / _timeStep;
+  setForces( getForces() + mConstraintImpulses / _timeStep );
 
   ///
 //  mA += mDelV / _timeStep;
@@ -930,7 +932,7 @@ void PointMass::aggregateAugMassMatrix(Eigen::MatrixXd& _MCol, int _col,
 //==============================================================================
 void PointMass::updateInvMassMatrix()
 {
-  mBiasForceForInvMeta = mForces;
+  mBiasForceForInvMeta = getForces();
 }
 
 //==============================================================================
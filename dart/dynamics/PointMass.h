@@ -388,8 +388,8 @@ protected:
   /// \{ \name Recursive dynamics routines
   //----------------------------------------------------------------------------
 
-  /// \brief Update transformation.
-  void updateTransform() const;
+  /// \brief Update transformation. Returns true if the local position changed.
+  bool updateTransform() const;
 
   /// \brief Update body velocity.
   void updateVelocity() const;
@@ -525,13 +525,13 @@ protected:
   /// Index of this PointMass within the SoftBodyNode
   size_t mIndex;
 
+  // The generalized positions, velocities, accelerations, and forces of this
+  // PointMass are stored in the state arrays of its SoftBodyNode, at mIndex.
+
   //----------------------------------------------------------------------------
   // Configuration
   //----------------------------------------------------------------------------
 
-  /// Position
-  Eigen::Vector3d mPositions;
-
   /// Derivatives w.r.t. an arbitrary scalr variable
   Eigen::Vector3d mPositionDeriv;
 
@@ -539,9 +539,6 @@ protected:
   // Velocity
   //----------------------------------------------------------------------------
 
-  /// Generalized velocity
-  Eigen::Vector3d mVelocities;
-
   /// Derivatives w.r.t. an arbitrary scalr variable
   Eigen::Vector3d mVelocitiesDeriv;
 
@@ -549,9 +546,6 @@ protected:
   // Acceleration
   //----------------------------------------------------------------------------
 
-  /// Generalized acceleration
-  Eigen::Vector3d mAccelerations;
-
   /// Derivatives w.r.t. an arbitrary scalr variable
   Eigen::Vector3d mAccelerationsDeriv;
 
@@ -559,9 +553,6 @@ protected:
   // Force
   //----------------------------------------------------------------------------
 
-  /// Generalized force
-  Eigen::Vector3d mForces;
-
   /// Derivatives w.r.t. an arbitrary scalr variable
   Eigen::Vector3d mForcesDeriv;
 
@@ -583,9 +574,6 @@ protected:
   /// Current position viewed in world frame.
   mutable Eigen::Vector3d mW;
 
-  /// Current position viewed in parent soft body node frame.
-  mutable Eigen::Vector3d mX;
-
   /// Current velocity viewed in parent soft body node frame.
   mutable Eigen::Vector3d mV;
 
@@ -163,9 +163,8 @@ Joint* PrismaticJoint::clone() const
 //==============================================================================
 void PrismaticJoint::updateLocalTransform() const
 {
-  mT = mJointP.mT_ParentBodyToJoint
-       * Eigen::Translation3d(mPrismaticP.mAxis * getPositionStatic())
-       * mJointP.mT_ChildBodyToJoint.inverse();
+  // The same implementation serves computeWorldTransforms<Scalar>()
+  mT = computeRelativeTransform(getPositionStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
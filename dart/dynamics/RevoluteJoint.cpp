@@ -164,9 +164,8 @@ Joint* RevoluteJoint::clone() const
 //==============================================================================
 void RevoluteJoint::updateLocalTransform() const
 {
-  mT = mJointP.mT_ParentBodyToJoint
-       * math::expAngular(mRevoluteP.mAxis * getPositionStatic())
-       * mJointP.mT_ChildBodyToJoint.inverse();
+  // The same implementation serves computeWorldTransforms<Scalar>()
+  mT = computeRelativeTransform(getPositionStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
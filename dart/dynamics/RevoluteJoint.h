@@ -112,6 +112,14 @@ public:
   ///
   const Eigen::Vector3d& getAxis() const;
 
+  /// Compute the transform from the parent BodyNode to the child BodyNode at
+  /// the given position for any scalar type, e.g. float or a forward-mode
+  /// automatic differentiation type. This does not change the state of the
+  /// joint.
+  template <typename Scalar>
+  math::Isometry3<Scalar> computeRelativeTransform(
+      const Scalar& _position) const;
+
 protected:
 
   /// Constructor called by Skeleton class
@@ -142,5 +150,7 @@ public:
 }  // namespace dynamics
 }  // namespace dart
 
+#include "dart/dynamics/detail/RevoluteJoint.h"
+
 #endif  // DART_DYNAMICS_REVOLUTEJOINT_H_
 
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Author(s): Jeongseok Lee <jslee02@gmail.com>
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_SCALARKINEMATICS_H_
+#define DART_DYNAMICS_SCALARKINEMATICS_H_
+
+#include <Eigen/Dense>
+
+#include "dart/math/MathTypes.h"
+#include "dart/dynamics/Skeleton.h"
+
+namespace dart {
+namespace dynamics {
+
+//------------------------------------------------------------------------------
+// Scalar-generic kinematics
+//
+// These function templates evaluate the kinematics of an existing Skeleton for
+// generalized positions of any scalar type that Eigen supports, such as float
+// or a forward-mode automatic differentiation type, without touching the state
+// of the Skeleton. Instantiating them with a dual number gives the exact
+// derivatives with respect to the positions.
+//
+// The scope is deliberately limited to position kinematics: only Skeletons
+// whose joints are RevoluteJoints, PrismaticJoints or joints without any
+// degrees of freedom are supported, and there are no scalar-generic
+// velocities, Jacobians or dynamics. The joint transforms come from the same
+// computeRelativeTransform() and getLocalTransform() that the double-precision
+// Skeleton uses, so both paths always agree.
+//------------------------------------------------------------------------------
+
+/// Compute the world transform of every BodyNode of _skeleton at the given
+/// generalized positions. The transforms are in the same order as the
+/// BodyNodes of the Skeleton. Returns an empty vector if the size of
+/// _positions does not match or if the Skeleton has an unsupported joint.
+template <typename Scalar>
+Eigen::aligned_vector<math::Isometry3<Scalar>> computeWorldTransforms(
+    const Skeleton& _skeleton,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& _positions);
+
+/// Compute the center of mass of _skeleton in the world frame at the given
+/// generalized positions. Returns a zero vector if the size of _positions does
+/// not match or if the Skeleton has an unsupported joint.
+template <typename Scalar>
+Eigen::Matrix<Scalar, 3, 1> computeCOM(
+    const Skeleton& _skeleton,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& _positions);
+
+} // namespace dynamics
+} // namespace dart
+
+#include "dart/dynamics/detail/ScalarKinematics.h"
+
+#endif // DART_DYNAMICS_SCALARKINEMATICS_H_
@@ -121,7 +121,7 @@ public:
   //           biased mesh shape. Two Vector3ds might be better; one is for
   //           minimum verterx, and the other is for maximum verterx of the
   //           bounding box.
-  const Eigen::Vector3d& getBoundingBoxDim() const;
+  virtual const Eigen::Vector3d& getBoundingBoxDim() const;
 
   /// \brief Set local transformation of the shape w.r.t. parent frame.
   void setLocalTransform(const Eigen::Isometry3d& _Transform);
@@ -145,7 +145,7 @@ public:
   /// \brief Get volume of this shape.
   ///        The volume will be automatically calculated by the sub-classes
   ///        such as BoxShape, EllipsoidShape, CylinderShape, and MeshShape.
-  double getVolume() const;
+  virtual double getVolume() const;
 
   /// \brief
   int getID() const;
@@ -200,8 +200,14 @@ const Eigen::Vector6d& SimpleFrame::getPrimaryRelativeAcceleration() const
 //==============================================================================
 const Eigen::Vector6d& SimpleFrame::getPartialAcceleration() const
 {
-  mPartialAcceleration = math::ad(getSpatialVelocity(),
-                                  getRelativeSpatialVelocity());
+  // The partial acceleration only depends on velocities, and any change to the
+  // velocities will also flag this Frame for an acceleration update. Skipping
+  // the computation otherwise keeps this getter free of writes once the
+  // acceleration is up to date, which makes it safe to call concurrently.
+  if(mNeedAccelerationUpdate)
+    mPartialAcceleration = math::ad(getSpatialVelocity(),
+                                    getRelativeSpatialVelocity());
+
   return mPartialAcceleration;
 }
 
@@ -126,6 +126,10 @@ Skeleton::~Skeleton()
 SkeletonPtr Skeleton::clone() const
 {
   SkeletonPtr skelClone = Skeleton::create(getName());
+  skelClone->mHasCollisionCategories = mHasCollisionCategories;
+  skelClone->mCollisionCategories = mCollisionCategories;
+  skelClone->mHasCollisionMask = mHasCollisionMask;
+  skelClone->mCollisionMask = mCollisionMask;
 
   for(size_t i=0; i<getNumBodyNodes(); ++i)
   {
@@ -326,6 +330,26 @@ bool Skeleton::isEnabledAdjacentBodyCheck() const
   return mSkeletonP.mEnabledAdjacentBodyCheck;
 }
 
+//==============================================================================
+void Skeleton::setCollisionCategories(uint32_t _categories)
+{
+  mHasCollisionCategories = true;
+  mCollisionCategories = _categories;
+
+  for (BodyNode* bodyNode : mSkelCache.mBodyNodes)
+    bodyNode->setCollisionCategories(_categories);
+}
+
+//==============================================================================
+void Skeleton::setCollisionMask(uint32_t _mask)
+{
+  mHasCollisionMask = true;
+  mCollisionMask = _mask;
+
+  for (BodyNode* bodyNode : mSkelCache.mBodyNodes)
+    bodyNode->setCollisionMask(_mask);
+}
+
 //==============================================================================
 void Skeleton::setMobile(bool _isMobile)
 {
@@ -781,11 +805,8 @@ void Skeleton::integratePositions(double _dt)
   for (size_t i = 0; i < mSkelCache.mBodyNodes.size(); ++i)
     mSkelCache.mBodyNodes[i]->getParentJoint()->integratePositions(_dt);
 
-  for (size_t i = 0; i < mSoftBodyNodes.size(); ++i)
-  {
-    for (size_t j = 0; j < mSoftBodyNodes[i]->getNumPointMasses(); ++j)
-      mSoftBodyNodes[i]->getPointMass(j)->integratePositions(_dt);
-  }
+  for (auto& softBodyNode : mSoftBodyNodes)
+    softBodyNode->integratePointMassPositions(_dt);
 }
 
 //==============================================================================
@@ -794,11 +815,8 @@ void Skeleton::integrateVelocities(double _dt)
   for (size_t i = 0; i < mSkelCache.mBodyNodes.size(); ++i)
     mSkelCache.mBodyNodes[i]->getParentJoint()->integrateVelocities(_dt);
 
-  for (size_t i = 0; i < mSoftBodyNodes.size(); ++i)
-  {
-    for (size_t j = 0; j < mSoftBodyNodes[i]->getNumPointMasses(); ++j)
-      mSoftBodyNodes[i]->getPointMass(j)->integrateVelocities(_dt);
-  }
+  for (auto& softBodyNode : mSoftBodyNodes)
+    softBodyNode->integratePointMassVelocities(_dt);
 }
 
 //==============================================================================
@@ -1376,6 +1394,10 @@ void Skeleton::drawMarkers(renderer::RenderInterface* _ri,
 //==============================================================================
 Skeleton::Skeleton(const Properties& _properties)
   : mSkeletonP(""),
+    mHasCollisionCategories(false),
+    mCollisionCategories(0u),
+    mHasCollisionMask(false),
+    mCollisionMask(0u),
     mTotalMass(0.0),
     mIsImpulseApplied(false),
     mUnionSize(1)
@@ -1427,6 +1449,12 @@ void Skeleton::registerBodyNode(BodyNode* _newBodyNode)
 
   _newBodyNode->mSkeleton = getPtr();
   _newBodyNode->mIndexInSkeleton = mSkelCache.mBodyNodes.size()-1;
+
+  if(mHasCollisionCategories)
+    _newBodyNode->setCollisionCategories(mCollisionCategories);
+
+  if(mHasCollisionMask)
+    _newBodyNode->setCollisionMask(mCollisionMask);
   addEntryToBodyNodeNameMgr(_newBodyNode);
   registerJoint(_newBodyNode->getParentJoint());
 
@@ -2763,33 +2791,86 @@ void Skeleton::computeForwardKinematics(bool _updateTransforms,
                                         bool _updateVels,
                                         bool _updateAccs)
 {
-  if (_updateTransforms)
+  if (!_updateTransforms && !_updateVels && !_updateAccs)
+    return;
+
+  // Parents come before their children in mSkelCache.mBodyNodes, so a single
+  // pass is enough to compute every requested quantity of a BodyNode while its
+  // data is still hot in cache. Any parent quantity that is somehow still out
+  // of date gets computed lazily by its getter.
+  for (BodyNode* bodyNode : mSkelCache.mBodyNodes)
+    bodyNode->updateKinematics(_updateTransforms, _updateVels, _updateAccs);
+}
+
+//==============================================================================
+static void computeFrameCaches(Frame* _frame)
+{
+  _frame->getWorldTransform();
+  _frame->getSpatialVelocity();
+  _frame->getRelativeSpatialAcceleration();
+  _frame->getPartialAcceleration();
+  _frame->getSpatialAcceleration();
+
+  JacobianNode* node = dynamic_cast<JacobianNode*>(_frame);
+  if(node)
   {
-    for (std::vector<BodyNode*>::iterator it = mSkelCache.mBodyNodes.begin();
-         it != mSkelCache.mBodyNodes.end(); ++it)
-    {
-      (*it)->updateTransform();
-    }
+    node->getJacobian();
+    node->getWorldJacobian();
+    node->getJacobianSpatialDeriv();
+    node->getJacobianClassicDeriv();
   }
 
-  if (_updateVels)
+  for(Frame* child : _frame->getChildFrames())
   {
-    for (std::vector<BodyNode*>::iterator it = mSkelCache.mBodyNodes.begin();
-         it != mSkelCache.mBodyNodes.end(); ++it)
-    {
-      (*it)->updateVelocity();
-      (*it)->updatePartialAcceleration();
-    }
+    // The BodyNodes are visited by Skeleton::computeAllCaches() itself
+    if(dynamic_cast<BodyNode*>(child))
+      continue;
+
+    computeFrameCaches(child);
   }
+}
+
+//==============================================================================
+void Skeleton::computeAllCaches(bool _updateDynamics)
+{
+  computeForwardKinematics(true, true, true);
+
+  for(BodyNode* bn : mSkelCache.mBodyNodes)
+    computeFrameCaches(bn);
 
-  if (_updateAccs)
+  getSupportPolygon();
+  for(size_t i=0; i < mTreeCache.size(); ++i)
+    getSupportPolygon(i);
+
+  if(!_updateDynamics)
+    return;
+
+  for(BodyNode* bn : mSkelCache.mBodyNodes)
   {
-    for (std::vector<BodyNode*>::iterator it = mSkelCache.mBodyNodes.begin();
-         it != mSkelCache.mBodyNodes.end(); ++it)
-    {
-      (*it)->updateAccelerationID();
-    }
+    bn->getArticulatedInertia();
+    bn->getArticulatedInertiaImplicit();
   }
+
+  for(size_t i=0; i < mTreeCache.size(); ++i)
+  {
+    getMassMatrix(i);
+    getAugMassMatrix(i);
+    getInvMassMatrix(i);
+    getInvAugMassMatrix(i);
+    getCoriolisForces(i);
+    getGravityForces(i);
+    getCoriolisAndGravityForces(i);
+    getExternalForces(i);
+  }
+
+  getMassMatrix();
+  getAugMassMatrix();
+  getInvMassMatrix();
+  getInvAugMassMatrix();
+  getCoriolisForces();
+  getGravityForces();
+  getCoriolisAndGravityForces();
+  getExternalForces();
 }
 
 //==============================================================================
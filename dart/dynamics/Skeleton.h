@@ -38,6 +38,7 @@
 #ifndef DART_DYNAMICS_SKELETON_H_
 #define DART_DYNAMICS_SKELETON_H_
 
+#include <cstdint>
 #include <mutex>
 #include "dart/common/NameManager.h"
 #include "dart/dynamics/MetaSkeleton.h"
@@ -158,6 +159,16 @@ public:
   /// bodies
   bool isEnabledAdjacentBodyCheck() const;
 
+  /// Set the collision categories of all the BodyNodes in this Skeleton,
+  /// including the ones that are added to it afterwards. See
+  /// BodyNode::setCollisionCategories().
+  void setCollisionCategories(uint32_t _categories);
+
+  /// Set the collision mask of all the BodyNodes in this Skeleton, including
+  /// the ones that are added to it afterwards. See
+  /// BodyNode::setCollisionMask().
+  void setCollisionMask(uint32_t _mask);
+
   /// Set whether this skeleton will be updated by forward dynamics.
   /// \param[in] _isMobile True if this skeleton is mobile.
   void setMobile(bool _isMobile);
@@ -494,10 +505,33 @@ public:
   /// an operational space controller. Instead of being idle from t0 to t1, it
   /// could use that time to compute the forward kinematics by calling this
   /// function.
+  ///
+  /// All of the requested quantities of a BodyNode are computed together in a
+  /// single pass over the Skeleton, which is considerably faster than updating
+  /// the transforms, velocities, and accelerations in separate passes.
   void computeForwardKinematics(bool _updateTransforms = true,
                                 bool _updateVels = true,
                                 bool _updateAccs = true);
 
+  /// Compute every quantity that the const getters of this Skeleton, its
+  /// BodyNodes, Joints, EndEffectors, and the other Frames attached to its
+  /// BodyNodes would otherwise compute lazily.
+  ///
+  /// Const getters such as Frame::getWorldTransform() or getMassMatrix() update
+  /// mutable caches on demand, so two threads that query the same Skeleton at
+  /// the same time will race even if neither of them modifies it. After this
+  /// function returns, and until the state or structure of the Skeleton is
+  /// modified again, those getters only read data. This allows one Skeleton to
+  /// be shared by several reader threads (e.g. for rendering or logging)
+  /// without cloning it and without any locking.
+  ///
+  /// If _updateDynamics is false, the articulated inertias, mass matrices, and
+  /// force vectors are skipped, so only kinematic queries are safe.
+  ///
+  /// Note that getConstraintForces() recomputes its result on every call, so it
+  /// must never be called concurrently.
+  void computeAllCaches(bool _updateDynamics = true);
+
   //----------------------------------------------------------------------------
   // Dynamics algorithms
   //----------------------------------------------------------------------------
@@ -1029,6 +1063,20 @@ protected:
   /// WholeBodyIK module for this Skeleton
   std::shared_ptr<WholeBodyIK> mWholeBodyIK;
 
+  /// True if setCollisionCategories() has been called, in which case every
+  /// BodyNode that is added to this Skeleton gets mCollisionCategories
+  bool mHasCollisionCategories;
+
+  /// Collision categories of the BodyNodes that are added to this Skeleton
+  uint32_t mCollisionCategories;
+
+  /// True if setCollisionMask() has been called, in which case every BodyNode
+  /// that is added to this Skeleton gets mCollisionMask
+  bool mHasCollisionMask;
+
+  /// Collision mask of the BodyNodes that are added to this Skeleton
+  uint32_t mCollisionMask;
+
   struct DirtyFlags
   {
     /// Default constructor
@@ -36,6 +36,9 @@
 
 #include "dart/dynamics/SoftBodyNode.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
 #include <string>
 #include <vector>
@@ -181,11 +184,15 @@ void SoftBodyNode::setProperties(const UniqueProperties& _properties)
     for(size_t i = newCount; i < oldCount; ++i)
       delete mPointMasses[i];
     mPointMasses.resize(newCount);
+    mPointPositions.resize(newCount);
+    mPointStates.resize(newCount);
     mSoftP.mPointProps.resize(newCount);
   }
   else if(oldCount < newCount)
   {
     mPointMasses.resize(newCount);
+    mPointPositions.resize(newCount, Eigen::Vector3d::Zero());
+    mPointStates.resize(newCount);
     mSoftP.mPointProps.resize(newCount);
     for(size_t i = oldCount; i < newCount; ++i)
     {
@@ -206,6 +213,8 @@ void SoftBodyNode::setProperties(const UniqueProperties& _properties)
     mSoftP.mPointProps[i].mConnectedPointMassIndices =
         props.mConnectedPointMassIndices;
   }
+  mConnectionsDirty = true;
+  mPointGrid.mDirty = true;
 
   setVertexSpringStiffness(_properties.mKv);
   setEdgeSpringStiffness(_properties.mKe);
@@ -284,9 +293,11 @@ SoftBodyNode::SoftBodyNode(BodyNode* _parentBodyNode,
   : Entity(Frame::World(), "", false),
     Frame(Frame::World(), ""),
     Node(ConstructBodyNode),
-    BodyNode(_parentBodyNode, _parentJoint, _properties)
+    BodyNode(_parentBodyNode, _parentJoint, _properties),
+    mConnectionsDirty(true)
 {
   mNotifier = new PointMassNotifier(this, "PointMassNotifier");
+  mPointGrid.mDirty = true;
   setProperties(_properties);
 }
 
@@ -410,7 +421,11 @@ double SoftBodyNode::getDampingCoefficient() const
 void SoftBodyNode::removeAllPointMasses()
 {
   mPointMasses.clear();
+  mPointPositions.clear();
+  mPointStates.resize(0);
   mSoftP.mPointProps.clear();
+  mConnectionsDirty = true;
+  mPointGrid.mDirty = true;
 }
 
 //==============================================================================
@@ -418,7 +433,11 @@ PointMass* SoftBodyNode::addPointMass(const PointMass::Properties& _properties)
 {
   mPointMasses.push_back(new PointMass(this));
   mPointMasses.back()->mIndex = mPointMasses.size()-1;
+  mPointPositions.push_back(Eigen::Vector3d::Zero());
+  mPointStates.resize(mPointMasses.size());
   mSoftP.mPointProps.push_back(_properties);
+  mConnectionsDirty = true;
+  mPointGrid.mDirty = true;
 
   return mPointMasses.back();
 }
@@ -452,6 +471,34 @@ size_t SoftBodyNode::getNumFaces() const
   return mSoftP.mFaces.size();
 }
 
+//==============================================================================
+const std::vector<Eigen::Vector3d>&
+SoftBodyNode::getPointMassLocalPositions() const
+{
+  if(mNotifier->needsTransformUpdate())
+    const_cast<SoftBodyNode*>(this)->updateTransform();
+
+  return mPointPositions;
+}
+
+//==============================================================================
+PointMass* SoftBodyNode::getNearestPointMass(const Eigen::Vector3d& _point)
+{
+  return const_cast<PointMass*>(
+        static_cast<const SoftBodyNode*>(this)->getNearestPointMass(_point));
+}
+
+//==============================================================================
+const PointMass* SoftBodyNode::getNearestPointMass(
+    const Eigen::Vector3d& _point) const
+{
+  if (mPointMasses.empty())
+    return nullptr;
+
+  return mPointMasses[findNearestPointMass(getWorldTransform().inverse()
+                                           * _point)];
+}
+
 //==============================================================================
 void SoftBodyNode::clearConstraintImpulse()
 {
@@ -473,11 +520,241 @@ void SoftBodyNode::checkArticulatedInertiaUpdate() const
 void SoftBodyNode::updateTransform()
 {
   BodyNode::updateTransform();
+  updatePointMassTransforms();
+  mNotifier->clearTransformNotice();
+}
 
+//==============================================================================
+void SoftBodyNode::updatePointMassTransforms()
+{
+  size_t firstChanged = mPointMasses.size();
+  size_t lastChanged = 0;
   for (size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateTransform();
+  {
+    if (mPointMasses[i]->updateTransform())
+    {
+      firstChanged = std::min(firstChanged, i);
+      lastChanged = i + 1;
+    }
+  }
 
-  mNotifier->clearTransformNotice();
+  if (firstChanged < lastChanged)
+  {
+    mPointGrid.mDirty = true;
+    if (mSoftShape)
+      mSoftShape->notifyVerticesChanged(firstChanged, lastChanged);
+  }
+}
+
+//==============================================================================
+/// View an array of 3-vectors as the columns of a 3xN matrix
+static Eigen::Map<Eigen::Matrix3Xd> asMatrix(
+    std::vector<Eigen::Vector3d>& _vectors)
+{
+  return Eigen::Map<Eigen::Matrix3Xd>(
+        _vectors.empty() ? nullptr : _vectors.front().data(),
+        3, _vectors.size());
+}
+
+//==============================================================================
+void SoftBodyNode::PointMassStates::resize(size_t _size)
+{
+  mPositions.resize(_size, Eigen::Vector3d::Zero());
+  mVelocities.resize(_size, Eigen::Vector3d::Zero());
+  mAccelerations.resize(_size, Eigen::Vector3d::Zero());
+  mForces.resize(_size, Eigen::Vector3d::Zero());
+  mPredictedPositions.resize(_size, Eigen::Vector3d::Zero());
+  mSpringForces.resize(_size, Eigen::Vector3d::Zero());
+}
+
+//==============================================================================
+void SoftBodyNode::updatePointMassConnections()
+{
+  const size_t numPointMasses = mPointMasses.size();
+
+  mConnectionOffsets.resize(numPointMasses + 1);
+  mConnectionOffsets[0] = 0;
+  mConnectionIndices.clear();
+  for (size_t i = 0; i < numPointMasses; ++i)
+  {
+    const std::vector<size_t>& connections =
+        mSoftP.mPointProps[i].mConnectedPointMassIndices;
+    mConnectionIndices.insert(mConnectionIndices.end(),
+                              connections.begin(), connections.end());
+    mConnectionOffsets[i + 1] = mConnectionIndices.size();
+  }
+
+  mConnectionsDirty = false;
+}
+
+//==============================================================================
+void SoftBodyNode::updatePointMassSpringForces(double _timeStep)
+{
+  if (mConnectionsDirty)
+    updatePointMassConnections();
+
+  const double kv = getVertexSpringStiffness();
+  const double ke = getEdgeSpringStiffness();
+  const double kd = getDampingCoefficient();
+
+  // The springs are evaluated implicitly at the predicted positions
+  // y = q + dt*dq, so the force on point mass i is
+  //   tau - kd*dq - kv*y + ke * sum_j (y_j - y_i)
+  Eigen::Map<Eigen::Matrix3Xd> y = asMatrix(mPointStates.mPredictedPositions);
+  Eigen::Map<Eigen::Matrix3Xd> f = asMatrix(mPointStates.mSpringForces);
+  const Eigen::Map<Eigen::Matrix3Xd> q = asMatrix(mPointStates.mPositions);
+  const Eigen::Map<Eigen::Matrix3Xd> dq = asMatrix(mPointStates.mVelocities);
+  const Eigen::Map<Eigen::Matrix3Xd> tau = asMatrix(mPointStates.mForces);
+
+  y = q + _timeStep * dq;
+  f = tau - kd * dq - kv * y;
+
+  if (ke == 0.0)
+    return;
+
+  const std::vector<Eigen::Vector3d>& Y = mPointStates.mPredictedPositions;
+  for (size_t i = 0; i < mPointMasses.size(); ++i)
+  {
+    Eigen::Vector3d stretch = Eigen::Vector3d::Zero();
+    for (size_t k = mConnectionOffsets[i]; k < mConnectionOffsets[i + 1]; ++k)
+      stretch += Y[mConnectionIndices[k]];
+    stretch -= static_cast<double>(mConnectionOffsets[i + 1]
+                                   - mConnectionOffsets[i]) * Y[i];
+
+    mPointStates.mSpringForces[i] += ke * stretch;
+  }
+}
+
+//==============================================================================
+void SoftBodyNode::updatePointMassGrid() const
+{
+  const std::vector<Eigen::Vector3d>& X = getPointMassLocalPositions();
+  const size_t numPointMasses = X.size();
+
+  Eigen::Vector3d lower = X[0];
+  Eigen::Vector3d upper = X[0];
+  for (const Eigen::Vector3d& x : X)
+  {
+    lower = lower.cwiseMin(x);
+    upper = upper.cwiseMax(x);
+  }
+
+  // Aim for about one point mass per cell along the longest axis
+  const Eigen::Vector3d extent = upper - lower;
+  const double cellsPerAxis = std::ceil(std::cbrt(numPointMasses));
+  mPointGrid.mCellSize = std::max(extent.maxCoeff() / cellsPerAxis, 1e-9);
+  mPointGrid.mOrigin = lower;
+  for (int i = 0; i < 3; ++i)
+  {
+    mPointGrid.mDims[i] = std::max(
+          1, static_cast<int>(std::ceil(extent[i] / mPointGrid.mCellSize)));
+  }
+
+  // Counting sort of the point masses into the cells
+  const size_t numCells = static_cast<size_t>(mPointGrid.mDims.prod());
+  std::vector<size_t> cells(numPointMasses);
+  mPointGrid.mCellOffsets.assign(numCells + 1, 0);
+  for (size_t i = 0; i < numPointMasses; ++i)
+  {
+    const Eigen::Vector3i c = ((X[i] - lower) / mPointGrid.mCellSize)
+        .cast<int>().cwiseMax(0).cwiseMin(mPointGrid.mDims
+                                          - Eigen::Vector3i::Ones());
+    cells[i] = (c[2] * mPointGrid.mDims[1] + c[1]) * mPointGrid.mDims[0] + c[0];
+    ++mPointGrid.mCellOffsets[cells[i] + 1];
+  }
+
+  for (size_t c = 0; c < numCells; ++c)
+    mPointGrid.mCellOffsets[c + 1] += mPointGrid.mCellOffsets[c];
+
+  std::vector<size_t> next(mPointGrid.mCellOffsets.begin(),
+                           mPointGrid.mCellOffsets.end() - 1);
+  mPointGrid.mPointIndices.resize(numPointMasses);
+  for (size_t i = 0; i < numPointMasses; ++i)
+    mPointGrid.mPointIndices[next[cells[i]]++] = i;
+
+  mPointGrid.mDirty = false;
+}
+
+//==============================================================================
+size_t SoftBodyNode::findNearestPointMass(
+    const Eigen::Vector3d& _localPoint) const
+{
+  const std::vector<Eigen::Vector3d>& X = getPointMassLocalPositions();
+  if (mPointGrid.mDirty)
+    updatePointMassGrid();
+
+  const Eigen::Vector3i& dims = mPointGrid.mDims;
+  const Eigen::Vector3i center
+      = ((_localPoint - mPointGrid.mOrigin) / mPointGrid.mCellSize)
+        .array().floor().cast<int>().matrix()
+        .cwiseMax(0).cwiseMin(dims - Eigen::Vector3i::Ones());
+
+  size_t nearest = 0;
+  double minDistSq = std::numeric_limits<double>::infinity();
+
+  // Visit the shells of cells around the cell of the query point. Every point
+  // mass in shell r+1 or beyond is at least r cells away, so the search stops
+  // once the nearest point mass found so far is closer than that.
+  const int maxRadius = dims.maxCoeff();
+  for (int r = 0; r <= maxRadius; ++r)
+  {
+    const Eigen::Vector3i lo = (center.array() - r).max(0).matrix();
+    const Eigen::Vector3i hi = (center.array() + r).min(dims.array() - 1)
+                               .matrix();
+    for (int k = lo[2]; k <= hi[2]; ++k)
+    {
+      for (int j = lo[1]; j <= hi[1]; ++j)
+      {
+        for (int i = lo[0]; i <= hi[0]; ++i)
+        {
+          const Eigen::Vector3i offset
+              = (Eigen::Vector3i(i, j, k) - center).cwiseAbs();
+          if (offset.maxCoeff() != r)
+            continue;
+
+          const size_t cell = (k * dims[1] + j) * dims[0] + i;
+          for (size_t n = mPointGrid.mCellOffsets[cell];
+               n < mPointGrid.mCellOffsets[cell + 1]; ++n)
+          {
+            const size_t index = mPointGrid.mPointIndices[n];
+            const double distSq = (X[index] - _localPoint).squaredNorm();
+            if (distSq < minDistSq)
+            {
+              minDistSq = distSq;
+              nearest = index;
+            }
+          }
+        }
+      }
+    }
+
+    const double reach = r * mPointGrid.mCellSize;
+    if (minDistSq <= reach * reach)
+      break;
+  }
+
+  return nearest;
+}
+
+//==============================================================================
+void SoftBodyNode::integratePointMassPositions(double _dt)
+{
+  if (mPointMasses.empty())
+    return;
+
+  asMatrix(mPointStates.mPositions) += _dt * asMatrix(mPointStates.mVelocities);
+  mNotifier->notifyTransformUpdate();
+}
+
+//==============================================================================
+void SoftBodyNode::integratePointMassVelocities(double _dt)
+{
+  if (mPointMasses.empty())
+    return;
+
+  asMatrix(mPointStates.mVelocities)
+      += _dt * asMatrix(mPointStates.mAccelerations);
+  mNotifier->notifyVelocityUpdate();
 }
 
 //==============================================================================
@@ -485,8 +762,15 @@ void SoftBodyNode::updateVelocity()
 {
   BodyNode::updateVelocity();
 
+  // v = w(parent) x mX + v(parent) + dq
+  const std::vector<Eigen::Vector3d>& X = getPointMassLocalPositions();
+  const Eigen::Vector6d& V = getSpatialVelocity();
   for (size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateVelocity();
+  {
+    mPointMasses[i]->mV = V.head<3>().cross(X[i]) + V.tail<3>()
+                          + mPointStates.mVelocities[i];
+    assert(!math::isNan(mPointMasses[i]->mV));
+  }
 
   mNotifier->clearVelocityNotice();
 }
@@ -496,12 +780,53 @@ void SoftBodyNode::updatePartialAcceleration() const
 {
   BodyNode::updatePartialAcceleration();
 
+  // eta = w(parent) x dq
+  const Eigen::Vector3d w = getSpatialVelocity().head<3>();
   for (size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updatePartialAcceleration();
+  {
+    mPointMasses[i]->mEta = w.cross(mPointStates.mVelocities[i]);
+    assert(!math::isNan(mPointMasses[i]->mEta));
+  }
 
   mNotifier->clearPartialAccelerationNotice();
 }
 
+//==============================================================================
+void SoftBodyNode::updateKinematics(bool _updateTransform,
+                                    bool _updateVelocity,
+                                    bool _updateAcceleration)
+{
+  BodyNode::updateKinematics(_updateTransform, _updateVelocity,
+                             _updateAcceleration);
+
+  if (_updateTransform)
+    updatePointMassTransforms();
+
+  for (auto& pointMass : mPointMasses)
+  {
+    if (_updateVelocity)
+    {
+      pointMass->updateVelocity();
+      pointMass->updatePartialAcceleration();
+    }
+
+    if (_updateAcceleration)
+      pointMass->updateAccelerationID();
+  }
+
+  if (_updateTransform)
+    mNotifier->clearTransformNotice();
+
+  if (_updateVelocity)
+  {
+    mNotifier->clearVelocityNotice();
+    mNotifier->clearPartialAccelerationNotice();
+  }
+
+  if (_updateAcceleration)
+    mNotifier->clearAccelerationNotice();
+}
+
 //==============================================================================
 void SoftBodyNode::updateAccelerationID()
 {
@@ -643,8 +968,43 @@ void SoftBodyNode::updateBiasForce(const Eigen::Vector3d& _gravity,
                                    double _timeStep)
 {
   const Eigen::Matrix6d& mI = mBodyP.mInertia.getSpatialTensor();
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateBiasForceFD(_timeStep, _gravity);
+  const Eigen::Vector6d& V = getSpatialVelocity();
+
+  // Point masses: the force kernel runs over the whole state arrays first,
+  // then the per-point terms that depend on the motion of this body
+  updatePointMassSpringForces(_timeStep);
+  checkArticulatedInertiaUpdate();
+  if (mNotifier->needsVelocityUpdate())
+    updateVelocity();
+  if (mNotifier->needsPartialAccelerationUpdate())
+    updatePartialAcceleration();
+
+  Eigen::Vector3d localGravity = Eigen::Vector3d::Zero();
+  if (mBodyP.mGravityMode == true)
+    localGravity = getWorldTransform().linear().transpose() * _gravity;
+
+  const Eigen::Vector3d w = V.head<3>();
+  for (size_t i = 0; i < mPointMasses.size(); ++i)
+  {
+    PointMass* pointMass = mPointMasses[i];
+    const double mass = mSoftP.mPointProps[i].mMass;
+
+    // B = w(parent) x m*v - fext - fgravity
+    pointMass->mB = w.cross(mass * pointMass->mV) - pointMass->mFext
+                    - mass * localGravity;
+    assert(!math::isNan(pointMass->mB));
+
+    // Cache data: alpha
+    pointMass->mAlpha = mPointStates.mSpringForces[i]
+                        - mass * pointMass->mEta - pointMass->mB;
+    assert(!math::isNan(pointMass->mAlpha));
+
+    // Cache data: beta
+    pointMass->mBeta = pointMass->mB;
+    pointMass->mBeta.noalias() += mass * (pointMass->mEta
+                          + pointMass->mImplicitPsi * pointMass->mAlpha);
+    assert(!math::isNan(pointMass->mBeta));
+  }
 
   // Gravity force
   if (mBodyP.mGravityMode == true)
@@ -653,7 +1013,6 @@ void SoftBodyNode::updateBiasForce(const Eigen::Vector3d& _gravity,
     mFgravity.setZero();
 
   // Set bias force
-  const Eigen::Vector6d& V = getSpatialVelocity();
   mBiasForce = -math::dad(V, mI * V) - mFext - mFgravity;
 
   // Verifycation
@@ -692,8 +1051,28 @@ void SoftBodyNode::updateAccelerationFD()
 {
   BodyNode::updateAccelerationFD();
 
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateAccelerationFD();
+  checkArticulatedInertiaUpdate();
+  if (mNotifier->needsPartialAccelerationUpdate())
+    updatePartialAcceleration();
+
+  const std::vector<Eigen::Vector3d>& X = getPointMassLocalPositions();
+  const Eigen::Vector6d& a_parent = getSpatialAcceleration();
+  for (size_t i = 0; i < mPointMasses.size(); ++i)
+  {
+    PointMass* pointMass = mPointMasses[i];
+    const double mass = mSoftP.mPointProps[i].mMass;
+
+    // ddq = imp_psi*(alpha - m*(dw(parent) x mX + dv(parent))
+    const Eigen::Vector3d a_frame
+        = a_parent.head<3>().cross(X[i]) + a_parent.tail<3>();
+    Eigen::Vector3d& ddq = mPointStates.mAccelerations[i];
+    ddq = pointMass->mImplicitPsi * (pointMass->mAlpha - mass * a_frame);
+    assert(!math::isNan(ddq));
+
+    // dv = dw(parent) x mX + dv(parent) + eata + ddq
+    pointMass->mA = a_frame + pointMass->mEta + ddq;
+    assert(!math::isNan(pointMass->mA));
+  }
 
   mNotifier->clearAccelerationNotice();
 }
@@ -703,8 +1082,14 @@ void SoftBodyNode::updateTransmittedForceFD()
 {
   BodyNode::updateTransmittedForceFD();
 
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateTransmittedForce();
+  // f = m*dv + B
+  for (size_t i = 0; i < mPointMasses.size(); ++i)
+  {
+    PointMass* pointMass = mPointMasses[i];
+    pointMass->mF = pointMass->mB;
+    pointMass->mF.noalias() += mSoftP.mPointProps[i].mMass * pointMass->mA;
+    assert(!math::isNan(pointMass->mF));
+  }
 }
 
 //==============================================================================
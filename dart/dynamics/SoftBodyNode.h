@@ -200,6 +200,21 @@ public:
   /// \brief
   size_t getNumFaces() const;
 
+  /// Get the local positions of all the PointMasses in the order of their
+  /// indices. They are stored in one contiguous buffer, which is also the
+  /// vertex buffer of the SoftMeshShape.
+  const std::vector<Eigen::Vector3d>& getPointMassLocalPositions() const;
+
+  /// Get the PointMass nearest to _point, which is expressed in the world
+  /// frame. The search uses a uniform grid over the local positions of the
+  /// point masses, which is rebuilt only after they have moved. Returns
+  /// nullptr if this SoftBodyNode has no point masses.
+  PointMass* getNearestPointMass(const Eigen::Vector3d& _point);
+
+  /// Get the PointMass nearest to _point, which is expressed in the world
+  /// frame
+  const PointMass* getNearestPointMass(const Eigen::Vector3d& _point) const;
+
   // Documentation inherited.
   virtual void clearConstraintImpulse() override;
 
@@ -232,6 +247,14 @@ protected:
   /// Update articulated inertia if necessary
   void checkArticulatedInertiaUpdate() const;
 
+  /// Integrate the positions of all the point masses in a single pass over
+  /// the state arrays
+  void integratePointMassPositions(double _dt);
+
+  /// Integrate the velocities of all the point masses in a single pass over
+  /// the state arrays
+  void integratePointMassVelocities(double _dt);
+
   // Documentation inherited.
   virtual void updateTransform() override;
 
@@ -241,6 +264,11 @@ protected:
   // Documentation inherited.
   virtual void updatePartialAcceleration() const override;
 
+  // Documentation inherited.
+  virtual void updateKinematics(bool _updateTransform,
+                                bool _updateVelocity,
+                                bool _updateAcceleration) override;
+
   // Documentation inherited.
   virtual void updateArtInertia(double _timeStep) const override;
 
@@ -353,6 +381,69 @@ protected:
   /// \brief List of point masses composing deformable mesh.
   std::vector<PointMass*> mPointMasses;
 
+  /// Local positions of the point masses, which are written by
+  /// PointMass::updateTransform()
+  std::vector<Eigen::Vector3d> mPointPositions;
+
+  /// Generalized coordinates of the point masses, stored as one array per
+  /// quantity so that each array can be viewed as a 3xN matrix. A PointMass
+  /// reads and writes the entries at its own index.
+  struct PointMassStates
+  {
+    std::vector<Eigen::Vector3d> mPositions;
+    std::vector<Eigen::Vector3d> mVelocities;
+    std::vector<Eigen::Vector3d> mAccelerations;
+    std::vector<Eigen::Vector3d> mForces;
+
+    /// Positions predicted at the end of the time step, q + dt*dq
+    std::vector<Eigen::Vector3d> mPredictedPositions;
+
+    /// Sum of the applied, spring, and damping forces on each point mass
+    std::vector<Eigen::Vector3d> mSpringForces;
+
+    /// Resize every array, zero-initializing any new entries
+    void resize(size_t _size);
+  };
+
+  /// State of the point masses
+  PointMassStates mPointStates;
+
+  /// Connectivity of the point masses in compressed row form: the neighbors
+  /// of point mass i are mConnectionIndices[mConnectionOffsets[i]] up to
+  /// mConnectionIndices[mConnectionOffsets[i+1]]
+  std::vector<size_t> mConnectionOffsets;
+
+  /// Concatenated neighbor lists of the point masses
+  std::vector<size_t> mConnectionIndices;
+
+  /// True if mConnectionOffsets and mConnectionIndices need to be rebuilt
+  bool mConnectionsDirty;
+
+  /// Uniform grid over mPointPositions for nearest point mass queries. The
+  /// point masses in cell c are mPointIndices[mCellOffsets[c]] up to
+  /// mPointIndices[mCellOffsets[c+1]].
+  struct PointMassGrid
+  {
+    /// Lower corner of the grid in the frame of the SoftBodyNode
+    Eigen::Vector3d mOrigin;
+
+    /// Edge length of the cubic cells
+    double mCellSize;
+
+    /// Number of cells along each axis
+    Eigen::Vector3i mDims;
+
+    std::vector<size_t> mCellOffsets;
+
+    std::vector<size_t> mPointIndices;
+
+    /// True if the grid needs to be rebuilt before the next query
+    bool mDirty;
+  };
+
+  /// Spatial index of the point masses
+  mutable PointMassGrid mPointGrid;
+
   /// An Entity which tracks when the point masses need to be updated
   PointMassNotifier* mNotifier;
 
@@ -381,6 +472,24 @@ private:
 
   ///
   void updateInertiaWithPointMass();
+
+  /// Update the transforms of the point masses and tell the SoftMeshShape
+  /// which of its vertices have moved
+  void updatePointMassTransforms();
+
+  /// Rebuild the compressed connectivity from the point mass properties
+  void updatePointMassConnections();
+
+  /// Compute the applied, spring, and damping forces of all the point masses
+  /// into mPointStates.mSpringForces
+  void updatePointMassSpringForces(double _timeStep);
+
+  /// Rebuild mPointGrid from the current local positions of the point masses
+  void updatePointMassGrid() const;
+
+  /// Get the index of the point mass nearest to _localPoint, which is
+  /// expressed in the frame of this SoftBodyNode
+  size_t findNearestPointMass(const Eigen::Vector3d& _localPoint) const;
 };
 
 class SoftBodyNodeHelper
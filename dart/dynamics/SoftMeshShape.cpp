@@ -36,6 +36,9 @@
 
 #include "dart/dynamics/SoftMeshShape.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "dart/common/Console.h"
 
 #include "dart/dynamics/PointMass.h"
@@ -47,7 +50,10 @@ namespace dynamics {
 SoftMeshShape::SoftMeshShape(SoftBodyNode* _softBodyNode)
   : Shape(SOFT_MESH),
     mSoftBodyNode(_softBodyNode),
-    mAssimpMesh(nullptr)
+    mAssimpMesh(nullptr),
+    mVertexVersion(0),
+    mDirtyVertices(0, 0),
+    mAssimpMeshVersion(std::numeric_limits<size_t>::max())
 {
   assert(_softBodyNode != nullptr);
   // Build mesh here using soft body node
@@ -71,6 +77,33 @@ const SoftBodyNode* SoftMeshShape::getSoftBodyNode() const
   return mSoftBodyNode;
 }
 
+const std::vector<Eigen::Vector3d>& SoftMeshShape::getVertices() const
+{
+  return mSoftBodyNode->getPointMassLocalPositions();
+}
+
+size_t SoftMeshShape::getVertexVersion() const
+{
+  // Bring the vertices up to date first, which may change the version
+  mSoftBodyNode->getPointMassLocalPositions();
+  return mVertexVersion;
+}
+
+const std::pair<size_t, size_t>& SoftMeshShape::getDirtyVertices() const
+{
+  mSoftBodyNode->getPointMassLocalPositions();
+  return mDirtyVertices;
+}
+
+void SoftMeshShape::notifyVerticesChanged(size_t _first, size_t _last)
+{
+  if (!checkDataVariance(DYNAMIC_VERTICES))
+    return;
+
+  ++mVertexVersion;
+  mDirtyVertices = std::make_pair(_first, _last);
+}
+
 Eigen::Matrix3d SoftMeshShape::computeInertia(double _mass) const
 {
   // TODO(JS): Not implemented.
@@ -129,16 +162,28 @@ void SoftMeshShape::_buildMesh()
 
 void SoftMeshShape::update()
 {
-  size_t nVertices = mSoftBodyNode->getNumPointMasses();
+  const std::vector<Eigen::Vector3d>& vertices = getVertices();
+  if (mAssimpMeshVersion == mVertexVersion)
+    return;
+
+  // Only the latest changes need to be copied if the mesh has seen the
+  // version before them
+  size_t first = 0;
+  size_t last = std::min<size_t>(vertices.size(), mAssimpMesh->mNumVertices);
+  if (mAssimpMeshVersion != std::numeric_limits<size_t>::max()
+      && mAssimpMeshVersion + 1 == mVertexVersion)
+  {
+    first = mDirtyVertices.first;
+    last = std::min(last, mDirtyVertices.second);
+  }
 
-  aiVector3D itAIVector3d;
-  for (size_t i = 0; i < nVertices; ++i)
+  for (size_t i = first; i < last; ++i)
   {
-    PointMass* itPointMass        = mSoftBodyNode->getPointMass(i);
-    const Eigen::Vector3d& vertex = itPointMass->getLocalPosition();
-    itAIVector3d.Set(vertex[0], vertex[1], vertex[2]);
-    mAssimpMesh->mVertices[i] = itAIVector3d;
+    const Eigen::Vector3d& vertex = vertices[i];
+    mAssimpMesh->mVertices[i].Set(vertex[0], vertex[1], vertex[2]);
   }
+
+  mAssimpMeshVersion = mVertexVersion;
 }
 
 }  // namespace dynamics
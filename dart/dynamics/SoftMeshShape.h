@@ -37,6 +37,9 @@
 #ifndef DART_DYNAMICS_SOFTMESHSHAPE_H_
 #define DART_DYNAMICS_SOFTMESHSHAPE_H_
 
+#include <utility>
+#include <vector>
+
 #include <assimp/scene.h>
 #include "dart/dynamics/Shape.h"
 #include <Eigen/Dense>
@@ -56,13 +59,30 @@ public:
   /// \brief Destructor.
   virtual ~SoftMeshShape();
 
-  /// \brief
+  /// Get an Assimp copy of the mesh. Its vertices are only brought up to date
+  /// by update().
   const aiMesh* getAssimpMesh() const;
 
   /// Get the SoftBodyNode that is associated with this SoftMeshShape
   const SoftBodyNode* getSoftBodyNode() const;
 
-  /// \brief Update positions of the vertices using the parent soft body node.
+  /// Get the vertices of this mesh in the frame of the SoftBodyNode. This is
+  /// the buffer of PointMass positions of the SoftBodyNode itself, so it is
+  /// always current and can be read without copying.
+  const std::vector<Eigen::Vector3d>& getVertices() const;
+
+  /// Get a number that changes whenever any of the vertices move. Vertex
+  /// changes are only tracked while the DataVariance of this shape includes
+  /// DYNAMIC_VERTICES, which it does by default.
+  size_t getVertexVersion() const;
+
+  /// Get the range [first, last) of the vertices that moved in the latest
+  /// change of the vertex version. Anything that has seen the previous version
+  /// only needs to update this range.
+  const std::pair<size_t, size_t>& getDirtyVertices() const;
+
+  /// \brief Update the vertices of the Assimp mesh. This is only needed by
+  /// users of getAssimpMesh().
   void update();
 
   // Documentation inherited.
@@ -75,9 +95,14 @@ public:
       bool                       _default = true) const;
 
 protected:
+  friend class SoftBodyNode;
+
   // Documentation inherited.
   virtual void computeVolume();
 
+  /// Called by the SoftBodyNode after the vertices [_first, _last) moved
+  void notifyVerticesChanged(size_t _first, size_t _last);
+
 private:
   /// \brief Build mesh using SoftBodyNode data
   void _buildMesh();
@@ -87,6 +112,16 @@ private:
 
   /// \brief
   aiMesh* mAssimpMesh;
+
+  /// Incremented whenever the vertices move
+  size_t mVertexVersion;
+
+  /// Vertices that moved in the latest version
+  std::pair<size_t, size_t> mDirtyVertices;
+
+  /// Vertex version that mAssimpMesh was last updated to, or the largest
+  /// size_t if it has never been updated
+  size_t mAssimpMeshVersion;
 };
 
 }  // namespace dynamics
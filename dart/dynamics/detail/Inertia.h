@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Author(s): Jeongseok Lee <jslee02@gmail.com>
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_DETAIL_INERTIA_H_
+#define DART_DYNAMICS_DETAIL_INERTIA_H_
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+// Note: Taken from Springer Handbook, chapter 2.2.11
+template <typename Scalar>
+math::Matrix6<Scalar> Inertia::computeSpatialTensor(
+    const Scalar& _mass,
+    const Eigen::Matrix<Scalar, 3, 1>& _com,
+    const Eigen::Matrix<Scalar, 3, 3>& _moment)
+{
+  Eigen::Matrix<Scalar, 3, 3> C;
+  C << Scalar(0), -_com[2],   _com[1],
+         _com[2], Scalar(0), -_com[0],
+        -_com[1],   _com[0], Scalar(0);
+
+  math::Matrix6<Scalar> spatial;
+
+  // Top left
+  spatial.template block<3,3>(0,0) = _moment + _mass*C*C.transpose();
+
+  // Bottom left
+  spatial.template block<3,3>(3,0) = _mass*C.transpose();
+
+  // Top right
+  spatial.template block<3,3>(0,3) = _mass*C;
+
+  // Bottom right
+  spatial.template block<3,3>(3,3)
+      = _mass*Eigen::Matrix<Scalar, 3, 3>::Identity();
+
+  return spatial;
+}
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_DETAIL_INERTIA_H_
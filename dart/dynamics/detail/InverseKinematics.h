@@ -44,6 +44,7 @@ IKErrorMethod& InverseKinematics::setErrorMethod(Args&&... args)
   IKErrorMethod* newMethod =
       new IKErrorMethod(this, std::forward<Args>(args)...);
   mErrorMethod = std::unique_ptr<IKErrorMethod>(newMethod);
+  ++mConfigurationVersion;
   return *newMethod;
 }
 
@@ -54,6 +55,7 @@ IKGradientMethod& InverseKinematics::setGradientMethod(Args&&... args)
   IKGradientMethod* newMethod =
       new IKGradientMethod(this, std::forward<Args>(args)...);
   mGradientMethod = std::unique_ptr<IKGradientMethod>(newMethod);
+  ++mConfigurationVersion;
   return *newMethod;
 }
 
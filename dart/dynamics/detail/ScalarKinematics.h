@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Author(s): Jeongseok Lee <jslee02@gmail.com>
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_DETAIL_SCALARKINEMATICS_H_
+#define DART_DYNAMICS_DETAIL_SCALARKINEMATICS_H_
+
+#include "dart/common/Console.h"
+#include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/RevoluteJoint.h"
+#include "dart/dynamics/PrismaticJoint.h"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+template <typename Scalar>
+Eigen::aligned_vector<math::Isometry3<Scalar>> computeWorldTransforms(
+    const Skeleton& _skeleton,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& _positions)
+{
+  Eigen::aligned_vector<math::Isometry3<Scalar>> transforms;
+
+  if (static_cast<size_t>(_positions.size()) != _skeleton.getNumDofs())
+  {
+    dterr << "[computeWorldTransforms] Mismatch between the number of "
+          << "positions [" << _positions.size() << "] and the number of DOFs ["
+          << _skeleton.getNumDofs() << "] of Skeleton named ["
+          << _skeleton.getName() << "].\n";
+    return transforms;
+  }
+
+  const size_t numBodyNodes = _skeleton.getNumBodyNodes();
+  transforms.reserve(numBodyNodes);
+
+  // BodyNodes are stored so that every parent comes before its children
+  for (size_t i = 0; i < numBodyNodes; ++i)
+  {
+    const BodyNode* bodyNode = _skeleton.getBodyNode(i);
+    const Joint* joint = bodyNode->getParentJoint();
+
+    math::Isometry3<Scalar> relative;
+    if (joint->getNumDofs() == 0)
+    {
+      relative = joint->getLocalTransform().template cast<Scalar>();
+    }
+    else if (joint->getType() == RevoluteJoint::getStaticType())
+    {
+      relative = static_cast<const RevoluteJoint*>(joint)
+          ->computeRelativeTransform(
+            _positions[joint->getIndexInSkeleton(0)]);
+    }
+    else if (joint->getType() == PrismaticJoint::getStaticType())
+    {
+      relative = static_cast<const PrismaticJoint*>(joint)
+          ->computeRelativeTransform(
+            _positions[joint->getIndexInSkeleton(0)]);
+    }
+    else
+    {
+      dterr << "[computeWorldTransforms] Unsupported Joint type ["
+            << joint->getType() << "] for Joint named [" << joint->getName()
+            << "] of Skeleton named [" << _skeleton.getName() << "].\n";
+      transforms.clear();
+      return transforms;
+    }
+
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+    if (parent)
+      transforms.push_back(transforms[parent->getIndexInSkeleton()] * relative);
+    else
+      transforms.push_back(relative);
+  }
+
+  return transforms;
+}
+
+//==============================================================================
+template <typename Scalar>
+Eigen::Matrix<Scalar, 3, 1> computeCOM(
+    const Skeleton& _skeleton,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& _positions)
+{
+  Eigen::Matrix<Scalar, 3, 1> com = Eigen::Matrix<Scalar, 3, 1>::Zero();
+
+  const Eigen::aligned_vector<math::Isometry3<Scalar>> transforms
+      = computeWorldTransforms(_skeleton, _positions);
+  if (transforms.size() != _skeleton.getNumBodyNodes())
+    return com;
+
+  Scalar totalMass(0);
+  for (size_t i = 0; i < transforms.size(); ++i)
+  {
+    const BodyNode* bodyNode = _skeleton.getBodyNode(i);
+    const Scalar mass(bodyNode->getMass());
+    com += mass * (transforms[i]
+                   * bodyNode->getLocalCOM().template cast<Scalar>());
+    totalMass += mass;
+  }
+
+  if (totalMass > Scalar(0))
+    com /= totalMass;
+
+  return com;
+}
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_DETAIL_SCALARKINEMATICS_H_
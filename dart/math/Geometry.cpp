@@ -624,15 +624,7 @@ Eigen::Vector6d logMap(const Eigen::Isometry3d& _T) {
 
 // res = T * s * Inv(T)
 Eigen::Vector6d AdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V) {
-  //--------------------------------------------------------------------------
-  // w' = R*w
-  // v' = p x R*w + R*v
-  //--------------------------------------------------------------------------
-  Eigen::Vector6d res;
-  res.head<3>().noalias() = _T.linear() * _V.head<3>();
-  res.tail<3>().noalias() = _T.linear() * _V.tail<3>() +
-                            _T.translation().cross(res.head<3>());
-  return res;
+  return AdT<double>(_T, _V);
 }
 
 //==============================================================================
@@ -650,14 +642,7 @@ Eigen::Matrix6d getAdTMatrix(const Eigen::Isometry3d& T)
 }
 
 Eigen::Vector6d AdR(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V) {
-  //--------------------------------------------------------------------------
-  // w' = R*w
-  // v' = R*v
-  //--------------------------------------------------------------------------
-  Eigen::Vector6d res;
-  res.head<3>().noalias() = _T.linear() * _V.head<3>();
-  res.tail<3>().noalias() = _T.linear() * _V.tail<3>();
-  return res;
+  return AdR<double>(_T, _V);
 }
 
 Eigen::Vector6d AdTAngular(const Eigen::Isometry3d& _T,
@@ -714,12 +699,7 @@ Eigen::Vector6d AdTLinear(const Eigen::Isometry3d& _T,
 
 // re = Inv(T)*s*T
 Eigen::Vector6d AdInvT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V) {
-  Eigen::Vector6d res;
-  res.head<3>().noalias() = _T.linear().transpose() * _V.head<3>();
-  res.tail<3>().noalias() =
-      _T.linear().transpose()
-      * (_V.tail<3>() + _V.head<3>().cross(_T.translation()));
-  return res;
+  return AdInvT<double>(_T, _V);
 }
 
 // se3 AdInvR(const SE3& T, const se3& s)
@@ -744,27 +724,11 @@ Eigen::Vector6d AdInvRLinear(const Eigen::Isometry3d& _T,
 }
 
 Eigen::Vector6d ad(const Eigen::Vector6d& _X, const Eigen::Vector6d& _Y) {
-  //--------------------------------------------------------------------------
-  // ad(s1, s2) = | [w1]    0 | | w2 |
-  //              | [v1] [w1] | | v2 |
-  //
-  //            = |          [w1]w2 |
-  //              | [v1]w2 + [w1]v2 |
-  //--------------------------------------------------------------------------
-  Eigen::Vector6d res;
-  res.head<3>() = _X.head<3>().cross(_Y.head<3>());
-  res.tail<3>() = _X.head<3>().cross(_Y.tail<3>()) +
-                  _X.tail<3>().cross(_Y.head<3>());
-  return res;
+  return ad<double>(_X, _Y);
 }
 
 Eigen::Vector6d dAdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _F) {
-  Eigen::Vector6d res;
-  res.head<3>().noalias() =
-      _T.linear().transpose()
-      * (_F.head<3>() + _F.tail<3>().cross(_T.translation()));
-  res.tail<3>().noalias() = _T.linear().transpose() * _F.tail<3>();
-  return res;
+  return dAdT<double>(_T, _F);
 }
 
 // dse3 dAdTLinear(const SE3& T, const Vec3& v)
@@ -785,19 +749,12 @@ Eigen::Vector6d dAdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _F) {
 
 Eigen::Vector6d dAdInvT(const Eigen::Isometry3d& _T,
                         const Eigen::Vector6d& _F) {
-  Eigen::Vector6d res;
-  res.tail<3>().noalias() = _T.linear() * _F.tail<3>();
-  res.head<3>().noalias() = _T.linear() * _F.head<3>();
-  res.head<3>() += _T.translation().cross(res.tail<3>());
-  return res;
+  return dAdInvT<double>(_T, _F);
 }
 
 Eigen::Vector6d dAdInvR(const Eigen::Isometry3d& _T,
                         const Eigen::Vector6d& _F) {
-  Eigen::Vector6d res;
-  res.head<3>().noalias() = _T.linear() * _F.head<3>();
-  res.tail<3>().noalias() = _T.linear() * _F.tail<3>();
-  return res;
+  return dAdInvR<double>(_T, _F);
 }
 
 // dse3 dAdInvPLinear(const Vec3& p, const Vec3& f)
@@ -1176,74 +1133,12 @@ Eigen::Matrix3d eulerZYZToMatrix(const Eigen::Vector3d& _angle) {
 // p = sin(t) / t*v + (t - sin(t)) / t^3*<w, v>*w + (1 - cos(t)) / t^2*(w X v)
 // , when S = (w, v), t = |w|
 Eigen::Isometry3d expMap(const Eigen::Vector6d& _S) {
-  Eigen::Isometry3d ret = Eigen::Isometry3d::Identity();
-  double s2[] = { _S[0]*_S[0], _S[1]*_S[1], _S[2]*_S[2] };
-  double s3[] = { _S[0]*_S[1], _S[1]*_S[2], _S[2]*_S[0] };
-  double theta = sqrt(s2[0] + s2[1] + s2[2]);
-  double cos_t = cos(theta), alpha, beta, gamma;
-
-  if (theta > DART_EPSILON) {
-    double sin_t = sin(theta);
-    alpha = sin_t / theta;
-    beta = (1.0 - cos_t) / theta / theta;
-    gamma = (_S[0]*_S[3] + _S[1]*_S[4] + _S[2]*_S[5])
-            * (theta - sin_t) / theta / theta / theta;
-  } else {
-    alpha = 1.0 - theta*theta/6.0;
-    beta = 0.5 - theta*theta/24.0;
-    gamma = (_S[0]*_S[3] + _S[1]*_S[4] + _S[2]*_S[5])/6.0 - theta*theta/120.0;
-  }
-
-  ret(0, 0) = beta*s2[0] + cos_t;
-  ret(1, 0) = beta*s3[0] + alpha*_S[2];
-  ret(2, 0) = beta*s3[2] - alpha*_S[1];
-
-  ret(0, 1) = beta*s3[0] - alpha*_S[2];
-  ret(1, 1) = beta*s2[1] + cos_t;
-  ret(2, 1) = beta*s3[1] + alpha*_S[0];
-
-  ret(0, 2) = beta*s3[2] + alpha*_S[1];
-  ret(1, 2) = beta*s3[1] - alpha*_S[0];
-  ret(2, 2) = beta*s2[2] + cos_t;
-
-  ret(0, 3) = alpha*_S[3] + beta*(_S[1]*_S[5] - _S[2]*_S[4]) + gamma*_S[0];
-  ret(1, 3) = alpha*_S[4] + beta*(_S[2]*_S[3] - _S[0]*_S[5]) + gamma*_S[1];
-  ret(2, 3) = alpha*_S[5] + beta*(_S[0]*_S[4] - _S[1]*_S[3]) + gamma*_S[2];
-
-  return ret;
+  return expMap<double>(_S);
 }
 
 // I + sin(t) / t*[S] + (1 - cos(t)) / t^2*[S]^2, where t = |S|
 Eigen::Isometry3d expAngular(const Eigen::Vector3d& _s) {
-  Eigen::Isometry3d ret = Eigen::Isometry3d::Identity();
-  double s2[] = { _s[0]*_s[0], _s[1]*_s[1], _s[2]*_s[2] };
-  double s3[] = { _s[0]*_s[1], _s[1]*_s[2], _s[2]*_s[0] };
-  double theta = sqrt(s2[0] + s2[1] + s2[2]);
-  double cos_t = cos(theta);
-  double alpha = 0.0;
-  double beta = 0.0;
-
-  if (theta > DART_EPSILON) {
-    alpha = sin(theta) / theta;
-    beta = (1.0 - cos_t) / theta / theta;
-  } else {
-    alpha = 1.0 - theta*theta/6.0;
-    beta = 0.5 - theta*theta/24.0;
-  }
-
-  ret(0, 0) = beta*s2[0] + cos_t;
-  ret(1, 0) = beta*s3[0] + alpha*_s[2];
-  ret(2, 0) = beta*s3[2] - alpha*_s[1];
-
-  ret(0, 1) = beta*s3[0] - alpha*_s[2];
-  ret(1, 1) = beta*s2[1] + cos_t;
-  ret(2, 1) = beta*s3[1] + alpha*_s[0];
-
-  ret(0, 2) = beta*s3[2] + alpha*_s[1];
-  ret(1, 2) = beta*s3[1] - alpha*_s[0];
-  ret(2, 2) = beta*s2[2] + cos_t;
-
-  return ret;
+  return expAngular<double>(_s);
 }
 
 // SE3 Normalize(const SE3& T)
@@ -1303,94 +1198,11 @@ Eigen::Isometry3d expAngular(const Eigen::Vector3d& _s) {
 // }
 
 Eigen::Vector6d dad(const Eigen::Vector6d& _s, const Eigen::Vector6d& _t) {
-  Eigen::Vector6d res;
-  res.head<3>() = _t.head<3>().cross(_s.head<3>())
-                  + _t.tail<3>().cross(_s.tail<3>());
-  res.tail<3>() = _t.tail<3>().cross(_s.head<3>());
-  return res;
+  return dad<double>(_s, _t);
 }
 
 Inertia transformInertia(const Eigen::Isometry3d& _T, const Inertia& _I) {
-  // operation count: multiplication = 186, addition = 117, subtract = 21
-
-  Inertia ret = Inertia::Identity();
-
-  double d0 = _I(0, 3) + _T(2, 3) * _I(3, 4) - _T(1, 3) * _I(3, 5);
-  double d1 = _I(1, 3) - _T(2, 3) * _I(3, 3) + _T(0, 3) * _I(3, 5);
-  double d2 = _I(2, 3) + _T(1, 3) * _I(3, 3) - _T(0, 3) * _I(3, 4);
-  double d3 = _I(0, 4) + _T(2, 3) * _I(4, 4) - _T(1, 3) * _I(4, 5);
-  double d4 = _I(1, 4) - _T(2, 3) * _I(3, 4) + _T(0, 3) * _I(4, 5);
-  double d5 = _I(2, 4) + _T(1, 3) * _I(3, 4) - _T(0, 3) * _I(4, 4);
-  double d6 = _I(0, 5) + _T(2, 3) * _I(4, 5) - _T(1, 3) * _I(5, 5);
-  double d7 = _I(1, 5) - _T(2, 3) * _I(3, 5) + _T(0, 3) * _I(5, 5);
-  double d8 = _I(2, 5) + _T(1, 3) * _I(3, 5) - _T(0, 3) * _I(4, 5);
-  double e0 = _I(0, 0) + _T(2, 3) * _I(0, 4) - _T(1, 3) * _I(0, 5)
-              + d3 * _T(2, 3) - d6 * _T(1, 3);
-  double e3 = _I(0, 1) + _T(2, 3) * _I(1, 4) - _T(1, 3) * _I(1, 5)
-              - d0 * _T(2, 3) + d6 * _T(0, 3);
-  double e4 = _I(1, 1) - _T(2, 3) * _I(1, 3) + _T(0, 3) * _I(1, 5)
-              - d1 * _T(2, 3) + d7 * _T(0, 3);
-  double e6 = _I(0, 2) + _T(2, 3) * _I(2, 4) - _T(1, 3) * _I(2, 5)
-              + d0 * _T(1, 3) - d3 * _T(0, 3);
-  double e7 = _I(1, 2) - _T(2, 3) * _I(2, 3) + _T(0, 3) * _I(2, 5)
-              + d1 * _T(1, 3) - d4 * _T(0, 3);
-  double e8 = _I(2, 2) + _T(1, 3) * _I(2, 3) - _T(0, 3) * _I(2, 4)
-              + d2 * _T(1, 3) - d5 * _T(0, 3);
-  double f0 = _T(0, 0) * e0 + _T(1, 0) * e3 + _T(2, 0) * e6;
-  double f1 = _T(0, 0) * e3 + _T(1, 0) * e4 + _T(2, 0) * e7;
-  double f2 = _T(0, 0) * e6 + _T(1, 0) * e7 + _T(2, 0) * e8;
-  double f3 = _T(0, 0) * d0 + _T(1, 0) * d1 + _T(2, 0) * d2;
-  double f4 = _T(0, 0) * d3 + _T(1, 0) * d4 + _T(2, 0) * d5;
-  double f5 = _T(0, 0) * d6 + _T(1, 0) * d7 + _T(2, 0) * d8;
-  double f6 = _T(0, 1) * e0 + _T(1, 1) * e3 + _T(2, 1) * e6;
-  double f7 = _T(0, 1) * e3 + _T(1, 1) * e4 + _T(2, 1) * e7;
-  double f8 = _T(0, 1) * e6 + _T(1, 1) * e7 + _T(2, 1) * e8;
-  double g0 = _T(0, 1) * d0 + _T(1, 1) * d1 + _T(2, 1) * d2;
-  double g1 = _T(0, 1) * d3 + _T(1, 1) * d4 + _T(2, 1) * d5;
-  double g2 = _T(0, 1) * d6 + _T(1, 1) * d7 + _T(2, 1) * d8;
-  double g3 = _T(0, 2) * d0 + _T(1, 2) * d1 + _T(2, 2) * d2;
-  double g4 = _T(0, 2) * d3 + _T(1, 2) * d4 + _T(2, 2) * d5;
-  double g5 = _T(0, 2) * d6 + _T(1, 2) * d7 + _T(2, 2) * d8;
-  double h0 = _T(0, 0) * _I(3, 3) + _T(1, 0) * _I(3, 4) + _T(2, 0) * _I(3, 5);
-  double h1 = _T(0, 0) * _I(3, 4) + _T(1, 0) * _I(4, 4) + _T(2, 0) * _I(4, 5);
-  double h2 = _T(0, 0) * _I(3, 5) + _T(1, 0) * _I(4, 5) + _T(2, 0) * _I(5, 5);
-  double h3 = _T(0, 1) * _I(3, 3) + _T(1, 1) * _I(3, 4) + _T(2, 1) * _I(3, 5);
-  double h4 = _T(0, 1) * _I(3, 4) + _T(1, 1) * _I(4, 4) + _T(2, 1) * _I(4, 5);
-  double h5 = _T(0, 1) * _I(3, 5) + _T(1, 1) * _I(4, 5) + _T(2, 1) * _I(5, 5);
-
-  ret(0, 0) = f0 * _T(0, 0) + f1 * _T(1, 0) + f2 * _T(2, 0);
-  ret(0, 1) = f0 * _T(0, 1) + f1 * _T(1, 1) + f2 * _T(2, 1);
-  ret(0, 2) = f0 * _T(0, 2) + f1 * _T(1, 2) + f2 * _T(2, 2);
-  ret(0, 3) = f3 * _T(0, 0) + f4 * _T(1, 0) + f5 * _T(2, 0);
-  ret(0, 4) = f3 * _T(0, 1) + f4 * _T(1, 1) + f5 * _T(2, 1);
-  ret(0, 5) = f3 * _T(0, 2) + f4 * _T(1, 2) + f5 * _T(2, 2);
-  ret(1, 1) = f6 * _T(0, 1) + f7 * _T(1, 1) + f8 * _T(2, 1);
-  ret(1, 2) = f6 * _T(0, 2) + f7 * _T(1, 2) + f8 * _T(2, 2);
-  ret(1, 3) = g0 * _T(0, 0) + g1 * _T(1, 0) + g2 * _T(2, 0);
-  ret(1, 4) = g0 * _T(0, 1) + g1 * _T(1, 1) + g2 * _T(2, 1);
-  ret(1, 5) = g0 * _T(0, 2) + g1 * _T(1, 2) + g2 * _T(2, 2);
-  ret(2, 2) = (_T(0, 2) * e0 + _T(1, 2) * e3 + _T(2, 2) * e6) * _T(0, 2)
-              + (_T(0, 2) * e3 + _T(1, 2) * e4 + _T(2, 2) * e7) * _T(1, 2)
-              + (_T(0, 2) * e6 + _T(1, 2) * e7 + _T(2, 2) * e8) * _T(2, 2);
-  ret(2, 3) = g3 * _T(0, 0) + g4 * _T(1, 0) + g5 * _T(2, 0);
-  ret(2, 4) = g3 * _T(0, 1) + g4 * _T(1, 1) + g5 * _T(2, 1);
-  ret(2, 5) = g3 * _T(0, 2) + g4 * _T(1, 2) + g5 * _T(2, 2);
-  ret(3, 3) = h0 * _T(0, 0) + h1 * _T(1, 0) + h2 * _T(2, 0);
-  ret(3, 4) = h0 * _T(0, 1) + h1 * _T(1, 1) + h2 * _T(2, 1);
-  ret(3, 5) = h0 * _T(0, 2) + h1 * _T(1, 2) + h2 * _T(2, 2);
-  ret(4, 4) = h3 * _T(0, 1) + h4 * _T(1, 1) + h5 * _T(2, 1);
-  ret(4, 5) = h3 * _T(0, 2) + h4 * _T(1, 2) + h5 * _T(2, 2);
-  ret(5, 5) =
-      (_T(0, 2) * _I(3, 3) + _T(1, 2) * _I(3, 4) + _T(2, 2) * _I(3, 5))
-      * _T(0, 2)
-      + (_T(0, 2) * _I(3, 4) + _T(1, 2) * _I(4, 4) + _T(2, 2) * _I(4, 5))
-      * _T(1, 2)
-      + (_T(0, 2) * _I(3, 5) + _T(1, 2) * _I(4, 5) + _T(2, 2) * _I(5, 5))
-      * _T(2, 2);
-
-  ret.triangularView<Eigen::StrictlyLower>() = ret.transpose();
-
-  return ret;
+  return transformInertia<double>(_T, _I);
 }
 
 Eigen::Matrix3d parallelAxisTheorem(const Eigen::Matrix3d& _original,
@@ -533,7 +533,63 @@ Eigen::Vector2d computeClosestPointOnSupportPolygon(
     const Eigen::Vector2d& _p,
     const SupportPolygon& _support);
 
+//------------------------------------------------------------------------------
+// Scalar-generic spatial algebra
+//
+// These function templates are the implementations of the spatial algebra
+// routines above for any scalar type that Eigen supports, such as float or a
+// forward-mode automatic differentiation type. The double versions above simply
+// forward to them, so their results are identical.
+//------------------------------------------------------------------------------
+
+/// \brief Exponential mapping
+template <typename Scalar>
+Isometry3<Scalar> expMap(const Vector6<Scalar>& _S);
+
+/// \brief fast version of Exp(se3(s, 0))
+template <typename Scalar>
+Isometry3<Scalar> expAngular(const Eigen::Matrix<Scalar, 3, 1>& _s);
+
+/// \brief adjoint mapping
+template <typename Scalar>
+Vector6<Scalar> AdT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _V);
+
+/// \brief fast version of Ad([R 0; 0 1], V)
+template <typename Scalar>
+Vector6<Scalar> AdR(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _V);
+
+/// \brief fast version of Ad(Inv(T), V)
+template <typename Scalar>
+Vector6<Scalar> AdInvT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _V);
+
+/// \brief dual adjoint mapping
+template <typename Scalar>
+Vector6<Scalar> dAdT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _F);
+
+/// \brief fast version of dAd(Inv(T), F)
+template <typename Scalar>
+Vector6<Scalar> dAdInvT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _F);
+
+/// \brief fast version of dAd(Inv([R 0; 0 1]), F)
+template <typename Scalar>
+Vector6<Scalar> dAdInvR(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _F);
+
+/// \brief adjoint mapping
+template <typename Scalar>
+Vector6<Scalar> ad(const Vector6<Scalar>& _X, const Vector6<Scalar>& _Y);
+
+/// \brief dual adjoint mapping
+template <typename Scalar>
+Vector6<Scalar> dad(const Vector6<Scalar>& _s, const Vector6<Scalar>& _t);
+
+/// \brief Transform a spatial inertia into the frame of _T
+template <typename Scalar>
+Matrix6<Scalar> transformInertia(const Isometry3<Scalar>& _T,
+                                 const Matrix6<Scalar>& _I);
+
 }  // namespace math
 }  // namespace dart
 
+#include "dart/math/detail/Geometry.h"
+
 #endif  // DART_MATH_GEOMETRY_H_
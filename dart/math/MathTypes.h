@@ -178,6 +178,18 @@ typedef Eigen::Matrix<double, 3, Eigen::Dynamic> LinearJacobian;
 typedef Eigen::Matrix<double, 3, Eigen::Dynamic> AngularJacobian;
 typedef Eigen::Matrix<double, 6, Eigen::Dynamic> Jacobian;
 
+/// Spatial vector (twist or wrench) for an arbitrary scalar type
+template <typename Scalar>
+using Vector6 = Eigen::Matrix<Scalar, 6, 1>;
+
+/// Spatial matrix (e.g. spatial inertia) for an arbitrary scalar type
+template <typename Scalar>
+using Matrix6 = Eigen::Matrix<Scalar, 6, 6>;
+
+/// Rigid body transformation for an arbitrary scalar type
+template <typename Scalar>
+using Isometry3 = Eigen::Transform<Scalar, 3, Eigen::Isometry>;
+
 }  // namespace math
 }  // namespace dart
 
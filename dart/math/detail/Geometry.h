@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Author(s): Jeongseok Lee <jslee02@gmail.com>
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_MATH_DETAIL_GEOMETRY_H_
+#define DART_MATH_DETAIL_GEOMETRY_H_
+
+#include <cmath>
+
+namespace dart {
+namespace math {
+
+//==============================================================================
+template <typename Scalar>
+Isometry3<Scalar> expMap(const Vector6<Scalar>& _S)
+{
+  using std::sqrt;
+  using std::cos;
+  using std::sin;
+
+  Isometry3<Scalar> ret = Isometry3<Scalar>::Identity();
+  const Scalar s2[] = { _S[0]*_S[0], _S[1]*_S[1], _S[2]*_S[2] };
+  const Scalar s3[] = { _S[0]*_S[1], _S[1]*_S[2], _S[2]*_S[0] };
+  const Scalar theta = sqrt(s2[0] + s2[1] + s2[2]);
+  const Scalar cos_t = cos(theta);
+  const Scalar dot = _S[0]*_S[3] + _S[1]*_S[4] + _S[2]*_S[5];
+  Scalar alpha, beta, gamma;
+
+  if (theta > Scalar(DART_EPSILON))
+  {
+    const Scalar sin_t = sin(theta);
+    alpha = sin_t / theta;
+    beta = (Scalar(1) - cos_t) / theta / theta;
+    gamma = dot * (theta - sin_t) / theta / theta / theta;
+  }
+  else
+  {
+    alpha = Scalar(1) - theta*theta/Scalar(6);
+    beta = Scalar(0.5) - theta*theta/Scalar(24);
+    gamma = dot/Scalar(6) - theta*theta/Scalar(120);
+  }
+
+  ret(0, 0) = beta*s2[0] + cos_t;
+  ret(1, 0) = beta*s3[0] + alpha*_S[2];
+  ret(2, 0) = beta*s3[2] - alpha*_S[1];
+
+  ret(0, 1) = beta*s3[0] - alpha*_S[2];
+  ret(1, 1) = beta*s2[1] + cos_t;
+  ret(2, 1) = beta*s3[1] + alpha*_S[0];
+
+  ret(0, 2) = beta*s3[2] + alpha*_S[1];
+  ret(1, 2) = beta*s3[1] - alpha*_S[0];
+  ret(2, 2) = beta*s2[2] + cos_t;
+
+  ret(0, 3) = alpha*_S[3] + beta*(_S[1]*_S[5] - _S[2]*_S[4]) + gamma*_S[0];
+  ret(1, 3) = alpha*_S[4] + beta*(_S[2]*_S[3] - _S[0]*_S[5]) + gamma*_S[1];
+  ret(2, 3) = alpha*_S[5] + beta*(_S[0]*_S[4] - _S[1]*_S[3]) + gamma*_S[2];
+
+  return ret;
+}
+
+//==============================================================================
+template <typename Scalar>
+Isometry3<Scalar> expAngular(const Eigen::Matrix<Scalar, 3, 1>& _s)
+{
+  using std::sqrt;
+  using std::cos;
+  using std::sin;
+
+  Isometry3<Scalar> ret = Isometry3<Scalar>::Identity();
+  const Scalar s2[] = { _s[0]*_s[0], _s[1]*_s[1], _s[2]*_s[2] };
+  const Scalar s3[] = { _s[0]*_s[1], _s[1]*_s[2], _s[2]*_s[0] };
+  const Scalar theta = sqrt(s2[0] + s2[1] + s2[2]);
+  const Scalar cos_t = cos(theta);
+  Scalar alpha, beta;
+
+  if (theta > Scalar(DART_EPSILON))
+  {
+    alpha = sin(theta) / theta;
+    beta = (Scalar(1) - cos_t) / theta / theta;
+  }
+  else
+  {
+    alpha = Scalar(1) - theta*theta/Scalar(6);
+    beta = Scalar(0.5) - theta*theta/Scalar(24);
+  }
+
+  ret(0, 0) = beta*s2[0] + cos_t;
+  ret(1, 0) = beta*s3[0] + alpha*_s[2];
+  ret(2, 0) = beta*s3[2] - alpha*_s[1];
+
+  ret(0, 1) = beta*s3[0] - alpha*_s[2];
+  ret(1, 1) = beta*s2[1] + cos_t;
+  ret(2, 1) = beta*s3[1] + alpha*_s[0];
+
+  ret(0, 2) = beta*s3[2] + alpha*_s[1];
+  ret(1, 2) = beta*s3[1] - alpha*_s[0];
+  ret(2, 2) = beta*s2[2] + cos_t;
+
+  return ret;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> AdT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _V)
+{
+  //--------------------------------------------------------------------------
+  // w' = R*w
+  // v' = p x R*w + R*v
+  //--------------------------------------------------------------------------
+  Vector6<Scalar> res;
+  res.template head<3>().noalias() = _T.linear() * _V.template head<3>();
+  res.template tail<3>().noalias() = _T.linear() * _V.template tail<3>() +
+      _T.translation().cross(res.template head<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> AdR(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _V)
+{
+  //--------------------------------------------------------------------------
+  // w' = R*w
+  // v' = R*v
+  //--------------------------------------------------------------------------
+  Vector6<Scalar> res;
+  res.template head<3>().noalias() = _T.linear() * _V.template head<3>();
+  res.template tail<3>().noalias() = _T.linear() * _V.template tail<3>();
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> AdInvT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _V)
+{
+  Vector6<Scalar> res;
+  res.template head<3>().noalias()
+      = _T.linear().transpose() * _V.template head<3>();
+  res.template tail<3>().noalias()
+      = _T.linear().transpose()
+        * (_V.template tail<3>()
+           + _V.template head<3>().cross(_T.translation()));
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> dAdT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _F)
+{
+  Vector6<Scalar> res;
+  res.template head<3>().noalias()
+      = _T.linear().transpose()
+        * (_F.template head<3>()
+           + _F.template tail<3>().cross(_T.translation()));
+  res.template tail<3>().noalias()
+      = _T.linear().transpose() * _F.template tail<3>();
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> dAdInvT(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _F)
+{
+  Vector6<Scalar> res;
+  res.template tail<3>().noalias() = _T.linear() * _F.template tail<3>();
+  res.template head<3>().noalias() = _T.linear() * _F.template head<3>();
+  res.template head<3>() += _T.translation().cross(res.template tail<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> dAdInvR(const Isometry3<Scalar>& _T, const Vector6<Scalar>& _F)
+{
+  Vector6<Scalar> res;
+  res.template head<3>().noalias() = _T.linear() * _F.template head<3>();
+  res.template tail<3>().noalias() = _T.linear() * _F.template tail<3>();
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> ad(const Vector6<Scalar>& _X, const Vector6<Scalar>& _Y)
+{
+  //--------------------------------------------------------------------------
+  // ad(s1, s2) = | [w1]    0 | | w2 |
+  //              | [v1] [w1] | | v2 |
+  //
+  //            = |          [w1]w2 |
+  //              | [v1]w2 + [w1]v2 |
+  //--------------------------------------------------------------------------
+  Vector6<Scalar> res;
+  res.template head<3>() = _X.template head<3>().cross(_Y.template head<3>());
+  res.template tail<3>() = _X.template head<3>().cross(_Y.template tail<3>())
+                           + _X.template tail<3>().cross(_Y.template head<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Vector6<Scalar> dad(const Vector6<Scalar>& _s, const Vector6<Scalar>& _t)
+{
+  Vector6<Scalar> res;
+  res.template head<3>() = _t.template head<3>().cross(_s.template head<3>())
+                           + _t.template tail<3>().cross(_s.template tail<3>());
+  res.template tail<3>() = _t.template tail<3>().cross(_s.template head<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename Scalar>
+Matrix6<Scalar> transformInertia(const Isometry3<Scalar>& _T,
+                                 const Matrix6<Scalar>& _I)
+{
+  // operation count: multiplication = 186, addition = 117, subtract = 21
+
+  Matrix6<Scalar> ret = Matrix6<Scalar>::Identity();
+
+  const Scalar d0 = _I(0, 3) + _T(2, 3) * _I(3, 4) - _T(1, 3) * _I(3, 5);
+  const Scalar d1 = _I(1, 3) - _T(2, 3) * _I(3, 3) + _T(0, 3) * _I(3, 5);
+  const Scalar d2 = _I(2, 3) + _T(1, 3) * _I(3, 3) - _T(0, 3) * _I(3, 4);
+  const Scalar d3 = _I(0, 4) + _T(2, 3) * _I(4, 4) - _T(1, 3) * _I(4, 5);
+  const Scalar d4 = _I(1, 4) - _T(2, 3) * _I(3, 4) + _T(0, 3) * _I(4, 5);
+  const Scalar d5 = _I(2, 4) + _T(1, 3) * _I(3, 4) - _T(0, 3) * _I(4, 4);
+  const Scalar d6 = _I(0, 5) + _T(2, 3) * _I(4, 5) - _T(1, 3) * _I(5, 5);
+  const Scalar d7 = _I(1, 5) - _T(2, 3) * _I(3, 5) + _T(0, 3) * _I(5, 5);
+  const Scalar d8 = _I(2, 5) + _T(1, 3) * _I(3, 5) - _T(0, 3) * _I(4, 5);
+  const Scalar e0 = _I(0, 0) + _T(2, 3) * _I(0, 4) - _T(1, 3) * _I(0, 5)
+                    + d3 * _T(2, 3) - d6 * _T(1, 3);
+  const Scalar e3 = _I(0, 1) + _T(2, 3) * _I(1, 4) - _T(1, 3) * _I(1, 5)
+                    - d0 * _T(2, 3) + d6 * _T(0, 3);
+  const Scalar e4 = _I(1, 1) - _T(2, 3) * _I(1, 3) + _T(0, 3) * _I(1, 5)
+                    - d1 * _T(2, 3) + d7 * _T(0, 3);
+  const Scalar e6 = _I(0, 2) + _T(2, 3) * _I(2, 4) - _T(1, 3) * _I(2, 5)
+                    + d0 * _T(1, 3) - d3 * _T(0, 3);
+  const Scalar e7 = _I(1, 2) - _T(2, 3) * _I(2, 3) + _T(0, 3) * _I(2, 5)
+                    + d1 * _T(1, 3) - d4 * _T(0, 3);
+  const Scalar e8 = _I(2, 2) + _T(1, 3) * _I(2, 3) - _T(0, 3) * _I(2, 4)
+                    + d2 * _T(1, 3) - d5 * _T(0, 3);
+  const Scalar f0 = _T(0, 0) * e0 + _T(1, 0) * e3 + _T(2, 0) * e6;
+  const Scalar f1 = _T(0, 0) * e3 + _T(1, 0) * e4 + _T(2, 0) * e7;
+  const Scalar f2 = _T(0, 0) * e6 + _T(1, 0) * e7 + _T(2, 0) * e8;
+  const Scalar f3 = _T(0, 0) * d0 + _T(1, 0) * d1 + _T(2, 0) * d2;
+  const Scalar f4 = _T(0, 0) * d3 + _T(1, 0) * d4 + _T(2, 0) * d5;
+  const Scalar f5 = _T(0, 0) * d6 + _T(1, 0) * d7 + _T(2, 0) * d8;
+  const Scalar f6 = _T(0, 1) * e0 + _T(1, 1) * e3 + _T(2, 1) * e6;
+  const Scalar f7 = _T(0, 1) * e3 + _T(1, 1) * e4 + _T(2, 1) * e7;
+  const Scalar f8 = _T(0, 1) * e6 + _T(1, 1) * e7 + _T(2, 1) * e8;
+  const Scalar g0 = _T(0, 1) * d0 + _T(1, 1) * d1 + _T(2, 1) * d2;
+  const Scalar g1 = _T(0, 1) * d3 + _T(1, 1) * d4 + _T(2, 1) * d5;
+  const Scalar g2 = _T(0, 1) * d6 + _T(1, 1) * d7 + _T(2, 1) * d8;
+  const Scalar g3 = _T(0, 2) * d0 + _T(1, 2) * d1 + _T(2, 2) * d2;
+  const Scalar g4 = _T(0, 2) * d3 + _T(1, 2) * d4 + _T(2, 2) * d5;
+  const Scalar g5 = _T(0, 2) * d6 + _T(1, 2) * d7 + _T(2, 2) * d8;
+  const Scalar h0 = _T(0, 0) * _I(3, 3) + _T(1, 0) * _I(3, 4)
+                    + _T(2, 0) * _I(3, 5);
+  const Scalar h1 = _T(0, 0) * _I(3, 4) + _T(1, 0) * _I(4, 4)
+                    + _T(2, 0) * _I(4, 5);
+  const Scalar h2 = _T(0, 0) * _I(3, 5) + _T(1, 0) * _I(4, 5)
+                    + _T(2, 0) * _I(5, 5);
+  const Scalar h3 = _T(0, 1) * _I(3, 3) + _T(1, 1) * _I(3, 4)
+                    + _T(2, 1) * _I(3, 5);
+  const Scalar h4 = _T(0, 1) * _I(3, 4) + _T(1, 1) * _I(4, 4)
+                    + _T(2, 1) * _I(4, 5);
+  const Scalar h5 = _T(0, 1) * _I(3, 5) + _T(1, 1) * _I(4, 5)
+                    + _T(2, 1) * _I(5, 5);
+
+  ret(0, 0) = f0 * _T(0, 0) + f1 * _T(1, 0) + f2 * _T(2, 0);
+  ret(0, 1) = f0 * _T(0, 1) + f1 * _T(1, 1) + f2 * _T(2, 1);
+  ret(0, 2) = f0 * _T(0, 2) + f1 * _T(1, 2) + f2 * _T(2, 2);
+  ret(0, 3) = f3 * _T(0, 0) + f4 * _T(1, 0) + f5 * _T(2, 0);
+  ret(0, 4) = f3 * _T(0, 1) + f4 * _T(1, 1) + f5 * _T(2, 1);
+  ret(0, 5) = f3 * _T(0, 2) + f4 * _T(1, 2) + f5 * _T(2, 2);
+  ret(1, 1) = f6 * _T(0, 1) + f7 * _T(1, 1) + f8 * _T(2, 1);
+  ret(1, 2) = f6 * _T(0, 2) + f7 * _T(1, 2) + f8 * _T(2, 2);
+  ret(1, 3) = g0 * _T(0, 0) + g1 * _T(1, 0) + g2 * _T(2, 0);
+  ret(1, 4) = g0 * _T(0, 1) + g1 * _T(1, 1) + g2 * _T(2, 1);
+  ret(1, 5) = g0 * _T(0, 2) + g1 * _T(1, 2) + g2 * _T(2, 2);
+  ret(2, 2) = (_T(0, 2) * e0 + _T(1, 2) * e3 + _T(2, 2) * e6) * _T(0, 2)
+              + (_T(0, 2) * e3 + _T(1, 2) * e4 + _T(2, 2) * e7) * _T(1, 2)
+              + (_T(0, 2) * e6 + _T(1, 2) * e7 + _T(2, 2) * e8) * _T(2, 2);
+  ret(2, 3) = g3 * _T(0, 0) + g4 * _T(1, 0) + g5 * _T(2, 0);
+  ret(2, 4) = g3 * _T(0, 1) + g4 * _T(1, 1) + g5 * _T(2, 1);
+  ret(2, 5) = g3 * _T(0, 2) + g4 * _T(1, 2) + g5 * _T(2, 2);
+  ret(3, 3) = h0 * _T(0, 0) + h1 * _T(1, 0) + h2 * _T(2, 0);
+  ret(3, 4) = h0 * _T(0, 1) + h1 * _T(1, 1) + h2 * _T(2, 1);
+  ret(3, 5) = h0 * _T(0, 2) + h1 * _T(1, 2) + h2 * _T(2, 2);
+  ret(4, 4) = h3 * _T(0, 1) + h4 * _T(1, 1) + h5 * _T(2, 1);
+  ret(4, 5) = h3 * _T(0, 2) + h4 * _T(1, 2) + h5 * _T(2, 2);
+  ret(5, 5) =
+      (_T(0, 2) * _I(3, 3) + _T(1, 2) * _I(3, 4) + _T(2, 2) * _I(3, 5))
+      * _T(0, 2)
+      + (_T(0, 2) * _I(3, 4) + _T(1, 2) * _I(4, 4) + _T(2, 2) * _I(4, 5))
+      * _T(1, 2)
+      + (_T(0, 2) * _I(3, 5) + _T(1, 2) * _I(4, 5) + _T(2, 2) * _I(5, 5))
+      * _T(2, 2);
+
+  ret.template triangularView<Eigen::StrictlyLower>() = ret.transpose();
+
+  return ret;
+}
+
+}  // namespace math
+}  // namespace dart
+
+#endif  // DART_MATH_DETAIL_GEOMETRY_H_
@@ -244,6 +244,35 @@ void NullFunction::evalHessian(
   _Hess.setZero();
 }
 
+//==============================================================================
+LeastSquaresFunction::LeastSquaresFunction(const std::string& _name)
+  : Function(_name)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LeastSquaresFunction::~LeastSquaresFunction()
+{
+  // Do nothing
+}
+
+//==============================================================================
+double LeastSquaresFunction::eval(const Eigen::VectorXd& _x)
+{
+  evalResidual(_x, mResidualCache);
+  return 0.5*mResidualCache.squaredNorm();
+}
+
+//==============================================================================
+void LeastSquaresFunction::evalGradient(const Eigen::VectorXd& _x,
+                                        Eigen::Map<Eigen::VectorXd> _grad)
+{
+  evalResidual(_x, mResidualCache);
+  evalJacobian(_x, mJacobianCache);
+  _grad.noalias() = mJacobianCache.transpose()*mResidualCache;
+}
+
 //==============================================================================
 MultiFunction::MultiFunction()
 {
@@ -202,6 +202,50 @@ public:
       Eigen::Map<Eigen::VectorXd, Eigen::RowMajor> _Hess) override;
 };
 
+/// LeastSquaresFunction is a Function whose value is half of the squared norm
+/// of a residual vector, i.e. 0.5*r(x)^T*r(x). Solvers that are aware of this
+/// structure, such as LevenbergMarquardtSolver, work with the residual vector
+/// and its Jacobian directly, while any other Solver can treat it like an
+/// ordinary Function.
+class LeastSquaresFunction : public Function
+{
+public:
+  /// Constructor
+  explicit LeastSquaresFunction(
+      const std::string& _name = "least_squares_function");
+
+  /// Destructor
+  virtual ~LeastSquaresFunction();
+
+  /// Get the number of components in the residual vector
+  virtual size_t getNumResiduals() const = 0;
+
+  /// Evaluate the residual vector at the point x. _residual must be filled
+  /// with getNumResiduals() components.
+  virtual void evalResidual(const Eigen::VectorXd& _x,
+                            Eigen::VectorXd& _residual) = 0;
+
+  /// Evaluate the Jacobian of the residual vector at the point x. _jacobian
+  /// must be filled with getNumResiduals() rows and one column per component
+  /// of x.
+  virtual void evalJacobian(const Eigen::VectorXd& _x,
+                            Eigen::MatrixXd& _jacobian) = 0;
+
+  /// Returns 0.5*r(x)^T*r(x)
+  virtual double eval(const Eigen::VectorXd& _x) override;
+
+  /// Returns J(x)^T*r(x), the gradient of 0.5*r(x)^T*r(x)
+  virtual void evalGradient(const Eigen::VectorXd& _x,
+                            Eigen::Map<Eigen::VectorXd> _grad) override;
+
+protected:
+  /// Cache for the residual vector
+  Eigen::VectorXd mResidualCache;
+
+  /// Cache for the Jacobian of the residual vector
+  Eigen::MatrixXd mJacobianCache;
+};
+
 /// \brief class MultiFunction
 class MultiFunction
 {
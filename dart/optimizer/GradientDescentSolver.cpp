@@ -136,11 +136,18 @@ bool GradientDescentSolver::solve()
 
   mLastNumIterations = 0;
   size_t attemptCount = 0;
+  bool stopped = false;
   do
   {
     size_t stepCount = 0;
     do
     {
+      if(isStopRequested())
+      {
+        stopped = true;
+        break;
+      }
+
       ++mLastNumIterations;
 
       // Perturb the configuration if we have reached an iteration where we are
@@ -246,6 +253,9 @@ bool GradientDescentSolver::solve()
 
     } while(!minimized || !satisfied);
 
+    if(stopped)
+      break;
+
     if(!minimized || !satisfied)
     {
       ++attemptCount;
@@ -269,7 +279,7 @@ bool GradientDescentSolver::solve()
   problem->setOptimalSolution(x);
   problem->setOptimumValue(problem->getObjective()->eval(x));
 
-  return minimized && satisfied;
+  return !stopped && minimized && satisfied;
 }
 
 //==============================================================================
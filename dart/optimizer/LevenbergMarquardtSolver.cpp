@@ -0,0 +1,503 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "dart/common/Console.h"
+#include "dart/math/Helpers.h"
+#include "dart/optimizer/LevenbergMarquardtSolver.h"
+#include "dart/optimizer/Problem.h"
+
+namespace dart {
+namespace optimizer {
+
+//==============================================================================
+const std::string LevenbergMarquardtSolver::Type = "LevenbergMarquardtSolver";
+
+//==============================================================================
+LevenbergMarquardtSolver::UniqueProperties::UniqueProperties(
+    double _initialDamping,
+    size_t _maxAttempts)
+  : mInitialDamping(_initialDamping),
+    mMaxAttempts(_maxAttempts)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::Properties::Properties(
+    const Solver::Properties& _solverProperties,
+    const UniqueProperties& _lmProperties)
+  : Solver::Properties(_solverProperties),
+    UniqueProperties(_lmProperties)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::LevenbergMarquardtSolver(
+    const Properties& _properties)
+  : Solver(_properties),
+    mLevenbergMarquardtP(_properties),
+    mLastNumIterations(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::LevenbergMarquardtSolver(
+    std::shared_ptr<Problem> _problem)
+  : Solver(_problem),
+    mLastNumIterations(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::~LevenbergMarquardtSolver()
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool LevenbergMarquardtSolver::solve()
+{
+  std::shared_ptr<Problem> problem = mProperties.mProblem;
+  if(nullptr == problem)
+  {
+    dtwarn << "[LevenbergMarquardtSolver::solve] Attempting to solve a nullptr "
+           << "problem! We will return false.\n";
+    return false;
+  }
+
+  const double tol = std::abs(mProperties.mTolerance);
+  const size_t dim = problem->getDimension();
+
+  Eigen::VectorXd x = problem->getInitialGuess();
+  assert(x.size() == static_cast<int>(dim));
+
+  Eigen::VectorXd xNew(dim);
+
+  const Eigen::VectorXd& lower = problem->getLowerBounds();
+  const Eigen::VectorXd& upper = problem->getUpperBounds();
+  auto isFixed = [&](size_t _i)
+  {
+    return (x[_i] <= lower[_i] && mGradient[_i] > 0.0)
+        || (x[_i] >= upper[_i] && mGradient[_i] < 0.0);
+  };
+
+  bool minimized = false;
+  bool satisfied = false;
+
+  mLastNumIterations = 0;
+  size_t attemptCount = 0;
+  bool stopped = false;
+  while(true)
+  {
+    clampToBoundary(x);
+    double cost = evalCost(x, true);
+
+    // The damping starts out proportional to the scale of J^T*J
+    double damping = mLevenbergMarquardtP.mInitialDamping;
+    if(mJacobian.size() > 0)
+    {
+      const double scale = mJacobian.colwise().squaredNorm().maxCoeff();
+      if(scale > 0.0)
+        damping *= scale;
+    }
+
+    double dampingGrowth = 2.0;
+
+    minimized = false;
+    size_t stepCount = 0;
+    while(true)
+    {
+      if(isStopRequested())
+      {
+        stopped = true;
+        break;
+      }
+
+      // Coordinates that sit on a bound while the gradient pushes them past it
+      // are held fixed for this step
+      mStep = -mGradient;
+      for(size_t i=0; i < dim; ++i)
+      {
+        if(isFixed(i))
+          mStep[i] = 0.0;
+      }
+
+      satisfied = areConstraintsSatisfied(x);
+      if(satisfied && mStep.lpNorm<Eigen::Infinity>() <= tol)
+      {
+        minimized = true;
+        break;
+      }
+
+      if(mProperties.mNumMaxIterations > 0
+         && stepCount >= mProperties.mNumMaxIterations)
+        break;
+
+      ++stepCount;
+      ++mLastNumIterations;
+
+      // Solve (J^T*J + damping*I)*step = -gradient over the free coordinates.
+      // Only the lower triangle of the normal matrix is used by the LDLT.
+      mNormalMatrix.resize(dim, dim);
+      mNormalMatrix.setZero();
+      mNormalMatrix.diagonal().setConstant(damping);
+      mNormalMatrix.selfadjointView<Eigen::Lower>().rankUpdate(
+            mJacobian.transpose());
+      for(size_t i=0; i < dim; ++i)
+      {
+        if(isFixed(i))
+        {
+          mNormalMatrix.row(i).setZero();
+          mNormalMatrix.col(i).setZero();
+          mNormalMatrix(i,i) = 1.0;
+        }
+      }
+      mFactorization.compute(mNormalMatrix);
+      mFactorization.solveInPlace(mStep);
+
+      xNew = x + mStep;
+      clampToBoundary(xNew);
+      mStep = xNew - x;
+
+      if(mStep.norm() < tol)
+      {
+        // The steps have become too small to make any more progress
+        minimized = satisfied;
+        break;
+      }
+
+      // Compare the actual reduction of the cost to the reduction that is
+      // predicted by the Gauss-Newton model
+      const double predicted =
+          -mGradient.dot(mStep) - 0.5*(mJacobian*mStep).squaredNorm();
+      const double newCost = evalCost(xNew, false);
+      const double ratio = predicted > 0.0 ? (cost - newCost)/predicted : -1.0;
+
+      if(ratio > 0.0)
+      {
+        x = xNew;
+        cost = evalCost(x, true);
+        damping *= std::max(1.0/3.0, 1.0 - std::pow(2.0*ratio - 1.0, 3));
+        dampingGrowth = 2.0;
+      }
+      else
+      {
+        damping *= dampingGrowth;
+        dampingGrowth *= 2.0;
+      }
+
+      if(nullptr != mProperties.mOutStream &&
+         mProperties.mIterationsPerPrint > 0 &&
+         stepCount%mProperties.mIterationsPerPrint == 0)
+      {
+        *mProperties.mOutStream
+            << "[LevenbergMarquardtSolver] Progress (attempt #"
+            << attemptCount << " | iteration #" << stepCount << ")\n"
+            << "cost: " << cost << " | damping: " << damping << " | "
+            << (satisfied? "constraints satisfied | "
+                         : "constraints unsatisfied | ")
+            << "x: " << x.transpose() << "\n"
+            << "grad: " << mGradient.transpose() << std::endl;
+      }
+    }
+
+    if(stopped || (minimized && satisfied))
+      break;
+
+    ++attemptCount;
+    if(mLevenbergMarquardtP.mMaxAttempts > 0
+       && attemptCount >= mLevenbergMarquardtP.mMaxAttempts)
+      break;
+
+    if(attemptCount-1 >= problem->getSeeds().size())
+      break;
+
+    x = problem->getSeed(attemptCount-1);
+  }
+
+  problem->setOptimalSolution(x);
+  problem->setOptimumValue(problem->getObjective()->eval(x));
+
+  return !stopped && minimized && satisfied;
+}
+
+//==============================================================================
+std::string LevenbergMarquardtSolver::getType() const
+{
+  return Type;
+}
+
+//==============================================================================
+std::shared_ptr<Solver> LevenbergMarquardtSolver::clone() const
+{
+  return std::make_shared<LevenbergMarquardtSolver>(
+        getLevenbergMarquardtProperties());
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setProperties(const Properties& _properties)
+{
+  Solver::setProperties(_properties);
+  setProperties(static_cast<const UniqueProperties&>(_properties));
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setProperties(
+    const UniqueProperties& _properties)
+{
+  setInitialDamping(_properties.mInitialDamping);
+  setMaxAttempts(_properties.mMaxAttempts);
+}
+
+//==============================================================================
+LevenbergMarquardtSolver::Properties
+LevenbergMarquardtSolver::getLevenbergMarquardtProperties() const
+{
+  return LevenbergMarquardtSolver::Properties(
+        getSolverProperties(), mLevenbergMarquardtP);
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::copy(const LevenbergMarquardtSolver& _other)
+{
+  if(this == &_other)
+    return;
+
+  setProperties(_other.getLevenbergMarquardtProperties());
+}
+
+//==============================================================================
+LevenbergMarquardtSolver& LevenbergMarquardtSolver::operator=(
+    const LevenbergMarquardtSolver& _other)
+{
+  copy(_other);
+  return *this;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setInitialDamping(double _damping)
+{
+  mLevenbergMarquardtP.mInitialDamping = std::abs(_damping);
+}
+
+//==============================================================================
+double LevenbergMarquardtSolver::getInitialDamping() const
+{
+  return mLevenbergMarquardtP.mInitialDamping;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::setMaxAttempts(size_t _maxAttempts)
+{
+  mLevenbergMarquardtP.mMaxAttempts = _maxAttempts;
+}
+
+//==============================================================================
+size_t LevenbergMarquardtSolver::getMaxAttempts() const
+{
+  return mLevenbergMarquardtP.mMaxAttempts;
+}
+
+//==============================================================================
+size_t LevenbergMarquardtSolver::getLastNumIterations() const
+{
+  return mLastNumIterations;
+}
+
+//==============================================================================
+static size_t countResiduals(Function* _function)
+{
+  LeastSquaresFunction* leastSquares =
+      dynamic_cast<LeastSquaresFunction*>(_function);
+  if(leastSquares)
+    return leastSquares->getNumResiduals();
+
+  return 1;
+}
+
+//==============================================================================
+double LevenbergMarquardtSolver::evalCost(
+    const Eigen::VectorXd& _x, bool _computeDerivatives)
+{
+  const std::shared_ptr<Problem>& problem = mProperties.mProblem;
+  Function* objective = problem->getObjective().get();
+  const bool leastSquaresObjective =
+      nullptr != dynamic_cast<LeastSquaresFunction*>(objective);
+
+  size_t numResiduals = leastSquaresObjective? countResiduals(objective) : 0;
+  for(size_t i=0; i < problem->getNumEqConstraints(); ++i)
+    numResiduals += countResiduals(problem->getEqConstraint(i).get());
+  for(size_t i=0; i < problem->getNumIneqConstraints(); ++i)
+    numResiduals += countResiduals(problem->getIneqConstraint(i).get());
+
+  mResidual.resize(numResiduals);
+  if(_computeDerivatives)
+    mJacobian.resize(numResiduals, _x.size());
+
+  size_t row = 0;
+  if(leastSquaresObjective)
+    addResiduals(objective, _x, false, _computeDerivatives, row);
+
+  for(size_t i=0; i < problem->getNumEqConstraints(); ++i)
+  {
+    addResiduals(problem->getEqConstraint(i).get(), _x, false,
+                 _computeDerivatives, row);
+  }
+
+  for(size_t i=0; i < problem->getNumIneqConstraints(); ++i)
+  {
+    addResiduals(problem->getIneqConstraint(i).get(), _x, true,
+                 _computeDerivatives, row);
+  }
+
+  double cost = 0.5*mResidual.squaredNorm();
+
+  if(_computeDerivatives)
+    mGradient.noalias() = mJacobian.transpose()*mResidual;
+
+  // An objective that is not a least-squares function only contributes its
+  // value and its gradient
+  if(!leastSquaresObjective)
+  {
+    cost += objective->eval(_x);
+
+    if(_computeDerivatives)
+    {
+      mFunctionGradient.setZero(_x.size());
+      Eigen::Map<Eigen::VectorXd> gradMap(mFunctionGradient.data(),
+                                          mFunctionGradient.size());
+      objective->evalGradient(_x, gradMap);
+      mGradient += mFunctionGradient;
+    }
+  }
+
+  return cost;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::addResiduals(
+    Function* _function, const Eigen::VectorXd& _x,
+    bool _inequality, bool _computeDerivatives, size_t& _row)
+{
+  LeastSquaresFunction* leastSquares =
+      dynamic_cast<LeastSquaresFunction*>(_function);
+
+  size_t numResiduals = 1;
+  if(leastSquares)
+  {
+    numResiduals = leastSquares->getNumResiduals();
+    leastSquares->evalResidual(_x, mFunctionResidual);
+    mResidual.segment(_row, numResiduals) = mFunctionResidual;
+
+    if(_computeDerivatives)
+    {
+      leastSquares->evalJacobian(_x, mFunctionJacobian);
+      mJacobian.middleRows(_row, numResiduals) = mFunctionJacobian;
+    }
+  }
+  else
+  {
+    mResidual[_row] = _function->eval(_x);
+
+    if(_computeDerivatives)
+    {
+      mFunctionGradient.setZero(_x.size());
+      Eigen::Map<Eigen::VectorXd> gradMap(mFunctionGradient.data(),
+                                          mFunctionGradient.size());
+      _function->evalGradient(_x, gradMap);
+      mJacobian.row(_row) = mFunctionGradient.transpose();
+    }
+  }
+
+  // Inequality constraints only produce a residual while they are violated
+  if(_inequality)
+  {
+    for(size_t i=_row; i < _row + numResiduals; ++i)
+    {
+      if(mResidual[i] > 0.0)
+        continue;
+
+      mResidual[i] = 0.0;
+      if(_computeDerivatives)
+        mJacobian.row(i).setZero();
+    }
+  }
+
+  _row += numResiduals;
+}
+
+//==============================================================================
+bool LevenbergMarquardtSolver::areConstraintsSatisfied(
+    const Eigen::VectorXd& _x)
+{
+  const std::shared_ptr<Problem>& problem = mProperties.mProblem;
+  const double tol = std::abs(mProperties.mTolerance);
+
+  for(size_t i=0; i < problem->getNumEqConstraints(); ++i)
+  {
+    if(std::abs(problem->getEqConstraint(i)->eval(_x)) > tol)
+      return false;
+  }
+
+  for(size_t i=0; i < problem->getNumIneqConstraints(); ++i)
+  {
+    if(problem->getIneqConstraint(i)->eval(_x) > tol)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+void LevenbergMarquardtSolver::clampToBoundary(Eigen::VectorXd& _x) const
+{
+  const std::shared_ptr<Problem>& problem = mProperties.mProblem;
+  const Eigen::VectorXd& lower = problem->getLowerBounds();
+  const Eigen::VectorXd& upper = problem->getUpperBounds();
+
+  assert(lower.size() == _x.size());
+  assert(upper.size() == _x.size());
+
+  for(int i=0; i < _x.size(); ++i)
+    _x[i] = math::clip(_x[i], lower[i], upper[i]);
+}
+
+} // namespace optimizer
+} // namespace dart
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_OPTIMIZER_LEVENBERGMARQUARDTSOLVER_H_
+#define DART_OPTIMIZER_LEVENBERGMARQUARDTSOLVER_H_
+
+#include <Eigen/Cholesky>
+
+#include "dart/optimizer/Function.h"
+#include "dart/optimizer/Solver.h"
+
+namespace dart {
+namespace optimizer {
+
+/// LevenbergMarquardtSolver is a Solver extension which is native to DART. It
+/// is meant for nonlinear least-squares problems, which it solves with damped
+/// Gauss-Newton steps. The damping is adjusted like the radius of a trust
+/// region: steps that reduce the cost as much as the Gauss-Newton model
+/// predicted will shrink the damping, while steps that fail to reduce the cost
+/// are rejected and the damping is increased.
+///
+/// Every LeastSquaresFunction in the Problem (the objective as well as the
+/// constraints) contributes its residual vector and residual Jacobian. Any
+/// other equality constraint c(x) contributes the single residual c(x), and any
+/// other inequality constraint g(x) contributes max(0, g(x)). An objective that
+/// is not a LeastSquaresFunction contributes only its gradient to the steps.
+///
+/// The steps are clipped to the lower and upper bounds of the Problem.
+class LevenbergMarquardtSolver : public Solver
+{
+public:
+
+  static const std::string Type;
+
+  struct UniqueProperties
+  {
+    /// The initial damping will be this value multiplied by the largest
+    /// diagonal component of J^T*J
+    double mInitialDamping;
+
+    /// Number of attempts to make before quitting. The first attempt starts
+    /// from the initial guess of the Problem, and each following attempt
+    /// starts from the next seed of the Problem. No more attempts will be made
+    /// once the seeds run out.
+    size_t mMaxAttempts;
+
+    UniqueProperties(double _initialDamping = 1e-3,
+                     size_t _maxAttempts = 1);
+  };
+
+  struct Properties : Solver::Properties, UniqueProperties
+  {
+    Properties(
+        const Solver::Properties& _solverProperties = Solver::Properties(),
+        const UniqueProperties& _lmProperties = UniqueProperties() );
+  };
+
+  /// Default constructor
+  explicit LevenbergMarquardtSolver(
+      const Properties& _properties = Properties());
+
+  /// Alternative constructor
+  explicit LevenbergMarquardtSolver(std::shared_ptr<Problem> _problem);
+
+  /// Destructor
+  virtual ~LevenbergMarquardtSolver();
+
+  // Documentation inherited
+  virtual bool solve() override;
+
+  // Documentation inherited
+  virtual std::string getType() const override;
+
+  // Documentation inherited
+  virtual std::shared_ptr<Solver> clone() const override;
+
+  /// Set the Properties of this LevenbergMarquardtSolver
+  void setProperties(const Properties& _properties);
+
+  /// Set the Properties of this LevenbergMarquardtSolver
+  void setProperties(const UniqueProperties& _properties);
+
+  /// Get the Properties of this LevenbergMarquardtSolver
+  Properties getLevenbergMarquardtProperties() const;
+
+  /// Copy the Properties of another LevenbergMarquardtSolver
+  void copy(const LevenbergMarquardtSolver& _other);
+
+  /// Copy the Properties of another LevenbergMarquardtSolver
+  LevenbergMarquardtSolver& operator=(const LevenbergMarquardtSolver& _other);
+
+  /// Set UniqueProperties::mInitialDamping
+  void setInitialDamping(double _damping);
+
+  /// Get UniqueProperties::mInitialDamping
+  double getInitialDamping() const;
+
+  /// Set UniqueProperties::mMaxAttempts
+  void setMaxAttempts(size_t _maxAttempts);
+
+  /// Get UniqueProperties::mMaxAttempts
+  size_t getMaxAttempts() const;
+
+  /// Get the number of iterations used in the last call to solve()
+  size_t getLastNumIterations() const;
+
+protected:
+
+  /// Evaluate the cost of the Problem at _x and fill in mResidual. If
+  /// _computeDerivatives is true, mJacobian and mGradient will also be filled
+  /// in.
+  double evalCost(const Eigen::VectorXd& _x, bool _computeDerivatives);
+
+  /// Write the residuals of _function at _x into mResidual, starting from
+  /// _row, and advance _row past them. If _computeDerivatives is true, the
+  /// corresponding rows of mJacobian will also be filled in.
+  void addResiduals(Function* _function, const Eigen::VectorXd& _x,
+                    bool _inequality, bool _computeDerivatives, size_t& _row);
+
+  /// Returns true if every constraint of the Problem is satisfied at _x
+  bool areConstraintsSatisfied(const Eigen::VectorXd& _x);
+
+  /// Clip _x to the bounds of the Problem
+  void clampToBoundary(Eigen::VectorXd& _x) const;
+
+  /// LevenbergMarquardtSolver properties
+  UniqueProperties mLevenbergMarquardtP;
+
+  /// The number of iterations used in the last call to solve()
+  size_t mLastNumIterations;
+
+  /// Stacked residual vector of the Problem
+  Eigen::VectorXd mResidual;
+
+  /// Stacked residual Jacobian of the Problem
+  Eigen::MatrixXd mJacobian;
+
+  /// Gradient of the cost of the Problem
+  Eigen::VectorXd mGradient;
+
+  /// Cache for the residual of a single Function
+  Eigen::VectorXd mFunctionResidual;
+
+  /// Cache for the residual Jacobian of a single Function
+  Eigen::MatrixXd mFunctionJacobian;
+
+  /// Cache for the gradient of a single Function
+  Eigen::VectorXd mFunctionGradient;
+
+  /// Damped normal matrix J^T*J + damping*I
+  Eigen::MatrixXd mNormalMatrix;
+
+  /// Factorization of mNormalMatrix
+  Eigen::LDLT<Eigen::MatrixXd> mFactorization;
+
+  /// Cache for the step
+  Eigen::VectorXd mStep;
+};
+
+} // namespace optimizer
+} // namespace dart
+
+#endif // DART_OPTIMIZER_LEVENBERGMARQUARDTSOLVER_H_
@@ -63,14 +63,16 @@ Solver::Properties::Properties(
 
 //==============================================================================
 Solver::Solver(const Properties& _properties)
-  : mProperties(_properties)
+  : mProperties(_properties),
+    mStopFlag(nullptr)
 {
   // Do nothing
 }
 
 //==============================================================================
 Solver::Solver(std::shared_ptr<Problem> _problem)
-  : mProperties(_problem)
+  : mProperties(_problem),
+    mStopFlag(nullptr)
 {
   // Do nothing
 }
@@ -192,5 +194,23 @@ const std::string& Solver::getResultFileName() const
   return mProperties.mResultFile;
 }
 
+//==============================================================================
+void Solver::setStopFlag(const std::atomic<bool>* _stopFlag)
+{
+  mStopFlag = _stopFlag;
+}
+
+//==============================================================================
+const std::atomic<bool>* Solver::getStopFlag() const
+{
+  return mStopFlag;
+}
+
+//==============================================================================
+bool Solver::isStopRequested() const
+{
+  return nullptr != mStopFlag && mStopFlag->load();
+}
+
 }  // namespace optimizer
 }  // namespace dart
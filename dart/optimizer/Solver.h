@@ -39,6 +39,7 @@
 #ifndef DART_OPTIMIZER_SOLVER_H_
 #define DART_OPTIMIZER_SOLVER_H_
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 
@@ -176,10 +177,25 @@ public:
   /// string indicates that results should not be printed to a file.
   const std::string& getResultFileName() const;
 
+  /// Set a flag that can be raised from another thread to make a solve() that
+  /// is in progress give up at its next iteration and return false. The flag
+  /// is not owned by the Solver, so it must outlive every solve() that uses it.
+  /// Pass in a nullptr to remove the flag.
+  void setStopFlag(const std::atomic<bool>* _stopFlag);
+
+  /// Get the flag that was given to setStopFlag()
+  const std::atomic<bool>* getStopFlag() const;
+
 protected:
 
+  /// Returns true if the flag given to setStopFlag() has been raised
+  bool isStopRequested() const;
+
   Properties mProperties;
 
+  /// Flag that asks a solve() in progress to stop
+  const std::atomic<bool>* mStopFlag;
+
 };
 
 }  // namespace optimizer
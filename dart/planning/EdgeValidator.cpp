@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/planning/EdgeValidator.h"
+
+#include <atomic>
+#include <cmath>
+#include <future>
+
+#include "dart/common/Console.h"
+#include "dart/dynamics/Skeleton.h"
+
+namespace dart {
+namespace planning {
+
+//==============================================================================
+EdgeValidator::EdgeValidator(simulation::WorldPtr _world,
+                             dynamics::SkeletonPtr _robot,
+                             const std::vector<size_t>& _dofs,
+                             double _stepSize, size_t _numThreads)
+  : mWorld(_world),
+    mRobot(_robot),
+    mDofs(_dofs),
+    mStepSize(_stepSize),
+    mThreadPool(new common::ThreadPool(_numThreads))
+{
+  resetClones();
+}
+
+//==============================================================================
+EdgeValidator::~EdgeValidator()
+{
+  // Join the threads before the clones that they are using go away
+  mThreadPool.reset();
+}
+
+//==============================================================================
+size_t EdgeValidator::findFirstCollision(
+    const std::vector<Eigen::VectorXd>& _states)
+{
+  const size_t numStates = _states.size();
+  if(0 == numStates || mWorkers.empty())
+    return numStates;
+
+  synchronizeClones();
+
+  // There is nothing to gain from the thread pool for a single state
+  if(1 == numStates || 1 == mWorkers.size())
+  {
+    for(size_t i=0; i < numStates; ++i)
+    {
+      if(isInCollision(mWorkers[0], _states[i]))
+        return i;
+    }
+
+    return numStates;
+  }
+
+  // The threads take the states in order, and a thread gives up as soon as it
+  // takes a state behind the first collision that has been found so far. Every
+  // state in front of the final result has therefore been checked.
+  std::atomic<size_t> nextState(0);
+  std::atomic<size_t> firstCollision(numStates);
+
+  const size_t numWorkers = std::min(mWorkers.size(), numStates);
+  std::vector<std::future<void>> results;
+  results.reserve(numWorkers);
+  for(size_t w=0; w < numWorkers; ++w)
+  {
+    results.push_back(mThreadPool->submit([&, w]()
+    {
+      Worker& worker = mWorkers[w];
+
+      while(true)
+      {
+        const size_t i = nextState++;
+        if(i >= firstCollision.load())
+          return;
+
+        if(isInCollision(worker, _states[i]))
+        {
+          size_t current = firstCollision.load();
+          while(i < current
+                && !firstCollision.compare_exchange_weak(current, i))
+          {
+            // compare_exchange_weak reloads current when it fails
+          }
+          return;
+        }
+      }
+    }));
+  }
+
+  for(std::future<void>& result : results)
+    result.get();
+
+  return firstCollision.load();
+}
+
+//==============================================================================
+bool EdgeValidator::isSegmentCollisionFree(
+    const Eigen::VectorXd& _config1, const Eigen::VectorXd& _config2,
+    std::vector<Eigen::VectorXd>* _intermediatePoints)
+{
+  std::vector<Eigen::VectorXd> states;
+  discretize(_config1, _config2, states);
+
+  if(findFirstCollision(states) < states.size())
+    return false;
+
+  if(_intermediatePoints)
+    _intermediatePoints->swap(states);
+
+  return true;
+}
+
+//==============================================================================
+void EdgeValidator::discretize(const Eigen::VectorXd& _config1,
+                               const Eigen::VectorXd& _config2,
+                               std::vector<Eigen::VectorXd>& _states) const
+{
+  _states.clear();
+
+  const double length = (_config2 - _config1).norm();
+  if(length <= mStepSize)
+    return;
+
+  const size_t numSegments = static_cast<size_t>(std::ceil(length/mStepSize));
+  _states.reserve(numSegments - 1);
+  for(size_t i=1; i < numSegments; ++i)
+  {
+    const double t = static_cast<double>(i) / static_cast<double>(numSegments);
+    _states.push_back((1.0 - t) * _config1 + t * _config2);
+  }
+}
+
+//==============================================================================
+void EdgeValidator::setStepSize(double _stepSize)
+{
+  mStepSize = _stepSize;
+}
+
+//==============================================================================
+double EdgeValidator::getStepSize() const
+{
+  return mStepSize;
+}
+
+//==============================================================================
+size_t EdgeValidator::getNumThreads() const
+{
+  return mThreadPool->getNumThreads();
+}
+
+//==============================================================================
+void EdgeValidator::runOnAllThreads(const std::function<void(size_t)>& _job)
+{
+  if(mWorkers.empty())
+    return;
+
+  synchronizeClones();
+
+  std::vector<std::future<void>> results;
+  results.reserve(mWorkers.size());
+  for(size_t w=0; w < mWorkers.size(); ++w)
+    results.push_back(mThreadPool->submit([&_job, w]() { _job(w); }));
+
+  for(std::future<void>& result : results)
+    result.get();
+}
+
+//==============================================================================
+bool EdgeValidator::isInCollision(size_t _thread, const Eigen::VectorXd& _state)
+{
+  return isInCollision(mWorkers[_thread], _state);
+}
+
+//==============================================================================
+void EdgeValidator::resetClones()
+{
+  mWorkers.clear();
+
+  if(nullptr == mWorld || nullptr == mRobot)
+  {
+    dterr << "[EdgeValidator::resetClones] The world or the robot is a "
+          << "nullptr. No states will be checked for collisions!\n";
+    return;
+  }
+
+  mWorkers.resize(mThreadPool->getNumThreads());
+  for(Worker& worker : mWorkers)
+  {
+    worker.mWorld = mWorld->clone();
+    worker.mRobot = worker.mWorld->getSkeleton(mRobot->getName());
+  }
+
+  if(nullptr == mWorkers[0].mRobot)
+  {
+    dterr << "[EdgeValidator::resetClones] The robot named ["
+          << mRobot->getName() << "] is not in the world ["
+          << mWorld->getName() << "]. No states will be checked for "
+          << "collisions!\n";
+    mWorkers.clear();
+  }
+}
+
+//==============================================================================
+void EdgeValidator::synchronizeClones()
+{
+  const size_t numSkeletons = mWorld->getNumSkeletons();
+  for(Worker& worker : mWorkers)
+  {
+    if(worker.mWorld->getNumSkeletons() != numSkeletons)
+    {
+      dtwarn << "[EdgeValidator::synchronizeClones] The number of Skeletons "
+             << "in the world [" << mWorld->getName() << "] has changed. "
+             << "Please call resetClones()!\n";
+      return;
+    }
+  }
+
+  for(size_t i=0; i < numSkeletons; ++i)
+  {
+    const Eigen::VectorXd positions = mWorld->getSkeleton(i)->getPositions();
+    for(Worker& worker : mWorkers)
+      worker.mWorld->getSkeleton(i)->setPositions(positions);
+  }
+}
+
+//==============================================================================
+bool EdgeValidator::isInCollision(Worker& _worker,
+                                  const Eigen::VectorXd& _state) const
+{
+  _worker.mRobot->setPositions(mDofs, _state);
+  return _worker.mWorld->checkCollision(_worker.mRobot, mDofs);
+}
+
+} // namespace planning
+} // namespace dart
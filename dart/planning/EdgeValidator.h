@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_PLANNING_EDGEVALIDATOR_H_
+#define DART_PLANNING_EDGEVALIDATOR_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "dart/common/ThreadPool.h"
+#include "dart/dynamics/SmartPointer.h"
+#include "dart/simulation/World.h"
+
+namespace dart {
+namespace planning {
+
+/// EdgeValidator checks batches of robot configurations for collisions in
+/// parallel. Every thread owns a clone of the world, so the states of a batch
+/// can be set and collision checked concurrently without touching the robot of
+/// the original world. A batch stops as soon as its first colliding state is
+/// known, and the states behind it are never checked.
+///
+/// The positions of all the Skeletons of the original world are copied into
+/// the clones before each batch, so obstacles may be moved between queries. If
+/// Skeletons are added to or removed from the original world, call
+/// resetClones().
+class EdgeValidator
+{
+public:
+
+  /// Constructor. Passing in 0 for _numThreads will use the number of hardware
+  /// threads reported by the system.
+  EdgeValidator(simulation::WorldPtr _world, dynamics::SkeletonPtr _robot,
+                const std::vector<size_t>& _dofs, double _stepSize = 0.1,
+                size_t _numThreads = 0);
+
+  /// Copying is not allowed
+  EdgeValidator(const EdgeValidator&) = delete;
+
+  /// Assignment is not allowed
+  EdgeValidator& operator=(const EdgeValidator&) = delete;
+
+  /// Destructor
+  virtual ~EdgeValidator();
+
+  /// Returns the index of the first state of _states that is in collision, or
+  /// _states.size() if all of them are collision-free. States are handed out
+  /// to the threads in order, so every state in front of the returned index
+  /// has been checked.
+  size_t findFirstCollision(const std::vector<Eigen::VectorXd>& _states);
+
+  /// Returns true iff the segment between _config1 and _config2 is
+  /// collision-free. The endpoints are not checked. If the segment is
+  /// collision-free, _intermediatePoints is filled with the checked states in
+  /// order from _config1 to _config2; otherwise it is not touched.
+  bool isSegmentCollisionFree(const Eigen::VectorXd& _config1,
+                              const Eigen::VectorXd& _config2,
+                              std::vector<Eigen::VectorXd>* _intermediatePoints
+                                  = nullptr);
+
+  /// Fill _states with the evenly spaced states strictly between _config1 and
+  /// _config2 such that no two consecutive states of the segment are further
+  /// apart than the step size.
+  void discretize(const Eigen::VectorXd& _config1,
+                  const Eigen::VectorXd& _config2,
+                  std::vector<Eigen::VectorXd>& _states) const;
+
+  /// Set the maximum distance between two consecutive states of a segment
+  void setStepSize(double _stepSize);
+
+  /// Get the maximum distance between two consecutive states of a segment
+  double getStepSize() const;
+
+  /// Get the number of threads that the states are checked on
+  size_t getNumThreads() const;
+
+  /// Call _job once on each thread with the index of that thread and wait
+  /// until all of them have returned. The clones are synchronized with the
+  /// original world beforehand. Inside of _job, a thread checks states with
+  /// isInCollision(), passing in its own index.
+  void runOnAllThreads(const std::function<void(size_t)>& _job);
+
+  /// Returns true iff _state is in collision in the clone of the world that
+  /// belongs to thread _thread. Threads may call this concurrently as long as
+  /// each one passes in a different index.
+  bool isInCollision(size_t _thread, const Eigen::VectorXd& _state);
+
+  /// Throw away the clones of the world and create them again
+  void resetClones();
+
+protected:
+
+  /// The robot and the world that one thread checks its states in
+  struct Worker
+  {
+    /// Clone of the original world
+    simulation::WorldPtr mWorld;
+
+    /// Clone of the robot inside of mWorld
+    dynamics::SkeletonPtr mRobot;
+  };
+
+  /// Copy the positions of the original world into the clones
+  void synchronizeClones();
+
+  /// Returns true iff _state is in collision in the world of _worker
+  bool isInCollision(Worker& _worker, const Eigen::VectorXd& _state) const;
+
+  /// The world that the robot is in
+  simulation::WorldPtr mWorld;
+
+  /// The robot whose configurations are checked
+  dynamics::SkeletonPtr mRobot;
+
+  /// The dofs of the robot that the configurations refer to
+  std::vector<size_t> mDofs;
+
+  /// Maximum distance between two consecutive states of a segment
+  double mStepSize;
+
+  /// Threads that the states are checked on
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+
+  /// One Worker per thread of mThreadPool
+  std::vector<Worker> mWorkers;
+};
+
+} // namespace planning
+} // namespace dart
+
+#endif // DART_PLANNING_EDGEVALIDATOR_H_
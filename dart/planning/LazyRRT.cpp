@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2010, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** 
+ * @file LazyRRT.cpp
+ * @brief An RRT that defers collision checking until the tree reaches its target. New nodes are
+ * added without any checks, and only the nodes on a candidate path are checked, at which point
+ * the subtrees hanging off colliding nodes are pruned and the search continues.
+ */
+
+#include "LazyRRT.h"
+#include "EdgeValidator.h"
+
+using namespace std;
+using namespace Eigen;
+using namespace dart;
+using namespace simulation;
+using namespace dynamics;
+
+namespace dart {
+namespace planning {
+
+/* ********************************************************************************************* */
+LazyRRT::LazyRRT(WorldPtr world, SkeletonPtr robot, const std::vector<size_t> &dofs,
+		const VectorXd &root, double stepSize, const std::shared_ptr<EdgeValidator>& edgeValidator) :
+	RRT(world, robot, dofs, root, stepSize),
+	edgeValidator(edgeValidator),
+	validated(getSize(), true),
+	removed(getSize(), false)
+{
+	// NOTE: The roots are added by the RRT constructor, before the lazy bookkeeping exists, and
+	// are assumed to be collision-free.
+}
+
+/* ********************************************************************************************* */
+LazyRRT::LazyRRT(WorldPtr world, SkeletonPtr robot, const std::vector<size_t> &dofs,
+		const vector<VectorXd> &roots, double stepSize,
+		const std::shared_ptr<EdgeValidator>& edgeValidator) :
+	RRT(world, robot, dofs, roots, stepSize),
+	edgeValidator(edgeValidator),
+	validated(getSize(), true),
+	removed(getSize(), false)
+{
+}
+
+/* ********************************************************************************************* */
+bool LazyRRT::newConfig(list<VectorXd> &intermediatePoints, VectorXd &qnew, const VectorXd &qnear,
+		const VectorXd &qtarget) {
+	return true;
+}
+
+/* ********************************************************************************************* */
+bool LazyRRT::validatePath(int node) {
+
+	// Collect the unchecked nodes from the root down to the given node
+	vector<int> unchecked;
+	for(int x = node; x != -1; x = parentVector[x]) {
+		if(!validated[x]) unchecked.push_back(x);
+	}
+	if(unchecked.empty()) return true;
+
+	vector<VectorXd> states;
+	states.reserve(unchecked.size());
+	for(vector<int>::reverse_iterator it = unchecked.rbegin(); it != unchecked.rend(); ++it)
+		states.push_back(getConfig(*it));
+
+	// Find the first node in collision, either in parallel or one by one
+	size_t firstCollision = states.size();
+	if(edgeValidator) {
+		firstCollision = edgeValidator->findFirstCollision(states);
+	}
+	else {
+		VectorXd savedConfiguration = robot->getPositions(dofs);
+		for(size_t i = 0; i < states.size(); i++) {
+			if(checkCollisions(states[i])) {
+				firstCollision = i;
+				break;
+			}
+		}
+		robot->setPositions(dofs, savedConfiguration);
+	}
+
+	// The nodes in front of the collision are fine, the rest of the path goes with the first
+	// colliding node
+	for(size_t i = 0; i < firstCollision; i++)
+		validated[unchecked[unchecked.size() - 1 - i]] = true;
+	if(firstCollision == states.size()) return true;
+
+	removeSubtree(unchecked[unchecked.size() - 1 - firstCollision]);
+	return false;
+}
+
+/* ********************************************************************************************* */
+bool LazyRRT::isValidated(int node) const {
+	return validated[node];
+}
+
+/* ********************************************************************************************* */
+bool LazyRRT::isRemoved(int node) const {
+	return removed[node];
+}
+
+/* ********************************************************************************************* */
+int LazyRRT::addNode(const VectorXd &qnew, int parentId) {
+	int id = RRT::addNode(qnew, parentId);
+	validated.push_back(false);
+	removed.push_back(false);
+	return id;
+}
+
+/* ********************************************************************************************* */
+void LazyRRT::removeSubtree(int node) {
+
+	// Nodes are always added after their parents, so a single pass over the later nodes finds
+	// the whole subtree
+	removed[node] = true;
+	index.remove(node);
+	for(size_t i = node + 1; i < getSize(); i++) {
+		if(!removed[i] && parentVector[i] != -1 && removed[parentVector[i]]) {
+			removed[i] = true;
+			index.remove(i);
+		}
+	}
+
+	// Fall back to the root of the tree if the active node was pruned
+	if(removed[activeNode]) {
+		int x = activeNode;
+		while(removed[x]) x = parentVector[x];
+		activeNode = x;
+	}
+}
+
+} // namespace planning
+} // namespace dart
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2010, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the Georgia Tech Research Corporation nor
+ *       the names of its contributors may be used to endorse or
+ *       promote products derived from this software without specific
+ *       prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY GEORGIA TECH RESEARCH CORPORATION ''AS
+ * IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL GEORGIA
+ * TECH RESEARCH CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** 
+ * @file LazyRRT.h
+ * @brief An RRT that defers collision checking until the tree reaches its target. New nodes are
+ * added without any checks, and only the nodes on a candidate path are checked, at which point
+ * the subtrees hanging off colliding nodes are pruned and the search continues.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "RRT.h"
+
+namespace dart {
+namespace planning {
+
+class EdgeValidator;
+
+/// The lazy-collision-checking RRT implementation
+class LazyRRT : public RRT {
+public:
+
+	/// Constructor with a single root. If an edge validator is given, the nodes of a candidate
+	/// path are checked in parallel with it; otherwise they are checked one by one in the world.
+	LazyRRT(simulation::WorldPtr world, dynamics::SkeletonPtr robot, const std::vector<size_t> &dofs,
+			const Eigen::VectorXd &root, double stepSize = 0.02,
+			const std::shared_ptr<EdgeValidator>& edgeValidator = nullptr);
+
+	/// Constructor with multiple roots (so, multiple trees)
+	LazyRRT(simulation::WorldPtr world, dynamics::SkeletonPtr robot, const std::vector<size_t> &dofs,
+			const std::vector<Eigen::VectorXd> &roots, double stepSize = 0.02,
+			const std::shared_ptr<EdgeValidator>& edgeValidator = nullptr);
+
+	/// Destructor
+	virtual ~LazyRRT() {}
+
+	/// Accepts every new configuration. The collision check is deferred to validatePath().
+	bool newConfig(std::list<Eigen::VectorXd> &intermediatePoints, Eigen::VectorXd &qnew,
+			const Eigen::VectorXd &qnear, const Eigen::VectorXd &qtarget) override;
+
+	/// Checks the unchecked nodes on the path from the root to the given node, starting at the root.
+	/// If one of them is in collision, it is removed from the tree together with its subtree and
+	/// false is returned. Removed nodes keep their indices and still count towards getSize().
+	bool validatePath(int node) override;
+
+	/// Returns true if the given node has been checked and is collision-free
+	bool isValidated(int node) const;
+
+	/// Returns true if the given node has been pruned from the tree
+	bool isRemoved(int node) const;
+
+protected:
+
+	/// Checks the nodes of a candidate path in parallel. Can be null.
+	std::shared_ptr<EdgeValidator> edgeValidator;
+
+	/// The ith node has been checked and is collision-free (roots are assumed to be)
+	std::vector<bool> validated;
+
+	/// The ith node has been pruned from the tree
+	std::vector<bool> removed;
+
+	/// Adds a new, unchecked node to the tree
+	int addNode(const Eigen::VectorXd &qnew, int parentId) override;
+
+	/// Removes the given node and all of its descendants from the tree
+	void removeSubtree(int node);
+};
+
+} // namespace planning
+} // namespace dart
@@ -0,0 +1,690 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/planning/NearestNeighbors.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "dart/common/Console.h"
+
+namespace dart {
+namespace planning {
+
+const size_t NearestNeighbors::BLOCK_SIZE;
+const size_t NearestNeighbors::BUFFER_SIZE;
+const size_t NearestNeighbors::LEAF_SIZE;
+
+//==============================================================================
+class NearestNeighbors::KNearestResults
+{
+public:
+
+  explicit KNearestResults(size_t _k) : mK(_k) {}
+
+  /// Squared distance that a point must not exceed to be added
+  double getBound() const
+  {
+    if(mHeap.size() < mK)
+      return std::numeric_limits<double>::infinity();
+
+    return mHeap.top().first;
+  }
+
+  void add(double _squaredDistance, size_t _index)
+  {
+    if(mHeap.size() < mK)
+    {
+      mHeap.push(std::make_pair(_squaredDistance, _index));
+    }
+    else if(_squaredDistance < mHeap.top().first)
+    {
+      mHeap.pop();
+      mHeap.push(std::make_pair(_squaredDistance, _index));
+    }
+  }
+
+  /// Move the results into the output in order of increasing distance
+  void extract(std::vector<size_t>& _indices, std::vector<double>* _distances)
+  {
+    const size_t numResults = mHeap.size();
+    _indices.resize(numResults);
+    if(_distances)
+      _distances->resize(numResults);
+
+    for(size_t i = numResults; i > 0; --i)
+    {
+      _indices[i-1] = mHeap.top().second;
+      if(_distances)
+        (*_distances)[i-1] = std::sqrt(mHeap.top().first);
+      mHeap.pop();
+    }
+  }
+
+protected:
+
+  size_t mK;
+
+  /// Max-heap of the best points found so far
+  std::priority_queue<std::pair<double, size_t>> mHeap;
+};
+
+//==============================================================================
+class NearestNeighbors::RadiusResults
+{
+public:
+
+  explicit RadiusResults(double _radius) : mBound(_radius*_radius) {}
+
+  /// Squared distance that a point must not exceed to be added
+  double getBound() const
+  {
+    return mBound;
+  }
+
+  void add(double _squaredDistance, size_t _index)
+  {
+    mResults.push_back(std::make_pair(_squaredDistance, _index));
+  }
+
+  /// Move the results into the output in order of increasing distance
+  void extract(std::vector<size_t>& _indices, std::vector<double>* _distances)
+  {
+    std::sort(mResults.begin(), mResults.end());
+
+    _indices.resize(mResults.size());
+    if(_distances)
+      _distances->resize(mResults.size());
+
+    for(size_t i = 0; i < mResults.size(); ++i)
+    {
+      _indices[i] = mResults[i].second;
+      if(_distances)
+        (*_distances)[i] = std::sqrt(mResults[i].first);
+    }
+  }
+
+protected:
+
+  double mBound;
+
+  std::vector<std::pair<double, size_t>> mResults;
+};
+
+//==============================================================================
+NearestNeighbors::NearestNeighbors(size_t _dimension)
+  : mDimension(_dimension),
+    mSize(0),
+    mWeights(Eigen::VectorXd::Ones(_dimension)),
+    mPeriods(Eigen::VectorXd::Zero(_dimension)),
+    mHasPeriods(false)
+{
+  mBuffer.reserve(BUFFER_SIZE);
+}
+
+//==============================================================================
+NearestNeighbors::NearestNeighbors(const NearestNeighbors& _other)
+  : mDimension(_other.mDimension),
+    mSize(_other.mSize),
+    mBlocks(_other.mBlocks),
+    mRemoved(_other.mRemoved),
+    mWeights(_other.mWeights),
+    mPeriods(_other.mPeriods),
+    mHasPeriods(_other.mHasPeriods),
+    mTrees(_other.mTrees),
+    mBuffer(_other.mBuffer)
+{
+  mBuffer.reserve(BUFFER_SIZE);
+  resetBlockData();
+}
+
+//==============================================================================
+NearestNeighbors& NearestNeighbors::operator=(const NearestNeighbors& _other)
+{
+  if(this == &_other)
+    return *this;
+
+  mDimension = _other.mDimension;
+  mSize = _other.mSize;
+  mBlocks = _other.mBlocks;
+  mRemoved = _other.mRemoved;
+  mWeights = _other.mWeights;
+  mPeriods = _other.mPeriods;
+  mHasPeriods = _other.mHasPeriods;
+  mTrees = _other.mTrees;
+  mBuffer = _other.mBuffer;
+  mBuffer.reserve(BUFFER_SIZE);
+  resetBlockData();
+
+  return *this;
+}
+
+//==============================================================================
+size_t NearestNeighbors::getDimension() const
+{
+  return mDimension;
+}
+
+//==============================================================================
+size_t NearestNeighbors::getSize() const
+{
+  return mSize;
+}
+
+//==============================================================================
+size_t NearestNeighbors::add(const Eigen::Ref<const Eigen::VectorXd>& _point)
+{
+  assert(static_cast<size_t>(_point.size()) == mDimension);
+
+  const size_t index = mSize;
+  if(index / BLOCK_SIZE == mBlocks.size())
+  {
+    mBlocks.push_back(Eigen::MatrixXd(mDimension, BLOCK_SIZE));
+    mBlockData.push_back(mBlocks.back().data());
+  }
+
+  std::copy(_point.data(), _point.data() + mDimension,
+            mBlockData[index / BLOCK_SIZE] + (index % BLOCK_SIZE) * mDimension);
+  mRemoved.push_back(false);
+  ++mSize;
+
+  mBuffer.push_back(index);
+  if(mBuffer.size() < BUFFER_SIZE)
+    return index;
+
+  // Carry the buffer into the first empty level, merging it with the full
+  // levels below, just like adding one to a binary number
+  std::vector<size_t> indices;
+  indices.swap(mBuffer);
+  mBuffer.reserve(BUFFER_SIZE);
+
+  size_t level = 0;
+  while(level < mTrees.size() && !mTrees[level].mNodes.empty())
+  {
+    indices.insert(indices.end(), mTrees[level].mIndices.begin(),
+                   mTrees[level].mIndices.end());
+    mTrees[level] = Tree();
+    ++level;
+  }
+
+  if(level == mTrees.size())
+    mTrees.push_back(Tree());
+
+  buildTree(mTrees[level], indices);
+
+  return index;
+}
+
+//==============================================================================
+void NearestNeighbors::remove(size_t _index)
+{
+  assert(_index < mSize);
+  mRemoved[_index] = true;
+}
+
+//==============================================================================
+bool NearestNeighbors::isRemoved(size_t _index) const
+{
+  return mRemoved[_index];
+}
+
+//==============================================================================
+void NearestNeighbors::clear()
+{
+  mSize = 0;
+  mBlocks.clear();
+  mBlockData.clear();
+  mRemoved.clear();
+  mTrees.clear();
+  mBuffer.clear();
+}
+
+//==============================================================================
+NearestNeighbors::ConstPoint NearestNeighbors::getPoint(size_t _index) const
+{
+  assert(_index < mSize);
+  return ConstPoint(getData(_index), mDimension);
+}
+
+//==============================================================================
+void NearestNeighbors::setWeights(const Eigen::VectorXd& _weights)
+{
+  if(static_cast<size_t>(_weights.size()) != mDimension
+     || (_weights.array() < 0.0).any())
+  {
+    dterr << "[NearestNeighbors::setWeights] The weights must be "
+          << mDimension << " non-negative numbers. The weights will not be "
+          << "changed.\n";
+    return;
+  }
+
+  mWeights = _weights;
+}
+
+//==============================================================================
+const Eigen::VectorXd& NearestNeighbors::getWeights() const
+{
+  return mWeights;
+}
+
+//==============================================================================
+void NearestNeighbors::setPeriod(size_t _coordinate, double _period)
+{
+  if(_coordinate >= mDimension || _period < 0.0)
+  {
+    dterr << "[NearestNeighbors::setPeriod] Invalid coordinate (" << _coordinate
+          << ") or negative period (" << _period << "). The period will not "
+          << "be changed.\n";
+    return;
+  }
+
+  mPeriods[_coordinate] = _period;
+  mHasPeriods = (mPeriods.array() > 0.0).any();
+}
+
+//==============================================================================
+double NearestNeighbors::getPeriod(size_t _coordinate) const
+{
+  return mPeriods[_coordinate];
+}
+
+//==============================================================================
+double NearestNeighbors::distance(
+    const Eigen::Ref<const Eigen::VectorXd>& _config1,
+    const Eigen::Ref<const Eigen::VectorXd>& _config2) const
+{
+  assert(static_cast<size_t>(_config1.size()) == mDimension);
+  assert(static_cast<size_t>(_config2.size()) == mDimension);
+
+  return std::sqrt(squaredDistance(_config1.data(), _config2.data()));
+}
+
+//==============================================================================
+Eigen::VectorXd NearestNeighbors::difference(
+    const Eigen::Ref<const Eigen::VectorXd>& _config1,
+    const Eigen::Ref<const Eigen::VectorXd>& _config2) const
+{
+  assert(static_cast<size_t>(_config1.size()) == mDimension);
+  assert(static_cast<size_t>(_config2.size()) == mDimension);
+
+  Eigen::VectorXd result = _config2 - _config1;
+  if(!mHasPeriods)
+    return result;
+
+  for(size_t i = 0; i < mDimension; ++i)
+  {
+    const double period = mPeriods[i];
+    if(period > 0.0)
+    {
+      // Move the displacement into [-period/2, period/2)
+      result[i] = std::fmod(result[i] + 0.5 * period, period);
+      if(result[i] < 0.0)
+        result[i] += period;
+      result[i] -= 0.5 * period;
+    }
+  }
+
+  return result;
+}
+
+//==============================================================================
+int NearestNeighbors::nearest(const Eigen::Ref<const Eigen::VectorXd>& _query,
+                              double* _distance) const
+{
+  std::vector<size_t> indices;
+  std::vector<double> distances;
+  nearestK(_query, 1, indices, &distances);
+
+  if(indices.empty())
+    return -1;
+
+  if(_distance)
+    *_distance = distances[0];
+
+  return static_cast<int>(indices[0]);
+}
+
+//==============================================================================
+void NearestNeighbors::nearestK(
+    const Eigen::Ref<const Eigen::VectorXd>& _query, size_t _k,
+    std::vector<size_t>& _indices, std::vector<double>* _distances) const
+{
+  assert(static_cast<size_t>(_query.size()) == mDimension);
+
+  KNearestResults results(_k);
+  if(_k > 0)
+    search(_query.data(), results);
+  results.extract(_indices, _distances);
+}
+
+//==============================================================================
+void NearestNeighbors::nearestR(
+    const Eigen::Ref<const Eigen::VectorXd>& _query, double _radius,
+    std::vector<size_t>& _indices, std::vector<double>* _distances) const
+{
+  assert(static_cast<size_t>(_query.size()) == mDimension);
+
+  RadiusResults results(_radius);
+  if(_radius >= 0.0)
+    search(_query.data(), results);
+  results.extract(_indices, _distances);
+}
+
+//==============================================================================
+const double* NearestNeighbors::getData(size_t _index) const
+{
+  return mBlockData[_index / BLOCK_SIZE] + (_index % BLOCK_SIZE) * mDimension;
+}
+
+//==============================================================================
+void NearestNeighbors::resetBlockData()
+{
+  mBlockData.clear();
+  mBlockData.reserve(mBlocks.size());
+  for(Eigen::MatrixXd& block : mBlocks)
+    mBlockData.push_back(block.data());
+}
+
+//==============================================================================
+void NearestNeighbors::buildTree(Tree& _tree,
+                                 std::vector<size_t>& _indices) const
+{
+  // Removed points do not need to be carried into the new tree
+  _tree.mIndices.clear();
+  _tree.mIndices.reserve(_indices.size());
+  for(size_t index : _indices)
+  {
+    if(!mRemoved[index])
+      _tree.mIndices.push_back(index);
+  }
+
+  const size_t maxNumNodes = 2 * (_tree.mIndices.size() / LEAF_SIZE + 1);
+  _tree.mNodes.reserve(maxNumNodes);
+  _tree.mBounds.reserve(2 * mDimension * maxNumNodes);
+  buildNode(_tree, 0, _tree.mIndices.size());
+
+  // Copy the points in the order of the leaves, so that a leaf is scanned
+  // without jumping around in memory
+  _tree.mPoints.resize(mDimension, _tree.mIndices.size());
+  for(size_t i = 0; i < _tree.mIndices.size(); ++i)
+    _tree.mPoints.col(i) = ConstPoint(getData(_tree.mIndices[i]), mDimension);
+}
+
+//==============================================================================
+size_t NearestNeighbors::buildNode(Tree& _tree, size_t _begin,
+                                   size_t _end) const
+{
+  const size_t node = _tree.mNodes.size();
+  Node newNode = { _begin, _end, 0, 0 };
+  _tree.mNodes.push_back(newNode);
+  _tree.mBounds.resize(_tree.mBounds.size() + 2 * mDimension);
+
+  if(_end - _begin <= LEAF_SIZE)
+  {
+    // The bounding box of a leaf is computed from its points
+    double* lower = &_tree.mBounds[2 * mDimension * node];
+    double* upper = lower + mDimension;
+    std::fill(lower, upper, std::numeric_limits<double>::infinity());
+    std::fill(upper, upper + mDimension,
+              -std::numeric_limits<double>::infinity());
+    for(size_t i = _begin; i < _end; ++i)
+    {
+      const double* point = getData(_tree.mIndices[i]);
+      for(size_t j = 0; j < mDimension; ++j)
+      {
+        lower[j] = std::min(lower[j], point[j]);
+        upper[j] = std::max(upper[j], point[j]);
+      }
+    }
+
+    return node;
+  }
+
+  // Split the coordinate with the largest spread at the median. The spread is
+  // estimated from a sample of the points, which is much cheaper than a full
+  // bounding box and works just as well for sampled configurations.
+  Eigen::VectorXd minimum = Eigen::VectorXd::Constant(
+        mDimension, std::numeric_limits<double>::infinity());
+  Eigen::VectorXd maximum = -minimum;
+  const size_t stride = std::max<size_t>(1, (_end - _begin) / 64);
+  for(size_t i = _begin; i < _end; i += stride)
+  {
+    const ConstPoint point(getData(_tree.mIndices[i]), mDimension);
+    minimum = minimum.cwiseMin(point);
+    maximum = maximum.cwiseMax(point);
+  }
+
+  size_t axis;
+  (maximum - minimum).maxCoeff(&axis);
+
+  const size_t middle = (_begin + _end) / 2;
+  std::nth_element(_tree.mIndices.begin() + _begin,
+                   _tree.mIndices.begin() + middle,
+                   _tree.mIndices.begin() + _end,
+                   [&](size_t _a, size_t _b)
+  {
+    return getData(_a)[axis] < getData(_b)[axis];
+  });
+
+  // NOTE: The nodes and the bounds may be reallocated by the recursion, so
+  // they are only accessed by position
+  const size_t left = buildNode(_tree, _begin, middle);
+  const size_t right = buildNode(_tree, middle, _end);
+  _tree.mNodes[node].mLeft = left;
+  _tree.mNodes[node].mRight = right;
+
+  // The bounding box of an inner node is the union of those of its children,
+  // which is tighter than the cell of a classic k-d tree when the points are
+  // clustered, like the nodes of an RRT
+  double* bounds = &_tree.mBounds[2 * mDimension * node];
+  const double* leftBounds = &_tree.mBounds[2 * mDimension * left];
+  const double* rightBounds = &_tree.mBounds[2 * mDimension * right];
+  for(size_t j = 0; j < mDimension; ++j)
+  {
+    bounds[j] = std::min(leftBounds[j], rightBounds[j]);
+    bounds[mDimension + j] = std::max(leftBounds[mDimension + j],
+                                      rightBounds[mDimension + j]);
+  }
+
+  return node;
+}
+
+//==============================================================================
+double NearestNeighbors::squaredDistance(const double* _point1,
+                                         const double* _point2,
+                                         double _bound) const
+{
+  double result = 0.0;
+
+  if(!mHasPeriods)
+  {
+    for(size_t i = 0; i < mDimension; ++i)
+    {
+      const double difference = _point1[i] - _point2[i];
+      result += mWeights[i] * difference * difference;
+      if(result > _bound)
+        break;
+    }
+
+    return result;
+  }
+
+  for(size_t i = 0; i < mDimension; ++i)
+  {
+    double difference = std::abs(_point1[i] - _point2[i]);
+
+    const double period = mPeriods[i];
+    if(period > 0.0)
+    {
+      difference = std::fmod(difference, period);
+      difference = std::min(difference, period - difference);
+    }
+
+    result += mWeights[i] * difference * difference;
+    if(result > _bound)
+      break;
+  }
+
+  return result;
+}
+
+//==============================================================================
+double NearestNeighbors::squaredDistance(const double* _point,
+                                         const double* _lower,
+                                         const double* _upper) const
+{
+  double result = 0.0;
+  for(size_t i = 0; i < mDimension; ++i)
+  {
+    double difference = 0.0;
+
+    const double period = mPeriods[i];
+    if(period > 0.0)
+    {
+      if(_upper[i] - _lower[i] < period)
+      {
+        // Move the point into the period that starts at the lower bound
+        double shifted = std::fmod(_point[i] - _lower[i], period);
+        if(shifted < 0.0)
+          shifted += period;
+        shifted += _lower[i];
+
+        if(shifted > _upper[i])
+          difference = std::min(shifted - _upper[i],
+                                _lower[i] + period - shifted);
+      }
+    }
+    else if(_point[i] < _lower[i])
+    {
+      difference = _lower[i] - _point[i];
+    }
+    else if(_point[i] > _upper[i])
+    {
+      difference = _point[i] - _upper[i];
+    }
+
+    result += mWeights[i] * difference * difference;
+  }
+
+  return result;
+}
+
+//==============================================================================
+template <class Results>
+void NearestNeighbors::search(const double* _query, Results& _results) const
+{
+  for(size_t index : mBuffer)
+  {
+    if(mRemoved[index])
+      continue;
+
+    const double squared
+        = squaredDistance(_query, getData(index), _results.getBound());
+    if(squared <= _results.getBound())
+      _results.add(squared, index);
+  }
+
+  // The largest tree is searched first, since it is the most likely to
+  // tighten the bound for the others
+  for(size_t i = mTrees.size(); i > 0; --i)
+  {
+    const Tree& tree = mTrees[i-1];
+    if(tree.mIndices.empty())
+      continue;
+
+    const double* bounds = &tree.mBounds[0];
+    if(squaredDistance(_query, bounds, bounds + mDimension)
+       <= _results.getBound())
+    {
+      searchNode(tree, 0, _query, _results);
+    }
+  }
+}
+
+//==============================================================================
+template <class Results>
+void NearestNeighbors::searchNode(const Tree& _tree, size_t _node,
+                                  const double* _query,
+                                  Results& _results) const
+{
+  const Node& node = _tree.mNodes[_node];
+
+  if(0 == node.mLeft)
+  {
+    for(size_t i = node.mBegin; i < node.mEnd; ++i)
+    {
+      const size_t index = _tree.mIndices[i];
+      if(mRemoved[index])
+        continue;
+
+      const double squared = squaredDistance(
+            _query, _tree.mPoints.col(i).data(), _results.getBound());
+      if(squared <= _results.getBound())
+        _results.add(squared, index);
+    }
+
+    return;
+  }
+
+  const double* leftBounds = &_tree.mBounds[2 * mDimension * node.mLeft];
+  const double* rightBounds = &_tree.mBounds[2 * mDimension * node.mRight];
+  const double leftDistance = squaredDistance(
+        _query, leftBounds, leftBounds + mDimension);
+  const double rightDistance = squaredDistance(
+        _query, rightBounds, rightBounds + mDimension);
+
+  // Visit the closer child first, so that the bound of the results is as
+  // tight as possible when the other one is considered
+  if(leftDistance <= rightDistance)
+  {
+    if(leftDistance <= _results.getBound())
+      searchNode(_tree, node.mLeft, _query, _results);
+    if(rightDistance <= _results.getBound())
+      searchNode(_tree, node.mRight, _query, _results);
+  }
+  else
+  {
+    if(rightDistance <= _results.getBound())
+      searchNode(_tree, node.mRight, _query, _results);
+    if(leftDistance <= _results.getBound())
+      searchNode(_tree, node.mLeft, _query, _results);
+  }
+}
+
+} // namespace planning
+} // namespace dart
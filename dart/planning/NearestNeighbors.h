@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_PLANNING_NEARESTNEIGHBORS_H_
+#define DART_PLANNING_NEARESTNEIGHBORS_H_
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "dart/math/MathTypes.h"
+
+namespace dart {
+namespace planning {
+
+/// NearestNeighbors is an incremental k-d tree index for configurations. The
+/// points are copied into contiguous blocks of aligned memory, so adding a
+/// point never moves the points that are already stored and does not allocate
+/// memory per point.
+///
+/// Insertions follow the logarithmic method: new points are collected in a
+/// small buffer, and whenever the buffer is full, it is merged with the trees
+/// of equal size into a new balanced tree. Each point is rebuilt into a new
+/// tree O(log n) times, and a query searches O(log n) balanced trees.
+///
+/// Distances are weighted Euclidean distances. Any coordinate can wrap around,
+/// e.g. the position of a revolute joint without limits. The metric can be
+/// changed at any time, since the trees only depend on the coordinates of the
+/// points.
+class NearestNeighbors
+{
+public:
+
+  /// Read-only view of a point of the index. It stays valid until the index
+  /// is cleared.
+  typedef Eigen::Map<const Eigen::VectorXd> ConstPoint;
+
+  /// Constructor
+  explicit NearestNeighbors(size_t _dimension);
+
+  /// Copy constructor. The copy stores its own copies of the points.
+  NearestNeighbors(const NearestNeighbors& _other);
+
+  /// Assignment operator. This index stores its own copies of the points.
+  NearestNeighbors& operator=(const NearestNeighbors& _other);
+
+  /// Get the number of coordinates of each point
+  size_t getDimension() const;
+
+  /// Get the number of points that have been added, including removed ones
+  size_t getSize() const;
+
+  /// Add a point and return its index. Indices are assigned consecutively,
+  /// starting at 0.
+  size_t add(const Eigen::Ref<const Eigen::VectorXd>& _point);
+
+  /// Exclude a point from all future queries. Its index is not reused.
+  void remove(size_t _index);
+
+  /// Returns true if the point has been removed
+  bool isRemoved(size_t _index) const;
+
+  /// Remove all the points and reset the indices
+  void clear();
+
+  /// Get a point of the index
+  ConstPoint getPoint(size_t _index) const;
+
+  /// Set the weight of each coordinate in the distance metric. The weights
+  /// must not be negative. All weights are 1 by default.
+  void setWeights(const Eigen::VectorXd& _weights);
+
+  /// Get the weight of each coordinate in the distance metric
+  const Eigen::VectorXd& getWeights() const;
+
+  /// Let a coordinate wrap around with the given period. Passing in a period
+  /// of 0 turns wrapping around off, which is the default.
+  void setPeriod(size_t _coordinate, double _period = 2.0*DART_PI);
+
+  /// Get the period of a coordinate, which is 0 if it does not wrap around
+  double getPeriod(size_t _coordinate) const;
+
+  /// Compute the distance between two configurations under the metric of this
+  /// index
+  double distance(const Eigen::Ref<const Eigen::VectorXd>& _config1,
+                  const Eigen::Ref<const Eigen::VectorXd>& _config2) const;
+
+  /// Compute the displacement from _config1 to _config2. Coordinates that wrap
+  /// around take the shorter way, so their displacement is at most half a
+  /// period. Weighting the displacement by the weights of this index gives
+  /// distance(_config1, _config2).
+  Eigen::VectorXd difference(
+      const Eigen::Ref<const Eigen::VectorXd>& _config1,
+      const Eigen::Ref<const Eigen::VectorXd>& _config2) const;
+
+  /// Returns the index of the point nearest to _query, or -1 if there are no
+  /// points
+  int nearest(const Eigen::Ref<const Eigen::VectorXd>& _query,
+              double* _distance = nullptr) const;
+
+  /// Find the (at most) _k points nearest to _query, sorted by increasing
+  /// distance
+  void nearestK(const Eigen::Ref<const Eigen::VectorXd>& _query, size_t _k,
+                std::vector<size_t>& _indices,
+                std::vector<double>* _distances = nullptr) const;
+
+  /// Find all the points that are not further than _radius from _query, sorted
+  /// by increasing distance
+  void nearestR(const Eigen::Ref<const Eigen::VectorXd>& _query,
+                double _radius, std::vector<size_t>& _indices,
+                std::vector<double>* _distances = nullptr) const;
+
+protected:
+
+  /// Number of points in each block of memory
+  static const size_t BLOCK_SIZE = 256;
+
+  /// Number of new points that are collected before they are put in a tree
+  static const size_t BUFFER_SIZE = 32;
+
+  /// Maximum number of points in a leaf of a tree
+  static const size_t LEAF_SIZE = 8;
+
+  /// A node of a tree, which covers a contiguous range of Tree::mIndices
+  struct Node
+  {
+    /// First position in Tree::mIndices
+    size_t mBegin;
+
+    /// One past the last position in Tree::mIndices
+    size_t mEnd;
+
+    /// Children of the node. The root can never be a child, so 0 marks a leaf.
+    size_t mLeft;
+    size_t mRight;
+  };
+
+  /// A balanced k-d tree over a subset of the points
+  struct Tree
+  {
+    /// Indices of the points, ordered such that every node covers a range
+    std::vector<size_t> mIndices;
+
+    /// Copies of the points in the order of mIndices, one point per column
+    Eigen::MatrixXd mPoints;
+
+    /// Nodes of the tree, where the root comes first
+    std::vector<Node> mNodes;
+
+    /// Bounding box of each node: the lower corner followed by the upper
+    /// corner, for one node after the other
+    std::vector<double> mBounds;
+  };
+
+  /// Gathers the results of a k-nearest-neighbors query
+  class KNearestResults;
+
+  /// Gathers the results of a radius query
+  class RadiusResults;
+
+  /// Get the coordinates of a point
+  const double* getData(size_t _index) const;
+
+  /// Point mBlockData at the blocks of mBlocks
+  void resetBlockData();
+
+  /// Build a tree over the given points
+  void buildTree(Tree& _tree, std::vector<size_t>& _indices) const;
+
+  /// Create the node over a range of _tree.mIndices and its children, and
+  /// return the position of the node
+  size_t buildNode(Tree& _tree, size_t _begin, size_t _end) const;
+
+  /// Compute the weighted squared distance between two points. The
+  /// computation stops early once the result exceeds _bound.
+  double squaredDistance(const double* _point1, const double* _point2,
+                         double _bound
+                             = std::numeric_limits<double>::infinity()) const;
+
+  /// Compute the weighted squared distance between a point and a box
+  double squaredDistance(const double* _point, const double* _lower,
+                         const double* _upper) const;
+
+  /// Collect the results of a query from all the trees and the buffer
+  template <class Results>
+  void search(const double* _query, Results& _results) const;
+
+  /// Collect the results of a query from a subtree
+  template <class Results>
+  void searchNode(const Tree& _tree, size_t _node, const double* _query,
+                  Results& _results) const;
+
+  /// Number of coordinates of each point
+  size_t mDimension;
+
+  /// Number of points that have been added
+  size_t mSize;
+
+  /// Blocks of BLOCK_SIZE points, one point per column. A deque never moves
+  /// its elements when it grows, so the points never move either.
+  std::deque<Eigen::MatrixXd> mBlocks;
+
+  /// Data of each block of mBlocks, which is faster to look up
+  std::vector<double*> mBlockData;
+
+  /// Whether each point has been removed
+  std::vector<bool> mRemoved;
+
+  /// Weight of each coordinate
+  Eigen::VectorXd mWeights;
+
+  /// Period of each coordinate, or 0 if it does not wrap around
+  Eigen::VectorXd mPeriods;
+
+  /// True if any coordinate wraps around
+  bool mHasPeriods;
+
+  /// The ith tree either has no nodes or was built from BUFFER_SIZE * 2^i
+  /// points, minus the ones that had been removed at the time
+  std::vector<Tree> mTrees;
+
+  /// Points that have not been put in a tree yet
+  std::vector<size_t> mBuffer;
+};
+
+} // namespace planning
+} // namespace dart
+
+#endif // DART_PLANNING_NEARESTNEIGHBORS_H_
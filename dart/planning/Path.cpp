@@ -220,7 +220,7 @@ Path::Path(const list<VectorXd> &path, double maxDeviation) :
 	}
 
 	// create list of switching point candidates, calculate total path length and absolute positions of path segments
-  for(list<PathSegment*>::iterator segment = pathSegments.begin(); segment != pathSegments.end(); ++segment) {
+  for(vector<PathSegment*>::iterator segment = pathSegments.begin(); segment != pathSegments.end(); ++segment) {
 		(*segment)->position = length;
 		list<double> localSwitchingPoints = (*segment)->getSwitchingPoints();
     for(list<double>::const_iterator point = localSwitchingPoints.begin(); point != localSwitchingPoints.end(); ++point) {
@@ -236,13 +236,14 @@ Path::Path(const Path &path) :
 	length(path.length),
 	switchingPoints(path.switchingPoints)
 {
-  for(list<PathSegment*>::const_iterator it = path.pathSegments.begin(); it != path.pathSegments.end(); ++it) {
+  pathSegments.reserve(path.pathSegments.size());
+  for(vector<PathSegment*>::const_iterator it = path.pathSegments.begin(); it != path.pathSegments.end(); ++it) {
 		pathSegments.push_back((*it)->clone());
 	}
 }
 
 Path::~Path() {
-  for(list<PathSegment*>::iterator it = pathSegments.begin(); it != pathSegments.end(); ++it) {
+  for(vector<PathSegment*>::iterator it = pathSegments.begin(); it != pathSegments.end(); ++it) {
 		delete *it;
 	}
 }
@@ -251,14 +252,13 @@ double Path::getLength() const {
 	return length;
 }
 
+static bool comparePosition(double s, const PathSegment* segment) {
+	return s < segment->position;
+}
+
 PathSegment* Path::getPathSegment(double &s) const {
-	list<PathSegment*>::const_iterator it = pathSegments.begin();
-	list<PathSegment*>::const_iterator next = it;
-  ++next;
-	while(next != pathSegments.end() && s >= (*next)->position) {
-		it = next;
-    ++next;
-	}
+	vector<PathSegment*>::const_iterator it = upper_bound(pathSegments.begin() + 1, pathSegments.end(), s, comparePosition);
+  --it;
 	s -= (*it)->position;
 	return *it;
 }
@@ -278,11 +278,12 @@ VectorXd Path::getCurvature(double s) const {
 	return pathSegment->getCurvature(s);
 }
 
+static bool compareSwitchingPoint(double s, const pair<double, bool> &switchingPoint) {
+	return s < switchingPoint.first;
+}
+
 double Path::getNextSwitchingPoint(double s, bool &discontinuity) const {
-	list<pair<double, bool> >::const_iterator it = switchingPoints.begin();
-	while(it != switchingPoints.end() && it->first <= s) {
-    ++it;
-	}
+	vector<pair<double, bool> >::const_iterator it = upper_bound(switchingPoints.begin(), switchingPoints.end(), s, compareSwitchingPoint);
 	if(it == switchingPoints.end()) {
 		discontinuity = true;
 		return length;
@@ -293,7 +294,7 @@ double Path::getNextSwitchingPoint(double s, bool &discontinuity) const {
 	}
 }
 
-list<pair<double, bool> > Path::getSwitchingPoints() const {
+const vector<pair<double, bool> >& Path::getSwitchingPoints() const {
 	return switchingPoints;
 }
 
@@ -39,6 +39,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 #include <Eigen/Core>
 
 namespace dart {
@@ -81,12 +82,14 @@ public:
 	Eigen::VectorXd getTangent(double s) const;
 	Eigen::VectorXd getCurvature(double s) const;
 	double getNextSwitchingPoint(double s, bool &discontinuity) const;
-	std::list<std::pair<double, bool> > getSwitchingPoints() const;
+	const std::vector<std::pair<double, bool> >& getSwitchingPoints() const;
 private:
+	/// Finds the segment containing s by binary search over the segment
+	/// positions and makes s relative to the start of that segment.
 	PathSegment* getPathSegment(double &s) const;
 	double length;
-	std::list<std::pair<double, bool> > switchingPoints;
-	std::list<PathSegment*> pathSegments;
+	std::vector<std::pair<double, bool> > switchingPoints;
+	std::vector<PathSegment*> pathSegments;
 };
 
 } // namespace planning
@@ -37,6 +37,7 @@
  */
 
 #include "PathFollowingTrajectory.h"
+#include <algorithm>
 #include <limits>
 #include <iostream>
 #include <fstream>
@@ -60,7 +61,7 @@ PathFollowingTrajectory::PathFollowingTrajectory(const Path &path, const VectorX
 	maxAcceleration(maxAcceleration),
 	n(maxVelocity.size()),
 	valid(true),
-    cachedTime(numeric_limits<double>::max())
+    cachedTrajectorySegment(1)
 {
 	// debug
 	//{
@@ -74,7 +75,7 @@ PathFollowingTrajectory::PathFollowingTrajectory(const Path &path, const VectorX
 	//file.close();
 	//}
 
-    list<TrajectoryStep> startTrajectory;
+    vector<TrajectoryStep> startTrajectory;
 	startTrajectory.push_back(TrajectoryStep(0.0, 0.0));
 	double afterAcceleration = getMinMaxPathAcceleration(0.0, 0.0, true);
 	while(!integrateForward(startTrajectory, afterAcceleration) && valid) {
@@ -84,33 +85,30 @@ PathFollowingTrajectory::PathFollowingTrajectory(const Path &path, const VectorX
 			break;
 		}
 		//cout << "set arrow from " << switchingPoint.pathPos << ", " << switchingPoint.pathVel - 0.8 << " to " << switchingPoint.pathPos << ", " << switchingPoint.pathVel - 0.3 << endl;
-        list<TrajectoryStep> trajectory;
-		trajectory.push_back(switchingPoint);
-		integrateBackward(trajectory, startTrajectory, beforeAcceleration);
+		integrateBackward(switchingPoint, startTrajectory, beforeAcceleration);
 	}
 
-    list<TrajectoryStep> endTrajectory;
-	endTrajectory.push_front(TrajectoryStep(path.getLength(), 0.0));
 	double beforeAcceleration = getMinMaxPathAcceleration(path.getLength(), 0.0, false);
-	integrateBackward(endTrajectory, startTrajectory, beforeAcceleration);
-	
-	this->trajectory = startTrajectory;
+	integrateBackward(TrajectoryStep(path.getLength(), 0.0), startTrajectory, beforeAcceleration);
 
 	// calculate timing
-    list<TrajectoryStep>::iterator previous = trajectory.begin();
-    list<TrajectoryStep>::iterator it = previous;
-	it->time = 0.0;
-  ++it;
-	while(it != trajectory.end()) {
-		it->time = previous->time + (it->pathPos - previous->pathPos) / ((it->pathVel + previous->pathVel) / 2.0);
-		previous = it;
-    ++it;
+	const size_t numSteps = startTrajectory.size();
+	times.resize(numSteps);
+	pathPositions.resize(numSteps);
+	pathVelocities.resize(numSteps);
+	times[0] = 0.0;
+	pathPositions[0] = startTrajectory[0].pathPos;
+	pathVelocities[0] = startTrajectory[0].pathVel;
+	for(size_t i = 1; i < numSteps; i++) {
+		pathPositions[i] = startTrajectory[i].pathPos;
+		pathVelocities[i] = startTrajectory[i].pathVel;
+		times[i] = times[i - 1] + (pathPositions[i] - pathPositions[i - 1]) / ((pathVelocities[i] + pathVelocities[i - 1]) / 2.0);
 	}
 
 	// debug
 	//ofstream file("trajectory.txt");
-	//for(list<TrajectoryStep>::iterator it = trajectory.begin(); it != trajectory.end(); it++) {
-	//	file << it->pathPos << "  " << it->pathVel << endl;
+	//for(size_t i = 0; i < pathPositions.size(); i++) {
+	//	file << pathPositions[i] << "  " << pathVelocities[i] << endl;
 	//}
 	//file.close();
 }
@@ -197,26 +195,45 @@ bool PathFollowingTrajectory::getNextAccelerationSwitchingPoint(double pathPos,
 }
 
 bool PathFollowingTrajectory::getNextVelocitySwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration) {
-	const double stepSize = 0.001;
+	const double minStepSize = 0.001;
 	const double accuracy = 0.000001;
 
+	// Scan with minStepSize, but double the step as long as the switching
+	// condition stays exactly the same. This is the case along linear path
+	// segments, where tangent and curvature are constant. Enlarged steps never
+	// cross a switching point of the path, so each one stays within a segment.
 	bool start = false;
-	pathPos -= stepSize;
-	do {
-		pathPos += stepSize;
+	double stepSize = minStepSize;
+	double previousCondition = numeric_limits<double>::quiet_NaN();
+	double previousPathPos = pathPos - minStepSize;
+	while(true) {
+		const double condition = getMinMaxPhaseSlope(pathPos, getVelocityMaxPathVelocity(pathPos), false) - getVelocityMaxPathVelocityDeriv(pathPos);
+		if(condition >= 0.0) {
+			start = true;
+		}
+		if((start && condition <= 0.0) || pathPos >= path.getLength()) {
+			break;
+		}
 
+		stepSize = (condition == previousCondition) ? 2.0 * stepSize : minStepSize;
+		previousCondition = condition;
+		previousPathPos = pathPos;
 
-		if(getMinMaxPhaseSlope(pathPos, getVelocityMaxPathVelocity(pathPos), false) >= getVelocityMaxPathVelocityDeriv(pathPos)) {
-			start = true;
+		if(stepSize > minStepSize) {
+			bool discontinuity;
+			const double switchingPathPos = path.getNextSwitchingPoint(pathPos, discontinuity);
+			pathPos = min(pathPos + stepSize, max(switchingPathPos, pathPos + minStepSize));
 		}
-	} while((!start || getMinMaxPhaseSlope(pathPos, getVelocityMaxPathVelocity(pathPos), false) > getVelocityMaxPathVelocityDeriv(pathPos))
-		&& pathPos < path.getLength());
+		else {
+			pathPos += minStepSize;
+		}
+	}
 
 	if(pathPos >= path.getLength()) {
 		return true; // end of trajectory reached
 	}
 
-	double beforePathPos = pathPos - stepSize;
+	double beforePathPos = previousPathPos;
 	double afterPathPos = pathPos;
 	while(afterPathPos - beforePathPos > accuracy) {
 		pathPos = (beforePathPos + afterPathPos) / 2.0;
@@ -234,22 +251,22 @@ bool PathFollowingTrajectory::getNextVelocitySwitchingPoint(double pathPos, Traj
 	return false;
 }
 
-bool PathFollowingTrajectory::integrateForward(list<TrajectoryStep> &trajectory, double acceleration) {
+bool PathFollowingTrajectory::integrateForward(vector<TrajectoryStep> &trajectory, double acceleration) {
 	
 	double pathPos = trajectory.back().pathPos;
 	double pathVel = trajectory.back().pathVel;
 	
-    list<pair<double, bool> > switchingPoints = path.getSwitchingPoints();
-    list<pair<double, bool> >::iterator nextDiscontinuity = switchingPoints.begin();
+	// the path returns its length if there are no more discontinuities
+	double nextDiscontinuity = -numeric_limits<double>::infinity();
 
 	while(true)
 	{
-		if(pathPos > 1.304) {
-      // int test = 48;
-		}
-
-    while(nextDiscontinuity != switchingPoints.end() && (nextDiscontinuity->first <= pathPos || !nextDiscontinuity->second)) {
-      ++nextDiscontinuity;
+		if(nextDiscontinuity <= pathPos) {
+			bool discontinuity;
+			nextDiscontinuity = pathPos;
+			do {
+				nextDiscontinuity = path.getNextSwitchingPoint(nextDiscontinuity, discontinuity);
+			} while(!discontinuity);
 		}
 
 		double oldPathPos = pathPos;
@@ -259,9 +276,9 @@ bool PathFollowingTrajectory::integrateForward(list<TrajectoryStep> &trajectory,
 		pathPos += timeStep * 0.5 * (oldPathVel + pathVel);
 
 
-		if(nextDiscontinuity != switchingPoints.end() && pathPos > nextDiscontinuity->first) {
-			pathVel = oldPathVel + (nextDiscontinuity->first + eps - oldPathPos) * (pathVel - oldPathVel) / (pathPos - oldPathPos);
-			pathPos = nextDiscontinuity->first + eps;
+		if(pathPos > nextDiscontinuity) {
+			pathVel = oldPathVel + (nextDiscontinuity + eps - oldPathPos) * (pathVel - oldPathVel) / (pathPos - oldPathPos);
+			pathPos = nextDiscontinuity + eps;
 		}
 
 		//pathVel += timeStep * acceleration;
@@ -313,7 +330,7 @@ bool PathFollowingTrajectory::integrateForward(list<TrajectoryStep> &trajectory,
 			trajectory.push_back(TrajectoryStep(before, trajectory.back().pathVel + slope * (before - trajectory.back().pathPos)));
 		
 			if(getAccelerationMaxPathVelocity(after) < getVelocityMaxPathVelocity(after)) {
-				if(after > nextDiscontinuity->first) {
+				if(after > nextDiscontinuity) {
 					return false;
 				}
 				else if(getMinMaxPhaseSlope(trajectory.back().pathPos, trajectory.back().pathVel, true) > getAccelerationMaxPathVelocityDeriv(trajectory.back().pathPos)) {
@@ -331,10 +348,14 @@ bool PathFollowingTrajectory::integrateForward(list<TrajectoryStep> &trajectory,
 }
 
 
-void PathFollowingTrajectory::integrateBackward(list<TrajectoryStep> &trajectory, list<TrajectoryStep> &startTrajectory, double acceleration) {
-    list<TrajectoryStep>::reverse_iterator before = startTrajectory.rbegin();
-	double pathPos = trajectory.front().pathPos;
-	double pathVel = trajectory.front().pathVel;
+void PathFollowingTrajectory::integrateBackward(const TrajectoryStep &endPoint, vector<TrajectoryStep> &startTrajectory, double acceleration) {
+	// steps are appended in reverse order, so trajectory.back() is the earliest one
+	vector<TrajectoryStep> trajectory;
+	trajectory.push_back(endPoint);
+	// startTrajectory[before - 1] is the last step of startTrajectory not behind pathPos
+	size_t before = startTrajectory.size();
+	double pathPos = endPoint.pathPos;
+	double pathVel = endPoint.pathVel;
 
 	while(true)
 	{
@@ -345,7 +366,7 @@ void PathFollowingTrajectory::integrateBackward(list<TrajectoryStep> &trajectory
 		pathVel -= timeStep * acceleration;
 		pathPos -= timeStep * 0.5 * (oldPathVel + pathVel);
 
-		trajectory.push_front(TrajectoryStep(pathPos, pathVel));
+		trajectory.push_back(TrajectoryStep(pathPos, pathVel));
 		acceleration = getMinMaxPathAcceleration(pathPos, pathVel, false);
 
 		if(pathVel < 0.0 || pathPos < 0.0) {
@@ -354,34 +375,34 @@ void PathFollowingTrajectory::integrateBackward(list<TrajectoryStep> &trajectory
 			return;
 		}
 
-		while(before != startTrajectory.rend() && before->pathPos > pathPos) {
-      ++before;
+		while(before > 0 && startTrajectory[before - 1].pathPos > pathPos) {
+      --before;
 		}
 
 		bool error = false;
 
-		if(before != startTrajectory.rbegin() && pathVel >= before->pathVel + getSlope(before.base()) * (pathPos - before->pathPos)) {
-			TrajectoryStep overshoot = trajectory.front();
-			trajectory.pop_front();
-            list<TrajectoryStep>::iterator after = before.base();
-			TrajectoryStep intersection = getIntersection(startTrajectory, after, overshoot, trajectory.front());
+		if(before != startTrajectory.size() && pathVel >= startTrajectory[before - 1].pathVel + getSlope(startTrajectory, before) * (pathPos - startTrajectory[before - 1].pathPos)) {
+			TrajectoryStep overshoot = trajectory.back();
+			trajectory.pop_back();
+			size_t after = before;
+			TrajectoryStep intersection = getIntersection(startTrajectory, after, overshoot, trajectory.back());
 			//cout << "set arrow from " << intersection.pathPos << ", " << intersection.pathVel - 0.8 << " to " << intersection.pathPos << ", " << intersection.pathVel - 0.3 << endl;
 		
-			if(after != startTrajectory.end()) {
-				startTrajectory.erase(after, startTrajectory.end());
+			if(after != startTrajectory.size()) {
+				startTrajectory.erase(startTrajectory.begin() + after, startTrajectory.end());
 				startTrajectory.push_back(intersection);
 			}
-			startTrajectory.splice(startTrajectory.end(), trajectory);
+			startTrajectory.insert(startTrajectory.end(), trajectory.rbegin(), trajectory.rend());
 
 			return;
 		}
 		else if(pathVel > getAccelerationMaxPathVelocity(pathPos) + eps || pathVel > getVelocityMaxPathVelocity(pathPos) + eps) {
 			// find more accurate intersection with max-velocity curve using bisection
-			TrajectoryStep overshoot = trajectory.front();
-			trajectory.pop_front();
-			double slope = getSlope(overshoot, trajectory.front());
+			TrajectoryStep overshoot = trajectory.back();
+			trajectory.pop_back();
+			double slope = getSlope(overshoot, trajectory.back());
 			double before = overshoot.pathPos;
-			double after = trajectory.front().pathPos;
+			double after = trajectory.back().pathPos;
 			while(after - before > 0.00001) {
 				const double midpoint = 0.5 * (before + after);
 				double midpointPathVel = overshoot.pathVel + slope * (midpoint - overshoot.pathPos);
@@ -391,18 +412,18 @@ void PathFollowingTrajectory::integrateBackward(list<TrajectoryStep> &trajectory
 				else
 					after = midpoint;
 			}
-			trajectory.push_front(TrajectoryStep(after, overshoot.pathVel + slope * (after - overshoot.pathPos)));
+			trajectory.push_back(TrajectoryStep(after, overshoot.pathVel + slope * (after - overshoot.pathPos)));
 
 			if(getAccelerationMaxPathVelocity(before) < getVelocityMaxPathVelocity(before)) {
-				if(trajectory.front().pathVel > getAccelerationMaxPathVelocity(before) + 0.0001) {
+				if(trajectory.back().pathVel > getAccelerationMaxPathVelocity(before) + 0.0001) {
 					error = true;
 				}
-				else if(getMinMaxPhaseSlope(trajectory.front().pathPos, trajectory.front().pathVel, false) < getAccelerationMaxPathVelocityDeriv(trajectory.front().pathPos)) { 
+				else if(getMinMaxPhaseSlope(trajectory.back().pathPos, trajectory.back().pathVel, false) < getAccelerationMaxPathVelocityDeriv(trajectory.back().pathPos)) { 
 					error = true;
 				}
 			}
 			else {
-				if(getMinMaxPhaseSlope(trajectory.back().pathPos, trajectory.back().pathVel, false) < getVelocityMaxPathVelocityDeriv(trajectory.back().pathPos)) {
+				if(getMinMaxPhaseSlope(trajectory.front().pathPos, trajectory.front().pathVel, false) < getVelocityMaxPathVelocityDeriv(trajectory.front().pathPos)) {
 					error = true;
 				}
 			}
@@ -411,10 +432,10 @@ void PathFollowingTrajectory::integrateBackward(list<TrajectoryStep> &trajectory
 
 		if(error) {
 			ofstream file("trajectory.txt");
-      for(list<TrajectoryStep>::iterator it = startTrajectory.begin(); it != startTrajectory.end(); ++it) {
+      for(vector<TrajectoryStep>::const_iterator it = startTrajectory.begin(); it != startTrajectory.end(); ++it) {
 				file << it->pathPos << "  " << it->pathVel << endl;
 			}
-      for(list<TrajectoryStep>::iterator it = trajectory.begin(); it != trajectory.end(); ++it) {
+      for(vector<TrajectoryStep>::const_reverse_iterator it = trajectory.rbegin(); it != trajectory.rend(); ++it) {
 				file << it->pathPos << "  " << it->pathVel << endl;
 			}
 			file.close();
@@ -429,32 +450,30 @@ inline double PathFollowingTrajectory::getSlope(const TrajectoryStep &point1, co
 	return (point2.pathVel - point1.pathVel) / (point2.pathPos - point1.pathPos);
 }
 
-inline double PathFollowingTrajectory::getSlope(list<TrajectoryStep>::const_iterator lineEnd) {
-	list<TrajectoryStep>::const_iterator lineStart = lineEnd;
-  --lineStart;
-	return getSlope(*lineStart, *lineEnd);
+inline double PathFollowingTrajectory::getSlope(const vector<TrajectoryStep> &trajectory, size_t lineEnd) {
+	return getSlope(trajectory[lineEnd - 1], trajectory[lineEnd]);
 }
 
-PathFollowingTrajectory::TrajectoryStep PathFollowingTrajectory::getIntersection(const list<TrajectoryStep> &trajectory, list<TrajectoryStep>::iterator &it, const TrajectoryStep &linePoint1, const TrajectoryStep &linePoint2) {
+PathFollowingTrajectory::TrajectoryStep PathFollowingTrajectory::getIntersection(const vector<TrajectoryStep> &trajectory, size_t &index, const TrajectoryStep &linePoint1, const TrajectoryStep &linePoint2) {
 	
 	const double lineSlope = getSlope(linePoint1, linePoint2);
-	it--;
+	const TrajectoryStep &previous = trajectory[index - 1];
 
 	double factor = 1.0;
-	if(it->pathVel > linePoint1.pathVel + lineSlope * (it->pathPos - linePoint1.pathPos))
+	if(previous.pathVel > linePoint1.pathVel + lineSlope * (previous.pathPos - linePoint1.pathPos))
 		factor = -1.0;
-	it++;
 	
-	while(it != trajectory.end() && factor * it->pathVel < factor * (linePoint1.pathVel + lineSlope * (it->pathPos - linePoint1.pathPos))) {
-		it++;
+	while(index < trajectory.size() && factor * trajectory[index].pathVel < factor * (linePoint1.pathVel + lineSlope * (trajectory[index].pathPos - linePoint1.pathPos))) {
+		index++;
 	}
 
-	if(it == trajectory.end()) {
+	if(index == trajectory.size()) {
 		return TrajectoryStep(0.0, 0.0);
 	}
 	else {
-		const double trajectorySlope = getSlope(it);
-		const double intersectionPathPos = (it->pathVel - linePoint1.pathVel + lineSlope * linePoint1.pathPos - trajectorySlope * it->pathPos)
+		const TrajectoryStep &it = trajectory[index];
+		const double trajectorySlope = getSlope(trajectory, index);
+		const double intersectionPathPos = (it.pathVel - linePoint1.pathVel + lineSlope * linePoint1.pathPos - trajectorySlope * it.pathPos)
 			/ (lineSlope - trajectorySlope);
 		const double intersectionPathVel = linePoint1.pathVel + lineSlope * (intersectionPathPos - linePoint1.pathPos);
 		return TrajectoryStep(intersectionPathPos, intersectionPathVel);
@@ -538,75 +557,76 @@ bool PathFollowingTrajectory::isValid() const {
 }
 
 double PathFollowingTrajectory::getDuration() const {
-	return trajectory.back().time;
+	return times.back();
 }
 
-list<PathFollowingTrajectory::TrajectoryStep>::const_iterator PathFollowingTrajectory::getTrajectorySegment(double time) const {
-	if(time >= trajectory.back().time) {
-		list<TrajectoryStep>::const_iterator last = trajectory.end();
-    --last;
-		return last;
+size_t PathFollowingTrajectory::getTrajectorySegment(double time) const {
+	if(time >= times.back()) {
+		return times.size() - 1;
 	}
-	else {
-		if(time < cachedTime) {
-			cachedTrajectorySegment = trajectory.begin();
+
+	size_t i = cachedTrajectorySegment;
+	if(time < times[i - 1] || time >= times[i]) {
+		if(time >= times[i] && time < times[i + 1]) {
+			i++;
 		}
-		while(time >= cachedTrajectorySegment->time) {
-      ++cachedTrajectorySegment;
+		else {
+			i = upper_bound(times.begin() + 1, times.end(), time) - times.begin();
 		}
-		cachedTime = time;
-		return cachedTrajectorySegment;
+		cachedTrajectorySegment = i;
 	}
+	return i;
 }
 
-VectorXd PathFollowingTrajectory::getPosition(double time) const {
-	list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-	list<TrajectoryStep>::const_iterator previous = it;
-  --previous;
-	
-	//const double pathPos = previous->pathPos + (time - previous->time) * (previous->pathVel + it->pathVel) / 2.0;
-	
-	double timeStep = it->time - previous->time;
-	const double acceleration = (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
+void PathFollowingTrajectory::getPathState(size_t i, double time, double &pathPos, double &pathVel, double &pathAcc) const {
+	const size_t previous = i - 1;
 
-	timeStep = time - previous->time;
-	const double pathPos = previous->pathPos + timeStep * previous->pathVel + timeStep * timeStep * acceleration; 
-	
+	//const double pathPos = pathPositions[previous] + (time - times[previous]) * (pathVelocities[previous] + pathVelocities[i]) / 2.0;
+
+	double timeStep = times[i] - times[previous];
+	pathAcc = (pathPositions[i] - pathPositions[previous] - timeStep * pathVelocities[previous]) / (timeStep * timeStep);
+
+	timeStep = time - times[previous];
+	pathPos = pathPositions[previous] + timeStep * pathVelocities[previous] + timeStep * timeStep * pathAcc;
+	pathVel = pathVelocities[previous] + timeStep * pathAcc;
+}
+
+VectorXd PathFollowingTrajectory::getPosition(double time) const {
+	double pathPos, pathVel, pathAcc;
+	getPathState(getTrajectorySegment(time), time, pathPos, pathVel, pathAcc);
 	return path.getConfig(pathPos);
 }
 
 VectorXd PathFollowingTrajectory::getVelocity(double time) const {
-	list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-	list<TrajectoryStep>::const_iterator previous = it;
-  --previous;
-	
-	//const double pathPos = previous->pathPos + (time - previous->time) * (previous->pathVel + it->pathVel) / 2.0;
-	
-	double timeStep = it->time - previous->time;
-	const double acceleration = (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
-
-	timeStep = time - previous->time;
-	const double pathPos = previous->pathPos + timeStep * previous->pathVel + timeStep * timeStep * acceleration; 
-	const double pathVel = previous->pathVel + timeStep * acceleration;
-	
+	double pathPos, pathVel, pathAcc;
+	getPathState(getTrajectorySegment(time), time, pathPos, pathVel, pathAcc);
 	return path.getTangent(pathPos) * pathVel;
 }
 
+void PathFollowingTrajectory::getPositions(const VectorXd &timestamps, MatrixXd &positions) const {
+	positions.resize(n, timestamps.size());
+	for(int i = 0; i < timestamps.size(); i++) {
+		double pathPos, pathVel, pathAcc;
+		getPathState(getTrajectorySegment(timestamps[i]), timestamps[i], pathPos, pathVel, pathAcc);
+		positions.col(i) = path.getConfig(pathPos);
+	}
+}
+
+void PathFollowingTrajectory::getVelocities(const VectorXd &timestamps, MatrixXd &velocities) const {
+	velocities.resize(n, timestamps.size());
+	for(int i = 0; i < timestamps.size(); i++) {
+		double pathPos, pathVel, pathAcc;
+		getPathState(getTrajectorySegment(timestamps[i]), timestamps[i], pathPos, pathVel, pathAcc);
+		velocities.col(i) = path.getTangent(pathPos) * pathVel;
+	}
+}
+
 double PathFollowingTrajectory::getMaxAccelerationError() {
 	double maxAccelerationError = 0.0;
 
 	for(double time = 0.0; time < getDuration(); time += 0.000001) {
-		list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-		list<TrajectoryStep>::const_iterator previous = it;
-    --previous;
-
-		double timeStep = it->time - previous->time;
-		const double pathAcceleration = (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
-		
-		timeStep = time - previous->time;
-		const double pathPos = previous->pathPos + timeStep * previous->pathVel + timeStep * timeStep * pathAcceleration;
-
-		const double pathVel = previous->pathVel + timeStep * pathAcceleration;
+		double pathPos, pathVel, pathAcceleration;
+		getPathState(getTrajectorySegment(time), time, pathPos, pathVel, pathAcceleration);
 
 		VectorXd acceleration = path.getTangent(pathPos) * pathAcceleration + path.getCurvature(pathPos) * pathVel * pathVel;
 		
@@ -38,6 +38,7 @@
 
 #pragma once
 
+#include <vector>
 #include <Eigen/Core>
 #include "Path.h"
 #include "Trajectory.h"
@@ -55,6 +56,16 @@ public:
 	double getDuration() const;
 	Eigen::VectorXd getPosition(double time) const;
 	Eigen::VectorXd getVelocity(double time) const;
+
+	/// Evaluates the trajectory at many timestamps at once. Column i of
+	/// positions holds the configuration at timestamps[i]. Timestamps that
+	/// fall into the same or the next segment as their predecessor are looked
+	/// up in constant time, all others by binary search.
+	void getPositions(const Eigen::VectorXd &timestamps, Eigen::MatrixXd &positions) const;
+
+	/// Same as getPositions() for the velocities.
+	void getVelocities(const Eigen::VectorXd &timestamps, Eigen::MatrixXd &velocities) const;
+
 	double getMaxAccelerationError();
 
 private:
@@ -62,19 +73,17 @@ private:
 		TrajectoryStep() {}
 		TrajectoryStep(double pathPos, double pathVel) :
 			pathPos(pathPos),
-      pathVel(pathVel),
-      time(0.0)
+      pathVel(pathVel)
 		{}
 		double pathPos;
 		double pathVel;
-		double time;
 	};
 
 	bool getNextSwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
 	bool getNextAccelerationSwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
 	bool getNextVelocitySwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
-	bool integrateForward(std::list<TrajectoryStep> &trajectory, double acceleration);
-	void integrateBackward(std::list<TrajectoryStep> &trajectory, std::list<TrajectoryStep> &startTrajectory, double acceleration);
+	bool integrateForward(std::vector<TrajectoryStep> &trajectory, double acceleration);
+	void integrateBackward(const TrajectoryStep &endPoint, std::vector<TrajectoryStep> &startTrajectory, double acceleration);
 	double getMinMaxPathAcceleration(double pathPosition, double pathVelocity, bool max);
 	double getMinMaxPhaseSlope(double pathPosition, double pathVelocity, bool max);
 	double getAccelerationMaxPathVelocity(double pathPos);
@@ -82,24 +91,35 @@ private:
 	double getAccelerationMaxPathVelocityDeriv(double pathPos);
 	double getVelocityMaxPathVelocityDeriv(double pathPos);
 	
-	TrajectoryStep getIntersection(const std::list<TrajectoryStep> &trajectory, std::list<TrajectoryStep>::iterator &it, const TrajectoryStep &linePoint1, const TrajectoryStep &linePoint2);
+	TrajectoryStep getIntersection(const std::vector<TrajectoryStep> &trajectory, size_t &index, const TrajectoryStep &linePoint1, const TrajectoryStep &linePoint2);
 	inline double getSlope(const TrajectoryStep &point1, const TrajectoryStep &point2);
-	inline double getSlope(std::list<TrajectoryStep>::const_iterator lineEnd);
-	
-	std::list<TrajectoryStep>::const_iterator getTrajectorySegment(double time) const;
+	inline double getSlope(const std::vector<TrajectoryStep> &trajectory, size_t lineEnd);
+
+	/// Returns the index i of the step that ends the segment containing time,
+	/// i.e. times[i-1] <= time < times[i]. Consecutive lookups are answered
+	/// from the cached segment, all others by binary search.
+	size_t getTrajectorySegment(double time) const;
+
+	/// Interpolates the path position, velocity and acceleration at time
+	/// within segment i.
+	void getPathState(size_t i, double time, double &pathPos, double &pathVel, double &pathAcc) const;
 	
 	Path path;
 	Eigen::VectorXd maxVelocity;
 	Eigen::VectorXd maxAcceleration;
 	unsigned int n;
 	bool valid;
-	std::list<TrajectoryStep> trajectory;
+
+	// The time-parameterized trajectory, stored as parallel arrays so that
+	// lookups by time are a binary search over contiguous memory.
+	std::vector<double> times;
+	std::vector<double> pathPositions;
+	std::vector<double> pathVelocities;
 
 	static const double eps;
 	static const double timeStep;
 
-	mutable double cachedTime;
-	mutable std::list<TrajectoryStep>::const_iterator cachedTrajectorySegment;
+	mutable size_t cachedTrajectorySegment;
 };
 
 } // namespace planning
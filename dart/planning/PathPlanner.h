@@ -11,12 +11,16 @@
 #define DART_PLANNING_PATHPLANNER_H_
 
 #include <Eigen/Core>
+#include <atomic>
 #include <iostream>
 #include <limits>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
+#include "dart/planning/EdgeValidator.h"
 #include "RRT.h"
 #include <cstdio>
 
@@ -36,6 +40,10 @@ public:
   size_t maxNodes;        ///< Maximum number of iterations the sampling would continue
   simulation::WorldPtr world;  ///< The world that the robot is in (for obstacles and etc.)
 
+  /// If set and running more than one thread, the bidirectional search grows both trees on all of
+  /// its threads at once. Every thread checks the new nodes in its own clone of the world.
+  std::shared_ptr<EdgeValidator> edgeValidator;
+
   // NOTE: It is useful to keep the rrts around after planning for reuse, analysis, and etc.
   R* start_rrt;            ///< The rrt for unidirectional search
   R* goal_rrt;              ///< The second rrt if bidirectional search is executed
@@ -43,19 +51,20 @@ public:
 public:
 
   /// The default constructor
-  PathPlanner() : world(nullptr) {}
+  PathPlanner() : world(nullptr), start_rrt(nullptr), goal_rrt(nullptr) {}
 
   /// The desired constructor - you should use this one.
-  PathPlanner(simulation::World& world, bool bidirectional_ = true, bool connect_ = true, double stepSize_ = 0.1,
-    size_t maxNodes_ = 1e6, double goalBias_ = 0.3) : world(&world), bidirectional(bidirectional_),
-    connect(connect_), stepSize(stepSize_), maxNodes(maxNodes_), goalBias(goalBias_) {
+  PathPlanner(simulation::WorldPtr world, bool bidirectional_ = true, bool connect_ = true, double stepSize_ = 0.1,
+    size_t maxNodes_ = 1e6, double goalBias_ = 0.3) : connect(connect_), bidirectional(bidirectional_),
+    stepSize(stepSize_), goalBias(goalBias_), maxNodes(maxNodes_), world(world), start_rrt(nullptr),
+    goal_rrt(nullptr) {
   }
 
   /// The destructor
   virtual ~PathPlanner() {}
 
   /// Plan a path from a single start configuration to a single goal
-  bool planPath(dynamics::Skeleton* robot, const std::vector<int> &dofs, const Eigen::VectorXd &start,
+  bool planPath(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs, const Eigen::VectorXd &start,
       const Eigen::VectorXd &goal, std::list<Eigen::VectorXd> &path) {
     std::vector<Eigen::VectorXd> startVector, goalVector;
     startVector.push_back(start);
@@ -64,13 +73,13 @@ public:
   }
 
   /// Plan a path from a _set_ of start configurations to a _set_ of goals
-  bool planPath(dynamics::Skeleton* robot, const std::vector<size_t> &dofs, const std::vector<Eigen::VectorXd> &start,
+  bool planPath(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs, const std::vector<Eigen::VectorXd> &start,
     const std::vector<Eigen::VectorXd> &goal, std::list<Eigen::VectorXd> &path);
 
 private:
 
   /// Performs a unidirectional RRT with the given options.
-  bool planSingleTreeRrt(dynamics::Skeleton* robot, const std::vector<int> &dofs,
+  bool planSingleTreeRrt(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs,
     const std::vector<Eigen::VectorXd> &start, const Eigen::VectorXd &goal,
     std::list<Eigen::VectorXd> &path);
 
@@ -80,14 +89,30 @@ private:
   /// configurations whereas here, first, start rrt extends towards a random node and creates
   /// some node N. Afterwards, the second rrt extends towards _the node N_ and they continue
   /// swapping roles.
-  bool planBidirectionalRrt(dynamics::Skeleton* robot, const std::vector<int> &dofs,
+  bool planBidirectionalRrt(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs,
     const std::vector<Eigen::VectorXd> &start, const std::vector<Eigen::VectorXd> &goal,
     std::list<Eigen::VectorXd> &path);
+
+  /// Performs the bidirectional RRT on all threads of the edge validator. Each thread repeats the
+  /// steps of the serial version on the shared trees: it extends one tree towards a sample and the
+  /// other one towards the node that the first one ended up with, swapping the roles of the trees
+  /// every time. The trees are locked only to query and add nodes, while the new nodes are checked
+  /// for collisions in the clone of the world that belongs to the thread. R::newConfig() is not used.
+  bool planParallelBidirectionalRrt(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs,
+    const std::vector<Eigen::VectorXd> &start, const std::vector<Eigen::VectorXd> &goal,
+    std::list<Eigen::VectorXd> &path);
+
+  /// Extends the rrt from its nearest node towards the target on the given thread of the edge
+  /// validator, taking a single step or, if connect is set, as many as possible. Returns the node
+  /// and the configuration that the rrt ended up with: the last added node, or the nearest one if
+  /// no node was added.
+  typename R::StepResult extendInParallel(R* rrt, std::mutex &mutex, size_t thread,
+    const Eigen::VectorXd &target, std::atomic<size_t> &numNodes, int &node, Eigen::VectorXd &config);
 };
 
 /* ********************************************************************************************* */
 template <class R>
-bool PathPlanner<R>::planPath(dynamics::Skeleton* robot, const std::vector<size_t> &dofs,
+bool PathPlanner<R>::planPath(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs,
     const std::vector<Eigen::VectorXd> &start, const std::vector<Eigen::VectorXd> &goal,
     std::list<Eigen::VectorXd> &path) {
 
@@ -100,7 +125,7 @@ bool PathPlanner<R>::planPath(dynamics::Skeleton* robot, const std::vector<size_
   std::vector<Eigen::VectorXd> feasibleStart;
   for(unsigned int i = 0; i < start.size(); i++) {
     robot->setPositions(dofs, start[i]);
-    if(!world->checkCollision()) feasibleStart.push_back(start[i]);
+    if(!world->checkCollision(robot, dofs)) feasibleStart.push_back(start[i]);
   }
 
   // Return false if there are no feasible start configurations
@@ -113,7 +138,7 @@ bool PathPlanner<R>::planPath(dynamics::Skeleton* robot, const std::vector<size_
   std::vector<Eigen::VectorXd> feasibleGoal;
   for(unsigned int i = 0; i < goal.size(); i++) {
     robot->setPositions(dofs, goal[i]);
-    if(!world->checkCollision()) feasibleGoal.push_back(goal[i]);
+    if(!world->checkCollision(robot, dofs)) feasibleGoal.push_back(goal[i]);
   }
 
   // Return false if there are no feasible goal configurations
@@ -127,7 +152,9 @@ bool PathPlanner<R>::planPath(dynamics::Skeleton* robot, const std::vector<size_
 
   // Direct the search towards single or bidirectional
   bool result = false;
-  if(bidirectional)
+  if(bidirectional && edgeValidator && edgeValidator->getNumThreads() > 1)
+    result = planParallelBidirectionalRrt(robot, dofs, feasibleStart, feasibleGoal, path);
+  else if(bidirectional)
     result = planBidirectionalRrt(robot, dofs, feasibleStart, feasibleGoal, path);
   else {
     if(feasibleGoal.size() > 1) fprintf(stderr, "WARNING: planPath is using ONLY the first goal!\n");
@@ -142,7 +169,7 @@ bool PathPlanner<R>::planPath(dynamics::Skeleton* robot, const std::vector<size_
 
 /* ********************************************************************************************* */
 template <class R>
-bool PathPlanner<R>::planSingleTreeRrt(dynamics::Skeleton* robot, const std::vector<int> &dofs,
+bool PathPlanner<R>::planSingleTreeRrt(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs,
     const std::vector<Eigen::VectorXd> &start, const Eigen::VectorXd &goal,
     std::list<Eigen::VectorXd> &path) {
 
@@ -168,8 +195,10 @@ bool PathPlanner<R>::planSingleTreeRrt(dynamics::Skeleton* robot, const std::vec
     else start_rrt->tryStep(target);
 
     // Check if the goal is reached and create the path, if so
+    // NOTE: Lazy RRTs check the nodes of the candidate path only now and prune the tree if one of
+    // them is in collision, in which case the search continues.
     double gap = start_rrt->getGap(goal);
-    if(gap < stepSize) {
+    if(gap < stepSize && start_rrt->validatePath(start_rrt->activeNode)) {
       if(debug) std::cout << "Returning true, reached the goal" << std::endl;
       start_rrt->tracePath(start_rrt->activeNode, path);
       return true;
@@ -187,7 +216,7 @@ bool PathPlanner<R>::planSingleTreeRrt(dynamics::Skeleton* robot, const std::vec
 
 /* ********************************************************************************************* */
 template <class R>
-bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::vector<int> &dofs,
+bool PathPlanner<R>::planBidirectionalRrt(const dynamics::SkeletonPtr &robot, const std::vector<size_t> &dofs,
     const std::vector<Eigen::VectorXd> &start, const std::vector<Eigen::VectorXd> &goal,
     std::list<Eigen::VectorXd> &path) {
 
@@ -227,12 +256,14 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
     // NOTE: connect(x) and tryStep(x) functions return true if rrt2 can add the given node
     // in the tree. In this case, this would imply that the two trees meet.
     bool treesMet = false;
-    const Eigen::VectorXd& rrt2target = *(rrt1->configVector[rrt1->activeNode]);
+    const Eigen::VectorXd rrt2target = rrt1->getConfig(rrt1->activeNode);
     if(connect) treesMet = rrt2->connect(rrt2target);
     else treesMet = (rrt2->tryStep(rrt2target) == R::STEP_REACHED);
 
-    // Check if the trees have met and create the path, if so.
-    if(treesMet) {
+    // Check if the trees have met and create the path, if so. Lazy RRTs check the nodes of the
+    // candidate path only now and prune the trees if one of them is in collision.
+    if(treesMet && start_rrt->validatePath(start_rrt->activeNode)
+        && goal_rrt->validatePath(goal_rrt->activeNode)) {
       start_rrt->tracePath(start_rrt->activeNode, path);
       goal_rrt->tracePath(goal_rrt->activeNode, path, true);
       return true;
@@ -243,19 +274,135 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
 
     // Print the gap between the trees in debug mode
     if(debug) {
-      double gap = rrt2->getGap(*(rrt1->configVector[rrt1->activeNode]));
+      double gap = rrt2->getGap(rrt1->getConfig(rrt1->activeNode));
       if(gap < smallestGap) {
         smallestGap = gap;
-        std::cout << "Gap: " << smallestGap << "  Sizes: " << start_rrt->configVector.size()
-          << "/" << goal_rrt->configVector.size() << std::endl;
+        std::cout << "Gap: " << smallestGap << "  Sizes: " << start_rrt->getSize()
+          << "/" << goal_rrt->getSize() << std::endl;
+      }
+    }
+  }
+
+  // Maximum # of iterations are reached and path is not found - failed.
+  return false;
+}
+
+/* ********************************************************************************************* */
+template <class R>
+bool PathPlanner<R>::planParallelBidirectionalRrt(const dynamics::SkeletonPtr &robot,
+    const std::vector<size_t> &dofs, const std::vector<Eigen::VectorXd> &start,
+    const std::vector<Eigen::VectorXd> &goal, std::list<Eigen::VectorXd> &path) {
+
+  start_rrt = new R(world, robot, dofs, start, stepSize);
+  goal_rrt = new R(world, robot, dofs, goal, stepSize);
+
+  // Each tree has its own lock, so that two threads working on different trees do not wait for
+  // each other. The random number generator is shared by all threads.
+  std::mutex startMutex, goalMutex, randomMutex, solutionMutex;
+  std::atomic<size_t> numNodes(start_rrt->getSize() + goal_rrt->getSize());
+  std::atomic<bool> treesMet(false);
+  int startNode = -1;
+  int goalNode = -1;
+
+  while(numNodes < maxNodes) {
+
+    edgeValidator->runOnAllThreads([&](size_t thread) {
+
+      // Half of the threads start out with the goal rrt, so that both trees grow right away
+      bool fromStart = (thread % 2 == 1);
+      while(!treesMet && numNodes < maxNodes) {
+
+        // Swap the roles of the two RRTs as in the serial version
+        fromStart = !fromStart;
+        R* rrt1 = fromStart ? start_rrt : goal_rrt;
+        R* rrt2 = fromStart ? goal_rrt : start_rrt;
+        std::mutex &mutex1 = fromStart ? startMutex : goalMutex;
+        std::mutex &mutex2 = fromStart ? goalMutex : startMutex;
+
+        // Get the target node based on the bias
+        Eigen::VectorXd target;
+        {
+          std::lock_guard<std::mutex> lock(randomMutex);
+          double randomValue = ((double) rand()) / RAND_MAX;
+          if(randomValue < goalBias) target = goal[0];
+          else target = rrt1->getRandomConfig();
+        }
+
+        // rrt1 reaches out to the target and rrt2 to the node that rrt1 ended up with
+        int node1, node2;
+        Eigen::VectorXd config1, config2;
+        extendInParallel(rrt1, mutex1, thread, target, numNodes, node1, config1);
+        if(extendInParallel(rrt2, mutex2, thread, config1, numNodes, node2, config2) != R::STEP_REACHED)
+          continue;
+
+        // Only the first thread whose trees meet gets to report it
+        std::lock_guard<std::mutex> lock(solutionMutex);
+        if(!treesMet) {
+          startNode = fromStart ? node1 : node2;
+          goalNode = fromStart ? node2 : node1;
+          treesMet = true;
+        }
       }
+    });
+
+    if(!treesMet)
+      break;
+
+    // Lazy RRTs check the nodes of the candidate path only now and prune the trees if one of them
+    // is in collision, in which case the search continues.
+    start_rrt->activeNode = startNode;
+    goal_rrt->activeNode = goalNode;
+    if(start_rrt->validatePath(startNode) && goal_rrt->validatePath(goalNode)) {
+      start_rrt->tracePath(startNode, path);
+      goal_rrt->tracePath(goalNode, path, true);
+      return true;
     }
+
+    treesMet = false;
+    numNodes = start_rrt->getSize() + goal_rrt->getSize();
   }
 
   // Maximum # of iterations are reached and path is not found - failed.
   return false;
 }
 
+/* ********************************************************************************************* */
+template <class R>
+typename R::StepResult PathPlanner<R>::extendInParallel(R* rrt, std::mutex &mutex, size_t thread,
+    const Eigen::VectorXd &target, std::atomic<size_t> &numNodes, int &node, Eigen::VectorXd &config) {
+
+  // The overrides of R may be protected, but they are accessible through the base class
+  RRT* tree = rrt;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    node = tree->getNearestNeighbor(target);
+    config = tree->getConfig(node);
+  }
+
+  Eigen::VectorXd qnew;
+  while(true) {
+
+    // Check if already reached, otherwise take a step under the metric of the tree. The metric
+    // does not change while planning, so it can be read without holding the lock.
+    if(!tree->computeStep(config, target, qnew))
+      return R::STEP_REACHED;
+
+    // The collision check is what takes time, so it happens without holding the lock
+    if(edgeValidator->isInCollision(thread, qnew))
+      return R::STEP_COLLISION;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      node = tree->addNode(qnew, node);
+    }
+    config = qnew;
+    ++numNodes;
+
+    if(!connect)
+      return R::STEP_PROGRESS;
+  }
+}
+
 } // namespace planning
 } // namespace dart
 
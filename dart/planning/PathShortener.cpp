@@ -1,6 +1,7 @@
 #include "PathShortener.h"
 #include "dart/simulation/World.h"
 #include "RRT.h"
+#include "EdgeValidator.h"
 #include "dart/collision/CollisionDetector.h"
 #include "dart/dynamics/Skeleton.h"
 #include <ctime>
@@ -77,6 +78,16 @@ bool PathShortener::localPlanner(list<VectorXd> &intermediatePoints, list<Vector
 // does not check endpoints
 // interemdiatePoints are only touched if collision-free
 bool PathShortener::segmentCollisionFree(list<VectorXd> &intermediatePoints, const VectorXd &config1, const VectorXd &config2) {
+	// The validator checks the evenly spaced states of the segment in parallel and stops at the
+	// first collision
+	if(edgeValidator) {
+		vector<VectorXd> states;
+		if(!edgeValidator->isSegmentCollisionFree(config1, config2, &states))
+			return false;
+		intermediatePoints.assign(states.begin(), states.end());
+		return true;
+	}
+
 	const double length = (config1 - config2).norm();
 	if(length <= stepSize) {
 		return true;
@@ -93,7 +104,7 @@ bool PathShortener::segmentCollisionFree(list<VectorXd> &intermediatePoints, con
 	list<VectorXd> intermediatePoints1, intermediatePoints2;
   // TODO(JS): What kinematic values should be updated here?
   robot->setPositions(dofs, midpoint);
-	if(!world->checkCollision() && segmentCollisionFree(intermediatePoints1, config1, midpoint)
+	if(!world->checkCollision(robot, dofs) && segmentCollisionFree(intermediatePoints1, config1, midpoint)
 			&& segmentCollisionFree(intermediatePoints2, midpoint, config2))
 	{
 		intermediatePoints.clear();
@@ -107,5 +118,13 @@ bool PathShortener::segmentCollisionFree(list<VectorXd> &intermediatePoints, con
 	}
 }
 
+void PathShortener::setEdgeValidator(const std::shared_ptr<EdgeValidator>& validator) {
+	edgeValidator = validator;
+}
+
+const std::shared_ptr<EdgeValidator>& PathShortener::getEdgeValidator() const {
+	return edgeValidator;
+}
+
 } // namespace planning
 } // namespace dart
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <vector>
 #include <Eigen/Core>
 
@@ -13,6 +14,8 @@ namespace dynamics { class Skeleton; }
 
 namespace planning {
 
+class EdgeValidator;
+
 class PathShortener
 {
 public:
@@ -21,11 +24,16 @@ public:
 	~PathShortener();
 	virtual void shortenPath(std::list<Eigen::VectorXd> &rawPath);
 	bool segmentCollisionFree(std::list<Eigen::VectorXd> &waypoints, const Eigen::VectorXd &config1, const Eigen::VectorXd &config2);
+	/// Check the segments in parallel with the given validator instead of bisecting them on the
+	/// calling thread. Pass in nullptr to go back to bisection.
+	void setEdgeValidator(const std::shared_ptr<EdgeValidator>& edgeValidator);
+	const std::shared_ptr<EdgeValidator>& getEdgeValidator() const;
 protected:
   simulation::WorldPtr world;
   dynamics::SkeletonPtr robot;
 	std::vector<size_t> dofs;
 	double stepSize;
+	std::shared_ptr<EdgeValidator> edgeValidator;
 	virtual bool localPlanner(std::list<Eigen::VectorXd> &waypoints, std::list<Eigen::VectorXd>::const_iterator it1, std::list<Eigen::VectorXd>::const_iterator it2);
 };
 
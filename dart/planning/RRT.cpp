@@ -44,7 +44,6 @@
 #include "RRT.h"
 #include "dart/simulation/World.h"
 #include "dart/dynamics/Skeleton.h"
-#include <flann/flann.hpp>
 
 using namespace std;
 using namespace Eigen;
@@ -63,9 +62,9 @@ RRT::RRT(WorldPtr world, SkeletonPtr robot, const std::vector<size_t> &dofs,
 	world(world),
 	robot(robot),
 	dofs(dofs),
-  index(new flann::Index<flann::L2<double> >(flann::KDTreeSingleIndexParams()))
+	index(dofs.size())
 {
-	// Reset the random number generator and add the given start configuration to the flann structure
+	// Reset the random number generator and add the given start configuration to the tree
   srand(time(nullptr));
 	addNode(root, -1);
 }
@@ -77,9 +76,9 @@ RRT::RRT(WorldPtr world, SkeletonPtr robot, const std::vector<size_t> &dofs, con
 	world(world),
 	robot(robot),
 	dofs(dofs),
-	index(new flann::Index<flann::L2<double> >(flann::KDTreeSingleIndexParams()))
+	index(dofs.size())
 {
-	// Reset the random number generator and add the given start configurations to the flann structure
+	// Reset the random number generator and add the given start configurations to the tree
   srand(time(nullptr));
   for(size_t i = 0; i < roots.size(); i++) {
 		addNode(roots[i], -1);
@@ -102,7 +101,7 @@ bool RRT::connect(const VectorXd &target) {
 	StepResult result = STEP_PROGRESS;
 	while(result == STEP_PROGRESS) {
 		result = tryStepFromNode(target, NNidx);
-		NNidx = configVector.size() - 1;
+		NNidx = getSize() - 1;
 	}
 	return (result == STEP_REACHED);
 }
@@ -122,15 +121,14 @@ RRT::StepResult RRT::tryStep(const VectorXd &qtry) {
 /* ********************************************************************************************* */
 RRT::StepResult RRT::tryStepFromNode(const VectorXd &qtry, int NNidx) {
 
-	// Get the configuration of the nearest neighbor and check if already reached
-	const VectorXd& qnear = *(configVector[NNidx]);
-	if((qtry - qnear).norm() < stepSize) {
+	// Get the configuration of the nearest neighbor and create the new node a step towards qtry,
+	// unless it is already reached
+	const VectorXd qnear = getConfig(NNidx);
+	VectorXd qnew;
+	if(!computeStep(qnear, qtry, qnew)) {
 		return STEP_REACHED;
 	}
 
-	// Create the new node: scale the direction vector to stepSize and add to qnear
-	VectorXd qnew = qnear + stepSize * (qtry - qnear).normalized();
-
 	// Check for collision, make changes to the qNew and create intermediate points if necessary
 	// NOTE: This is largely implementation dependent and in default, no points are created.
 	list<VectorXd> intermediatePoints;
@@ -145,6 +143,18 @@ RRT::StepResult RRT::tryStepFromNode(const VectorXd &qtry, int NNidx) {
 	return STEP_PROGRESS;
 }
 
+/* ********************************************************************************************* */
+bool RRT::computeStep(const VectorXd &qnear, const VectorXd &qtarget, VectorXd &qnew) const {
+
+	// The nearest neighbor queries and the steps must agree on the metric, or the tree would grow
+	// from nodes that are not the nearest ones
+	const double distance = index.distance(qnear, qtarget);
+	if(distance < stepSize) return false;
+
+	qnew = qnear + (stepSize / distance) * index.difference(qnear, qtarget);
+	return true;
+}
+
 /* ********************************************************************************************* */
 bool RRT::newConfig(list<VectorXd> &intermediatePoints, VectorXd &qnew, const VectorXd &qnear, const VectorXd &qtarget) {
 	return !checkCollisions(qnew);
@@ -153,31 +163,17 @@ bool RRT::newConfig(list<VectorXd> &intermediatePoints, VectorXd &qnew, const Ve
 /* ********************************************************************************************* */
 int RRT::addNode(const VectorXd &qnew, int parentId) {
 	
-	// Update the graph vector
-	VectorXd* temp = new VectorXd(qnew);
-	configVector.push_back(temp);
+	// Update the graph vector and the nearest neighbor index, which stores the configuration
+	int id = index.add(qnew);
 	parentVector.push_back(parentId);
 
-	// Update the underlying flann structure (the kdtree)
-	unsigned int id = configVector.size() - 1;
-	if(id == 0) 
-		index->buildIndex(flann::Matrix<double>((double*)temp->data(), 1, temp->size()));
-	else 
-		index->addPoints(flann::Matrix<double>((double*)temp->data(), 1, temp->size()));
-	
 	activeNode = id;
 	return id;
 }
 
 /* ********************************************************************************************* */
-inline int RRT::getNearestNeighbor(const VectorXd &qsamp) {
-	int nearest;
-	double distance;
-	const flann::Matrix<double> queryMatrix((double*)qsamp.data(), 1, qsamp.size());
-	flann::Matrix<int> nearestMatrix(&nearest, 1, 1);
-	flann::Matrix<double> distanceMatrix(flann::Matrix<double>(&distance, 1, 1));
-	index->knnSearch(queryMatrix, nearestMatrix, distanceMatrix, 1, 
-		flann::SearchParams(flann::FLANN_CHECKS_UNLIMITED));
+int RRT::getNearestNeighbor(const VectorXd &qsamp) {
+	int nearest = index.nearest(qsamp);
 	activeNode = nearest;
 	return nearest;
 }
@@ -205,7 +201,7 @@ VectorXd RRT::getRandomConfig() {
 
 /* ********************************************************************************************* */
 double RRT::getGap(const VectorXd &target) {
-	return (target - *(configVector[activeNode])).norm();
+	return index.distance(target, getConfig(activeNode));
 }
 
 /* ********************************************************************************************* */
@@ -214,21 +210,36 @@ void RRT::tracePath(int node, std::list<VectorXd> &path, bool reverse) {
 	// Keep following the "linked list" in the given direction
 	int x = node;
 	while(x != -1) {
-		if(!reverse) path.push_front(*(configVector[x]));	
-		else path.push_back(*(configVector[x]));
+		if(!reverse) path.push_front(getConfig(x));
+		else path.push_back(getConfig(x));
 		x = parentVector[x];
 	}
 }
 
+/* ********************************************************************************************* */
+bool RRT::validatePath(int node) {
+	return true;
+}
+
 /* ********************************************************************************************* */
 bool RRT::checkCollisions(const VectorXd &c) {
   robot->setPositions(dofs, c);
-	return world->checkCollision();
+	return world->checkCollision(robot, dofs);
 }
 
 /* ********************************************************************************************* */
 size_t RRT::getSize() {
-	return configVector.size();
+	return index.getSize();
+}
+
+/* ********************************************************************************************* */
+NearestNeighbors::ConstPoint RRT::getConfig(int node) const {
+	return index.getPoint(node);
+}
+
+/* ********************************************************************************************* */
+NearestNeighbors& RRT::getNearestNeighbors() {
+	return index;
 }
 
 } // namespace planning
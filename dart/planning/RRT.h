@@ -49,11 +49,7 @@
 
 #include "dart/dynamics/SmartPointer.h"
 #include "dart/simulation/World.h"
-
-namespace flann {
-	template <class A> class L2;
-	template <class A> class Index;
-}
+#include "dart/planning/NearestNeighbors.h"
 
 namespace dart {
 
@@ -62,6 +58,8 @@ namespace dynamics { class Skeleton; }
 
 namespace planning {
 
+template <class R> class PathPlanner;
+
 /// The rapidly-expanding random tree implementation
 class RRT {
 public:
@@ -83,12 +81,7 @@ public:
 	const double stepSize;	///< Step size at each node creation
 
 	int activeNode;	 								///< Last added node or the nearest node found after a search
-	std::vector<int> parentVector;		///< The ith node in configVector has parent with index pV[i]
-
-	/// All visited configs
-	// NOTE We are using pointers for the VectorXd's because flann copies the pointers for the
-	// data points and we give it the copies made in the heap
-	std::vector<const Eigen::VectorXd*> configVector; 	
+	std::vector<int> parentVector;		///< The ith node has parent with index pV[i]
 
 public:
 
@@ -126,7 +119,15 @@ public:
 	virtual bool newConfig(std::list<Eigen::VectorXd> &intermediatePoints, Eigen::VectorXd &qnew, 
 			const Eigen::VectorXd &qnear, const Eigen::VectorXd &qtarget);
 
-	/// Returns the distance between the current active node and the given node.
+	/// Computes the configuration one "stepSize" away from qnear towards qtarget. The step is measured
+	/// with the metric of the nearest neighbor index, so it follows the weights of the dofs and takes
+	/// the shorter way around for dofs that wrap around. Returns false without changing qnew if
+	/// qtarget is closer than "stepSize".
+	bool computeStep(const Eigen::VectorXd &qnear, const Eigen::VectorXd &qtarget,
+			Eigen::VectorXd &qnew) const;
+
+	/// Returns the distance between the current active node and the given node under the metric of
+	/// the nearest neighbor index.
 	/// TODO This might mislead the users to thinking returning the distance between the given target
 	/// and the nearest neighbor.
 	double getGap(const Eigen::VectorXd &target);
@@ -135,9 +136,23 @@ public:
 	/// after the goal is reached.
 	void tracePath(int node, std::list<Eigen::VectorXd> &path, bool reverse = false);
 
+	/// Checks the nodes on the path from the root to the given node that have not been checked for
+	/// collisions yet and returns false if one of them is in collision. Implementations that defer
+	/// collision checks may prune the tree in that case. The nodes of the default RRT are checked
+	/// when they are created, so it always returns true.
+	virtual bool validatePath(int node);
+
 	/// Returns the number of nodes in the tree.
 	size_t getSize();
 
+	/// Returns the configuration of the given node. The configurations are stored by the nearest
+	/// neighbor index, so the returned view stays valid as the tree grows.
+	NearestNeighbors::ConstPoint getConfig(int node) const;
+
+	/// Returns the nearest neighbor index of the tree, e.g. to weight the dofs or to let the
+	/// positions of continuous joints wrap around when looking for the nearest node
+	NearestNeighbors& getNearestNeighbors();
+
 	/// Implementation-specific function for checking collisions 
 	virtual bool checkCollisions(const Eigen::VectorXd &c);
 
@@ -146,12 +161,15 @@ public:
 
 protected:
 
+	/// The parallel bidirectional planner finds and adds nodes itself while holding a lock on the tree
+	template <class R> friend class PathPlanner;
+
   simulation::WorldPtr world;                 ///< The world that the robot is in
   dynamics::SkeletonPtr robot;        ///< The ID of the robot for which a plan is generated
 	std::vector<size_t> dofs;                    ///< The dofs of the robot the planner can manipulate
 
-	/// The underlying flann data structure for fast nearest neighbor searches 
-	flann::Index<flann::L2<double> >* index;
+	/// Stores the configurations of all visited nodes for fast nearest neighbor searches
+	NearestNeighbors index;
 
 	/// Returns a random value between the given minimum and maximum value
 	double randomInRange(double min, double max);
@@ -330,7 +330,7 @@ void OpenGLRenderInterface::applyMaterial(const struct aiMaterial *mtl)
 
 
 // This function is taken from the examples coming with assimp
-void OpenGLRenderInterface::recursiveRender(const struct aiScene *sc, const struct aiNode* nd) {
+void OpenGLRenderInterface::recursiveRender(const struct aiScene *sc, const struct aiNode* nd, double alpha) {
     unsigned int i;
     unsigned int n = 0, t;
     aiMatrix4x4 m = nd->mTransformation;
@@ -369,8 +369,13 @@ void OpenGLRenderInterface::recursiveRender(const struct aiScene *sc, const stru
 
             for (i = 0; i < face->mNumIndices; i++) {
                 int index = face->mIndices[i];
-                if(mesh->mColors[0] != nullptr)
-                    glColor4fv((GLfloat*)&mesh->mColors[0][index]);
+                if(mesh->mColors[0] != nullptr) {
+                    const aiColor4D& color = mesh->mColors[0][index];
+                    if(alpha < 0.0)
+                        glColor4fv((GLfloat*)&color);
+                    else
+                        glColor4f(color.r, color.g, color.b, alpha);
+                }
                 if(mesh->mNormals != nullptr)
                     glNormal3fv(&mesh->mNormals[index].x);
                 glVertex3fv(&mesh->mVertices[index].x);
@@ -384,7 +389,7 @@ void OpenGLRenderInterface::recursiveRender(const struct aiScene *sc, const stru
 
     // draw all children
     for (n = 0; n < nd->mNumChildren; ++n) {
-        recursiveRender(sc, nd->mChildren[n]);
+        recursiveRender(sc, nd->mChildren[n], alpha);
     }
 
     glPopMatrix();
@@ -399,6 +404,15 @@ void OpenGLRenderInterface::drawMesh(const Eigen::Vector3d& _scale, const aiScen
     }
 }
 
+void OpenGLRenderInterface::drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh, double _alpha) {
+    if(_mesh) {
+        glPushMatrix();
+        glScaled(_scale(0), _scale(1), _scale(2));
+        recursiveRender(_mesh, _mesh->mRootNode, _alpha);
+        glPopMatrix();
+    }
+}
+
 void OpenGLRenderInterface::drawList(GLuint index) {
     glCallList(index);
 }
@@ -449,7 +463,10 @@ void OpenGLRenderInterface::compileList(dynamics::Shape* _shape) {
             if(shapeMesh == 0)
                 return;
 
-            shapeMesh->setDisplayList(compileList(shapeMesh->getScale(), shapeMesh->getMesh()));
+            if(shapeMesh->hasAlpha())
+                shapeMesh->setDisplayList(compileList(shapeMesh->getScale(), shapeMesh->getMesh(), shapeMesh->getRGBA()[3]));
+            else
+                shapeMesh->setDisplayList(compileList(shapeMesh->getScale(), shapeMesh->getMesh()));
 
             break;
         }
@@ -473,6 +490,20 @@ GLuint OpenGLRenderInterface::compileList(const Eigen::Vector3d& _scale, const a
     return index;
 }
 
+GLuint OpenGLRenderInterface::compileList(const Eigen::Vector3d& _scale, const aiScene* _mesh, double _alpha) {
+    if(!_mesh)
+        return 0;
+
+    // Generate one list
+    GLuint index = glGenLists(1);
+    // Compile list
+    glNewList(index, GL_COMPILE);
+    drawMesh(_scale, _mesh, _alpha);
+    glEndList();
+
+    return index;
+}
+
 void OpenGLRenderInterface::draw(dynamics::Skeleton* _skel, bool _vizCol, bool _colMesh) {
     if(_skel == 0)
         return;
@@ -564,6 +595,8 @@ void OpenGLRenderInterface::draw(dynamics::Shape* _shape) {
                 break;
             else if(mesh->getDisplayList())
                 drawList(mesh->getDisplayList());
+            else if(mesh->hasAlpha())
+                drawMesh(mesh->getScale(), mesh->getMesh(), mesh->getRGBA()[3]);
             else
                 drawMesh(mesh->getScale(), mesh->getMesh());
 
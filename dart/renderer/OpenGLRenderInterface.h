@@ -87,6 +87,7 @@ public:
     void compileList(dynamics::BodyNode* _node);
     void compileList(dynamics::Shape* _shape);
     GLuint compileList(const Eigen::Vector3d& _scale, const aiScene* _mesh);
+    GLuint compileList(const Eigen::Vector3d& _scale, const aiScene* _mesh, double _alpha);
 
     virtual void draw(dynamics::Skeleton* _skel, bool _vizCol = false, bool _colMesh = false);
     virtual void draw(dynamics::BodyNode* _node, bool _vizCol = false, bool _colMesh = false);
@@ -96,6 +97,7 @@ public:
     virtual void drawCube(const Eigen::Vector3d& _size) override;
     virtual void drawCylinder(double _radius, double _height) override;
     virtual void drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh) override;
+    virtual void drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh, double _alpha) override;
     virtual void drawList(GLuint index) override;
     virtual void drawLineSegments(const std::vector<Eigen::Vector3d>& _vertices,
                                   const Eigen::aligned_vector<Eigen::Vector2i>& _connections) override;
@@ -112,7 +114,8 @@ private:
     void color4_to_float4(const aiColor4D *c, float f[4]);
     void set_float4(float f[4], float a, float b, float c, float d);
     void applyMaterial(const struct aiMaterial *mtl);
-    void recursiveRender(const struct aiScene *sc, const struct aiNode* nd);
+    // A negative alpha keeps the alpha of the vertex colors
+    void recursiveRender(const struct aiScene *sc, const struct aiNode* nd, double alpha = -1.0);
 
     int mViewportX, mViewportY, mViewportWidth, mViewportHeight;
 
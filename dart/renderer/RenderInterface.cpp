@@ -136,6 +136,11 @@ void RenderInterface::drawMesh(const Eigen::Vector3d& _scale, const aiScene* _me
 {
 }
 
+void RenderInterface::drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh, double _alpha)
+{
+  drawMesh(_scale, _mesh);
+}
+
 void RenderInterface::drawList(unsigned int indeX)
 {
 }
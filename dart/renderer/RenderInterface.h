@@ -107,6 +107,7 @@ public:
     virtual void drawCube(const Eigen::Vector3d& _size);
     virtual void drawCylinder(double _radius, double _height);
     virtual void drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh);
+    virtual void drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh, double _alpha); // _alpha replaces the alpha of the vertex colors
     virtual void drawList(unsigned int index);
     virtual void drawLineSegments(const std::vector<Eigen::Vector3d>& _vertices,
                                   const Eigen::aligned_vector<Eigen::Vector2i>& _connections);
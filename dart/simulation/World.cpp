@@ -42,11 +42,13 @@
 
 #include "dart/simulation/World.h"
 
+#include <future>
 #include <iostream>
 #include <string>
 #include <vector>
 
 #include "dart/common/Console.h"
+#include "dart/common/ThreadPool.h"
 #include "dart/integration/SemiImplicitEulerIntegrator.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/constraint/ConstraintSolver.h"
@@ -61,6 +63,7 @@ World::World(const std::string& _name)
     mNameMgrForSimpleFrames("World::SimpleFrame | " + _name, "frame"),
     mGravity(0.0, 0.0, -9.81),
     mTimeStep(0.001),
+    mNumThreads(1),
     mTime(0.0),
     mFrame(0),
     mConstraintSolver(new constraint::ConstraintSolver(mTimeStep)),
@@ -90,6 +93,7 @@ WorldPtr World::clone() const
 
   worldClone->setGravity(mGravity);
   worldClone->setTimeStep(mTimeStep);
+  worldClone->setNumThreads(mNumThreads);
 
   // Clone and add each Skeleton
   for(size_t i=0; i<mSkeletons.size(); ++i)
@@ -142,6 +146,22 @@ double World::getTimeStep() const
   return mTimeStep;
 }
 
+//==============================================================================
+void World::setNumThreads(size_t _numThreads)
+{
+  if (_numThreads == mNumThreads)
+    return;
+
+  mNumThreads = _numThreads;
+  mThreadPool.reset();
+}
+
+//==============================================================================
+size_t World::getNumThreads() const
+{
+  return mNumThreads;
+}
+
 //==============================================================================
 void World::reset()
 {
@@ -154,13 +174,40 @@ void World::reset()
 void World::step(bool _resetCommand)
 {
   // Integrate velocity for unconstrained skeletons
-  for (auto& skel : mSkeletons)
+  if (mNumThreads == 1 || mSkeletons.size() < 2)
   {
-    if (!skel->isMobile())
-      continue;
+    for (auto& skel : mSkeletons)
+    {
+      if (!skel->isMobile())
+        continue;
 
-    skel->computeForwardDynamics();
-    skel->integrateVelocities(mTimeStep);
+      skel->computeForwardDynamics();
+      skel->integrateVelocities(mTimeStep);
+    }
+  }
+  else
+  {
+    if (!mThreadPool)
+      mThreadPool.reset(new common::ThreadPool(mNumThreads));
+
+    std::vector<std::future<void>> results;
+    results.reserve(mSkeletons.size());
+    for (auto& skel : mSkeletons)
+    {
+      if (!skel->isMobile())
+        continue;
+
+      dynamics::Skeleton* skeleton = skel.get();
+      const double timeStep = mTimeStep;
+      results.push_back(mThreadPool->submit([skeleton, timeStep]()
+      {
+        skeleton->computeForwardDynamics();
+        skeleton->integrateVelocities(timeStep);
+      }));
+    }
+
+    for (auto& result : results)
+      result.get();
   }
 
   // Detect activated constraints and compute constraint impulses
@@ -497,6 +544,20 @@ bool World::checkCollision(bool _checkAllCollisions)
         _checkAllCollisions, false);
 }
 
+//==============================================================================
+bool World::checkCollision(const dynamics::SkeletonPtr& _skeleton)
+{
+  return mConstraintSolver->getCollisionDetector()->checkCollision(_skeleton);
+}
+
+//==============================================================================
+bool World::checkCollision(const dynamics::SkeletonPtr& _skeleton,
+                           const std::vector<size_t>& _dofs)
+{
+  return mConstraintSolver->getCollisionDetector()->checkCollision(
+        _skeleton, _dofs);
+}
+
 //==============================================================================
 constraint::ConstraintSolver* World::getConstraintSolver() const
 {
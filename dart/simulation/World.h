@@ -43,6 +43,7 @@
 #ifndef DART_SIMULATION_WORLD_H_
 #define DART_SIMULATION_WORLD_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <set>
@@ -58,6 +59,10 @@
 
 namespace dart {
 
+namespace common {
+class ThreadPool;
+}  // namespace common
+
 namespace integration {
 class Integrator;
 }  // namespace integration
@@ -120,6 +125,16 @@ public:
   /// Get time step
   double getTimeStep() const;
 
+  /// Set the number of threads used to compute the unconstrained dynamics of
+  /// the Skeletons in step(). The Skeletons do not interact until the
+  /// constraint solver runs, so each one can be advanced on its own thread.
+  /// Pass 0 to use one thread per hardware core. The default of 1 steps the
+  /// Skeletons serially.
+  void setNumThreads(size_t _numThreads);
+
+  /// Get the number of threads used to compute the unconstrained dynamics
+  size_t getNumThreads() const;
+
   //--------------------------------------------------------------------------
   // Structural Properties
   //--------------------------------------------------------------------------
@@ -174,6 +189,16 @@ public:
   /// Return whether there is any collision between bodies
   bool checkCollision(bool _checkAllCollisions = false);
 
+  /// Return whether any BodyNode of _skeleton collides with anything. No
+  /// contacts are computed and the query returns at the first collision.
+  bool checkCollision(const dynamics::SkeletonPtr& _skeleton);
+
+  /// Return whether any BodyNode of _skeleton that is moved by the degrees of
+  /// freedom _dofs collides with anything. No contacts are computed and the
+  /// query returns at the first collision.
+  bool checkCollision(const dynamics::SkeletonPtr& _skeleton,
+                      const std::vector<size_t>& _dofs);
+
   //--------------------------------------------------------------------------
   // Simulation
   //--------------------------------------------------------------------------
@@ -260,6 +285,12 @@ protected:
   /// Simulation time step
   double mTimeStep;
 
+  /// Number of threads for the unconstrained dynamics
+  size_t mNumThreads;
+
+  /// Thread pool for the unconstrained dynamics, created on first use
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+
   /// Current simulation time
   double mTime;
 
@@ -36,9 +36,12 @@
 
 #include "C3D.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 
+#include "dart/utils/C3DReader.h"
+
 ///////////////////////////////////////////////////////////////////////
 //  C3D file reader and writer
 ///////////////////////////////////////////////////////////////////////
@@ -46,7 +49,7 @@
 namespace dart {
 namespace utils {
 
-float ConvertDecToFloat(char _bytes[4]) {
+float convertDecToFloat(char _bytes[4]) {
     union {
         char theChars[4];
         float theFloat;
@@ -61,7 +64,7 @@ float ConvertDecToFloat(char _bytes[4]) {
 }
 
 
-void ConvertFloatToDec(float _f, char* _bytes) {
+void convertFloatToDec(float _f, char* _bytes) {
     char* p = (char*)&_f;
     _bytes[0] = p[2];
     _bytes[1] = p[3];
@@ -73,108 +76,33 @@ void ConvertFloatToDec(float _f, char* _bytes) {
 
 
 bool loadC3DFile(const char* _fileName, Eigen::EIGEN_VV_VEC3D& _pointData, int* _nFrame, int* _nMarker, double* _freq) {
-    char buf[C3D_REC_SIZE];
-    FILE *file;
-    Eigen::Vector3d v;
-    c3d_head hdr;
-    c3d_param param;
-    c3d_frameSI frameSI;
-    c3d_frame frame;
-    bool bDecFmt = true;
-
-    if ((file = fopen( _fileName, "rb" )) == nullptr)
+    C3DReader reader;
+    if (!reader.open(_fileName))
         return false;
 
-    //get the header
-    if (!fread(buf, C3D_REC_SIZE, 1, file))
-    {
-        fclose(file);
-        return false;
-    }
-    memcpy(&hdr, buf, sizeof(hdr));
-
-    //get number format
-    if (hdr.rec_start > 2) {
-        if (!fread(buf, C3D_REC_SIZE, 1, file))
-        {
-            fclose(file);
-            return false;
-        }
-        memcpy(&param, buf, sizeof(param));
-        if (param.ftype == 84)
-            bDecFmt = false;
-    }
+    const size_t numFrames = reader.getNumFrames();
+    const size_t numMarkers = reader.getNumMarkers();
 
-    //convert if in dec format
-    if (bDecFmt) {
-        hdr.freq = ConvertDecToFloat((char*)&hdr.freq);
-        hdr.scale = ConvertDecToFloat((char*)&hdr.scale);
-    }
-
-    int numFrames = hdr.end_frame - hdr.start_frame + 1;
-    int numMarkers = hdr.pnt_cnt;
-    double c3dScale = hdr.scale;
-
-    *_freq = hdr.freq;
+    *_freq = reader.getFrameRate();
     *_nMarker = numMarkers;
     *_nFrame = numFrames;
 
-    float pntScale = (hdr.scale < 0) ? 1 : hdr.scale;
-
-    //eat parameter records
-    for (int i = 3; i < hdr.rec_start; i++) {
-        if (!fread(buf, C3D_REC_SIZE, 1, file)) {
-            fclose(file);
-            return false;
-        }
-    }
-
-    // start retrieving data
+    // decode a chunk of frames at a time, so the whole file is never held
+    // twice in memory
+    const size_t chunkSize = 4096;
+    C3DFrames frames;
     _pointData.resize(numFrames);
+    for (size_t first = 0; first < numFrames; first += chunkSize) {
+        const size_t count = std::min(chunkSize, numFrames - first);
+        if (!reader.readFrames(first, count, frames))
+            return false;
 
-    int iRecSize;
-    if (c3dScale < 0)
-        iRecSize = sizeof(c3d_frame) + ( hdr.a_channels * hdr.a_frames * sizeof(float));
-    else
-        iRecSize = sizeof(c3d_frameSI) + ( hdr.a_channels * hdr.a_frames * sizeof(short));
-
-    for (int i = 0; i < numFrames; i++) {
-        _pointData[i].resize(numMarkers);
-        for (int j = 0; j < numMarkers; j++) {
-            if (!fread(buf, iRecSize, 1, file))
-            {
-                fclose(file);
-                return false;
-            }
-            if (c3dScale < 0) {
-                memcpy(&frame, buf, sizeof(frame));
-                if(bDecFmt){
-                    frame.y = ConvertDecToFloat((char*)&frame.y);
-                    frame.z = ConvertDecToFloat((char*)&frame.z);
-                    frame.x = ConvertDecToFloat((char*)&frame.x);
-                }
-                v[0] = frame.y / 1000.0;
-                v[1] = frame.z / 1000.0;
-                v[2] = frame.x / 1000.0;
-            } else {
-                memcpy(&frameSI, buf, sizeof(frameSI));
-                if (bDecFmt) {
-                    frameSI.y = (short)ConvertDecToFloat((char*)&frameSI.y);
-                    frameSI.z = (short)ConvertDecToFloat((char*)&frameSI.z);
-                    frameSI.x = (short)ConvertDecToFloat((char*)&frameSI.x);
-                }
-                v[0] = (float)frameSI.y * pntScale / 1000.0;
-                v[1] = (float)frameSI.z * pntScale / 1000.0;
-                v[2] = (float)frameSI.x * pntScale / 1000.0;
-            }
-            _pointData[i][j] = v;
+        for (size_t i = first; i < first + count; i++) {
+            _pointData[i].resize(numMarkers);
+            for (size_t j = 0; j < numMarkers; j++)
+                _pointData[i][j] = frames.getPosition(i, j);
         }
     }
-    fclose(file);
-
-    //const char *pch = strrchr(_fileName, '\\');  //clip leading path
-    //if (pch)
-    //    _fileName = pch + 1;
 
     return true;
 }
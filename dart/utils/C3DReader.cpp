@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/C3DReader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <iostream>
+
+#include "dart/common/Console.h"
+#include "dart/common/ThreadPool.h"
+#include "dart/utils/C3D.h"
+
+namespace dart {
+namespace utils {
+
+namespace {
+
+/// Number of frames that are decoded by a single task of readFrames
+const size_t MIN_FRAMES_PER_TASK = 1024u;
+
+} // anonymous namespace
+
+//==============================================================================
+Eigen::Vector3d C3DFrames::getPosition(size_t _frame, size_t _marker) const
+{
+  const size_t index = (_frame - mFirstFrame) * mNumMarkers + _marker;
+  return Eigen::Vector3d(mX[index], mY[index], mZ[index]);
+}
+
+//==============================================================================
+C3DReader::C3DReader()
+  : mData(nullptr),
+    mDataOffset(0u),
+    mFrameSize(0u),
+    mPointSize(0u),
+    mIsFloat(false),
+    mIsDec(false),
+    mScale(1.0),
+    mNumFrames(0u),
+    mNumMarkers(0u),
+    mFrameRate(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool C3DReader::open(const std::string& _fileName)
+{
+  close();
+
+  std::unique_ptr<common::LocalResource> resource(
+        new common::LocalResource(_fileName));
+  if(!resource->isGood())
+  {
+    dtwarn << "[C3DReader::open] Failed opening '" << _fileName << "'.\n";
+    return false;
+  }
+
+  const size_t size = resource->getSize();
+  const char* data = resource->getData();
+  if(!data)
+  {
+    // The file cannot be mapped into memory, so keep a copy of it instead
+    mBuffer.resize(size);
+    if(size && resource->read(&mBuffer[0], size, 1) != 1)
+    {
+      dtwarn << "[C3DReader::open] Failed reading '" << _fileName << "'.\n";
+      mBuffer.clear();
+      return false;
+    }
+    data = mBuffer.data();
+  }
+
+  if(size < C3D_REC_SIZE)
+  {
+    dtwarn << "[C3DReader::open] '" << _fileName << "' is too small to be a "
+           << "C3D file.\n";
+    mBuffer.clear();
+    return false;
+  }
+
+  c3d_head header;
+  std::memcpy(&header, data, sizeof(header));
+
+  // The processor type is stored in the parameter section, which usually
+  // starts in the second record
+  mIsDec = true;
+  const size_t paramRecord = std::max<size_t>(header.prec_start, 2u);
+  if(header.rec_start > 2 && paramRecord * C3D_REC_SIZE <= size)
+  {
+    c3d_param param;
+    std::memcpy(&param, data + (paramRecord - 1) * C3D_REC_SIZE,
+                sizeof(param));
+    if(param.ftype == 84)
+      mIsDec = false;
+  }
+
+  if(mIsDec)
+  {
+    header.freq = convertDecToFloat(reinterpret_cast<char*>(&header.freq));
+    header.scale = convertDecToFloat(reinterpret_cast<char*>(&header.scale));
+  }
+
+  if(header.pnt_cnt < 0 || header.a_channels < 0 || header.rec_start < 2)
+  {
+    dtwarn << "[C3DReader::open] '" << _fileName << "' has an invalid "
+           << "header.\n";
+    mBuffer.clear();
+    return false;
+  }
+
+  // A negative scale means that the points are stored as floats
+  mIsFloat = header.scale < 0;
+  mScale = mIsFloat ? 1.0 : header.scale;
+  mPointSize = mIsFloat ? sizeof(c3d_frame) : sizeof(c3d_frameSI);
+  mNumMarkers = static_cast<size_t>(header.pnt_cnt);
+  mFrameRate = header.freq;
+
+  // a_channels is the number of analog samples of all the channels in a frame
+  const size_t sampleSize = mIsFloat ? sizeof(float) : sizeof(short);
+  mFrameSize = mNumMarkers * mPointSize + header.a_channels * sampleSize;
+  mDataOffset = (header.rec_start - 1) * C3D_REC_SIZE;
+
+  // The frame numbers are 16-bit values, so longer recordings wrap around
+  const size_t headerFrames = static_cast<uint16_t>(
+        static_cast<uint16_t>(header.end_frame)
+        - static_cast<uint16_t>(header.start_frame) + 1u);
+  const size_t availableFrames = (mFrameSize == 0u || size < mDataOffset) ?
+        headerFrames : (size - mDataOffset) / mFrameSize;
+
+  if(availableFrames < headerFrames)
+  {
+    dtwarn << "[C3DReader::open] '" << _fileName << "' is truncated: the "
+           << "header lists " << headerFrames << " frames, but the file "
+           << "only contains " << availableFrames << ".\n";
+    mBuffer.clear();
+    return false;
+  }
+
+  const size_t wraps = (availableFrames - headerFrames) / 65536u;
+  mNumFrames = headerFrames + wraps * 65536u;
+
+  if(data != mBuffer.data())
+    mResource = std::move(resource);
+  mData = data;
+
+  return true;
+}
+
+//==============================================================================
+void C3DReader::close()
+{
+  mResource.reset();
+  mBuffer.clear();
+  mData = nullptr;
+  mNumFrames = 0u;
+  mNumMarkers = 0u;
+}
+
+//==============================================================================
+bool C3DReader::isOpen() const
+{
+  return mData != nullptr;
+}
+
+//==============================================================================
+size_t C3DReader::getNumFrames() const
+{
+  return mNumFrames;
+}
+
+//==============================================================================
+size_t C3DReader::getNumMarkers() const
+{
+  return mNumMarkers;
+}
+
+//==============================================================================
+double C3DReader::getFrameRate() const
+{
+  return mFrameRate;
+}
+
+//==============================================================================
+Eigen::Vector3d C3DReader::getPosition(size_t _frame, size_t _marker) const
+{
+  return decodePoint(mData + mDataOffset + _frame * mFrameSize
+                     + _marker * mPointSize);
+}
+
+//==============================================================================
+bool C3DReader::readFrames(size_t _firstFrame, size_t _numFrames,
+                           C3DFrames& _frames,
+                           common::ThreadPool* _threadPool) const
+{
+  if(!isOpen() || _firstFrame > mNumFrames
+     || _numFrames > mNumFrames - _firstFrame)
+  {
+    dtwarn << "[C3DReader::readFrames] Requested frames [" << _firstFrame
+           << ", " << _firstFrame + _numFrames << ") are out of range [0, "
+           << mNumFrames << ").\n";
+    return false;
+  }
+
+  _frames.mFirstFrame = _firstFrame;
+  _frames.mNumFrames = _numFrames;
+  _frames.mNumMarkers = mNumMarkers;
+  _frames.mX.resize(_numFrames * mNumMarkers);
+  _frames.mY.resize(_numFrames * mNumMarkers);
+  _frames.mZ.resize(_numFrames * mNumMarkers);
+
+  double* x = _frames.mX.data();
+  double* y = _frames.mY.data();
+  double* z = _frames.mZ.data();
+
+  if(!_threadPool || _numFrames < 2u * MIN_FRAMES_PER_TASK)
+  {
+    decodeFrames(_firstFrame, _numFrames, x, y, z);
+    return true;
+  }
+
+  // Give each thread a few tasks, so uneven progress is balanced out
+  const size_t numTasks = std::min(4u * _threadPool->getNumThreads(),
+                                   _numFrames / MIN_FRAMES_PER_TASK);
+  const size_t framesPerTask = (_numFrames + numTasks - 1u) / numTasks;
+
+  std::vector<std::future<void>> results;
+  results.reserve(numTasks);
+  for(size_t begin = 0u; begin < _numFrames; begin += framesPerTask)
+  {
+    const size_t count = std::min(framesPerTask, _numFrames - begin);
+    const size_t offset = begin * mNumMarkers;
+    results.push_back(_threadPool->submit([=]()
+    {
+      decodeFrames(_firstFrame + begin, count,
+                   x + offset, y + offset, z + offset);
+    }));
+  }
+
+  for(std::future<void>& result : results)
+    result.get();
+
+  return true;
+}
+
+//==============================================================================
+void C3DReader::decodeFrames(size_t _firstFrame, size_t _numFrames,
+                             double* _x, double* _y, double* _z) const
+{
+  const char* frame = mData + mDataOffset + _firstFrame * mFrameSize;
+  size_t index = 0u;
+  for(size_t i = 0u; i < _numFrames; ++i)
+  {
+    const char* record = frame;
+    for(size_t j = 0u; j < mNumMarkers; ++j)
+    {
+      const Eigen::Vector3d position = decodePoint(record);
+      _x[index] = position[0];
+      _y[index] = position[1];
+      _z[index] = position[2];
+
+      record += mPointSize;
+      ++index;
+    }
+
+    frame += mFrameSize;
+  }
+}
+
+//==============================================================================
+Eigen::Vector3d C3DReader::decodePoint(const char* _record) const
+{
+  // The files store the points in millimeters with the axes in the order
+  // (z, x, y) relative to DART
+  if(mIsFloat)
+  {
+    c3d_frame point;
+    std::memcpy(&point, _record, sizeof(point));
+    if(mIsDec)
+    {
+      point.x = convertDecToFloat(reinterpret_cast<char*>(&point.x));
+      point.y = convertDecToFloat(reinterpret_cast<char*>(&point.y));
+      point.z = convertDecToFloat(reinterpret_cast<char*>(&point.z));
+    }
+
+    return Eigen::Vector3d(point.y, point.z, point.x) / 1000.0;
+  }
+
+  // Integers have the same byte order on DEC and Intel processors
+  c3d_frameSI point;
+  std::memcpy(&point, _record, sizeof(point));
+  return Eigen::Vector3d(point.y, point.z, point.x) * (mScale / 1000.0);
+}
+
+} // namespace utils
+} // namespace dart
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_C3DREADER_H_
+#define DART_UTILS_C3DREADER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/common/LocalResource.h"
+
+namespace dart {
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace utils {
+
+/// Marker positions of consecutive frames of a C3D file, in
+/// structure-of-arrays layout. The coordinates of a marker in a frame are
+/// stored at index (frame - mFirstFrame) * mNumMarkers + marker of mX, mY and
+/// mZ, in meters.
+struct C3DFrames
+{
+  /// Index of the first frame
+  size_t mFirstFrame = 0u;
+
+  /// Number of frames
+  size_t mNumFrames = 0u;
+
+  /// Number of markers in each frame
+  size_t mNumMarkers = 0u;
+
+  /// X coordinates of the markers
+  std::vector<double> mX;
+
+  /// Y coordinates of the markers
+  std::vector<double> mY;
+
+  /// Z coordinates of the markers
+  std::vector<double> mZ;
+
+  /// Get the position of _marker in _frame, which is an index into the whole
+  /// file. The indices are not checked.
+  Eigen::Vector3d getPosition(size_t _frame, size_t _marker) const;
+};
+
+/// C3DReader gives random access to the marker trajectories of a C3D file
+/// without loading the whole file. The file is mapped into memory through a
+/// common::LocalResource, and frames are only decoded when they are
+/// requested, either one marker at a time or in chunks of consecutive frames.
+/// Decoding does not modify the reader, so several threads can decode
+/// different parts of the same file at the same time.
+///
+/// The number of frames in the C3D header is a 16-bit value. Recordings with
+/// more frames are recognized from the size of the data section, as long as
+/// the number of frames in the header matches it modulo 2^16.
+class C3DReader
+{
+public:
+  /// Constructor
+  C3DReader();
+
+  /// Copying is not allowed
+  C3DReader(const C3DReader&) = delete;
+
+  /// Assignment is not allowed
+  C3DReader& operator=(const C3DReader&) = delete;
+
+  /// Open the C3D file at _fileName. Returns false if the file cannot be
+  /// opened or is not a valid C3D file.
+  bool open(const std::string& _fileName);
+
+  /// Close the file
+  void close();
+
+  /// Returns true if a file is open
+  bool isOpen() const;
+
+  /// Get the number of frames in the file
+  size_t getNumFrames() const;
+
+  /// Get the number of markers in each frame
+  size_t getNumMarkers() const;
+
+  /// Get the number of frames per second
+  double getFrameRate() const;
+
+  /// Decode the position of _marker in _frame, in meters. The indices are not
+  /// checked.
+  Eigen::Vector3d getPosition(size_t _frame, size_t _marker) const;
+
+  /// Decode _numFrames frames, starting at _firstFrame, into _frames. If
+  /// _threadPool is not a nullptr, the frames are decoded in parallel on its
+  /// threads. Returns false if the frames are out of range.
+  bool readFrames(size_t _firstFrame, size_t _numFrames, C3DFrames& _frames,
+                  common::ThreadPool* _threadPool = nullptr) const;
+
+protected:
+  /// Decode _numFrames frames, starting at _firstFrame, into the arrays _x,
+  /// _y and _z
+  void decodeFrames(size_t _firstFrame, size_t _numFrames,
+                    double* _x, double* _y, double* _z) const;
+
+  /// Decode the point record at _record
+  Eigen::Vector3d decodePoint(const char* _record) const;
+
+  /// The mapped file
+  std::unique_ptr<common::LocalResource> mResource;
+
+  /// Copy of the file if it cannot be mapped into memory
+  std::string mBuffer;
+
+  /// Content of the file
+  const char* mData;
+
+  /// Offset of the first frame in the file
+  size_t mDataOffset;
+
+  /// Size of a frame in the file, including the analog samples
+  size_t mFrameSize;
+
+  /// Size of a point record in the file
+  size_t mPointSize;
+
+  /// True if the points are stored as floats, false for scaled integers
+  bool mIsFloat;
+
+  /// True if the floats use the DEC format
+  bool mIsDec;
+
+  /// Scale of the integer points
+  double mScale;
+
+  /// Number of frames
+  size_t mNumFrames;
+
+  /// Number of markers
+  size_t mNumMarkers;
+
+  /// Frames per second
+  double mFrameRate;
+};
+
+} // namespace utils
+} // namespace dart
+
+#endif // DART_UTILS_C3DREADER_H_
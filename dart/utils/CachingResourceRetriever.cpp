@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/CachingResourceRetriever.h"
+
+#include <cassert>
+#include <iostream>
+
+#include "dart/common/Console.h"
+#include "dart/common/MemoryResource.h"
+
+namespace dart {
+namespace utils {
+
+//==============================================================================
+CachingResourceRetriever::CachingResourceRetriever(
+    const common::ResourceRetrieverPtr& _retriever, size_t _capacity)
+  : mRetriever(_retriever),
+    mCapacity(_capacity),
+    mSize(0u)
+{
+  assert(mRetriever);
+}
+
+//==============================================================================
+bool CachingResourceRetriever::exists(const common::Uri& _uri)
+{
+  const std::string key = _uri.toString();
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(const Entry* entry = find(key))
+      return entry->mExists;
+  }
+
+  const bool exists = mRetriever->exists(_uri);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if(!find(key))
+    insert(key, exists, nullptr);
+
+  return exists;
+}
+
+//==============================================================================
+common::ResourcePtr CachingResourceRetriever::retrieve(const common::Uri& _uri)
+{
+  const std::string key = _uri.toString();
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(const Entry* entry = find(key))
+    {
+      if(entry->mContent)
+        return std::make_shared<common::MemoryResource>(entry->mContent);
+      else if(!entry->mExists)
+        return nullptr;
+    }
+  }
+
+  // Load without holding the lock, so other URIs can be retrieved in the
+  // meantime
+  const common::ResourcePtr resource = mRetriever->retrieve(_uri);
+  if(!resource)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    insert(key, false, nullptr);
+    return nullptr;
+  }
+
+  const size_t size = resource->getSize();
+  if(key.size() + size > getCapacity())
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    insert(key, true, nullptr);
+    return resource;
+  }
+
+  const auto content = std::make_shared<std::string>();
+  if(const char* data = resource->getData())
+  {
+    content->assign(data, size);
+  }
+  else
+  {
+    content->resize(size);
+    if(size > 0u && resource->read(&content->front(), size, 1) != 1)
+    {
+      dtwarn << "[CachingResourceRetriever::retrieve] Failed reading URI '"
+             << key << "'. It will not be cached.\n";
+      return mRetriever->retrieve(_uri);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  insert(key, true, content);
+  return std::make_shared<common::MemoryResource>(content);
+}
+
+//==============================================================================
+void CachingResourceRetriever::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+  mLeastRecentlyUsed.clear();
+  mSize = 0u;
+}
+
+//==============================================================================
+void CachingResourceRetriever::setCapacity(size_t _capacity)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mCapacity = _capacity;
+  while(mSize > mCapacity)
+    erase(mEntries.find(mLeastRecentlyUsed.back()));
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getCapacity() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCapacity;
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getSize() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSize;
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getNumEntries() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+
+//==============================================================================
+CachingResourceRetriever::Entry* CachingResourceRetriever::find(
+    const std::string& _key)
+{
+  const auto it = mEntries.find(_key);
+  if(it == mEntries.end())
+    return nullptr;
+
+  mLeastRecentlyUsed.splice(mLeastRecentlyUsed.begin(), mLeastRecentlyUsed,
+                            it->second.mPosition);
+  return &it->second;
+}
+
+//==============================================================================
+void CachingResourceRetriever::insert(
+    const std::string& _key, bool _exists,
+    const std::shared_ptr<const std::string>& _content)
+{
+  const auto it = mEntries.find(_key);
+  if(it != mEntries.end())
+    erase(it);
+
+  Entry entry;
+  entry.mExists = _exists;
+  entry.mContent = _content;
+
+  const size_t size = getEntrySize(_key, entry);
+  if(size > mCapacity)
+    return;
+
+  while(mSize + size > mCapacity)
+    erase(mEntries.find(mLeastRecentlyUsed.back()));
+
+  mLeastRecentlyUsed.push_front(_key);
+  entry.mPosition = mLeastRecentlyUsed.begin();
+  mEntries[_key] = entry;
+  mSize += size;
+}
+
+//==============================================================================
+void CachingResourceRetriever::erase(
+    std::unordered_map<std::string, Entry>::iterator _it)
+{
+  mSize -= getEntrySize(_it->first, _it->second);
+  mLeastRecentlyUsed.erase(_it->second.mPosition);
+  mEntries.erase(_it);
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getEntrySize(const std::string& _key,
+                                              const Entry& _entry)
+{
+  return _key.size() + (_entry.mContent ? _entry.mContent->size() : 0u);
+}
+
+} // namespace utils
+} // namespace dart
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_CACHINGRESOURCERETRIEVER_H_
+#define DART_UTILS_CACHINGRESOURCERETRIEVER_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "dart/common/ResourceRetriever.h"
+
+namespace dart {
+namespace utils {
+
+/// CachingResourceRetriever remembers the results of another
+/// \ref ResourceRetriever, e.g. a \ref CompositeResourceRetriever. The content
+/// of a retrieved resource is kept in memory and handed out as a
+/// common::MemoryResource, so a URI that is requested repeatedly while a
+/// World is being loaded is only read from its source once. The results of
+/// exists() and of failed lookups are remembered as well, which saves the
+/// wrapped retriever from probing the filesystem again.
+///
+/// The cache holds at most a given number of bytes and drops the least
+/// recently used URIs first. Resources that are larger than the whole cache
+/// are passed through without being cached. Changes to the underlying
+/// resources are not noticed, so clear() has to be called after they have
+/// been modified. All of the functions are thread-safe.
+class CachingResourceRetriever : public virtual common::ResourceRetriever
+{
+public:
+  /// Default capacity of the cache, in bytes
+  static const size_t DEFAULT_CAPACITY = 64u * 1024u * 1024u;
+
+  /// Constructor. The cache holds up to _capacity bytes of the content that
+  /// is retrieved through _retriever.
+  explicit CachingResourceRetriever(
+    const common::ResourceRetrieverPtr& _retriever,
+    size_t _capacity = DEFAULT_CAPACITY);
+
+  virtual ~CachingResourceRetriever() = default;
+
+  // Documentation inherited.
+  bool exists(const common::Uri& _uri) override;
+
+  // Documentation inherited.
+  common::ResourcePtr retrieve(const common::Uri& _uri) override;
+
+  /// Forget everything that has been cached
+  void clear();
+
+  /// Set the number of bytes that the cache may hold. Entries are dropped
+  /// right away if the cache holds more than that.
+  void setCapacity(size_t _capacity);
+
+  /// Get the number of bytes that the cache may hold
+  size_t getCapacity() const;
+
+  /// Get the number of bytes that the cache currently holds
+  size_t getSize() const;
+
+  /// Get the number of URIs that the cache currently remembers
+  size_t getNumEntries() const;
+
+private:
+  /// What is known about a URI
+  struct Entry
+  {
+    /// Whether the resource exists
+    bool mExists;
+
+    /// Content of the resource, or nullptr if it has not been cached
+    std::shared_ptr<const std::string> mContent;
+
+    /// Position of the URI in mLeastRecentlyUsed
+    std::list<std::string>::iterator mPosition;
+  };
+
+  /// Return the entry of _key and mark it as the most recently used one, or
+  /// nullptr if there is no entry. mMutex must be locked.
+  Entry* find(const std::string& _key);
+
+  /// Add or replace the entry of _key and drop the least recently used
+  /// entries if the cache is full. mMutex must be locked.
+  void insert(const std::string& _key, bool _exists,
+              const std::shared_ptr<const std::string>& _content);
+
+  /// Remove the entry at _it. mMutex must be locked.
+  void erase(std::unordered_map<std::string, Entry>::iterator _it);
+
+  /// Return the number of bytes that are used by the entry of _key
+  static size_t getEntrySize(const std::string& _key, const Entry& _entry);
+
+  /// The retriever that is being cached
+  common::ResourceRetrieverPtr mRetriever;
+
+  /// Maximum number of bytes in the cache
+  size_t mCapacity;
+
+  /// Number of bytes in the cache
+  size_t mSize;
+
+  /// The cached URIs, from the most to the least recently used one
+  std::list<std::string> mLeastRecentlyUsed;
+
+  /// The entries by their URI
+  std::unordered_map<std::string, Entry> mEntries;
+
+  /// Protects the members above, except for mRetriever
+  mutable std::mutex mMutex;
+};
+
+using CachingResourceRetrieverPtr = std::shared_ptr<CachingResourceRetriever>;
+
+} // namespace utils
+} // namespace dart
+
+#endif // ifndef DART_UTILS_CACHINGRESOURCERETRIEVER_H_
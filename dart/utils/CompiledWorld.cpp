@@ -0,0 +1,1237 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/CompiledWorld.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "dart/common/Console.h"
+#include "dart/common/LocalResourceRetriever.h"
+#include "dart/common/MemoryResource.h"
+#include "dart/common/detail/BinaryIO.h"
+#include "dart/collision/CollisionDetector.h"
+#include "dart/constraint/ConstraintSolver.h"
+#include "dart/dynamics/BallJoint.h"
+#include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/CylinderShape.h"
+#include "dart/dynamics/DegreeOfFreedom.h"
+#include "dart/dynamics/EllipsoidShape.h"
+#include "dart/dynamics/EulerJoint.h"
+#include "dart/dynamics/FreeJoint.h"
+#include "dart/dynamics/LineSegmentShape.h"
+#include "dart/dynamics/Marker.h"
+#include "dart/dynamics/MeshShape.h"
+#include "dart/dynamics/PlanarJoint.h"
+#include "dart/dynamics/PlaneShape.h"
+#include "dart/dynamics/PrismaticJoint.h"
+#include "dart/dynamics/RevoluteJoint.h"
+#include "dart/dynamics/ScrewJoint.h"
+#include "dart/dynamics/SoftBodyNode.h"
+#include "dart/dynamics/SoftMeshShape.h"
+#include "dart/dynamics/TranslationalJoint.h"
+#include "dart/dynamics/UniversalJoint.h"
+#include "dart/dynamics/WeldJoint.h"
+
+namespace dart {
+namespace utils {
+
+using common::detail::BinaryReader;
+using common::detail::BinaryWriter;
+
+namespace {
+
+/// Identifies a compiled world file
+const char COMPILED_WORLD_MAGIC[8] = {'D', 'A', 'R', 'T', 'W', 'L', 'D', '\0'};
+
+/// Version of the compiled world format
+const uint32_t COMPILED_WORLD_VERSION = 2;
+
+/// What a compiled file contains
+enum ContentType : uint8_t
+{
+  WORLD_CONTENT,
+  SKELETON_CONTENT
+};
+
+/// The types of Joints that can be compiled
+enum JointType : uint8_t
+{
+  WELD_JOINT,
+  REVOLUTE_JOINT,
+  PRISMATIC_JOINT,
+  SCREW_JOINT,
+  UNIVERSAL_JOINT,
+  BALL_JOINT,
+  EULER_JOINT,
+  TRANSLATIONAL_JOINT,
+  PLANAR_JOINT,
+  FREE_JOINT
+};
+
+/// The number of values that are stored for every DegreeOfFreedom
+const size_t NUM_DOF_VALUES = 16;
+
+//==============================================================================
+template <typename Derived>
+void writeMatrix(BinaryWriter& _writer, const Eigen::MatrixBase<Derived>& _m)
+{
+  const typename Derived::PlainObject m = _m;
+  _writer.write(m.data(), m.size() * sizeof(typename Derived::Scalar));
+}
+
+//==============================================================================
+template <typename MatrixType>
+bool readMatrix(BinaryReader& _reader, MatrixType& _m)
+{
+  return _reader.read(_m.data(),
+                      _m.size() * sizeof(typename MatrixType::Scalar));
+}
+
+//==============================================================================
+void writeBool(BinaryWriter& _writer, bool _value)
+{
+  _writer.write(static_cast<uint8_t>(_value));
+}
+
+//==============================================================================
+bool readBool(BinaryReader& _reader, bool& _value)
+{
+  uint8_t value;
+  if(!_reader.read(value))
+    return false;
+
+  _value = (value != 0);
+  return true;
+}
+
+//==============================================================================
+bool isCompilable(const dynamics::ShapePtr& _shape)
+{
+  if(dynamic_cast<const dynamics::SoftMeshShape*>(_shape.get()))
+    return false; // Soft shapes are created by their SoftBodyNode
+
+  if(_shape->getShapeType() == dynamics::Shape::MESH)
+  {
+    const auto mesh = static_cast<const dynamics::MeshShape*>(_shape.get());
+    if(mesh->getMeshUri().empty())
+    {
+      dtwarn << "[CompiledWorld] Skipping a MeshShape that was not loaded from "
+             << "a URI.\n";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+void writeShape(BinaryWriter& _writer, const dynamics::Shape* _shape)
+{
+  _writer.write(static_cast<uint8_t>(_shape->getShapeType()));
+  writeMatrix(_writer, _shape->getLocalTransform().matrix());
+  writeMatrix(_writer, _shape->getRGBA());
+  _writer.write(static_cast<uint32_t>(_shape->getDataVariance()));
+  writeBool(_writer, _shape->isHidden());
+
+  switch(_shape->getShapeType())
+  {
+    case dynamics::Shape::BOX:
+      writeMatrix(_writer,
+                  static_cast<const dynamics::BoxShape*>(_shape)->getSize());
+      break;
+    case dynamics::Shape::ELLIPSOID:
+      writeMatrix(_writer,
+                  static_cast<const dynamics::EllipsoidShape*>(_shape)
+                  ->getSize());
+      break;
+    case dynamics::Shape::CYLINDER:
+    {
+      const auto cylinder = static_cast<const dynamics::CylinderShape*>(_shape);
+      _writer.write(cylinder->getRadius());
+      _writer.write(cylinder->getHeight());
+      break;
+    }
+    case dynamics::Shape::PLANE:
+    {
+      const auto plane = static_cast<const dynamics::PlaneShape*>(_shape);
+      writeMatrix(_writer, plane->getNormal());
+      _writer.write(plane->getOffset());
+      break;
+    }
+    case dynamics::Shape::MESH:
+    {
+      const auto mesh = static_cast<const dynamics::MeshShape*>(_shape);
+      writeMatrix(_writer, mesh->getScale());
+      _writer.writeString(mesh->getMeshUri());
+      _writer.write(static_cast<uint8_t>(mesh->getColorMode()));
+      _writer.write(static_cast<int32_t>(mesh->getColorIndex()));
+      break;
+    }
+    case dynamics::Shape::LINE_SEGMENT:
+    {
+      const auto lines = static_cast<const dynamics::LineSegmentShape*>(_shape);
+      _writer.write(lines->getThickness());
+
+      const std::vector<Eigen::Vector3d>& vertices = lines->getVertices();
+      _writer.write(static_cast<uint32_t>(vertices.size()));
+      for(const Eigen::Vector3d& vertex : vertices)
+        writeMatrix(_writer, vertex);
+
+      const auto& connections = lines->getConnections();
+      _writer.write(static_cast<uint32_t>(connections.size()));
+      for(const Eigen::Vector2i& connection : connections)
+        writeMatrix(_writer, connection);
+      break;
+    }
+    case dynamics::Shape::SOFT_MESH:
+      break;
+  }
+}
+
+//==============================================================================
+dynamics::ShapePtr readShape(BinaryReader& _reader,
+                             const common::ResourceRetrieverPtr& _retriever)
+{
+  uint8_t type;
+  Eigen::Isometry3d transform;
+  Eigen::Vector4d rgba;
+  uint32_t dataVariance;
+  bool hidden;
+  if(!_reader.read(type) || !readMatrix(_reader, transform.matrix())
+     || !readMatrix(_reader, rgba) || !_reader.read(dataVariance)
+     || !readBool(_reader, hidden))
+    return nullptr;
+
+  dynamics::ShapePtr shape;
+  switch(type)
+  {
+    case dynamics::Shape::BOX:
+    case dynamics::Shape::ELLIPSOID:
+    {
+      Eigen::Vector3d size;
+      if(!readMatrix(_reader, size))
+        return nullptr;
+
+      if(type == dynamics::Shape::BOX)
+        shape = std::make_shared<dynamics::BoxShape>(size);
+      else
+        shape = std::make_shared<dynamics::EllipsoidShape>(size);
+      break;
+    }
+    case dynamics::Shape::CYLINDER:
+    {
+      double radius, height;
+      if(!_reader.read(radius) || !_reader.read(height))
+        return nullptr;
+
+      shape = std::make_shared<dynamics::CylinderShape>(radius, height);
+      break;
+    }
+    case dynamics::Shape::PLANE:
+    {
+      Eigen::Vector3d normal;
+      double offset;
+      if(!readMatrix(_reader, normal) || !_reader.read(offset))
+        return nullptr;
+
+      shape = std::make_shared<dynamics::PlaneShape>(normal, offset);
+      break;
+    }
+    case dynamics::Shape::MESH:
+    {
+      Eigen::Vector3d scale;
+      std::string uri;
+      uint8_t colorMode;
+      int32_t colorIndex;
+      if(!readMatrix(_reader, scale) || !_reader.readString(uri)
+         || !_reader.read(colorMode) || !_reader.read(colorIndex))
+        return nullptr;
+
+      const aiScene* mesh = dynamics::MeshShape::loadMesh(uri, _retriever);
+      const auto meshShape = std::make_shared<dynamics::MeshShape>(
+            scale, mesh, uri, _retriever);
+      meshShape->setColorMode(
+            static_cast<dynamics::MeshShape::ColorMode>(colorMode));
+      meshShape->setColorIndex(colorIndex);
+      shape = meshShape;
+      break;
+    }
+    case dynamics::Shape::LINE_SEGMENT:
+    {
+      float thickness;
+      uint32_t numVertices;
+      if(!_reader.read(thickness) || !_reader.read(numVertices)
+         || !_reader.canRead(numVertices, 3 * sizeof(double)))
+        return nullptr;
+
+      const auto lines = std::make_shared<dynamics::LineSegmentShape>(
+            thickness);
+      Eigen::Vector3d vertex;
+      for(size_t i=0; i<numVertices; ++i)
+      {
+        if(!readMatrix(_reader, vertex))
+          return nullptr;
+
+        lines->addVertex(vertex);
+      }
+
+      uint32_t numConnections;
+      if(!_reader.read(numConnections))
+        return nullptr;
+
+      Eigen::Vector2i connection;
+      for(size_t i=0; i<numConnections; ++i)
+      {
+        if(!readMatrix(_reader, connection) || connection[0] < 0
+           || connection[1] < 0
+           || static_cast<size_t>(connection[0]) >= numVertices
+           || static_cast<size_t>(connection[1]) >= numVertices)
+          return nullptr;
+
+        lines->addConnection(connection[0], connection[1]);
+      }
+
+      shape = lines;
+      break;
+    }
+    default:
+      return nullptr;
+  }
+
+  shape->setLocalTransform(transform);
+  shape->setRGBA(rgba);
+  shape->setDataVariance(dataVariance);
+  shape->setHidden(hidden);
+
+  return shape;
+}
+
+//==============================================================================
+void writeShapeIndices(
+    BinaryWriter& _writer, const std::vector<dynamics::ShapePtr>& _shapes,
+    const std::unordered_map<const dynamics::Shape*, uint32_t>& _indices)
+{
+  std::vector<uint32_t> indices;
+  for(const dynamics::ShapePtr& shape : _shapes)
+  {
+    const auto it = _indices.find(shape.get());
+    if(it != _indices.end())
+      indices.push_back(it->second);
+  }
+
+  _writer.write(static_cast<uint32_t>(indices.size()));
+  _writer.write(indices.data(), indices.size() * sizeof(uint32_t));
+}
+
+//==============================================================================
+bool readShapeIndices(BinaryReader& _reader,
+                      const std::vector<dynamics::ShapePtr>& _table,
+                      std::vector<dynamics::ShapePtr>& _shapes)
+{
+  uint32_t numShapes;
+  if(!_reader.read(numShapes)
+     || !_reader.canRead(numShapes, sizeof(uint32_t)))
+    return false;
+
+  _shapes.clear();
+  _shapes.reserve(numShapes);
+  for(size_t i=0; i<numShapes; ++i)
+  {
+    uint32_t index;
+    if(!_reader.read(index) || index >= _table.size())
+      return false;
+
+    _shapes.push_back(_table[index]);
+  }
+
+  return true;
+}
+
+//==============================================================================
+void writeBodyNode(BinaryWriter& _writer, const dynamics::BodyNode* _bodyNode)
+{
+  const dynamics::BodyNode::Properties properties =
+      _bodyNode->getBodyNodeProperties();
+
+  _writer.writeString(properties.mName);
+  _writer.write(properties.mInertia.getMass());
+  writeMatrix(_writer, properties.mInertia.getLocalCOM());
+  writeMatrix(_writer, properties.mInertia.getMoment());
+  writeBool(_writer, properties.mGravityMode);
+  writeBool(_writer, _bodyNode->isCollidable());
+  _writer.write(properties.mFrictionCoeff);
+  _writer.write(properties.mRestitutionCoeff);
+  _writer.write(properties.mCollisionCategories);
+  _writer.write(properties.mCollisionMask);
+
+  // Shapes that are used for both visualization and collision are only
+  // stored once
+  std::vector<const dynamics::Shape*> shapes;
+  std::unordered_map<const dynamics::Shape*, uint32_t> indices;
+  for(const auto* list : {&properties.mVizShapes, &properties.mColShapes})
+  {
+    for(const dynamics::ShapePtr& shape : *list)
+    {
+      if(indices.count(shape.get()) == 0 && isCompilable(shape))
+      {
+        indices[shape.get()] = shapes.size();
+        shapes.push_back(shape.get());
+      }
+    }
+  }
+
+  _writer.write(static_cast<uint32_t>(shapes.size()));
+  for(const dynamics::Shape* shape : shapes)
+    writeShape(_writer, shape);
+
+  writeShapeIndices(_writer, properties.mVizShapes, indices);
+  writeShapeIndices(_writer, properties.mColShapes, indices);
+
+  _writer.write(static_cast<uint32_t>(_bodyNode->getNumMarkers()));
+  for(size_t i=0; i<_bodyNode->getNumMarkers(); ++i)
+  {
+    const dynamics::Marker* marker = _bodyNode->getMarker(i);
+    _writer.writeString(marker->getName());
+    writeMatrix(_writer, marker->getLocalPosition());
+    _writer.write(static_cast<uint8_t>(marker->getConstraintType()));
+  }
+}
+
+//==============================================================================
+bool readBodyNode(BinaryReader& _reader,
+                  dynamics::BodyNode::Properties& _properties,
+                  bool& _isCollidable,
+                  const common::ResourceRetrieverPtr& _retriever)
+{
+  double mass;
+  Eigen::Vector3d com;
+  Eigen::Matrix3d moment;
+  if(!_reader.readString(_properties.mName) || !_reader.read(mass)
+     || !readMatrix(_reader, com) || !readMatrix(_reader, moment)
+     || !readBool(_reader, _properties.mGravityMode)
+     || !readBool(_reader, _isCollidable)
+     || !_reader.read(_properties.mFrictionCoeff)
+     || !_reader.read(_properties.mRestitutionCoeff)
+     || !_reader.read(_properties.mCollisionCategories)
+     || !_reader.read(_properties.mCollisionMask))
+    return false;
+
+  _properties.mInertia = dynamics::Inertia(mass, com, moment);
+
+  // Every shape starts with its transform and color
+  uint32_t numShapes;
+  if(!_reader.read(numShapes)
+     || !_reader.canRead(numShapes, 20 * sizeof(double)))
+    return false;
+
+  std::vector<dynamics::ShapePtr> shapes;
+  shapes.reserve(numShapes);
+  for(size_t i=0; i<numShapes; ++i)
+  {
+    dynamics::ShapePtr shape = readShape(_reader, _retriever);
+    if(!shape)
+      return false;
+
+    shapes.push_back(shape);
+  }
+
+  if(!readShapeIndices(_reader, shapes, _properties.mVizShapes)
+     || !readShapeIndices(_reader, shapes, _properties.mColShapes))
+    return false;
+
+  // Every marker has at least the length of its name, an offset, and a type
+  uint32_t numMarkers;
+  if(!_reader.read(numMarkers)
+     || !_reader.canRead(numMarkers, sizeof(uint32_t) + 3 * sizeof(double)
+                                     + sizeof(uint8_t)))
+    return false;
+
+  _properties.mMarkerProperties.resize(numMarkers);
+  for(dynamics::Marker::Properties& marker : _properties.mMarkerProperties)
+  {
+    uint8_t type;
+    if(!_reader.readString(marker.mName)
+       || !readMatrix(_reader, marker.mOffset) || !_reader.read(type))
+      return false;
+
+    marker.mType = static_cast<dynamics::Marker::ConstraintType>(type);
+  }
+
+  return true;
+}
+
+//==============================================================================
+void writeSoftBodyNode(BinaryWriter& _writer,
+                       const dynamics::SoftBodyNode* _softBodyNode)
+{
+  const dynamics::SoftBodyNode::Properties properties =
+      _softBodyNode->getSoftBodyNodeProperties();
+
+  _writer.write(properties.mKv);
+  _writer.write(properties.mKe);
+  _writer.write(properties.mDampCoeff);
+
+  _writer.write(static_cast<uint32_t>(properties.mPointProps.size()));
+  for(const dynamics::PointMass::Properties& point : properties.mPointProps)
+  {
+    writeMatrix(_writer, point.mX0);
+    _writer.write(point.mMass);
+    _writer.write(static_cast<uint32_t>(
+                    point.mConnectedPointMassIndices.size()));
+    for(const size_t index : point.mConnectedPointMassIndices)
+      _writer.write(static_cast<uint32_t>(index));
+  }
+
+  _writer.write(static_cast<uint32_t>(properties.mFaces.size()));
+  for(const Eigen::Vector3i& face : properties.mFaces)
+    writeMatrix(_writer, face);
+
+  // The SoftMeshShape is recreated by the SoftBodyNode, but its appearance is
+  // kept
+  const dynamics::Shape* softShape = nullptr;
+  for(const dynamics::ShapePtr& shape : properties.mVizShapes)
+  {
+    if(dynamic_cast<const dynamics::SoftMeshShape*>(shape.get()))
+      softShape = shape.get();
+  }
+
+  writeBool(_writer, softShape != nullptr);
+  if(softShape)
+  {
+    writeMatrix(_writer, softShape->getRGBA());
+    writeMatrix(_writer, softShape->getLocalTransform().matrix());
+  }
+}
+
+//==============================================================================
+bool readSoftBodyNode(BinaryReader& _reader,
+                      dynamics::SoftBodyNode::UniqueProperties& _properties,
+                      bool& _hasSoftShape, Eigen::Vector4d& _softShapeRGBA,
+                      Eigen::Isometry3d& _softShapeTransform)
+{
+  uint32_t numPoints;
+  if(!_reader.read(_properties.mKv) || !_reader.read(_properties.mKe)
+     || !_reader.read(_properties.mDampCoeff) || !_reader.read(numPoints)
+     || !_reader.canRead(numPoints, 3 * sizeof(double)))
+    return false;
+
+  _properties.mPointProps.resize(numPoints);
+  for(dynamics::PointMass::Properties& point : _properties.mPointProps)
+  {
+    uint32_t numConnections;
+    if(!readMatrix(_reader, point.mX0) || !_reader.read(point.mMass)
+       || !_reader.read(numConnections)
+       || !_reader.canRead(numConnections, sizeof(uint32_t)))
+      return false;
+
+    point.mConnectedPointMassIndices.resize(numConnections);
+    for(size_t& index : point.mConnectedPointMassIndices)
+    {
+      uint32_t value;
+      if(!_reader.read(value) || value >= numPoints)
+        return false;
+
+      index = value;
+    }
+  }
+
+  uint32_t numFaces;
+  if(!_reader.read(numFaces)
+     || !_reader.canRead(numFaces, 3 * sizeof(int)))
+    return false;
+
+  _properties.mFaces.resize(numFaces);
+  for(Eigen::Vector3i& face : _properties.mFaces)
+  {
+    if(!readMatrix(_reader, face) || face.minCoeff() < 0
+       || static_cast<size_t>(face.maxCoeff()) >= numPoints)
+      return false;
+  }
+
+  if(!readBool(_reader, _hasSoftShape))
+    return false;
+
+  if(_hasSoftShape)
+  {
+    return readMatrix(_reader, _softShapeRGBA)
+        && readMatrix(_reader, _softShapeTransform.matrix());
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool writeJoint(BinaryWriter& _writer, const dynamics::Joint* _joint)
+{
+  const std::string& type = _joint->getType();
+  if(type == dynamics::WeldJoint::getStaticType())
+  {
+    _writer.write(WELD_JOINT);
+  }
+  else if(type == dynamics::RevoluteJoint::getStaticType())
+  {
+    _writer.write(REVOLUTE_JOINT);
+    writeMatrix(_writer, static_cast<const dynamics::RevoluteJoint*>(_joint)
+                ->getAxis());
+  }
+  else if(type == dynamics::PrismaticJoint::getStaticType())
+  {
+    _writer.write(PRISMATIC_JOINT);
+    writeMatrix(_writer, static_cast<const dynamics::PrismaticJoint*>(_joint)
+                ->getAxis());
+  }
+  else if(type == dynamics::ScrewJoint::getStaticType())
+  {
+    const auto screw = static_cast<const dynamics::ScrewJoint*>(_joint);
+    _writer.write(SCREW_JOINT);
+    writeMatrix(_writer, screw->getAxis());
+    _writer.write(screw->getPitch());
+  }
+  else if(type == dynamics::UniversalJoint::getStaticType())
+  {
+    const auto universal = static_cast<const dynamics::UniversalJoint*>(_joint);
+    _writer.write(UNIVERSAL_JOINT);
+    writeMatrix(_writer, universal->getAxis1());
+    writeMatrix(_writer, universal->getAxis2());
+  }
+  else if(type == dynamics::BallJoint::getStaticType())
+  {
+    _writer.write(BALL_JOINT);
+  }
+  else if(type == dynamics::EulerJoint::getStaticType())
+  {
+    _writer.write(EULER_JOINT);
+    _writer.write(static_cast<uint8_t>(
+        static_cast<const dynamics::EulerJoint*>(_joint)->getAxisOrder()));
+  }
+  else if(type == dynamics::TranslationalJoint::getStaticType())
+  {
+    _writer.write(TRANSLATIONAL_JOINT);
+  }
+  else if(type == dynamics::PlanarJoint::getStaticType())
+  {
+    const dynamics::PlanarJoint::Properties properties =
+        static_cast<const dynamics::PlanarJoint*>(_joint)
+        ->getPlanarJointProperties();
+    _writer.write(PLANAR_JOINT);
+    _writer.write(static_cast<uint8_t>(properties.mPlaneType));
+    writeMatrix(_writer, properties.mTransAxis1);
+    writeMatrix(_writer, properties.mTransAxis2);
+  }
+  else if(type == dynamics::FreeJoint::getStaticType())
+  {
+    _writer.write(FREE_JOINT);
+  }
+  else
+  {
+    dterr << "[CompiledWorld::writeJoint] Joint [" << _joint->getName()
+          << "] has the unsupported type [" << type << "].\n";
+    return false;
+  }
+
+  const dynamics::Joint::Properties& properties =
+      _joint->getJointProperties();
+  _writer.writeString(properties.mName);
+  writeMatrix(_writer, properties.mT_ParentBodyToJoint.matrix());
+  writeMatrix(_writer, properties.mT_ChildBodyToJoint.matrix());
+  writeBool(_writer, properties.mIsPositionLimited);
+  _writer.write(static_cast<uint8_t>(properties.mActuatorType));
+
+  _writer.write(static_cast<uint32_t>(_joint->getNumDofs()));
+  for(size_t i=0; i<_joint->getNumDofs(); ++i)
+  {
+    const dynamics::DegreeOfFreedom* dof = _joint->getDof(i);
+    _writer.writeString(dof->getName());
+    writeBool(_writer, dof->isNamePreserved());
+
+    const double values[NUM_DOF_VALUES] = {
+      dof->getPositionLowerLimit(), dof->getPositionUpperLimit(),
+      dof->getInitialPosition(), dof->getPosition(),
+      dof->getVelocityLowerLimit(), dof->getVelocityUpperLimit(),
+      dof->getInitialVelocity(), dof->getVelocity(),
+      dof->getAccelerationLowerLimit(), dof->getAccelerationUpperLimit(),
+      dof->getForceLowerLimit(), dof->getForceUpperLimit(),
+      dof->getSpringStiffness(), dof->getRestPosition(),
+      dof->getDampingCoefficient(), dof->getCoulombFriction()
+    };
+    _writer.write(values);
+  }
+
+  return true;
+}
+
+//==============================================================================
+template <typename JointType, typename NodeType>
+dynamics::BodyNode* createPair(
+    const dynamics::SkeletonPtr& _skeleton, dynamics::BodyNode* _parent,
+    const typename JointType::Properties& _jointProperties,
+    const typename NodeType::Properties& _bodyProperties)
+{
+  return _skeleton->createJointAndBodyNodePair<JointType, NodeType>(
+        _parent, _jointProperties, _bodyProperties).second;
+}
+
+//==============================================================================
+template <typename NodeType>
+dynamics::BodyNode* readJointAndCreatePair(
+    BinaryReader& _reader, const dynamics::SkeletonPtr& _skeleton,
+    dynamics::BodyNode* _parent,
+    const typename NodeType::Properties& _bodyProperties)
+{
+  using namespace dynamics;
+
+  uint8_t type;
+  if(!_reader.read(type))
+    return nullptr;
+
+  // Properties that are unique to the type of the Joint
+  Eigen::Vector3d axis1, axis2;
+  double pitch = 0.0;
+  uint8_t option = 0;
+  switch(type)
+  {
+    case REVOLUTE_JOINT:
+    case PRISMATIC_JOINT:
+      if(!readMatrix(_reader, axis1))
+        return nullptr;
+      break;
+    case SCREW_JOINT:
+      if(!readMatrix(_reader, axis1) || !_reader.read(pitch))
+        return nullptr;
+      break;
+    case UNIVERSAL_JOINT:
+      if(!readMatrix(_reader, axis1) || !readMatrix(_reader, axis2))
+        return nullptr;
+      break;
+    case EULER_JOINT:
+      if(!_reader.read(option))
+        return nullptr;
+      break;
+    case PLANAR_JOINT:
+      if(!_reader.read(option) || !readMatrix(_reader, axis1)
+         || !readMatrix(_reader, axis2))
+        return nullptr;
+      break;
+    case WELD_JOINT:
+    case BALL_JOINT:
+    case TRANSLATIONAL_JOINT:
+    case FREE_JOINT:
+      break;
+    default:
+      return nullptr;
+  }
+
+  Joint::Properties properties;
+  uint8_t actuatorType;
+  if(!_reader.readString(properties.mName)
+     || !readMatrix(_reader, properties.mT_ParentBodyToJoint.matrix())
+     || !readMatrix(_reader, properties.mT_ChildBodyToJoint.matrix())
+     || !readBool(_reader, properties.mIsPositionLimited)
+     || !_reader.read(actuatorType))
+    return nullptr;
+
+  properties.mActuatorType = static_cast<Joint::ActuatorType>(actuatorType);
+
+  BodyNode* bodyNode = nullptr;
+  switch(type)
+  {
+    case WELD_JOINT:
+      bodyNode = createPair<WeldJoint, NodeType>(
+            _skeleton, _parent, WeldJoint::Properties(properties),
+            _bodyProperties);
+      break;
+    case REVOLUTE_JOINT:
+      bodyNode = createPair<RevoluteJoint, NodeType>(
+            _skeleton, _parent, RevoluteJoint::Properties(
+              SingleDofJoint::Properties(properties),
+              RevoluteJoint::UniqueProperties(axis1)), _bodyProperties);
+      break;
+    case PRISMATIC_JOINT:
+      bodyNode = createPair<PrismaticJoint, NodeType>(
+            _skeleton, _parent, PrismaticJoint::Properties(
+              SingleDofJoint::Properties(properties),
+              PrismaticJoint::UniqueProperties(axis1)), _bodyProperties);
+      break;
+    case SCREW_JOINT:
+      bodyNode = createPair<ScrewJoint, NodeType>(
+            _skeleton, _parent, ScrewJoint::Properties(
+              SingleDofJoint::Properties(properties),
+              ScrewJoint::UniqueProperties(axis1, pitch)), _bodyProperties);
+      break;
+    case UNIVERSAL_JOINT:
+      bodyNode = createPair<UniversalJoint, NodeType>(
+            _skeleton, _parent, UniversalJoint::Properties(
+              MultiDofJoint<2>::Properties(properties),
+              UniversalJoint::UniqueProperties(axis1, axis2)),
+            _bodyProperties);
+      break;
+    case BALL_JOINT:
+      bodyNode = createPair<BallJoint, NodeType>(
+            _skeleton, _parent, BallJoint::Properties(
+              MultiDofJoint<3>::Properties(properties)), _bodyProperties);
+      break;
+    case EULER_JOINT:
+      bodyNode = createPair<EulerJoint, NodeType>(
+            _skeleton, _parent, EulerJoint::Properties(
+              MultiDofJoint<3>::Properties(properties),
+              EulerJoint::UniqueProperties(
+                static_cast<EulerJoint::AxisOrder>(option))),
+            _bodyProperties);
+      break;
+    case TRANSLATIONAL_JOINT:
+      bodyNode = createPair<TranslationalJoint, NodeType>(
+            _skeleton, _parent, TranslationalJoint::Properties(
+              MultiDofJoint<3>::Properties(properties)), _bodyProperties);
+      break;
+    case PLANAR_JOINT:
+    {
+      PlanarJoint::UniqueProperties planar;
+      switch(static_cast<PlanarJoint::PlaneType>(option))
+      {
+        case PlanarJoint::PT_XY:
+          planar.setXYPlane();
+          break;
+        case PlanarJoint::PT_YZ:
+          planar.setYZPlane();
+          break;
+        case PlanarJoint::PT_ZX:
+          planar.setZXPlane();
+          break;
+        default:
+          planar.setArbitraryPlane(axis1, axis2);
+      }
+
+      bodyNode = createPair<PlanarJoint, NodeType>(
+            _skeleton, _parent, PlanarJoint::Properties(
+              MultiDofJoint<3>::Properties(properties), planar),
+            _bodyProperties);
+      break;
+    }
+    case FREE_JOINT:
+      bodyNode = createPair<FreeJoint, NodeType>(
+            _skeleton, _parent, FreeJoint::Properties(
+              MultiDofJoint<6>::Properties(properties)), _bodyProperties);
+      break;
+  }
+
+  Joint* joint = bodyNode->getParentJoint();
+
+  uint32_t numDofs;
+  if(!_reader.read(numDofs) || numDofs != joint->getNumDofs())
+    return nullptr;
+
+  std::string name;
+  bool preserveName;
+  double values[NUM_DOF_VALUES];
+  for(size_t i=0; i<numDofs; ++i)
+  {
+    if(!_reader.readString(name) || !readBool(_reader, preserveName)
+       || !_reader.read(values))
+      return nullptr;
+
+    DegreeOfFreedom* dof = joint->getDof(i);
+    dof->setName(name, preserveName);
+    dof->setPositionLimits(values[0], values[1]);
+    dof->setInitialPosition(values[2]);
+    dof->setPosition(values[3]);
+    dof->setVelocityLimits(values[4], values[5]);
+    dof->setInitialVelocity(values[6]);
+    dof->setVelocity(values[7]);
+    dof->setAccelerationLimits(values[8], values[9]);
+    dof->setForceLimits(values[10], values[11]);
+    dof->setSpringStiffness(values[12]);
+    dof->setRestPosition(values[13]);
+    dof->setDampingCoefficient(values[14]);
+    dof->setCoulombFriction(values[15]);
+  }
+
+  return bodyNode;
+}
+
+//==============================================================================
+bool writeSkeleton(BinaryWriter& _writer,
+                   const dynamics::ConstSkeletonPtr& _skeleton)
+{
+  const dynamics::Skeleton::Properties& properties =
+      _skeleton->getSkeletonProperties();
+  _writer.writeString(properties.mName);
+  writeBool(_writer, properties.mIsMobile);
+  writeMatrix(_writer, properties.mGravity);
+  _writer.write(properties.mTimeStep);
+  writeBool(_writer, properties.mEnabledSelfCollisionCheck);
+  writeBool(_writer, properties.mEnabledAdjacentBodyCheck);
+
+  // BodyNodes are written in the order of their indices, which always puts a
+  // parent before its children
+  _writer.write(static_cast<uint32_t>(_skeleton->getNumBodyNodes()));
+  for(size_t i=0; i<_skeleton->getNumBodyNodes(); ++i)
+  {
+    const dynamics::BodyNode* bodyNode = _skeleton->getBodyNode(i);
+    const dynamics::BodyNode* parent = bodyNode->getParentBodyNode();
+    const int32_t parentIndex = parent ?
+          static_cast<int32_t>(parent->getIndexInSkeleton()) : -1;
+    assert(parentIndex < static_cast<int32_t>(i));
+
+    const auto softBodyNode =
+        dynamic_cast<const dynamics::SoftBodyNode*>(bodyNode);
+
+    _writer.write(parentIndex);
+    writeBool(_writer, softBodyNode != nullptr);
+    writeBodyNode(_writer, bodyNode);
+    if(softBodyNode)
+      writeSoftBodyNode(_writer, softBodyNode);
+
+    if(!writeJoint(_writer, bodyNode->getParentJoint()))
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+dynamics::SkeletonPtr readSkeleton(
+    BinaryReader& _reader, const common::ResourceRetrieverPtr& _retriever)
+{
+  dynamics::Skeleton::Properties properties;
+  if(!_reader.readString(properties.mName)
+     || !readBool(_reader, properties.mIsMobile)
+     || !readMatrix(_reader, properties.mGravity)
+     || !_reader.read(properties.mTimeStep)
+     || !readBool(_reader, properties.mEnabledSelfCollisionCheck)
+     || !readBool(_reader, properties.mEnabledAdjacentBodyCheck))
+    return nullptr;
+
+  const dynamics::SkeletonPtr skeleton =
+      dynamics::Skeleton::create(properties);
+
+  uint32_t numBodyNodes;
+  if(!_reader.read(numBodyNodes))
+    return nullptr;
+
+  for(size_t i=0; i<numBodyNodes; ++i)
+  {
+    int32_t parentIndex;
+    bool isSoft;
+    if(!_reader.read(parentIndex) || parentIndex >= static_cast<int32_t>(i)
+       || !readBool(_reader, isSoft))
+      return nullptr;
+
+    dynamics::BodyNode* parent = (parentIndex < 0) ?
+          nullptr : skeleton->getBodyNode(parentIndex);
+
+    dynamics::SoftBodyNode::Properties bodyProperties;
+    bool isCollidable;
+    if(!readBodyNode(_reader, bodyProperties, isCollidable, _retriever))
+      return nullptr;
+
+    dynamics::BodyNode* bodyNode;
+    if(isSoft)
+    {
+      bool hasSoftShape;
+      Eigen::Vector4d softShapeRGBA;
+      Eigen::Isometry3d softShapeTransform;
+      if(!readSoftBodyNode(_reader, bodyProperties, hasSoftShape,
+                           softShapeRGBA, softShapeTransform))
+        return nullptr;
+
+      bodyNode = readJointAndCreatePair<dynamics::SoftBodyNode>(
+            _reader, skeleton, parent, bodyProperties);
+
+      if(bodyNode && hasSoftShape)
+      {
+        for(size_t j=0; j<bodyNode->getNumVisualizationShapes(); ++j)
+        {
+          const dynamics::ShapePtr& shape = bodyNode->getVisualizationShape(j);
+          if(dynamic_cast<dynamics::SoftMeshShape*>(shape.get()))
+          {
+            shape->setRGBA(softShapeRGBA);
+            shape->setLocalTransform(softShapeTransform);
+          }
+        }
+      }
+    }
+    else
+    {
+      bodyNode = readJointAndCreatePair<dynamics::BodyNode>(
+            _reader, skeleton, parent, bodyProperties);
+    }
+
+    if(!bodyNode)
+      return nullptr;
+
+    bodyNode->setCollidable(isCollidable);
+  }
+
+  return skeleton;
+}
+
+//==============================================================================
+void writeHeader(BinaryWriter& _writer, ContentType _content)
+{
+  _writer.write(COMPILED_WORLD_MAGIC, sizeof(COMPILED_WORLD_MAGIC));
+  _writer.write(COMPILED_WORLD_VERSION);
+  _writer.write(_content);
+}
+
+//==============================================================================
+bool readHeader(BinaryReader& _reader, ContentType _content)
+{
+  char magic[sizeof(COMPILED_WORLD_MAGIC)];
+  uint32_t version;
+  uint8_t content;
+  return _reader.read(magic, sizeof(magic))
+      && std::memcmp(magic, COMPILED_WORLD_MAGIC, sizeof(magic)) == 0
+      && _reader.read(version) && version == COMPILED_WORLD_VERSION
+      && _reader.read(content) && content == _content;
+}
+
+//==============================================================================
+/// Retrieve the file at _uri as a resource that provides direct access to its
+/// content. Memory-mapped resources are used as they are, any other resource
+/// is read into memory first.
+common::ResourcePtr readFile(const common::Uri& _uri,
+                             const common::ResourceRetrieverPtr& _retriever)
+{
+  const common::ResourcePtr resource = _retriever->retrieve(_uri);
+  if(!resource)
+  {
+    dtwarn << "[CompiledWorld] Failed opening URI '" << _uri.toString()
+           << "'.\n";
+    return nullptr;
+  }
+
+  if(resource->getData())
+    return resource;
+
+  const auto content = std::make_shared<std::string>(resource->getSize(), '\0');
+  if(!content->empty()
+     && resource->read(&content->front(), content->size(), 1) != 1)
+  {
+    dtwarn << "[CompiledWorld] Failed reading URI '" << _uri.toString()
+           << "'.\n";
+    return nullptr;
+  }
+
+  return std::make_shared<common::MemoryResource>(content);
+}
+
+//==============================================================================
+common::ResourceRetrieverPtr getRetriever(
+    const common::ResourceRetrieverPtr& _retriever)
+{
+  if(_retriever)
+    return _retriever;
+  else
+    return common::LocalResourceRetriever::getDefault();
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool CompiledWorld::writeWorld(const simulation::WorldPtr& _world,
+                               const std::string& _path)
+{
+  BinaryWriter writer;
+  writeHeader(writer, WORLD_CONTENT);
+  writer.writeString(_world->getName());
+  writeMatrix(writer, _world->getGravity());
+  writer.write(_world->getTimeStep());
+
+  writer.write(static_cast<uint32_t>(_world->getNumSkeletons()));
+  for(size_t i=0; i<_world->getNumSkeletons(); ++i)
+  {
+    if(!utils::writeSkeleton(writer, _world->getSkeleton(i)))
+      return false;
+  }
+
+  // Collect the pairs of BodyNodes whose collisions were disabled
+  collision::CollisionDetector* detector =
+      _world->getConstraintSolver()->getCollisionDetector();
+  std::unordered_map<const dynamics::BodyNode*,
+                     std::pair<uint32_t, uint32_t>> bodyNodes;
+  for(size_t i=0; i<_world->getNumSkeletons(); ++i)
+  {
+    const dynamics::SkeletonPtr skeleton = _world->getSkeleton(i);
+    for(size_t j=0; j<skeleton->getNumBodyNodes(); ++j)
+      bodyNodes[skeleton->getBodyNode(j)] = std::make_pair(i, j);
+  }
+
+  std::vector<std::pair<const dynamics::BodyNode*, const dynamics::BodyNode*>>
+      disabledPairs;
+  for(const auto& pair : detector->getDisabledPairs())
+  {
+    if(bodyNodes.count(pair.first) && bodyNodes.count(pair.second))
+      disabledPairs.push_back(pair);
+  }
+
+  writer.write(static_cast<uint32_t>(disabledPairs.size()));
+  for(const auto& pair : disabledPairs)
+  {
+    writer.write(bodyNodes[pair.first]);
+    writer.write(bodyNodes[pair.second]);
+  }
+
+  if(!writer.saveToFile(_path))
+  {
+    dterr << "[CompiledWorld::writeWorld] Failed writing '" << _path << "'.\n";
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+simulation::WorldPtr CompiledWorld::readWorld(
+    const common::Uri& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  const common::ResourceRetrieverPtr retriever = getRetriever(_retriever);
+
+  const common::ResourcePtr file = readFile(_uri, retriever);
+  if(!file)
+    return nullptr;
+
+  BinaryReader reader(file->getData(), file->getSize());
+
+  std::string name;
+  Eigen::Vector3d gravity;
+  double timeStep;
+  uint32_t numSkeletons;
+  if(!readHeader(reader, WORLD_CONTENT) || !reader.readString(name)
+     || !readMatrix(reader, gravity) || !reader.read(timeStep)
+     || !reader.read(numSkeletons))
+  {
+    dterr << "[CompiledWorld::readWorld] '" << _uri.toString() << "' is not a "
+          << "compiled World of the current version.\n";
+    return nullptr;
+  }
+
+  simulation::WorldPtr world = std::make_shared<simulation::World>(name);
+  world->setGravity(gravity);
+  world->setTimeStep(timeStep);
+
+  for(size_t i=0; i<numSkeletons; ++i)
+  {
+    const dynamics::SkeletonPtr skeleton =
+        utils::readSkeleton(reader, retriever);
+    if(!skeleton)
+    {
+      dterr << "[CompiledWorld::readWorld] Failed reading Skeleton #" << i
+            << " of '" << _uri.toString() << "'.\n";
+      return nullptr;
+    }
+
+    world->addSkeleton(skeleton);
+  }
+
+  collision::CollisionDetector* detector =
+      world->getConstraintSolver()->getCollisionDetector();
+
+  uint32_t numDisabledPairs;
+  if(!reader.read(numDisabledPairs))
+    return nullptr;
+
+  std::pair<uint32_t, uint32_t> indices[2];
+  dynamics::BodyNode* bodyNodes[2];
+  for(size_t i=0; i<numDisabledPairs; ++i)
+  {
+    for(size_t j=0; j<2; ++j)
+    {
+      if(!reader.read(indices[j]) || indices[j].first >= numSkeletons)
+        return nullptr;
+
+      const dynamics::SkeletonPtr skeleton =
+          world->getSkeleton(indices[j].first);
+      if(indices[j].second >= skeleton->getNumBodyNodes())
+        return nullptr;
+
+      bodyNodes[j] = skeleton->getBodyNode(indices[j].second);
+    }
+
+    detector->disablePair(bodyNodes[0], bodyNodes[1]);
+  }
+
+  return world;
+}
+
+//==============================================================================
+bool CompiledWorld::writeSkeleton(const dynamics::SkeletonPtr& _skeleton,
+                                  const std::string& _path)
+{
+  BinaryWriter writer;
+  writeHeader(writer, SKELETON_CONTENT);
+  if(!utils::writeSkeleton(writer, _skeleton))
+    return false;
+
+  if(!writer.saveToFile(_path))
+  {
+    dterr << "[CompiledWorld::writeSkeleton] Failed writing '" << _path
+          << "'.\n";
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+dynamics::SkeletonPtr CompiledWorld::readSkeleton(
+    const common::Uri& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  const common::ResourceRetrieverPtr retriever = getRetriever(_retriever);
+
+  const common::ResourcePtr file = readFile(_uri, retriever);
+  if(!file)
+    return nullptr;
+
+  BinaryReader reader(file->getData(), file->getSize());
+  if(!readHeader(reader, SKELETON_CONTENT))
+  {
+    dterr << "[CompiledWorld::readSkeleton] '" << _uri.toString() << "' is "
+          << "not a compiled Skeleton of the current version.\n";
+    return nullptr;
+  }
+
+  dynamics::SkeletonPtr skeleton = utils::readSkeleton(reader, retriever);
+  if(!skeleton)
+  {
+    dterr << "[CompiledWorld::readSkeleton] Failed reading '"
+          << _uri.toString() << "'.\n";
+  }
+
+  return skeleton;
+}
+
+} // namespace utils
+} // namespace dart
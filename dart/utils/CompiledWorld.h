@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_COMPILEDWORLD_H_
+#define DART_UTILS_COMPILEDWORLD_H_
+
+#include <string>
+
+#include "dart/common/ResourceRetriever.h"
+#include "dart/common/Uri.h"
+#include "dart/dynamics/Skeleton.h"
+#include "dart/simulation/World.h"
+
+namespace dart {
+namespace utils {
+
+/// CompiledWorld stores fully constructed Worlds and Skeletons in a versioned
+/// binary format, so they can be loaded again without parsing any XML. A
+/// compiled file contains the joint and body properties, the current
+/// positions and velocities, the shapes, markers, soft body properties and
+/// the collision settings of every Skeleton. A World additionally stores its
+/// gravity, time step and the BodyNode pairs that were disabled in its
+/// collision detector.
+///
+/// Meshes are not copied into the compiled file. A MeshShape is stored by the
+/// URI of its mesh, which is loaded through the MeshCache when the file is
+/// read, so the retriever that is given to the read functions must be able to
+/// resolve the same URIs as the retriever that the source file was parsed
+/// with. MeshShapes without a URI are skipped with a warning.
+///
+/// The format uses the native byte order and is meant as a cache for a
+/// particular machine, not for exchanging models.
+class CompiledWorld
+{
+public:
+  /// Write _world to a compiled file at _path. Returns false on failure.
+  static bool writeWorld(const simulation::WorldPtr& _world,
+                         const std::string& _path);
+
+  /// Read a World from a compiled file. Returns a nullptr on failure.
+  static simulation::WorldPtr readWorld(
+    const common::Uri& _uri,
+    const common::ResourceRetrieverPtr& _retriever = nullptr);
+
+  /// Write _skeleton to a compiled file at _path. Returns false on failure.
+  static bool writeSkeleton(const dynamics::SkeletonPtr& _skeleton,
+                            const std::string& _path);
+
+  /// Read a Skeleton from a compiled file. Returns a nullptr on failure.
+  static dynamics::SkeletonPtr readSkeleton(
+    const common::Uri& _uri,
+    const common::ResourceRetrieverPtr& _retriever = nullptr);
+};
+
+} // namespace utils
+} // namespace dart
+
+#endif // DART_UTILS_COMPILEDWORLD_H_
@@ -56,7 +56,7 @@ public:
     inline double getFPS() const { return mFPS; }
 
     inline Eigen::Vector3d getDataAt(int _frame, int _idx) const { return mData.at(_frame).at(_idx); } ///< Note: not checking index range
-    inline void addData(const Eigen::EIGEN_V_VEC3D& _data) { mData.push_back(_data); }
+    inline void addData(const Eigen::EIGEN_V_VEC3D& _data) { mData.push_back(_data); mNumFrames = mData.size(); mNumMarkers = _data.size(); }
 
     virtual bool loadFile(const char*);
     virtual bool saveFile(const char*, int _start, int _end, double _sampleRate = 1); ///< Note: down sampling not implemented yet
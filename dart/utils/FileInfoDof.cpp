@@ -164,6 +164,20 @@ void FileInfoDof::addDof(const Eigen::VectorXd& _dofs)
   mDofs.push_back(_dofs); mNumFrames++;
 }
 
+//==============================================================================
+void FileInfoDof::setNumFrames(size_t _numFrames)
+{
+  mDofs.resize(_numFrames, Eigen::VectorXd::Zero(mSkel->getNumDofs()));
+  mNumFrames = _numFrames;
+}
+
+//==============================================================================
+void FileInfoDof::setPoseAtFrame(size_t _frame, const Eigen::VectorXd& _pose)
+{
+  assert(_frame < mNumFrames);
+  mDofs[_frame] = _pose;
+}
+
 //==============================================================================
 double FileInfoDof::getDofAt(size_t _frame, size_t _id) const
 {
@@ -70,6 +70,13 @@ public:
   /// \brief Add Dof
   void addDof(const Eigen::VectorXd& _dofs);
 
+  /// \brief Resize to _numFrames frames of the dofs of the skeleton, which can
+  /// then be filled in with setPoseAtFrame()
+  void setNumFrames(size_t _numFrames);
+
+  /// \brief Set pose at frame. Different frames can be set concurrently.
+  void setPoseAtFrame(size_t _frame, const Eigen::VectorXd& _pose);
+
   /// \brief Get Dof
   double getDofAt(size_t _frame, size_t _id) const;
 
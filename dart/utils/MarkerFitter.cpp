@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/MarkerFitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iostream>
+
+#include "dart/common/Console.h"
+#include "dart/common/ThreadPool.h"
+#include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/Marker.h"
+#include "dart/simulation/Recording.h"
+#include "dart/utils/FileInfoC3D.h"
+#include "dart/utils/FileInfoDof.h"
+
+namespace dart {
+namespace utils {
+
+//==============================================================================
+MarkerFitter::Properties::Properties(size_t _numThreads,
+                                     size_t _maxIterations,
+                                     double _tolerance,
+                                     double _dampingCoefficient,
+                                     size_t _numWarmUpFrames,
+                                     size_t _minFramesPerTask)
+  : mNumThreads(_numThreads),
+    mMaxIterations(_maxIterations),
+    mTolerance(_tolerance),
+    mDampingCoefficient(_dampingCoefficient),
+    mNumWarmUpFrames(_numWarmUpFrames),
+    mMinFramesPerTask(_minFramesPerTask)
+{
+  // Do nothing
+}
+
+//==============================================================================
+MarkerFitter::MarkerFitter(const dynamics::SkeletonPtr& _skeleton,
+                           const Properties& _properties)
+  : mSkeleton(_skeleton),
+    mProperties(_properties)
+{
+  for(size_t i = 0; i < mSkeleton->getNumBodyNodes(); ++i)
+  {
+    const dynamics::BodyNode* bn = mSkeleton->getBodyNode(i);
+    for(size_t j = 0; j < bn->getNumMarkers(); ++j)
+    {
+      const dynamics::Marker* marker = bn->getMarker(j);
+      mMarkers.push_back(MarkerInfo{i, marker->getLocalPosition(), marker});
+      mCorrespondences.push_back(static_cast<int>(mCorrespondences.size()));
+    }
+  }
+}
+
+//==============================================================================
+MarkerFitter::~MarkerFitter()
+{
+  // Do nothing
+}
+
+//==============================================================================
+void MarkerFitter::setProperties(const Properties& _properties)
+{
+  if(_properties.mNumThreads != mProperties.mNumThreads)
+    mThreadPool.reset();
+
+  mProperties = _properties;
+}
+
+//==============================================================================
+const MarkerFitter::Properties& MarkerFitter::getProperties() const
+{
+  return mProperties;
+}
+
+//==============================================================================
+size_t MarkerFitter::getNumMarkers() const
+{
+  return mMarkers.size();
+}
+
+//==============================================================================
+const dynamics::Marker* MarkerFitter::getMarker(size_t _index) const
+{
+  return mMarkers[_index].mMarker;
+}
+
+//==============================================================================
+void MarkerFitter::setCorrespondences(const std::vector<int>& _recordedIndices)
+{
+  if(_recordedIndices.size() != mMarkers.size())
+  {
+    dtwarn << "[MarkerFitter::setCorrespondences] The Skeleton has "
+           << mMarkers.size() << " Markers, but " << _recordedIndices.size()
+           << " correspondences were given. They will be ignored.\n";
+    return;
+  }
+
+  mCorrespondences = _recordedIndices;
+}
+
+//==============================================================================
+const std::vector<int>& MarkerFitter::getCorrespondences() const
+{
+  return mCorrespondences;
+}
+
+//==============================================================================
+bool MarkerFitter::fit(const FileInfoC3D& _markers, FileInfoDof& _dofs)
+{
+  _dofs.setNumFrames(std::max(_markers.getNumFrames(), 0));
+  _dofs.setFPS(_markers.getFPS());
+
+  return solve(_markers, [&](size_t _frame, const Eigen::VectorXd& _pose)
+  {
+    _dofs.setPoseAtFrame(_frame, _pose);
+  });
+}
+
+//==============================================================================
+bool MarkerFitter::fit(const FileInfoC3D& _markers,
+                       simulation::Recording& _recording)
+{
+  if(_recording.getNumSkeletons() != 1
+     || _recording.getNumDofs(0) != static_cast<int>(mSkeleton->getNumDofs()))
+  {
+    dtwarn << "[MarkerFitter::fit] The Recording does not match the "
+           << "Skeleton '" << mSkeleton->getName() << "'.\n";
+    return false;
+  }
+
+  // Recording can only append states, so they are added once all the frames
+  // have been solved
+  std::vector<Eigen::VectorXd> poses;
+  if(!fit(_markers, poses))
+    return false;
+
+  for(const Eigen::VectorXd& pose : poses)
+    _recording.addState(pose);
+
+  return true;
+}
+
+//==============================================================================
+bool MarkerFitter::fit(const FileInfoC3D& _markers,
+                       std::vector<Eigen::VectorXd>& _poses)
+{
+  _poses.resize(std::max(_markers.getNumFrames(), 0));
+
+  return solve(_markers, [&](size_t _frame, const Eigen::VectorXd& _pose)
+  {
+    _poses[_frame] = _pose;
+  });
+}
+
+//==============================================================================
+const std::vector<double>& MarkerFitter::getErrors() const
+{
+  return mErrors;
+}
+
+//==============================================================================
+bool MarkerFitter::solve(
+    const FileInfoC3D& _markers,
+    const std::function<void(size_t, const Eigen::VectorXd&)>& _output)
+{
+  for(const int index : mCorrespondences)
+  {
+    if(index >= _markers.getNumMarkers())
+    {
+      dtwarn << "[MarkerFitter::fit] The recording has "
+             << _markers.getNumMarkers() << " markers, but marker " << index
+             << " was requested.\n";
+      return false;
+    }
+  }
+
+  const size_t numFrames = std::max(_markers.getNumFrames(), 0);
+  mErrors.assign(numFrames, 0.0);
+  if(numFrames == 0)
+    return true;
+
+  size_t numTasks = 1;
+  if(mProperties.mNumThreads != 1
+     && numFrames >= 2 * std::max<size_t>(mProperties.mMinFramesPerTask, 1))
+  {
+    if(!mThreadPool)
+      mThreadPool.reset(new common::ThreadPool(mProperties.mNumThreads));
+
+    numTasks = std::min(mThreadPool->getNumThreads(),
+                        numFrames / std::max<size_t>(
+                          mProperties.mMinFramesPerTask, 1));
+  }
+
+  // Cloning adds Frames to the World Frame, which is not thread-safe, so the
+  // clones are created up front
+  const Eigen::VectorXd initialPositions = mSkeleton->getPositions();
+  std::vector<dynamics::SkeletonPtr> clones(numTasks);
+  for(dynamics::SkeletonPtr& clone : clones)
+  {
+    clone = mSkeleton->clone();
+    clone->setPositions(initialPositions);
+  }
+
+  const size_t framesPerTask = (numFrames + numTasks - 1) / numTasks;
+  if(numTasks == 1)
+  {
+    fitFrames(clones[0].get(), _markers, 0, 0, numFrames, _output);
+    return true;
+  }
+
+  std::vector<std::future<void>> results;
+  results.reserve(numTasks);
+  for(size_t i = 0; i < numTasks; ++i)
+  {
+    const size_t first = i * framesPerTask;
+    const size_t last = std::min(first + framesPerTask, numFrames);
+    const size_t warmUp = first - std::min(first, mProperties.mNumWarmUpFrames);
+    dynamics::Skeleton* clone = clones[i].get();
+    results.push_back(mThreadPool->submit([&, clone, warmUp, first, last]()
+    {
+      fitFrames(clone, _markers, warmUp, first, last, _output);
+    }));
+  }
+
+  for(std::future<void>& result : results)
+    result.get();
+
+  return true;
+}
+
+//==============================================================================
+void MarkerFitter::fitFrames(
+    dynamics::Skeleton* _skeleton, const FileInfoC3D& _markers,
+    size_t _warmUpFrame, size_t _firstFrame, size_t _lastFrame,
+    const std::function<void(size_t, const Eigen::VectorXd&)>& _output)
+{
+  for(size_t frame = _warmUpFrame; frame < _lastFrame; ++frame)
+  {
+    // Each frame starts from the solution of the previous one
+    const double error = fitFrame(_skeleton, _markers, frame);
+    if(frame < _firstFrame)
+      continue;
+
+    mErrors[frame] = error;
+    _output(frame, _skeleton->getPositions());
+  }
+}
+
+//==============================================================================
+double MarkerFitter::fitFrame(dynamics::Skeleton* _skeleton,
+                              const FileInfoC3D& _markers,
+                              size_t _frame) const
+{
+  const size_t numDofs = _skeleton->getNumDofs();
+
+  Eigen::VectorXd lower(numDofs);
+  Eigen::VectorXd upper(numDofs);
+  for(size_t i = 0; i < numDofs; ++i)
+  {
+    lower[i] = _skeleton->getPositionLowerLimit(i);
+    upper[i] = _skeleton->getPositionUpperLimit(i);
+  }
+
+  // Gather the recorded markers that are visible in this frame
+  std::vector<std::pair<const MarkerInfo*, Eigen::Vector3d>> targets;
+  targets.reserve(mMarkers.size());
+  for(size_t i = 0; i < mMarkers.size(); ++i)
+  {
+    if(mCorrespondences[i] < 0)
+      continue;
+
+    const Eigen::Vector3d target = _markers.getDataAt(_frame,
+                                                      mCorrespondences[i]);
+    if(target.isZero(0.0) || !target.allFinite())
+      continue;
+
+    targets.push_back(std::make_pair(&mMarkers[i], target));
+  }
+
+  if(targets.empty())
+    return 0.0;
+
+  Eigen::MatrixXd J(3 * targets.size(), numDofs);
+  Eigen::VectorXd error(3 * targets.size());
+  const double damping = mProperties.mDampingCoefficient
+                         * mProperties.mDampingCoefficient;
+
+  bool converged = false;
+  for(size_t iteration = 0; ; ++iteration)
+  {
+    for(size_t i = 0; i < targets.size(); ++i)
+    {
+      const MarkerInfo& marker = *targets[i].first;
+      const dynamics::BodyNode* bn = _skeleton->getBodyNode(marker.mBodyNode);
+      error.segment<3>(3 * i) =
+          targets[i].second - bn->getWorldTransform() * marker.mOffset;
+      J.middleRows<3>(3 * i) = _skeleton->getLinearJacobian(bn,
+                                                            marker.mOffset);
+    }
+
+    // The error is always computed for the final positions
+    if(converged || iteration == mProperties.mMaxIterations)
+      break;
+
+    const Eigen::MatrixXd A = J.transpose() * J
+        + damping * Eigen::MatrixXd::Identity(numDofs, numDofs);
+    const Eigen::VectorXd dq = A.ldlt().solve(J.transpose() * error);
+
+    // The Jacobian maps velocities, so the step is integrated like one
+    _skeleton->setVelocities(dq);
+    _skeleton->integratePositions(1.0);
+    _skeleton->setPositions(
+          _skeleton->getPositions().cwiseMax(lower).cwiseMin(upper));
+
+    converged = dq.norm() < mProperties.mTolerance;
+  }
+
+  return std::sqrt(error.squaredNorm() / targets.size());
+}
+
+} // namespace utils
+} // namespace dart
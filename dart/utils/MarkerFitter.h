@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_MARKERFITTER_H_
+#define DART_UTILS_MARKERFITTER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/dynamics/Skeleton.h"
+
+namespace dart {
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace simulation {
+class Recording;
+} // namespace simulation
+
+namespace utils {
+
+class FileInfoC3D;
+class FileInfoDof;
+
+/// MarkerFitter computes the poses of a Skeleton that best match a recorded
+/// marker trajectory. Each frame is solved with damped least squares
+/// iterations over all the Markers of the Skeleton at once, starting from the
+/// solution of the previous frame.
+///
+/// The frames are split into consecutive chunks that are solved in parallel,
+/// each on its own clone of the Skeleton, so the Skeleton itself is never
+/// modified. A chunk that does not start at the first frame is warmed up by
+/// solving a few of the frames before it, so its first frames still start
+/// close to the solution.
+///
+/// Recorded marker positions that are exactly zero or not finite are treated
+/// as occluded and ignored for that frame.
+class MarkerFitter
+{
+public:
+  struct Properties
+  {
+    /// Number of threads that are used to solve the frames. Use 0 for the
+    /// number of hardware threads reported by the system.
+    size_t mNumThreads;
+
+    /// Maximum number of iterations for each frame
+    size_t mMaxIterations;
+
+    /// A frame is solved once an iteration changes the positions by less than
+    /// this amount
+    double mTolerance;
+
+    /// Damping coefficient of the least squares iterations
+    double mDampingCoefficient;
+
+    /// Number of frames that are solved before the start of a chunk to warm
+    /// up its starting pose
+    size_t mNumWarmUpFrames;
+
+    /// Minimum number of frames that are given to a thread
+    size_t mMinFramesPerTask;
+
+    Properties(size_t _numThreads = 0,
+               size_t _maxIterations = 50,
+               double _tolerance = 1e-6,
+               double _dampingCoefficient = 0.01,
+               size_t _numWarmUpFrames = 30,
+               size_t _minFramesPerTask = 100);
+  };
+
+  /// Constructor. The Markers of _skeleton are fitted to the recorded markers
+  /// with the same indices, where the Markers of the Skeleton are ordered by
+  /// the index of their BodyNode and then by their index within the BodyNode.
+  /// Use setCorrespondences() to pair them differently.
+  explicit MarkerFitter(const dynamics::SkeletonPtr& _skeleton,
+                        const Properties& _properties = Properties());
+
+  /// Destructor
+  virtual ~MarkerFitter();
+
+  /// Set the Properties of this MarkerFitter
+  void setProperties(const Properties& _properties);
+
+  /// Get the Properties of this MarkerFitter
+  const Properties& getProperties() const;
+
+  /// Get the number of Markers of the Skeleton
+  size_t getNumMarkers() const;
+
+  /// Get the Marker of the Skeleton with index _index
+  const dynamics::Marker* getMarker(size_t _index) const;
+
+  /// Set the recorded marker that each Marker of the Skeleton is fitted to.
+  /// _recordedIndices[i] is the index of the recorded marker of Marker i, or
+  /// -1 to ignore Marker i.
+  void setCorrespondences(const std::vector<int>& _recordedIndices);
+
+  /// Get the recorded marker that each Marker of the Skeleton is fitted to
+  const std::vector<int>& getCorrespondences() const;
+
+  /// Fit every frame of _markers, starting from the current positions of the
+  /// Skeleton, and write the poses into _dofs, which is resized to the number
+  /// of frames. Returns false if the recording does not contain the recorded
+  /// markers of the correspondences.
+  bool fit(const FileInfoC3D& _markers, FileInfoDof& _dofs);
+
+  /// Same as fit(const FileInfoC3D&, FileInfoDof&), but the poses are
+  /// appended to _recording, which must only record the Skeleton.
+  bool fit(const FileInfoC3D& _markers, simulation::Recording& _recording);
+
+  /// Same as fit(const FileInfoC3D&, FileInfoDof&), but the poses are written
+  /// into _poses.
+  bool fit(const FileInfoC3D& _markers, std::vector<Eigen::VectorXd>& _poses);
+
+  /// Get the root mean square distance between the Markers and the recorded
+  /// markers of each frame of the last fit
+  const std::vector<double>& getErrors() const;
+
+protected:
+  /// Marker of the Skeleton, identified by the index of its BodyNode
+  struct MarkerInfo
+  {
+    size_t mBodyNode;
+    Eigen::Vector3d mOffset;
+    const dynamics::Marker* mMarker;
+  };
+
+  /// Fit every frame of _markers and pass the poses to _output, which may be
+  /// called concurrently for different frames
+  bool solve(const FileInfoC3D& _markers,
+             const std::function<void(size_t, const Eigen::VectorXd&)>&
+                 _output);
+
+  /// Solve the frames [_firstFrame, _lastFrame) on _skeleton, warming up from
+  /// _warmUpFrame
+  void fitFrames(dynamics::Skeleton* _skeleton, const FileInfoC3D& _markers,
+                 size_t _warmUpFrame, size_t _firstFrame, size_t _lastFrame,
+                 const std::function<void(size_t, const Eigen::VectorXd&)>&
+                     _output);
+
+  /// Solve a single frame on _skeleton and return the root mean square error
+  double fitFrame(dynamics::Skeleton* _skeleton, const FileInfoC3D& _markers,
+                  size_t _frame) const;
+
+  /// Skeleton whose Markers are fitted
+  dynamics::SkeletonPtr mSkeleton;
+
+  /// Properties of this MarkerFitter
+  Properties mProperties;
+
+  /// Markers of the Skeleton
+  std::vector<MarkerInfo> mMarkers;
+
+  /// Recorded marker of each Marker of the Skeleton
+  std::vector<int> mCorrespondences;
+
+  /// Errors of the last fit
+  std::vector<double> mErrors;
+
+  /// Threads that solve the chunks. Created by the first fit.
+  std::unique_ptr<common::ThreadPool> mThreadPool;
+};
+
+} // namespace utils
+} // namespace dart
+
+#endif // DART_UTILS_MARKERFITTER_H_
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/MeshLoading.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dart/common/Console.h"
+#include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/MeshCache.h"
+#include "dart/dynamics/MeshShape.h"
+#include "dart/math/MathTypes.h"
+
+namespace dart {
+namespace utils {
+
+namespace {
+
+//==============================================================================
+/// Returns the shapes in _shapes whose meshes have failed to load. Waits for
+/// the meshes that are still being loaded, unless _skipUnready is true, in
+/// which case only the meshes that have already arrived are checked.
+std::vector<dynamics::ShapePtr> getFailedMeshShapes(
+    const std::vector<dynamics::ShapePtr>& _shapes, bool _skipUnready)
+{
+  std::vector<dynamics::ShapePtr> failed;
+  for(const dynamics::ShapePtr& shape : _shapes)
+  {
+    if(dynamics::Shape::MESH != shape->getShapeType())
+      continue;
+
+    const auto meshShape
+        = std::dynamic_pointer_cast<dynamics::MeshShape>(shape);
+    if(!meshShape || (_skipUnready && !meshShape->isReady()))
+      continue;
+
+    if(!meshShape->getMesh())
+    {
+      dtwarn << "[finishLoadingMeshes] Failed to load mesh ["
+             << meshShape->getMeshUri() << "]. The shape is removed.\n";
+      failed.push_back(shape);
+    }
+  }
+
+  return failed;
+}
+
+//==============================================================================
+/// The shapes whose moments of inertia are computed by finishLoadingMeshes().
+/// The parsers of different threads may defer them at the same time.
+class DeferredInertias
+{
+public:
+
+  /// Remember _shape
+  void add(const dynamics::ShapePtr& _shape)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Forget the shapes of skeletons that have never been finished, e.g.
+    // because they could not be parsed
+    for(auto it = mShapes.begin(); it != mShapes.end();)
+    {
+      if(it->second.expired())
+        it = mShapes.erase(it);
+      else
+        ++it;
+    }
+
+    mShapes[_shape.get()] = _shape;
+  }
+
+  /// Returns true and forgets _shape if it has been added
+  bool take(const dynamics::ShapePtr& _shape)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto it = mShapes.find(_shape.get());
+    if(it == mShapes.end())
+      return false;
+
+    // The address may belong to a shape that has been destroyed since
+    const bool found = it->second.lock() == _shape;
+    mShapes.erase(it);
+    return found;
+  }
+
+private:
+
+  std::mutex mMutex;
+
+  std::unordered_map<const dynamics::Shape*,
+                     std::weak_ptr<dynamics::Shape>> mShapes;
+};
+
+//==============================================================================
+DeferredInertias& getDeferredInertias()
+{
+  static DeferredInertias deferred;
+  return deferred;
+}
+
+//==============================================================================
+/// Set the moment of inertia of _bodyNode from _shape once its mesh has been
+/// loaded
+void computeDeferredInertia(dynamics::BodyNode* _bodyNode,
+                            const dynamics::ShapePtr& _shape)
+{
+  if(dynamics::Shape::MESH == _shape->getShapeType())
+  {
+    const auto meshShape
+        = std::dynamic_pointer_cast<dynamics::MeshShape>(_shape);
+    if(meshShape && !meshShape->getMesh())
+    {
+      dtwarn << "[finishLoadingMeshes] Cannot compute the moment of inertia "
+             << "of BodyNode [" << _bodyNode->getName() << "], because its "
+             << "mesh [" << meshShape->getMeshUri() << "] failed to load.\n";
+      return;
+    }
+  }
+
+  const Eigen::Matrix3d moment = _shape->computeInertia(_bodyNode->getMass());
+  _bodyNode->setMomentOfInertia(moment(0, 0), moment(1, 1), moment(2, 2),
+                                moment(0, 1), moment(0, 2), moment(1, 2));
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool computeMomentOfInertia(const dynamics::ShapePtr& _shape, double _mass,
+                            Eigen::Matrix3d& _moment)
+{
+  if(dynamics::Shape::MESH == _shape->getShapeType())
+  {
+    const auto meshShape
+        = std::dynamic_pointer_cast<dynamics::MeshShape>(_shape);
+    if(meshShape && !meshShape->isReady())
+    {
+      getDeferredInertias().add(_shape);
+      return false;
+    }
+
+    if(meshShape && !meshShape->getMesh())
+    {
+      dtwarn << "[computeMomentOfInertia] Cannot compute a moment of inertia "
+             << "from mesh [" << meshShape->getMeshUri() << "], because it "
+             << "failed to load.\n";
+      return false;
+    }
+  }
+
+  _moment = _shape->computeInertia(_mass);
+  return true;
+}
+
+//==============================================================================
+dynamics::ShapePtr createMeshShape(
+    const Eigen::Vector3d& _scale,
+    const std::string& _uri,
+    const common::ResourceRetrieverPtr& _retriever,
+    bool _isVisual)
+{
+  const dynamics::MeshCache::LoadingMode mode
+      = dynamics::MeshCache::getInstance().getLoadingMode();
+
+  if(dynamics::MeshCache::LOAD_IMMEDIATELY == mode)
+  {
+    const aiScene* model = dynamics::MeshShape::loadMesh(_uri, _retriever);
+    if(!model)
+      return nullptr;
+
+    return Eigen::make_aligned_shared<dynamics::MeshShape>(
+          _scale, model, _uri, _retriever);
+  }
+
+  const auto shape
+      = Eigen::make_aligned_shared<dynamics::MeshShape>(_scale, nullptr);
+  if(_isVisual && dynamics::MeshCache::LOAD_VISUALS_LAZILY == mode)
+    shape->setMeshLazy(_uri, _retriever);
+  else
+    shape->setMeshAsync(_uri, _retriever);
+
+  return shape;
+}
+
+//==============================================================================
+void finishLoadingMeshes(const dynamics::SkeletonPtr& _skeleton)
+{
+  if(!_skeleton)
+    return;
+
+  const bool lazyVisuals = dynamics::MeshCache::LOAD_VISUALS_LAZILY
+      == dynamics::MeshCache::getInstance().getLoadingMode();
+
+  for(size_t i = 0; i < _skeleton->getNumBodyNodes(); ++i)
+  {
+    dynamics::BodyNode* bodyNode = _skeleton->getBodyNode(i);
+
+    if(bodyNode->getNumVisualizationShapes() > 0)
+    {
+      // The moment of inertia comes from the same shape in every loading
+      // mode, so a deferred visual mesh is loaded here for its bounding box
+      const dynamics::ShapePtr& shape = bodyNode->getVisualizationShape(0);
+      if(getDeferredInertias().take(shape))
+        computeDeferredInertia(bodyNode, shape);
+    }
+
+    for(const dynamics::ShapePtr& shape : getFailedMeshShapes(
+          bodyNode->getVisualizationShapes(), lazyVisuals))
+      bodyNode->removeVisualizationShape(shape);
+
+    std::vector<dynamics::ShapePtr> colShapes;
+    for(size_t j = 0; j < bodyNode->getNumCollisionShapes(); ++j)
+      colShapes.push_back(bodyNode->getCollisionShape(j));
+
+    for(const dynamics::ShapePtr& shape : getFailedMeshShapes(
+          colShapes, false))
+      bodyNode->removeCollisionShape(shape);
+  }
+}
+
+} // namespace utils
+} // namespace dart
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_MESHLOADING_H_
+#define DART_UTILS_MESHLOADING_H_
+
+#include <string>
+
+#include <Eigen/Dense>
+
+#include "dart/common/ResourceRetriever.h"
+#include "dart/dynamics/Shape.h"
+#include "dart/dynamics/Skeleton.h"
+
+namespace dart {
+namespace utils {
+
+/// Create a MeshShape for the mesh at _uri, as the parsers do. Depending on
+/// dynamics::MeshCache::getLoadingMode(), the mesh is loaded right away,
+/// scheduled on the thread pool of the MeshCache, or, if _isVisual is true,
+/// deferred until the shape is first drawn. Returns a nullptr if the mesh is
+/// loaded right away and fails to load.
+dynamics::ShapePtr createMeshShape(
+    const Eigen::Vector3d& _scale,
+    const std::string& _uri,
+    const common::ResourceRetrieverPtr& _retriever,
+    bool _isVisual);
+
+/// Compute the moment of inertia of a body with _mass from _shape, as the
+/// parsers do for bodies that do not specify one. If _shape is a mesh that has
+/// not been loaded yet, this returns false instead of waiting for the mesh,
+/// and the moment of inertia is computed by finishLoadingMeshes() for the
+/// BodyNode whose first visualization shape is _shape. Also returns false,
+/// with a warning, if the mesh of _shape has failed to load.
+bool computeMomentOfInertia(const dynamics::ShapePtr& _shape, double _mass,
+                            Eigen::Matrix3d& _moment);
+
+/// Wait for the meshes of _skeleton that are still being loaded, and remove
+/// the shapes whose meshes have failed to load. Visual meshes that are
+/// deferred until they are first drawn are left alone.
+///
+/// The moments of inertia that computeMomentOfInertia() could not compute are
+/// computed here, from the first visualization shape of the BodyNode, as in
+/// every other loading mode. If that mesh is deferred until it is first drawn,
+/// it is loaded now. A BodyNode whose mesh fails to load keeps its current
+/// moment of inertia and a warning is printed.
+void finishLoadingMeshes(const dynamics::SkeletonPtr& _skeleton);
+
+} // namespace utils
+} // namespace dart
+
+#endif // DART_UTILS_MESHLOADING_H_
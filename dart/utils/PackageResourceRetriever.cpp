@@ -52,7 +52,7 @@ PackageResourceRetriever::PackageResourceRetriever(
   if (localRetriever)
     mLocalRetriever = localRetriever;
   else
-    mLocalRetriever = std::make_shared<common::LocalResourceRetriever>();
+    mLocalRetriever = common::LocalResourceRetriever::getDefault();
 }
 
 //==============================================================================
@@ -595,7 +595,7 @@ void openXMLFile(
   if(_retriever)
     retriever = _retriever;
   else
-    retriever = std::make_shared<common::LocalResourceRetriever>();
+    retriever = common::LocalResourceRetriever::getDefault();
 
   const common::ResourcePtr resource = retriever->retrieve(uri);
   if(!resource)
@@ -70,6 +70,7 @@
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/Marker.h"
 #include "dart/simulation/World.h"
+#include "dart/utils/MeshLoading.h"
 #include "dart/utils/SkelParser.h"
 #include "dart/common/LocalResourceRetriever.h"
 #include "dart/common/Uri.h"
@@ -208,6 +209,7 @@ dynamics::SkeletonPtr SkelParser::readSkeleton(
 
   dynamics::SkeletonPtr newSkeleton = readSkeleton(
     skeletonElement, _fileUri, retriever);
+  finishLoadingMeshes(newSkeleton);
 
   return newSkeleton;
 }
@@ -290,13 +292,20 @@ simulation::WorldPtr SkelParser::readWorld(
   }
 
   //--------------------------------------------------------------------------
-  // Load soft skeletons
+  // Load soft skeletons. The meshes are loaded in the background while the
+  // remaining skeletons are being read, so the skeletons are only added to
+  // the world once all of them have been read.
+  std::vector<dynamics::SkeletonPtr> newSkeletons;
   ElementEnumerator SkeletonElements(_worldElement, "skeleton");
   while (SkeletonElements.next())
   {
-    dynamics::SkeletonPtr newSkeleton
-        = readSkeleton(SkeletonElements.get(), _baseUri, _retriever);
+    newSkeletons.push_back(
+          readSkeleton(SkeletonElements.get(), _baseUri, _retriever));
+  }
 
+  for (const dynamics::SkeletonPtr& newSkeleton : newSkeletons)
+  {
+    finishLoadingMeshes(newSkeleton);
     newWorld->addSkeleton(newSkeleton);
   }
 
@@ -619,7 +628,7 @@ SkelParser::SkelBodyNode SkelParser::readBodyNode(
   while (vizShapes.next())
   {
     dynamics::ShapePtr newShape = readShape(
-      vizShapes.get(), newBodyNode->mName, _baseUri, _retriever);
+      vizShapes.get(), newBodyNode->mName, _baseUri, _retriever, true);
 
     if(newShape)
       newBodyNode->mVizShapes.push_back(newShape);
@@ -631,7 +640,7 @@ SkelParser::SkelBodyNode SkelParser::readBodyNode(
   while (collShapes.next())
   {
     dynamics::ShapePtr newShape = readShape(
-      collShapes.get(), newBodyNode->mName, _baseUri, _retriever);
+      collShapes.get(), newBodyNode->mName, _baseUri, _retriever, false);
 
     if(newShape)
       newBodyNode->mColShapes.push_back(newShape);
@@ -666,10 +675,11 @@ SkelParser::SkelBodyNode SkelParser::readBodyNode(
     }
     else if (newBodyNode->mVizShapes.size() > 0)
     {
-      Eigen::Matrix3d Ic =
-          newBodyNode->mVizShapes[0]->computeInertia(mass);
-
-      newBodyNode->mInertia.setMoment(Ic);
+      // A mesh that is still being loaded is not waited for here. Its moment
+      // of inertia is computed by finishLoadingMeshes() instead.
+      Eigen::Matrix3d Ic;
+      if (computeMomentOfInertia(newBodyNode->mVizShapes[0], mass, Ic))
+        newBodyNode->mInertia.setMoment(Ic);
     }
 
     // offset
@@ -813,7 +823,8 @@ dynamics::ShapePtr SkelParser::readShape(
     tinyxml2::XMLElement* vizEle,
     const std::string& bodyName,
     const common::Uri& _baseUri,
-    const common::ResourceRetrieverPtr& _retriever)
+    const common::ResourceRetrieverPtr& _retriever,
+    bool _isVisual)
 {
   dynamics::ShapePtr newShape;
 
@@ -866,13 +877,8 @@ dynamics::ShapePtr SkelParser::readShape(
     Eigen::Vector3d       scale        = getValueVector3d(meshEle, "scale");
 
     const std::string meshUri = common::Uri::getRelativeUri(_baseUri, filename);
-    const aiScene* model = dynamics::MeshShape::loadMesh(meshUri, _retriever);
-    if (model)
-    {
-      newShape = std::make_shared<dynamics::MeshShape>(
-        scale, model, meshUri, _retriever);
-    }
-    else
+    newShape = createMeshShape(scale, meshUri, _retriever, _isVisual);
+    if (!newShape)
     {
       dterr << "Fail to load model[" << filename << "]." << std::endl;
     }
@@ -1993,7 +1999,7 @@ common::ResourceRetrieverPtr SkelParser::getRetriever(
   if(_retriever)
     return _retriever;
   else
-    return std::make_shared<common::LocalResourceRetriever>();
+    return common::LocalResourceRetriever::getDefault();
 }
 
 }  // namespace utils
@@ -167,7 +167,8 @@ protected:
       tinyxml2::XMLElement* _shapeElement,
       const std::string& bodyName,
       const common::Uri& _baseUri,
-      const common::ResourceRetrieverPtr& _retriever);
+      const common::ResourceRetrieverPtr& _retriever,
+      bool _isVisual);
 
   /// Read marker
   static dynamics::Marker::Properties readMarker(
@@ -1,6 +1,7 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "dart/common/Console.h"
 #include "dart/dynamics/BodyNode.h"
@@ -19,6 +20,7 @@
 #include "dart/dynamics/UniversalJoint.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
+#include "dart/utils/MeshLoading.h"
 #include "dart/utils/SkelParser.h"
 #include "dart/common/LocalResourceRetriever.h"
 #include "dart/common/Uri.h"
@@ -156,6 +158,7 @@ dynamics::SkeletonPtr SdfParser::readSkeleton(
 
   dynamics::SkeletonPtr newSkeleton = xmlReader(skelElement, skelPath,
                                                 _retriever);
+  finishLoadingMeshes(newSkeleton);
 
   return newSkeleton;
 }
@@ -198,13 +201,20 @@ simulation::WorldPtr SdfParser::readWorld(
   }
 
   //--------------------------------------------------------------------------
-  // Load skeletons
+  // Load skeletons. The meshes are loaded in the background while the
+  // remaining skeletons are being read, so the skeletons are only added to
+  // the world once all of them have been read.
+  std::vector<dynamics::SkeletonPtr> newSkeletons;
   ElementEnumerator skeletonElements(_worldElement, "model");
   while (skeletonElements.next())
   {
-    dynamics::SkeletonPtr newSkeleton
-            = skeletonReader(skeletonElements.get(), _skelPath, _retriever);
+    newSkeletons.push_back(
+          skeletonReader(skeletonElements.get(), _skelPath, _retriever));
+  }
 
+  for (const dynamics::SkeletonPtr& newSkeleton : newSkeletons)
+  {
+    finishLoadingMeshes(newSkeleton);
     newWorld->addSkeleton(newSkeleton);
   }
 
@@ -504,7 +514,8 @@ SdfParser::SDFBodyNode SdfParser::readBodyNode(
   ElementEnumerator vizShapes(_bodyNodeElement, "visual");
   while (vizShapes.next())
   {
-    dynamics::ShapePtr newShape(readShape(vizShapes.get(), _skelPath, _retriever));
+    dynamics::ShapePtr newShape(
+          readShape(vizShapes.get(), _skelPath, _retriever, true));
     if (newShape)
       properties.mVizShapes.push_back(newShape);
   }
@@ -514,7 +525,8 @@ SdfParser::SDFBodyNode SdfParser::readBodyNode(
   ElementEnumerator collShapes(_bodyNodeElement, "collision");
   while (collShapes.next())
   {
-    dynamics::ShapePtr newShape(readShape(collShapes.get(), _skelPath, _retriever));
+    dynamics::ShapePtr newShape(
+          readShape(collShapes.get(), _skelPath, _retriever, false));
 
     if (newShape)
       properties.mColShapes.push_back(newShape);
@@ -559,12 +571,15 @@ SdfParser::SDFBodyNode SdfParser::readBodyNode(
     else if (properties.mVizShapes.size() > 0
              && properties.mVizShapes[0] != nullptr)
     {
-      Eigen::Matrix3d Ic =
-          properties.mVizShapes[0]->computeInertia(
-            properties.mInertia.getMass());
-
-      properties.mInertia.setMoment(Ic(0,0), Ic(1,1), Ic(2,2),
-                                    Ic(0,1), Ic(0,2), Ic(1,2));
+      // A mesh that is still being loaded is not waited for here. Its moment
+      // of inertia is computed by finishLoadingMeshes() instead.
+      Eigen::Matrix3d Ic;
+      if (computeMomentOfInertia(properties.mVizShapes[0],
+                                 properties.mInertia.getMass(), Ic))
+      {
+        properties.mInertia.setMoment(Ic(0,0), Ic(1,1), Ic(2,2),
+                                      Ic(0,1), Ic(0,2), Ic(1,2));
+      }
     }
   }
 
@@ -579,7 +594,8 @@ SdfParser::SDFBodyNode SdfParser::readBodyNode(
 dynamics::ShapePtr SdfParser::readShape(
   tinyxml2::XMLElement* _shapelement,
   const std::string& _skelPath,
-  const common::ResourceRetrieverPtr& _retriever)
+  const common::ResourceRetrieverPtr& _retriever,
+  bool _isVisual)
 {
   dynamics::ShapePtr newShape;
 
@@ -643,12 +659,9 @@ dynamics::ShapePtr SdfParser::readShape(
           getValueVector3d(meshEle, "scale") : Eigen::Vector3d::Ones();
 
     const std::string meshUri = common::Uri::getRelativeUri(_skelPath, uri);
-    const aiScene* model = dynamics::MeshShape::loadMesh(meshUri, _retriever);
+    newShape = createMeshShape(scale, meshUri, _retriever, _isVisual);
 
-    if (model)
-      newShape = std::make_shared<dynamics::MeshShape>(
-        scale, model, meshUri, _retriever);
-    else
+    if (!newShape)
     {
       dtwarn << "[SdfParser::readShape] Failed to load mesh model ["
              << meshUri << "].\n";
@@ -1112,7 +1125,7 @@ common::ResourceRetrieverPtr SdfParser::getResourceRetriever(
   if(_retriever)
     return _retriever;
   else
-    return std::make_shared<common::LocalResourceRetriever>();
+    return common::LocalResourceRetriever::getDefault();
 }
 
 } // namespace utils
@@ -234,7 +234,8 @@ public:
     static dynamics::ShapePtr readShape(
             tinyxml2::XMLElement* _shapelement,
             const std::string& _skelPath,
-            const common::ResourceRetrieverPtr& _retriever);
+            const common::ResourceRetrieverPtr& _retriever,
+            bool _isVisual);
 
     /// \brief
     static JointMap readAllJoints(
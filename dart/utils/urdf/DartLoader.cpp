@@ -3,6 +3,7 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <type_traits>
 
 #include <urdf_parser/urdf_parser.h>
 #include <urdf_world/world.h>
@@ -21,6 +22,7 @@
 #include "dart/dynamics/CylinderShape.h"
 #include "dart/dynamics/MeshShape.h"
 #include "dart/simulation/World.h"
+#include "dart/utils/MeshLoading.h"
 #include "dart/utils/urdf/urdf_world_parser.h"
 
 using ModelInterfacePtr = boost::shared_ptr<urdf::ModelInterface>;
@@ -29,7 +31,7 @@ namespace dart {
 namespace utils {
 
 DartLoader::DartLoader()
-  : mLocalRetriever(new common::LocalResourceRetriever),
+  : mLocalRetriever(common::LocalResourceRetriever::getDefault()),
     mPackageRetriever(new utils::PackageResourceRetriever(mLocalRetriever)),
     mRetriever(new utils::CompositeResourceRetriever)
 {
@@ -215,6 +217,8 @@ dynamics::SkeletonPtr DartLoader::modelInterfaceToSkeleton(
 
   }
 
+  finishLoadingMeshes(skeleton);
+
   return skeleton;
 }
 
@@ -486,14 +490,11 @@ dynamics::ShapePtr DartLoader::createShape(
 
     // Load the mesh.
     const std::string resolvedUri = absoluteUri.toString();
-    const aiScene* scene = dynamics::MeshShape::loadMesh(
-      resolvedUri, _resourceRetriever);
-    if (!scene)
-      return nullptr;
-
     const Eigen::Vector3d scale(mesh->scale.x, mesh->scale.y, mesh->scale.z);
-    shape = Eigen::make_aligned_shared<dynamics::MeshShape>(
-      scale, scene, resolvedUri, _resourceRetriever);
+    shape = createMeshShape(scale, resolvedUri, _resourceRetriever,
+      std::is_same<VisualOrCollision, urdf::Visual>::value);
+    if (!shape)
+      return nullptr;
   }
   // Unknown geometry type
   else
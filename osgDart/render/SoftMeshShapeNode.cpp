@@ -34,6 +34,8 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+
 #include <osg/Geode>
 #include <osg/Geometry>
 
@@ -88,6 +90,9 @@ protected:
 
   dart::dynamics::SoftMeshShape* mSoftMeshShape;
 
+  /// Vertex version of mSoftMeshShape that mVertices was last updated to
+  size_t mVertexVersion;
+
 };
 
 //==============================================================================
@@ -185,18 +190,20 @@ SoftMeshShapeDrawable::SoftMeshShapeDrawable(
   : mVertices(new osg::Vec3Array),
     mNormals(new osg::Vec3Array),
     mColors(new osg::Vec4Array),
-    mSoftMeshShape(shape)
+    mSoftMeshShape(shape),
+    mVertexVersion(0)
 {
   refresh(true);
 }
 
-static Eigen::Vector3d normalFromVertex(const dart::dynamics::SoftBodyNode* bn,
-                                        const Eigen::Vector3i& face,
-                                        size_t v)
+static Eigen::Vector3d normalFromVertex(
+    const std::vector<Eigen::Vector3d>& vertices,
+    const Eigen::Vector3i& face,
+    size_t v)
 {
-  const Eigen::Vector3d& v0 = bn->getPointMass(face[v])->getLocalPosition();
-  const Eigen::Vector3d& v1 = bn->getPointMass(face[(v+1)%3])->getLocalPosition();
-  const Eigen::Vector3d& v2 = bn->getPointMass(face[(v+2)%3])->getLocalPosition();
+  const Eigen::Vector3d& v0 = vertices[face[v]];
+  const Eigen::Vector3d& v1 = vertices[face[(v+1)%3]];
+  const Eigen::Vector3d& v2 = vertices[face[(v+2)%3]];
 
   const Eigen::Vector3d dv1 = v1-v0;
   const Eigen::Vector3d dv2 = v2-v0;
@@ -209,6 +216,7 @@ static Eigen::Vector3d normalFromVertex(const dart::dynamics::SoftBodyNode* bn,
 }
 
 static void computeNormals(std::vector<Eigen::Vector3d>& normals,
+                           const std::vector<Eigen::Vector3d>& vertices,
                            const dart::dynamics::SoftBodyNode* bn)
 {
   for(size_t i=0; i<normals.size(); ++i)
@@ -218,7 +226,7 @@ static void computeNormals(std::vector<Eigen::Vector3d>& normals,
   {
     const Eigen::Vector3i& face = bn->getFace(i);
     for(size_t j=0; j<3; ++j)
-      normals[face[j]] += normalFromVertex(bn, face, j);
+      normals[face[j]] += normalFromVertex(vertices, face, j);
   }
 
   for(size_t i=0; i<normals.size(); ++i)
@@ -252,25 +260,49 @@ void SoftMeshShapeDrawable::refresh(bool firstTime)
     addPrimitiveSet(elements);
   }
 
-  if(   mSoftMeshShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_VERTICES)
-     || mSoftMeshShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_ELEMENTS)
-     || firstTime)
+  // The vertices are read straight from the PointMass buffer of the
+  // SoftBodyNode, and only when they have moved since the last refresh
+  const std::vector<Eigen::Vector3d>& vertices = mSoftMeshShape->getVertices();
+  const size_t version = mSoftMeshShape->getVertexVersion();
+  if(   firstTime
+     || mVertices->size() != vertices.size()
+     || (version != mVertexVersion && (
+           mSoftMeshShape->checkDataVariance(
+             dart::dynamics::Shape::DYNAMIC_VERTICES)
+        || mSoftMeshShape->checkDataVariance(
+             dart::dynamics::Shape::DYNAMIC_ELEMENTS))))
   {
-    if(mVertices->size() != bn->getNumPointMasses())
-      mVertices->resize(bn->getNumPointMasses());
+    // Only the vertices of the latest change need to be copied if the
+    // previous version has already been copied
+    size_t first = 0;
+    size_t last = vertices.size();
+    if(!firstTime && mVertices->size() == vertices.size()
+       && mVertexVersion + 1 == version)
+    {
+      first = mSoftMeshShape->getDirtyVertices().first;
+      last = std::min(last, mSoftMeshShape->getDirtyVertices().second);
+    }
 
-    if(mNormals->size() != bn->getNumPointMasses())
-      mNormals->resize(bn->getNumPointMasses());
+    if(mVertices->size() != vertices.size())
+      mVertices->resize(vertices.size());
 
-    if(mEigNormals.size() != bn->getNumPointMasses())
-      mEigNormals.resize(bn->getNumPointMasses());
+    if(mNormals->size() != vertices.size())
+      mNormals->resize(vertices.size());
 
-    computeNormals(mEigNormals, bn);
-    for(size_t i=0; i<bn->getNumPointMasses(); ++i)
-    {
-      (*mVertices)[i] = eigToOsgVec3(bn->getPointMass(i)->getLocalPosition());
+    if(mEigNormals.size() != vertices.size())
+      mEigNormals.resize(vertices.size());
+
+    for(size_t i=first; i<last; ++i)
+      (*mVertices)[i] = eigToOsgVec3(vertices[i]);
+
+    // Normals depend on the neighboring vertices, so they are all recomputed
+    computeNormals(mEigNormals, vertices, bn);
+    for(size_t i=0; i<vertices.size(); ++i)
       (*mNormals)[i] = eigToOsgVec3(mEigNormals[i]);
-    }
+
+    mVertices->dirty();
+    mNormals->dirty();
+    mVertexVersion = version;
 
     setVertexArray(mVertices);
     setNormalArray(mNormals, osg::Array::BIND_PER_VERTEX);
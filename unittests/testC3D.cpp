@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "dart/common/ThreadPool.h"
+#include "dart/utils/C3D.h"
+#include "dart/utils/C3DReader.h"
+#include "TestHelpers.h"
+
+using namespace dart;
+using namespace utils;
+
+//==============================================================================
+/// Returns the absolute path of _name in the working directory
+std::string getTestPath(const std::string& _name)
+{
+  char directory[4096];
+  if(!getcwd(directory, sizeof(directory)))
+    return _name;
+
+  return std::string(directory) + "/" + _name;
+}
+
+//==============================================================================
+Eigen::EIGEN_VV_VEC3D createTrajectories(size_t _numFrames, size_t _numMarkers)
+{
+  Eigen::EIGEN_VV_VEC3D data(_numFrames);
+  for(size_t i = 0; i < _numFrames; ++i)
+  {
+    data[i].resize(_numMarkers);
+    for(size_t j = 0; j < _numMarkers; ++j)
+      data[i][j] = Eigen::Vector3d(0.001 * i, 0.01 * j, -0.5 * j);
+  }
+
+  return data;
+}
+
+//==============================================================================
+TEST(C3D, ReaderMatchesLoader)
+{
+  const std::string path = DART_DATA_PATH "c3d/squat.c3d";
+
+  Eigen::EIGEN_VV_VEC3D data;
+  int numFrames;
+  int numMarkers;
+  double frameRate;
+  ASSERT_TRUE(loadC3DFile(path.c_str(), data, &numFrames, &numMarkers,
+                          &frameRate));
+  EXPECT_EQ(2539, numFrames);
+  EXPECT_EQ(53, numMarkers);
+  EXPECT_EQ(120.0, frameRate);
+
+  const Eigen::Vector3d expected(1.4624866943359376, -0.16403488159179688,
+                                 0.03227259445190429);
+  EXPECT_TRUE(equals(expected, data[1000][5], 1e-12));
+
+  C3DReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(2539u, reader.getNumFrames());
+  EXPECT_EQ(53u, reader.getNumMarkers());
+
+  for(size_t i = 0; i < reader.getNumFrames(); i += 97)
+  {
+    for(size_t j = 0; j < reader.getNumMarkers(); ++j)
+      EXPECT_TRUE(equals(data[i][j], reader.getPosition(i, j), 0.0));
+  }
+}
+
+//==============================================================================
+TEST(C3D, SaveAndRead)
+{
+  const std::string path = getTestPath("testC3D.c3d");
+  Eigen::EIGEN_VV_VEC3D data = createTrajectories(100, 7);
+  ASSERT_TRUE(saveC3DFile(path.c_str(), data, 100, 7, 60.0));
+
+  C3DReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(100u, reader.getNumFrames());
+  EXPECT_EQ(7u, reader.getNumMarkers());
+  EXPECT_EQ(60.0, reader.getFrameRate());
+
+  C3DFrames frames;
+  EXPECT_FALSE(reader.readFrames(90, 11, frames));
+  ASSERT_TRUE(reader.readFrames(10, 20, frames));
+  EXPECT_EQ(10u, frames.mFirstFrame);
+  EXPECT_EQ(20u, frames.mNumFrames);
+  EXPECT_EQ(140u, frames.mX.size());
+
+  for(size_t i = 10; i < 30; ++i)
+  {
+    for(size_t j = 0; j < 7; ++j)
+    {
+      EXPECT_TRUE(equals(data[i][j], frames.getPosition(i, j), 1e-6));
+      EXPECT_TRUE(equals(frames.getPosition(i, j),
+                         reader.getPosition(i, j), 0.0));
+    }
+  }
+
+  reader.close();
+  EXPECT_FALSE(reader.isOpen());
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+TEST(C3D, ParallelDecoding)
+{
+  // More frames than the 16-bit frame numbers of the header can describe
+  const size_t numFrames = 70000;
+  const std::string path = getTestPath("testC3D.c3d");
+  Eigen::EIGEN_VV_VEC3D data = createTrajectories(numFrames, 2);
+  ASSERT_TRUE(saveC3DFile(path.c_str(), data, numFrames, 2, 120.0));
+
+  C3DReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(numFrames, reader.getNumFrames());
+
+  C3DFrames serial;
+  ASSERT_TRUE(reader.readFrames(0, numFrames, serial));
+
+  common::ThreadPool threadPool(4);
+  C3DFrames parallel;
+  ASSERT_TRUE(reader.readFrames(0, numFrames, parallel, &threadPool));
+
+  EXPECT_TRUE(serial.mX == parallel.mX);
+  EXPECT_TRUE(serial.mY == parallel.mY);
+  EXPECT_TRUE(serial.mZ == parallel.mZ);
+  EXPECT_TRUE(equals(data[numFrames - 1][1],
+                     parallel.getPosition(numFrames - 1, 1), 1e-3));
+
+  reader.close();
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include "dart/common/LocalResourceRetriever.h"
+#include "dart/utils/CachingResourceRetriever.h"
+#include "TestHelpers.h"
+
+using dart::common::Uri;
+using dart::common::LocalResourceRetriever;
+using dart::utils::CachingResourceRetriever;
+
+TEST(CachingResourceRetriever, exists_RemembersResult)
+{
+  auto present = std::make_shared<PresentResourceRetriever>();
+  auto absent = std::make_shared<AbsentResourceRetriever>();
+  CachingResourceRetriever presentCache(present);
+  CachingResourceRetriever absentCache(absent);
+
+  EXPECT_TRUE(presentCache.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_TRUE(presentCache.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(1u, present->mExists.size());
+
+  EXPECT_FALSE(absentCache.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_FALSE(absentCache.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(1u, absent->mExists.size());
+}
+
+TEST(CachingResourceRetriever, retrieve_RemembersMissingResources)
+{
+  auto absent = std::make_shared<AbsentResourceRetriever>();
+  CachingResourceRetriever retriever(absent);
+
+  EXPECT_EQ(nullptr, retriever.retrieve(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(nullptr, retriever.retrieve(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(1u, absent->mRetrieve.size());
+  EXPECT_FALSE(retriever.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_TRUE(absent->mExists.empty());
+
+  retriever.clear();
+  EXPECT_EQ(0u, retriever.getNumEntries());
+  EXPECT_EQ(nullptr, retriever.retrieve(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(2u, absent->mRetrieve.size());
+}
+
+TEST(CachingResourceRetriever, retrieve_SharesContent)
+{
+  const std::string content = "Hello World";
+  const Uri uri = Uri::createFromPath(DART_DATA_PATH "test/hello_world.txt");
+
+  CachingResourceRetriever retriever(
+    std::make_shared<LocalResourceRetriever>());
+
+  auto resource1 = retriever.retrieve(uri);
+  auto resource2 = retriever.retrieve(uri);
+  ASSERT_TRUE(resource1 != nullptr);
+  ASSERT_TRUE(resource2 != nullptr);
+  EXPECT_EQ(1u, retriever.getNumEntries());
+  EXPECT_EQ(uri.toString().size() + content.size(), retriever.getSize());
+
+  // Both resources share the cached content, but have their own position.
+  ASSERT_TRUE(resource1->getData() != nullptr);
+  EXPECT_EQ(resource1->getData(), resource2->getData());
+  EXPECT_EQ(content, std::string(resource1->getData(), resource1->getSize()));
+
+  std::vector<char> buffer(content.size() + 1, '\0');
+  ASSERT_EQ(1u, resource1->read(buffer.data(), 6, 1));
+  EXPECT_EQ(6u, resource1->tell());
+  EXPECT_EQ(0u, resource2->tell());
+  ASSERT_EQ(1u, resource1->read(buffer.data() + 6, 5, 1));
+  EXPECT_STREQ(content.c_str(), buffer.data());
+}
+
+TEST(CachingResourceRetriever, retrieve_DropsLeastRecentlyUsed)
+{
+  auto present = std::make_shared<PresentResourceRetriever>();
+  const Uri uri1 = Uri::createFromString("package://test/1");
+  const Uri uri2 = Uri::createFromString("package://test/2");
+  const Uri uri3 = Uri::createFromString("package://test/3");
+
+  // There is enough room for two of the URIs.
+  CachingResourceRetriever retriever(present, 2u * uri1.toString().size());
+
+  EXPECT_TRUE(retriever.retrieve(uri1) != nullptr);
+  EXPECT_TRUE(retriever.retrieve(uri2) != nullptr);
+  EXPECT_TRUE(retriever.retrieve(uri1) != nullptr);
+  EXPECT_EQ(2u, present->mRetrieve.size());
+
+  // The second URI is the least recently used one.
+  EXPECT_TRUE(retriever.retrieve(uri3) != nullptr);
+  EXPECT_EQ(2u, retriever.getNumEntries());
+  EXPECT_TRUE(retriever.retrieve(uri1) != nullptr);
+  EXPECT_EQ(3u, present->mRetrieve.size());
+  EXPECT_TRUE(retriever.retrieve(uri2) != nullptr);
+  EXPECT_EQ(4u, present->mRetrieve.size());
+
+  retriever.setCapacity(0u);
+  EXPECT_EQ(0u, retriever.getNumEntries());
+  EXPECT_EQ(0u, retriever.getSize());
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -35,6 +35,7 @@
  */
 
 #include <iostream>
+#include <limits>
 #include <gtest/gtest.h>
 
 #include <fcl/collision.h>
@@ -48,6 +49,13 @@
 //#include "dart/collision/unc/UNCCollisionDetector.h"
 #include "dart/simulation/simulation.h"
 #include "dart/utils/utils.h"
+#include "dart/collision/dart/DARTCollisionDetector.h"
+#include "dart/collision/dart/DARTDistance.h"
+#include "dart/collision/fcl/FCLCollisionDetector.h"
+#include "dart/collision/fcl_mesh/FCLMeshCollisionDetector.h"
+#ifdef HAVE_BULLET_COLLISION
+  #include "dart/collision/bullet/BulletCollisionDetector.h"
+#endif
 
 using namespace dart;
 using namespace common;
@@ -586,6 +594,387 @@ TEST_F(COLLISION, CollisionOfPrescribedJoints)
   }
 }
 
+//==============================================================================
+SkeletonPtr createBox(const std::string& _name,
+                      const Eigen::Vector3d& _size,
+                      const Eigen::Vector3d& _position)
+{
+  SkeletonPtr box = Skeleton::create(_name);
+
+  WeldJoint::Properties properties;
+  properties.mT_ParentBodyToJoint.translation() = _position;
+  BodyNode* bn = box->createJointAndBodyNodePair<WeldJoint>(
+        nullptr, properties).second;
+  bn->addCollisionShape(std::make_shared<BoxShape>(_size));
+
+  return box;
+}
+
+//==============================================================================
+SkeletonPtr createTwoLinkArm()
+{
+  SkeletonPtr arm = Skeleton::create("arm");
+
+  BodyNode* bn = nullptr;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mAxis = Eigen::Vector3d::UnitY();
+    properties.mT_ParentBodyToJoint.translation() =
+        (i == 0) ? Eigen::Vector3d(0.0, 0.0, 1.0)
+                 : Eigen::Vector3d(0.0, 0.0, 0.5);
+    bn = arm->createJointAndBodyNodePair<RevoluteJoint>(bn, properties).second;
+
+    ShapePtr shape = std::make_shared<BoxShape>(
+          Eigen::Vector3d(0.1, 0.1, 0.5));
+    shape->setOffset(Eigen::Vector3d(0.0, 0.0, 0.25));
+    bn->addCollisionShape(shape);
+  }
+
+  return arm;
+}
+
+//==============================================================================
+void testSkeletonScopedQueries(const WorldPtr& _world,
+                               const SkeletonPtr& _arm)
+{
+  collision::CollisionDetector* cd =
+      _world->getConstraintSolver()->getCollisionDetector();
+
+  // The two clutter boxes always collide with each other
+  _arm->setPositions(Eigen::Vector2d::Zero());
+  EXPECT_TRUE(_world->checkCollision());
+  const size_t numContacts = cd->getNumContacts();
+  EXPECT_GT(numContacts, 0u);
+
+  // Only the first link touches the obstacle
+  EXPECT_TRUE(_world->checkCollision(_arm));
+  EXPECT_TRUE(_world->checkCollision(_arm, std::vector<size_t>(1, 0)));
+  EXPECT_FALSE(_world->checkCollision(_arm, std::vector<size_t>(1, 1)));
+  EXPECT_TRUE(cd->checkCollision(
+                std::vector<BodyNode*>(1, _arm->getBodyNode(0))));
+  EXPECT_FALSE(cd->checkCollision(
+                 std::vector<BodyNode*>(1, _arm->getBodyNode(1))));
+
+  // The boolean queries leave the contacts of the last full detection alone
+  EXPECT_EQ(cd->getNumContacts(), numContacts);
+
+  // Swinging the arm away from the obstacle clears it, even though the clutter
+  // is still in collision
+  _arm->setPositions(Eigen::Vector2d(-0.5 * DART_PI, 0.0));
+  EXPECT_FALSE(_world->checkCollision(_arm));
+  EXPECT_FALSE(_world->checkCollision(_arm, std::vector<size_t>(1, 0)));
+  EXPECT_TRUE(_world->checkCollision());
+}
+
+//==============================================================================
+TEST_F(COLLISION, SkeletonScopedQueries)
+{
+  WorldPtr world(new World);
+  SkeletonPtr arm = createTwoLinkArm();
+  world->addSkeleton(arm);
+  world->addSkeleton(createBox("obstacle", Eigen::Vector3d::Constant(0.1),
+                               Eigen::Vector3d(0.08, 0.0, 1.25)));
+  world->addSkeleton(createBox("clutter 1", Eigen::Vector3d::Constant(0.2),
+                               Eigen::Vector3d(5.0, 5.0, 1.0)));
+  world->addSkeleton(createBox("clutter 2", Eigen::Vector3d::Constant(0.2),
+                               Eigen::Vector3d(5.0, 5.0, 1.1)));
+
+  testSkeletonScopedQueries(world, arm);
+
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::DARTCollisionDetector());
+  testSkeletonScopedQueries(world, arm);
+
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::FCLCollisionDetector());
+  testSkeletonScopedQueries(world, arm);
+
+#ifdef HAVE_BULLET_COLLISION
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::BulletCollisionDetector());
+  testSkeletonScopedQueries(world, arm);
+#endif
+}
+
+//==============================================================================
+TEST_F(COLLISION, ShapeDistance)
+{
+  const double tol = 1e-6;
+  double distance;
+  Eigen::Vector3d point0;
+  Eigen::Vector3d point1;
+
+  Eigen::Isometry3d T0 = Eigen::Isometry3d::Identity();
+  Eigen::Isometry3d T1 = Eigen::Isometry3d::Identity();
+
+  // Separated spheres
+  ShapePtr sphere0 = std::make_shared<EllipsoidShape>(
+        Eigen::Vector3d::Constant(1.0));
+  ShapePtr sphere1 = std::make_shared<EllipsoidShape>(
+        Eigen::Vector3d::Constant(0.5));
+  T1.translation() = Eigen::Vector3d(2.0, 1.0, 0.0);
+  EXPECT_TRUE(collision::distance(sphere0, T0, sphere1, T1,
+                                  std::numeric_limits<double>::infinity(),
+                                  distance, point0, point1));
+  EXPECT_NEAR(distance, std::sqrt(5.0) - 0.75, tol);
+  EXPECT_NEAR(point0.norm(), 0.5, tol);
+  EXPECT_NEAR((point1 - T1.translation()).norm(), 0.25, tol);
+
+  // Intersecting spheres
+  T1.translation() = Eigen::Vector3d(0.5, 0.2, 0.1);
+  EXPECT_TRUE(collision::distance(sphere0, T0, sphere1, T1,
+                                  std::numeric_limits<double>::infinity(),
+                                  distance, point0, point1));
+  EXPECT_NEAR(distance, T1.translation().norm() - 0.75, tol);
+  EXPECT_NEAR((point0 - point1).norm(), -distance, tol);
+
+  // Axis-aligned boxes, where the distance is known in closed form
+  for (size_t i = 0; i < 100; ++i)
+  {
+    const Eigen::Vector3d size0 = Eigen::Vector3d::Random().cwiseAbs()
+                                  + Eigen::Vector3d::Constant(0.1);
+    const Eigen::Vector3d size1 = Eigen::Vector3d::Random().cwiseAbs()
+                                  + Eigen::Vector3d::Constant(0.1);
+    T1.translation() = 1.5 * Eigen::Vector3d::Random();
+
+    const Eigen::Vector3d gap
+        = T1.translation().cwiseAbs() - 0.5 * (size0 + size1);
+    const double expected = (gap.array() > 0.0).any()
+                            ? gap.cwiseMax(0.0).norm() : gap.maxCoeff();
+
+    EXPECT_TRUE(collision::distance(std::make_shared<BoxShape>(size0), T0,
+                                    std::make_shared<BoxShape>(size1), T1,
+                                    std::numeric_limits<double>::infinity(),
+                                    distance, point0, point1));
+    EXPECT_NEAR(distance, expected, tol);
+    EXPECT_NEAR((point0 - point1).norm(), std::abs(expected), tol);
+  }
+
+  // Upper bound
+  ShapePtr box0 = std::make_shared<BoxShape>(Eigen::Vector3d(1.0, 1.0, 1.0));
+  ShapePtr box1 = std::make_shared<BoxShape>(Eigen::Vector3d(1.0, 2.0, 1.0));
+  T1.translation() = Eigen::Vector3d(30.0, 0.3, 0.9);
+  EXPECT_TRUE(collision::distance(box0, T0, box1, T1, 1.0,
+                                  distance, point0, point1));
+  EXPECT_GE(distance, 1.0);
+
+  // Plane
+  ShapePtr plane = std::make_shared<PlaneShape>(Eigen::Vector3d::UnitZ(), 0.0);
+  T1.translation() = Eigen::Vector3d(0.0, 0.0, 0.4);
+  EXPECT_TRUE(collision::distance(plane, T0, box0, T1,
+                                  std::numeric_limits<double>::infinity(),
+                                  distance, point0, point1));
+  EXPECT_NEAR(distance, -0.1, tol);
+
+  // The upper bound also applies against a plane, from either side
+  T1.translation() = Eigen::Vector3d(0.0, 0.0, 30.0);
+  EXPECT_TRUE(collision::distance(plane, T0, box0, T1, 1.0,
+                                  distance, point0, point1));
+  EXPECT_GE(distance, 1.0);
+  EXPECT_LE(distance, 29.5 + tol);
+  EXPECT_TRUE(collision::distance(box0, T1, plane, T0, 1.0,
+                                  distance, point0, point1));
+  EXPECT_GE(distance, 1.0);
+  EXPECT_TRUE(collision::distance(plane, T0, box0, T1, 40.0,
+                                  distance, point0, point1));
+  EXPECT_NEAR(distance, 29.5, tol);
+
+  // A warm started query takes fewer iterations than a cold one
+  size_t numWarmIterations = 0;
+  size_t numColdIterations = 0;
+  collision::GJKSimplex warmSimplex;
+  T0.linear() = math::eulerXYZToMatrix(Eigen::Vector3d(0.3, 0.2, 0.1));
+  T1.translation() = Eigen::Vector3d(1.5, 0.5, 0.2);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    T1.linear() = math::eulerXYZToMatrix(Eigen::Vector3d(0.0, 0.01 * i, 0.0));
+
+    double warmDistance;
+    EXPECT_TRUE(collision::distance(box0, T0, box1, T1,
+                                    std::numeric_limits<double>::infinity(),
+                                    warmDistance, point0, point1,
+                                    &warmSimplex));
+    numWarmIterations += warmSimplex.mNumIterations;
+
+    collision::GJKSimplex coldSimplex;
+    EXPECT_TRUE(collision::distance(box0, T0, box1, T1,
+                                    std::numeric_limits<double>::infinity(),
+                                    distance, point0, point1, &coldSimplex));
+    numColdIterations += coldSimplex.mNumIterations;
+
+    EXPECT_NEAR(warmDistance, distance, tol);
+  }
+  EXPECT_LT(numWarmIterations, numColdIterations);
+}
+
+//==============================================================================
+void testDistanceQueries(const WorldPtr& _world, const SkeletonPtr& _arm)
+{
+  const double tol = 1e-4;
+  collision::CollisionDetector* cd =
+      _world->getConstraintSolver()->getCollisionDetector();
+
+  BodyNode* link1 = _arm->getBodyNode(0);
+  BodyNode* link2 = _arm->getBodyNode(1);
+  BodyNode* obstacle = _world->getSkeleton("obstacle")->getBodyNode(0);
+
+  // The first link lies horizontally below the obstacle and the second link
+  // points up at its end
+  _arm->setPositions(Eigen::Vector2d(-0.5 * DART_PI, 0.5 * DART_PI));
+
+  collision::DistanceResult result;
+  EXPECT_TRUE(cd->computeDistance(link2, obstacle, result));
+  EXPECT_NEAR(result.distance, 0.48, tol);
+  EXPECT_NEAR((result.point1 - result.point2).norm(), 0.48, tol);
+  EXPECT_TRUE(result.bodyNode1.lock() == link2);
+  EXPECT_TRUE(result.bodyNode2.lock() == obstacle);
+
+  EXPECT_FALSE(cd->computeDistance(link2, obstacle, result, 0.1));
+
+  // The closest pair that involves the arm
+  EXPECT_TRUE(cd->computeDistance(_arm, result));
+  EXPECT_NEAR(result.distance, std::sqrt(0.03 * 0.03 + 0.15 * 0.15), tol);
+  EXPECT_TRUE(result.bodyNode1.lock() == link1);
+
+  // Self-collision is disabled, so each link pairs with the three boxes
+  std::vector<collision::DistanceResult> results;
+  EXPECT_EQ(cd->computeDistances(_arm, results), 6u);
+  results.clear();
+  EXPECT_EQ(cd->computeDistances(_arm, results, 1.0), 2u);
+
+  // Penetration
+  _arm->setPositions(Eigen::Vector2d::Zero());
+  EXPECT_TRUE(cd->computeDistance(link1, obstacle, result));
+  EXPECT_NEAR(result.distance, -0.02, tol);
+}
+
+//==============================================================================
+TEST_F(COLLISION, DistanceQueries)
+{
+  WorldPtr world(new World);
+  SkeletonPtr arm = createTwoLinkArm();
+  world->addSkeleton(arm);
+  world->addSkeleton(createBox("obstacle", Eigen::Vector3d::Constant(0.1),
+                               Eigen::Vector3d(0.08, 0.0, 1.25)));
+  world->addSkeleton(createBox("clutter 1", Eigen::Vector3d::Constant(0.2),
+                               Eigen::Vector3d(5.0, 5.0, 1.0)));
+  world->addSkeleton(createBox("clutter 2", Eigen::Vector3d::Constant(0.2),
+                               Eigen::Vector3d(5.0, 5.0, 1.1)));
+
+  testDistanceQueries(world, arm);
+
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::DARTCollisionDetector());
+  testDistanceQueries(world, arm);
+
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::FCLCollisionDetector());
+  testDistanceQueries(world, arm);
+
+#ifdef HAVE_BULLET_COLLISION
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::BulletCollisionDetector());
+  testDistanceQueries(world, arm);
+#endif
+}
+
+//==============================================================================
+void testCollisionGroups(const WorldPtr& _world)
+{
+  collision::CollisionDetector* cd =
+      _world->getConstraintSolver()->getCollisionDetector();
+  BodyNode* box1 = _world->getSkeleton(0)->getBodyNode(0);
+  BodyNode* box2 = _world->getSkeleton(1)->getBodyNode(0);
+
+  EXPECT_TRUE(box1->canCollideWith(box2));
+  EXPECT_TRUE(_world->checkCollision());
+
+  // Filtering must hold in both directions
+  _world->getSkeleton(0)->setCollisionCategories(0x2u);
+  box2->setCollisionMask(~0x2u);
+  EXPECT_FALSE(box1->canCollideWith(box2));
+  EXPECT_FALSE(box2->canCollideWith(box1));
+  EXPECT_FALSE(_world->checkCollision());
+
+  box2->setCollisionMask(DART_DEFAULT_COLLISION_MASK);
+  EXPECT_TRUE(box1->canCollideWith(box2));
+  EXPECT_TRUE(_world->checkCollision());
+
+  box1->setCollisionMask(0x0u);
+  EXPECT_FALSE(_world->checkCollision());
+  box1->setCollisionMask(DART_DEFAULT_COLLISION_MASK);
+  box1->setCollisionCategories(DART_DEFAULT_COLLISION_CATEGORIES);
+
+  // Explicitly disabled pairs are kept regardless of the argument order
+  cd->disablePair(box2, box1);
+  EXPECT_TRUE(cd->isPairDisabled(box1, box2));
+  EXPECT_EQ(cd->getDisabledPairs().size(), 1u);
+  EXPECT_FALSE(_world->checkCollision());
+
+  cd->enablePair(box1, box2);
+  EXPECT_FALSE(cd->isPairDisabled(box2, box1));
+  EXPECT_TRUE(cd->getDisabledPairs().empty());
+  EXPECT_TRUE(_world->checkCollision());
+}
+
+//==============================================================================
+TEST_F(COLLISION, CollisionGroups)
+{
+  WorldPtr world(new World);
+  world->addSkeleton(createBox("box 1", Eigen::Vector3d::Constant(0.2),
+                               Eigen::Vector3d(5.0, 5.0, 1.0)));
+  world->addSkeleton(createBox("box 2", Eigen::Vector3d::Constant(0.2),
+                               Eigen::Vector3d(5.0, 5.0, 1.1)));
+
+  testCollisionGroups(world);
+
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::DARTCollisionDetector());
+  testCollisionGroups(world);
+
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::FCLCollisionDetector());
+  testCollisionGroups(world);
+
+#ifdef HAVE_BULLET_COLLISION
+  world->getConstraintSolver()->setCollisionDetector(
+        new collision::BulletCollisionDetector());
+  testCollisionGroups(world);
+#endif
+}
+
+//==============================================================================
+TEST_F(COLLISION, SkeletonCollisionGroups)
+{
+  SkeletonPtr skel = createBox("box", Eigen::Vector3d::Constant(0.2),
+                               Eigen::Vector3d::Zero());
+  skel->setCollisionCategories(0x4u);
+  skel->setCollisionMask(0x1u);
+  EXPECT_EQ(skel->getBodyNode(0)->getCollisionCategories(), 0x4u);
+  EXPECT_EQ(skel->getBodyNode(0)->getCollisionMask(), 0x1u);
+
+  // BodyNodes that are added later get the groups of the Skeleton, too
+  BodyNode* added = skel->createJointAndBodyNodePair<FreeJoint>(
+        skel->getBodyNode(0)).second;
+  EXPECT_EQ(added->getCollisionCategories(), 0x4u);
+  EXPECT_EQ(added->getCollisionMask(), 0x1u);
+
+  SkeletonPtr clone = skel->clone();
+  added = clone->createJointAndBodyNodePair<FreeJoint>(
+        clone->getBodyNode(0)).second;
+  EXPECT_EQ(added->getCollisionCategories(), 0x4u);
+  EXPECT_EQ(added->getCollisionMask(), 0x1u);
+
+  // A Skeleton without groups leaves the groups of its BodyNodes alone
+  SkeletonPtr other = Skeleton::create();
+  added = other->createJointAndBodyNodePair<FreeJoint>().second;
+  EXPECT_EQ(added->getCollisionCategories(),
+            static_cast<uint32_t>(DART_DEFAULT_COLLISION_CATEGORIES));
+  EXPECT_EQ(added->getCollisionMask(),
+            static_cast<uint32_t>(DART_DEFAULT_COLLISION_MASK));
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include <gtest/gtest.h>
+#ifdef _WIN32
+#include <direct.h>
+#define getcwd _getcwd
+#else
+#include <unistd.h>
+#endif
+#include "TestHelpers.h"
+
+#include "dart/config.h"
+#include "dart/dynamics/BallJoint.h"
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/CylinderShape.h"
+#include "dart/dynamics/EllipsoidShape.h"
+#include "dart/dynamics/EulerJoint.h"
+#include "dart/dynamics/FreeJoint.h"
+#include "dart/dynamics/LineSegmentShape.h"
+#include "dart/dynamics/PlanarJoint.h"
+#include "dart/dynamics/PrismaticJoint.h"
+#include "dart/dynamics/RevoluteJoint.h"
+#include "dart/dynamics/ScrewJoint.h"
+#include "dart/dynamics/SoftBodyNode.h"
+#include "dart/dynamics/TranslationalJoint.h"
+#include "dart/dynamics/UniversalJoint.h"
+#include "dart/dynamics/WeldJoint.h"
+#include "dart/utils/CompiledWorld.h"
+#include "dart/utils/SkelParser.h"
+#include "dart/utils/sdf/SdfParser.h"
+
+using namespace dart;
+using namespace utils;
+
+//==============================================================================
+/// Returns the absolute path of _name in the working directory, because URIs
+/// cannot refer to relative paths
+std::string getTestPath(const std::string& _name)
+{
+  char directory[4096];
+  if(!getcwd(directory, sizeof(directory)))
+    return _name;
+
+  return std::string(directory) + "/" + _name;
+}
+
+//==============================================================================
+template <typename JointType>
+BodyNode* addBody(const SkeletonPtr& _skeleton, BodyNode* _parent,
+                  const std::string& _name,
+                  const typename JointType::Properties& _joint
+                    = typename JointType::Properties())
+{
+  BodyNode::Properties body;
+  body.mName = _name;
+  body.mInertia = dynamics::Inertia(0.5, Eigen::Vector3d(0.1, 0.0, 0.0),
+                          Eigen::Vector3d(0.1, 0.2, 0.3).asDiagonal());
+
+  ShapePtr box = std::make_shared<BoxShape>(Eigen::Vector3d(0.2, 0.1, 0.1));
+  box->setColor(Eigen::Vector3d(0.1, 0.5, 0.9));
+  body.mVizShapes.push_back(box);
+  body.mColShapes.push_back(box);
+
+  typename JointType::Properties joint = _joint;
+  joint.mName = _name + " joint";
+  joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0.2, 0.0, 0.0);
+
+  return _skeleton->createJointAndBodyNodePair<JointType>(
+        _parent, joint, body).second;
+}
+
+//==============================================================================
+SkeletonPtr createTestSkeleton()
+{
+  SkeletonPtr skeleton = Skeleton::create("compiled skeleton");
+  skeleton->enableSelfCollision();
+
+  BodyNode* root = addBody<FreeJoint>(skeleton, nullptr, "root");
+  BodyNode* bn = addBody<RevoluteJoint>(skeleton, root, "revolute",
+        RevoluteJoint::Properties(SingleDofJoint::Properties(),
+                                  Eigen::Vector3d(0.0, 1.0, 0.0)));
+  bn->addVisualizationShape(std::make_shared<CylinderShape>(0.05, 0.3));
+  bn->addCollisionShape(std::make_shared<EllipsoidShape>(
+                          Eigen::Vector3d(0.1, 0.2, 0.3)));
+  bn->setCollidable(false);
+  bn->setFrictionCoeff(0.3);
+  bn->setGravityMode(false);
+
+  bn = addBody<PrismaticJoint>(skeleton, bn, "prismatic");
+  bn->addMarker(new Marker("marker", Eigen::Vector3d(0.1, 0.2, 0.3), bn));
+  bn = addBody<ScrewJoint>(skeleton, bn, "screw",
+        ScrewJoint::Properties(SingleDofJoint::Properties(),
+                               ScrewJoint::UniqueProperties(
+                                 Eigen::Vector3d::UnitX(), 0.3)));
+  bn = addBody<UniversalJoint>(skeleton, bn, "universal");
+  bn = addBody<EulerJoint>(skeleton, bn, "euler",
+        EulerJoint::Properties(MultiDofJoint<3>::Properties(),
+                               EulerJoint::UniqueProperties(
+                                 EulerJoint::AO_ZYX)));
+  addBody<BallJoint>(skeleton, bn, "ball");
+  addBody<TranslationalJoint>(skeleton, bn, "translational");
+  bn = addBody<PlanarJoint>(skeleton, root, "planar",
+        PlanarJoint::Properties(MultiDofJoint<3>::Properties(),
+                                PlanarJoint::UniqueProperties(
+                                  Eigen::Vector3d::UnitX(),
+                                  Eigen::Vector3d(0.0, 1.0, 1.0).normalized())));
+  bn = addBody<WeldJoint>(skeleton, bn, "weld");
+
+  std::shared_ptr<LineSegmentShape> lines =
+      std::make_shared<LineSegmentShape>(Eigen::Vector3d::Zero(),
+                                         Eigen::Vector3d::UnitZ(), 2.0f);
+  lines->addVertex(Eigen::Vector3d::UnitY(), 1);
+  bn->addVisualizationShape(lines);
+
+  SoftBodyNode::Properties softProperties(
+        BodyNode::Properties(std::string("soft")),
+        SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d(0.1, 0.2, 0.3), Eigen::Isometry3d::Identity(),
+          Eigen::Vector3i(3, 3, 3), 1.0));
+  skeleton->createJointAndBodyNodePair<RevoluteJoint, SoftBodyNode>(
+        bn, RevoluteJoint::Properties(), softProperties);
+
+  for(size_t i=0; i<skeleton->getNumDofs(); ++i)
+  {
+    DegreeOfFreedom* dof = skeleton->getDof(i);
+    dof->setPositionLimits(-1.0 - 0.1*i, 1.0 + 0.1*i);
+    dof->setDampingCoefficient(0.01*i);
+  }
+
+  skeleton->setPositions(Eigen::VectorXd::Random(skeleton->getNumDofs()));
+  skeleton->setVelocities(Eigen::VectorXd::Random(skeleton->getNumDofs()));
+
+  return skeleton;
+}
+
+//==============================================================================
+void expectEqualShapes(const ConstShapePtr& _expected,
+                       const ConstShapePtr& _actual)
+{
+  ASSERT_EQ(_expected->getShapeType(), _actual->getShapeType());
+  EXPECT_TRUE(equals(_expected->getLocalTransform().matrix(),
+                     _actual->getLocalTransform().matrix()));
+  EXPECT_TRUE(equals(_expected->getRGBA(), _actual->getRGBA()));
+  EXPECT_TRUE(equals(_expected->getBoundingBoxDim(),
+                     _actual->getBoundingBoxDim()));
+  EXPECT_NEAR(_expected->getVolume(), _actual->getVolume(), 1e-10);
+}
+
+//==============================================================================
+void expectEqualSkeletons(const SkeletonPtr& _expected,
+                          const SkeletonPtr& _actual)
+{
+  ASSERT_TRUE(_actual != nullptr);
+  EXPECT_EQ(_expected->getName(), _actual->getName());
+  EXPECT_EQ(_expected->isMobile(), _actual->isMobile());
+  EXPECT_EQ(_expected->isEnabledSelfCollisionCheck(),
+            _actual->isEnabledSelfCollisionCheck());
+  ASSERT_EQ(_expected->getNumBodyNodes(), _actual->getNumBodyNodes());
+  ASSERT_EQ(_expected->getNumDofs(), _actual->getNumDofs());
+  ASSERT_EQ(_expected->getNumSoftBodyNodes(), _actual->getNumSoftBodyNodes());
+
+  EXPECT_TRUE(equals(_expected->getPositions(), _actual->getPositions()));
+  EXPECT_TRUE(equals(_expected->getVelocities(), _actual->getVelocities()));
+  EXPECT_NEAR(_expected->getMass(), _actual->getMass(), 1e-10);
+
+  for(size_t i=0; i<_expected->getNumBodyNodes(); ++i)
+  {
+    const BodyNode* expected = _expected->getBodyNode(i);
+    const BodyNode* actual = _actual->getBodyNode(i);
+    EXPECT_EQ(expected->getName(), actual->getName());
+    EXPECT_EQ(expected->getParentJoint()->getType(),
+              actual->getParentJoint()->getType());
+    EXPECT_EQ(expected->getParentJoint()->getName(),
+              actual->getParentJoint()->getName());
+    EXPECT_EQ(expected->isCollidable(), actual->isCollidable());
+    EXPECT_EQ(expected->getCollisionCategories(),
+              actual->getCollisionCategories());
+    EXPECT_EQ(expected->getCollisionMask(), actual->getCollisionMask());
+    EXPECT_EQ(expected->getGravityMode(), actual->getGravityMode());
+    EXPECT_EQ(expected->getFrictionCoeff(), actual->getFrictionCoeff());
+    EXPECT_EQ(expected->getNumMarkers(), actual->getNumMarkers());
+    EXPECT_TRUE(equals(expected->getSpatialInertia(),
+                       actual->getSpatialInertia()));
+    EXPECT_TRUE(equals(expected->getWorldTransform().matrix(),
+                       actual->getWorldTransform().matrix()));
+    EXPECT_TRUE(equals(expected->getSpatialVelocity(),
+                       actual->getSpatialVelocity()));
+
+    ASSERT_EQ(expected->getNumVisualizationShapes(),
+              actual->getNumVisualizationShapes());
+    for(size_t j=0; j<expected->getNumVisualizationShapes(); ++j)
+      expectEqualShapes(expected->getVisualizationShape(j),
+                        actual->getVisualizationShape(j));
+
+    ASSERT_EQ(expected->getNumCollisionShapes(),
+              actual->getNumCollisionShapes());
+    for(size_t j=0; j<expected->getNumCollisionShapes(); ++j)
+      expectEqualShapes(expected->getCollisionShape(j),
+                        actual->getCollisionShape(j));
+  }
+
+  for(size_t i=0; i<_expected->getNumDofs(); ++i)
+  {
+    EXPECT_EQ(_expected->getDof(i)->getName(), _actual->getDof(i)->getName());
+    EXPECT_EQ(_expected->getPositionLowerLimit(i),
+              _actual->getPositionLowerLimit(i));
+    EXPECT_EQ(_expected->getPositionUpperLimit(i),
+              _actual->getPositionUpperLimit(i));
+    EXPECT_EQ(_expected->getDof(i)->getDampingCoefficient(),
+              _actual->getDof(i)->getDampingCoefficient());
+  }
+
+  for(size_t i=0; i<_expected->getNumSoftBodyNodes(); ++i)
+  {
+    const SoftBodyNode* expected = _expected->getSoftBodyNode(i);
+    const SoftBodyNode* actual = _actual->getSoftBodyNode(i);
+    ASSERT_EQ(expected->getNumPointMasses(), actual->getNumPointMasses());
+    EXPECT_EQ(expected->getNumFaces(), actual->getNumFaces());
+    EXPECT_EQ(expected->getVertexSpringStiffness(),
+              actual->getVertexSpringStiffness());
+    for(size_t j=0; j<expected->getNumPointMasses(); ++j)
+    {
+      EXPECT_TRUE(equals(expected->getPointMass(j)->getRestingPosition(),
+                         actual->getPointMass(j)->getRestingPosition()));
+      EXPECT_EQ(expected->getPointMass(j)->getNumConnectedPointMasses(),
+                actual->getPointMass(j)->getNumConnectedPointMasses());
+    }
+  }
+}
+
+//==============================================================================
+void expectEqualWorlds(const WorldPtr& _expected, const WorldPtr& _actual)
+{
+  ASSERT_TRUE(_actual != nullptr);
+  EXPECT_EQ(_expected->getName(), _actual->getName());
+  EXPECT_TRUE(equals(_expected->getGravity(), _actual->getGravity()));
+  EXPECT_EQ(_expected->getTimeStep(), _actual->getTimeStep());
+  ASSERT_EQ(_expected->getNumSkeletons(), _actual->getNumSkeletons());
+
+  for(size_t i=0; i<_expected->getNumSkeletons(); ++i)
+    expectEqualSkeletons(_expected->getSkeleton(i), _actual->getSkeleton(i));
+}
+
+//==============================================================================
+TEST(CompiledWorld, SkeletonRoundTrip)
+{
+  const std::string path = getTestPath("testCompiledWorld.dartskel");
+
+  SkeletonPtr skeleton = createTestSkeleton();
+  ASSERT_TRUE(CompiledWorld::writeSkeleton(skeleton, path));
+
+  SkeletonPtr compiled = CompiledWorld::readSkeleton(path);
+  expectEqualSkeletons(skeleton, compiled);
+
+  // A Skeleton file is not a World file
+  EXPECT_TRUE(CompiledWorld::readWorld(path) == nullptr);
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+TEST(CompiledWorld, TruncatedSkeleton)
+{
+  const std::string path = getTestPath("testCompiledWorld.dartskel");
+  ASSERT_TRUE(CompiledWorld::writeSkeleton(createTestSkeleton(), path));
+
+  std::ifstream input(path, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(input)),
+                            std::istreambuf_iterator<char>());
+  input.close();
+  ASSERT_FALSE(content.empty());
+
+  // Every prefix of the file ends in the middle of some value, so none of
+  // them may be read as a Skeleton
+  for(size_t size = 0; size < content.size(); ++size)
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(content.data(), size);
+    output.close();
+
+    EXPECT_TRUE(CompiledWorld::readSkeleton(path) == nullptr)
+        << "Read a Skeleton from the first " << size << " bytes";
+  }
+
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+TEST(CompiledWorld, CorruptCounts)
+{
+  const std::string path = getTestPath("testCompiledWorld.dartskel");
+
+  // A BodyNode without shapes or markers, so that the offsets of their counts
+  // can be found from the offset of its name
+  const std::string name = "corrupt body";
+  SkeletonPtr skeleton = Skeleton::create("corrupt skeleton");
+  BodyNode::Properties body;
+  body.mName = name;
+  skeleton->createJointAndBodyNodePair<FreeJoint>(
+        nullptr, FreeJoint::Properties(), body);
+  ASSERT_TRUE(CompiledWorld::writeSkeleton(skeleton, path));
+
+  std::ifstream input(path, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(input)),
+                            std::istreambuf_iterator<char>());
+  input.close();
+
+  const size_t namePosition = content.find(name);
+  ASSERT_NE(namePosition, std::string::npos);
+
+  // The name is followed by the mass, the center of mass, the moment of
+  // inertia, two flags, the friction and restitution coefficients, and the
+  // collision categories and mask
+  const size_t shapesPosition = namePosition + name.size()
+      + 13 * sizeof(double) + 2 * sizeof(uint8_t) + 2 * sizeof(double)
+      + 2 * sizeof(uint32_t);
+
+  // The shape count is followed by the empty visualization and collision
+  // shape index lists
+  const size_t markersPosition = shapesPosition + 3 * sizeof(uint32_t);
+  ASSERT_LE(markersPosition + sizeof(uint32_t), content.size());
+
+  for(const size_t position : {shapesPosition, markersPosition})
+  {
+    std::string corrupt = content;
+    ASSERT_EQ(corrupt.substr(position, sizeof(uint32_t)),
+              std::string(sizeof(uint32_t), '\0'));
+    corrupt.replace(position, sizeof(uint32_t), sizeof(uint32_t), '\xff');
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(corrupt.data(), corrupt.size());
+    output.close();
+
+    // A count that does not fit in the file must be rejected before anything
+    // is allocated for it
+    SkeletonPtr compiled;
+    EXPECT_NO_THROW(compiled = CompiledWorld::readSkeleton(path));
+    EXPECT_TRUE(compiled == nullptr);
+  }
+
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+TEST(CompiledWorld, WorldRoundTrip)
+{
+  const std::string path = getTestPath("testCompiledWorld.dartworld");
+
+  WorldPtr world = std::make_shared<World>("compiled world");
+  world->setGravity(Eigen::Vector3d(0.0, -9.81, 0.0));
+  world->setTimeStep(0.002);
+  world->addSkeleton(createTestSkeleton());
+  world->addSkeleton(createBox(Eigen::Vector3d(1.0, 1.0, 0.1)));
+
+  CollisionDetector* detector =
+      world->getConstraintSolver()->getCollisionDetector();
+  detector->disablePair(world->getSkeleton(0)->getBodyNode(0),
+                        world->getSkeleton(1)->getBodyNode(0));
+
+  ASSERT_TRUE(CompiledWorld::writeWorld(world, path));
+  WorldPtr compiled = CompiledWorld::readWorld(path);
+  std::remove(path.c_str());
+
+  expectEqualWorlds(world, compiled);
+
+  detector = compiled->getConstraintSolver()->getCollisionDetector();
+  EXPECT_TRUE(detector->isPairDisabled(
+                compiled->getSkeleton(0)->getBodyNode(0),
+                compiled->getSkeleton(1)->getBodyNode(0)));
+  EXPECT_FALSE(detector->isPairDisabled(
+                 compiled->getSkeleton(0)->getBodyNode(1),
+                 compiled->getSkeleton(1)->getBodyNode(0)));
+}
+
+//==============================================================================
+TEST(CompiledWorld, ParsedWorlds)
+{
+  const std::string path = getTestPath("testCompiledWorld.dartworld");
+
+  std::vector<WorldPtr> worlds;
+  worlds.push_back(SkelParser::readWorld(
+                     DART_DATA_PATH"skel/fullbody1.skel"));
+  worlds.push_back(SkelParser::readWorld(
+                     DART_DATA_PATH"skel/softBodies.skel"));
+
+  // The Atlas model is not contained in a World
+  worlds.push_back(std::make_shared<World>());
+  worlds.back()->addSkeleton(SdfParser::readSkeleton(
+                               DART_DATA_PATH"sdf/atlas/atlas_v3_no_head.sdf"));
+
+  for(const WorldPtr& world : worlds)
+  {
+    ASSERT_TRUE(world != nullptr);
+    ASSERT_TRUE(CompiledWorld::writeWorld(world, path));
+    expectEqualWorlds(world, CompiledWorld::readWorld(path));
+  }
+
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
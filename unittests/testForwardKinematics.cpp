@@ -36,8 +36,11 @@
 
 #include <iostream>
 #include <gtest/gtest.h>
+#include <Eigen/Dense>
+#include <unsupported/Eigen/AutoDiff>
 #include "TestHelpers.h"
 
+#include "dart/dynamics/ScalarKinematics.h"
 #include "dart/utils/urdf/DartLoader.h"
 
 std::vector<size_t> twoLinkIndices;
@@ -205,6 +208,71 @@ TEST(FORWARD_KINEMATICS, JACOBIAN_PARTIAL_CHANGE)
   EXPECT_TRUE((fd_J - J).norm() < tolerance);
 }
 
+//==============================================================================
+TEST(FORWARD_KINEMATICS, SCALAR_TYPES)
+{
+  typedef Eigen::AutoDiffScalar<Eigen::VectorXd> AutoDiff;
+  typedef Eigen::Matrix<AutoDiff, Eigen::Dynamic, 1> AutoDiffVector;
+
+  SkeletonPtr robot = createThreeLinkRobot(Vector3d(0.3, 0.3, 1.5), DOF_YAW,
+                                           Vector3d(0.3, 0.3, 1.0), DOF_X,
+                                           Vector3d(0.3, 0.3, 0.5), DOF_ROLL,
+                                           true);
+  const size_t numDofs = robot->getNumDofs();
+  const size_t numBodyNodes = robot->getNumBodyNodes();
+  BodyNode* ee = robot->getBodyNode(numBodyNodes - 1);
+
+  const size_t numTests = 10;
+  for (size_t i = 0; i < numTests; ++i)
+  {
+    const Eigen::VectorXd q = Eigen::VectorXd::Random(numDofs);
+    robot->setPositions(q);
+
+    // Single precision agrees with the double precision state of the Skeleton
+    const Eigen::VectorXf qf = q.cast<float>();
+    const Eigen::aligned_vector<Isometry3<float>> Tf
+        = computeWorldTransforms(*robot, qf);
+    ASSERT_EQ(Tf.size(), numBodyNodes);
+    for (size_t j = 0; j < numBodyNodes; ++j)
+    {
+      EXPECT_TRUE(equals(robot->getBodyNode(j)->getWorldTransform().matrix(),
+                         Eigen::Matrix4d(Tf[j].matrix().cast<double>()),
+                         1e-4));
+    }
+
+    // Seeding each position with a unit derivative gives the Jacobians
+    AutoDiffVector qd(numDofs);
+    for (size_t j = 0; j < numDofs; ++j)
+      qd[j] = AutoDiff(q[j], numDofs, j);
+
+    const Eigen::aligned_vector<Isometry3<AutoDiff>> Td
+        = computeWorldTransforms(*robot, qd);
+    ASSERT_EQ(Td.size(), numBodyNodes);
+
+    Eigen::Vector3d x;
+    Eigen::MatrixXd J(3, numDofs);
+    for (size_t r = 0; r < 3; ++r)
+    {
+      x[r] = Td.back().translation()[r].value();
+      J.row(r) = Td.back().translation()[r].derivatives().transpose();
+    }
+    EXPECT_TRUE(equals(x, Eigen::Vector3d(ee->getWorldTransform().translation()),
+                       1e-10));
+    EXPECT_TRUE(equals(J, Eigen::MatrixXd(ee->getLinearJacobian(
+                                            Frame::World())), 1e-10));
+
+    const Eigen::Matrix<AutoDiff, 3, 1> com = computeCOM(*robot, qd);
+    for (size_t r = 0; r < 3; ++r)
+    {
+      x[r] = com[r].value();
+      J.row(r) = com[r].derivatives().transpose();
+    }
+    EXPECT_TRUE(equals(x, robot->getCOM(), 1e-10));
+    EXPECT_TRUE(equals(J, Eigen::MatrixXd(robot->getCOMLinearJacobian()),
+                       1e-10));
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
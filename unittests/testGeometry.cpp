@@ -36,6 +36,8 @@
 
 #include <iostream>
 #include <gtest/gtest.h>
+#include <Eigen/Dense>
+#include <unsupported/Eigen/AutoDiff>
 #include "TestHelpers.h"
 
 #include "dart/math/Geometry.h"
@@ -599,6 +601,115 @@ TEST(LIE_GROUP_OPERATORS, ADJOINT_MAPPINGS)
     }
 }
 
+/******************************************************************************/
+TEST(LIE_GROUP_OPERATORS, SCALAR_TYPES)
+{
+    int numTest = 100;
+    const double floatTol = 1e-4;
+
+    for (int i = 0; i < numTest; ++i)
+    {
+        Eigen::Vector6d t = Eigen::Vector6d::Random();
+        Eigen::Vector6d V = Eigen::Vector6d::Random();
+        Eigen::Vector6d F = Eigen::Vector6d::Random();
+        Eigen::Matrix6d I = Eigen::Matrix6d::Random();
+        I = I.transpose() * I;
+
+        Eigen::Isometry3d T = math::expMap(t);
+
+        Eigen::Matrix<float, 6, 1> tf = t.cast<float>();
+        Eigen::Matrix<float, 6, 1> Vf = V.cast<float>();
+        Eigen::Matrix<float, 6, 1> Ff = F.cast<float>();
+        Eigen::Matrix<float, 6, 6> If = I.cast<float>();
+
+        Isometry3<float> Tf = math::expMap(tf);
+        Eigen::Vector3f wf = tf.head<3>();
+        Eigen::Vector3d w = t.head<3>();
+
+        EXPECT_TRUE(equals(T.matrix(),
+                           Eigen::Matrix4d(Tf.matrix().cast<double>()),
+                           floatTol));
+        EXPECT_TRUE(equals(expAngular(w).matrix(),
+                           Eigen::Matrix4d(expAngular(wf).matrix()
+                                           .cast<double>()),
+                           floatTol));
+
+        Eigen::aligned_vector<Eigen::Vector6d> expected;
+        Eigen::aligned_vector<Eigen::Matrix<float, 6, 1>> actual;
+
+        expected.push_back(AdT(T, V));     actual.push_back(AdT(Tf, Vf));
+        expected.push_back(AdR(T, V));     actual.push_back(AdR(Tf, Vf));
+        expected.push_back(AdInvT(T, V));  actual.push_back(AdInvT(Tf, Vf));
+        expected.push_back(dAdT(T, F));    actual.push_back(dAdT(Tf, Ff));
+        expected.push_back(dAdInvT(T, F)); actual.push_back(dAdInvT(Tf, Ff));
+        expected.push_back(dAdInvR(T, F)); actual.push_back(dAdInvR(Tf, Ff));
+        expected.push_back(ad(V, F));      actual.push_back(ad(Vf, Ff));
+        expected.push_back(dad(V, F));     actual.push_back(dad(Vf, Ff));
+
+        for (size_t j = 0; j < expected.size(); ++j)
+        {
+            EXPECT_TRUE(equals(expected[j],
+                               Eigen::Vector6d(actual[j].cast<double>()),
+                               floatTol));
+        }
+
+        EXPECT_TRUE(equals(transformInertia(T, I),
+                           Eigen::Matrix6d(transformInertia(Tf, If)
+                                           .cast<double>()),
+                           1e-3));
+
+        // The double versions must be exactly the templates for double
+        EXPECT_TRUE(AdT(T, V) == AdT<double>(T, V));
+        EXPECT_TRUE(transformInertia(T, I) == transformInertia<double>(T, I));
+    }
+}
+
+/******************************************************************************/
+TEST(INERTIA, SCALAR_TYPES)
+{
+    typedef Eigen::AutoDiffScalar<Eigen::VectorXd> AutoDiff;
+
+    int numTest = 100;
+
+    for (int i = 0; i < numTest; ++i)
+    {
+        const double mass = 1.0 + random(0.0, 10.0);
+        const Eigen::Vector3d com = Eigen::Vector3d::Random();
+        Eigen::Matrix3d moment = Eigen::Matrix3d::Random();
+        moment = moment.transpose() * moment + Eigen::Matrix3d::Identity();
+
+        // The double version is exactly the one used by Inertia
+        const dynamics::Inertia inertia(mass, com, moment);
+        EXPECT_TRUE(inertia.getSpatialTensor()
+                    == dynamics::Inertia::computeSpatialTensor(mass, com, moment));
+
+        const Eigen::Matrix<float, 6, 6> If = dynamics::Inertia::computeSpatialTensor(
+              float(mass), Eigen::Vector3f(com.cast<float>()),
+              Eigen::Matrix3f(moment.cast<float>()));
+        EXPECT_TRUE(equals(inertia.getSpatialTensor(),
+                           Eigen::Matrix6d(If.cast<double>()), 1e-4));
+
+        // The spatial tensor is linear in the mass for a fixed center of mass
+        // and a zero moment about it
+        const AutoDiff massd(mass, 1, 0);
+        const Matrix6<AutoDiff> Id = dynamics::Inertia::computeSpatialTensor(
+              massd, Eigen::Matrix<AutoDiff, 3, 1>(com.cast<AutoDiff>()),
+              Eigen::Matrix<AutoDiff, 3, 3>(moment.cast<AutoDiff>()));
+        const Eigen::Matrix6d expected = dynamics::Inertia::computeSpatialTensor(
+              1.0, com, Eigen::Matrix3d::Zero().eval());
+        for (int r = 0; r < 6; ++r)
+        {
+            for (int c = 0; c < 6; ++c)
+            {
+                EXPECT_NEAR(Id(r, c).value(),
+                            inertia.getSpatialTensor()(r, c), 1e-12);
+                ASSERT_EQ(Id(r, c).derivatives().size(), 1);
+                EXPECT_NEAR(Id(r, c).derivatives()[0], expected(r, c), 1e-12);
+            }
+        }
+    }
+}
+
 /******************************************************************************/
 int main(int argc, char* argv[])
 {
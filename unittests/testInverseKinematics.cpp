@@ -85,6 +85,236 @@ SkeletonPtr createFreeFloatingTwoLinkRobot(Vector3d dim1,
   return robot;
 }
 
+//==============================================================================
+Eigen::VectorXd computeReferenceDLS(const math::Jacobian& J,
+                                    const Eigen::Vector6d& error,
+                                    double damping)
+{
+  const double d2 = damping*damping;
+  if(J.rows() <= J.cols())
+    return J.transpose()*(d2*MatrixXd::Identity(J.rows(), J.rows())
+                          + J*J.transpose()).inverse()*error;
+
+  return (d2*MatrixXd::Identity(J.cols(), J.cols())
+          + J.transpose()*J).inverse()*J.transpose()*error;
+}
+
+//==============================================================================
+TEST(InverseKinematics, JacobianDLS)
+{
+  SkeletonPtr robot = createFreeFloatingTwoLinkRobot(
+        Vector3d(0.3, 0.3, 1.5), Vector3d(0.3, 0.3, 1.0), DOF_ROLL);
+  robot->setPositions(VectorXd::Random(robot->getNumDofs()));
+
+  BodyNode* ee = robot->getBodyNode("ee");
+  InverseKinematicsPtr ik = InverseKinematics::create(ee);
+  ik->setOffset(Vector3d(0.1, -0.2, 0.3));
+
+  // The Jacobian of the module must match the offset Jacobian of the node
+  const math::Jacobian fullJacobian = ee->getWorldJacobian(ik->getOffset());
+  const math::Jacobian& J = ik->computeJacobian();
+  for(size_t i=0; i < ik->getDofMap().size(); ++i)
+  {
+    const int j = ik->getDofMap()[i];
+    if(j >= 0)
+      EXPECT_TRUE(equals(J.col(j).eval(), fullJacobian.col(i).eval()));
+  }
+
+  InverseKinematics::JacobianDLS& dls =
+      dynamic_cast<InverseKinematics::JacobianDLS&>(ik->getGradientMethod());
+  dls.setComponentWiseClamp(1e10);
+
+  // More DOFs than task dimensions
+  Vector6d error = Vector6d::Random();
+  VectorXd grad;
+  dls.computeGradient(error, grad);
+  EXPECT_TRUE(equals(grad, computeReferenceDLS(J, error,
+                                               dls.getDampingCoefficient())));
+
+  // Fewer DOFs than task dimensions
+  ik->setDofs(std::vector<size_t>{0, 3, 6});
+  const math::Jacobian& smallJ = ik->computeJacobian();
+  EXPECT_EQ(smallJ.cols(), 3);
+  dls.computeGradient(error, grad);
+  EXPECT_TRUE(equals(grad, computeReferenceDLS(smallJ, error,
+                                               dls.getDampingCoefficient())));
+
+  // Changing the damping must take effect
+  dls.setDampingCoefficient(0.5);
+  dls.computeGradient(error, grad);
+  EXPECT_TRUE(equals(grad, computeReferenceDLS(smallJ, error, 0.5)));
+
+  // A reused factorization must still give exact results for new errors at the
+  // same joint positions
+  ik->useChain();
+  dls.setFactorizationReuse(true);
+  const math::Jacobian oldJ = ik->computeJacobian();
+  dls.computeGradient(error, grad);
+  error = Vector6d::Random();
+  dls.computeGradient(error, grad);
+  EXPECT_TRUE(equals(grad, computeReferenceDLS(oldJ, error, 0.5)));
+
+  // Moving the joints beyond the tolerance must refactorize
+  const VectorXd q = ik->getPositions();
+  ik->setPositions(q + VectorXd::Constant(q.size(), 0.1));
+  const math::Jacobian newJ = ik->computeJacobian();
+  dls.computeGradient(error, grad);
+  EXPECT_TRUE(equals(grad, computeReferenceDLS(newJ, error, 0.5)));
+
+  // Moves that are within the tolerance keep using the old factorization
+  dls.setFactorizationReuseTolerance(0.2);
+  ik->setPositions(q + VectorXd::Constant(q.size(), 0.2));
+  dls.computeGradient(error, grad);
+  EXPECT_TRUE(equals(grad, computeReferenceDLS(newJ, error, 0.5)));
+
+  dls.clearFactorization();
+  dls.computeGradient(error, grad);
+  EXPECT_TRUE(equals(grad, computeReferenceDLS(ik->computeJacobian(),
+                                               error, 0.5)));
+}
+
+//==============================================================================
+TEST(InverseKinematics, TargetMovedWhileChangeSignalsDisabled)
+{
+  SkeletonPtr robot = createFreeFloatingTwoLinkRobot(
+        Vector3d(0.3, 0.3, 1.5), Vector3d(0.3, 0.3, 1.0), DOF_ROLL);
+  robot->setPositions(VectorXd::Random(robot->getNumDofs()));
+
+  BodyNode* ee = robot->getBodyNode("ee");
+  InverseKinematicsPtr ik = InverseKinematics::create(ee);
+  InverseKinematics::ErrorMethod& errorMethod = ik->getErrorMethod();
+
+  const VectorXd q = ik->getPositions();
+  const Vector6d oldError = errorMethod.evalError(q);
+
+  const bool enabled = Entity::isEnabledChangeSignals();
+  Entity::disableChangeSignals();
+
+  // Moving the target must invalidate the cached error even though the
+  // change signals are disabled
+  Isometry3d tf = ik->getTarget()->getWorldTransform();
+  tf.translate(Vector3d(0.5, -0.5, 0.5));
+  ik->getTarget()->setTransform(tf);
+  const Vector6d newError = errorMethod.evalError(q);
+
+  if(enabled)
+    Entity::enableChangeSignals();
+
+  EXPECT_FALSE(equals(oldError, newError));
+  EXPECT_TRUE(equals(newError, errorMethod.computeError()));
+}
+
+//==============================================================================
+SkeletonPtr createRevoluteChain(size_t numLinks)
+{
+  SkeletonPtr robot = Skeleton::create();
+  BodyNode* bn = robot->createJointAndBodyNodePair<FreeJoint>().second;
+  for(size_t i=0; i < numLinks; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mAxis = (i%3 == 0)? Vector3d::UnitX()
+                     : (i%3 == 1)? Vector3d::UnitY() : Vector3d::UnitZ();
+    properties.mT_ParentBodyToJoint.translation() = Vector3d(0.0, 0.0, 0.3);
+    bn = robot->createJointAndBodyNodePair<RevoluteJoint>(bn, properties)
+        .second;
+  }
+
+  return robot;
+}
+
+//==============================================================================
+Eigen::MatrixXd computeReferenceNullSpace(const Eigen::MatrixXd& J)
+{
+  Eigen::JacobiSVD<Eigen::MatrixXd> svd(J, Eigen::ComputeFullV);
+  Eigen::MatrixXd NS;
+  math::extractNullSpace(svd, NS);
+  return NS*NS.transpose();
+}
+
+//==============================================================================
+TEST(InverseKinematics, HierarchicalNullSpaces)
+{
+  SkeletonPtr robot = createRevoluteChain(14);
+  robot->setPositions(VectorXd::Random(robot->getNumDofs()));
+  const size_t nDofs = robot->getNumDofs();
+
+  // Four levels, where the second level holds two modules whose null spaces do
+  // not commute
+  const size_t bodies[] = {4, 8, 10, 12, 14};
+  const size_t levels[] = {0, 1, 1, 2, 3};
+  for(size_t i=0; i < 5; ++i)
+  {
+    const InverseKinematicsPtr& ik =
+        robot->getBodyNode(bodies[i])->getIK(true);
+    ik->setHierarchyLevel(levels[i]);
+    ik->useWholeBody();
+  }
+
+  const std::shared_ptr<WholeBodyIK>& wholeBodyIK = robot->getIK(true);
+  wholeBodyIK->refreshIKHierarchy();
+  const std::vector<Eigen::MatrixXd>& nullspaces =
+      wholeBodyIK->computeNullSpaces();
+  ASSERT_EQ(nullspaces.size(), 4u);
+
+  const std::vector<HierarchicalIK::LevelStats>& stats =
+      wholeBodyIK->getLevelStats();
+  ASSERT_EQ(stats.size(), 4u);
+
+  Eigen::MatrixXd stackedJ(0, nDofs);
+  size_t totalRank = 0;
+  for(size_t level=0; level < 4; ++level)
+  {
+    for(size_t i=0; i < 5; ++i)
+    {
+      if(levels[i] != level)
+        continue;
+
+      const math::Jacobian J =
+          robot->getBodyNode(bodies[i])->getIK()->computeJacobian();
+      const std::vector<size_t>& dofs =
+          robot->getBodyNode(bodies[i])->getIK()->getDofs();
+
+      stackedJ.conservativeResize(stackedJ.rows()+6, nDofs);
+      stackedJ.bottomRows<6>().setZero();
+      for(size_t d=0; d < dofs.size(); ++d)
+        stackedJ.bottomRows<6>().col(dofs[d]) = J.col(d);
+    }
+
+    const Eigen::MatrixXd& NS = nullspaces[level];
+    EXPECT_TRUE(equals(NS, computeReferenceNullSpace(stackedJ), 1e-8));
+    EXPECT_TRUE(equals(NS, Eigen::MatrixXd(NS.transpose()), 1e-12));
+    EXPECT_TRUE(equals((NS*NS).eval(), NS, 1e-8));
+
+    totalRank += stats[level].mRank;
+    EXPECT_EQ(stats[level].mNumComputations, 1u);
+    EXPECT_GE(stats[level].mTotalTime, 0.0);
+  }
+  // The trace of a projector is the dimension of the space it projects onto
+  EXPECT_NEAR(static_cast<double>(nDofs - totalRank),
+              nullspaces.back().trace(), 1e-8);
+
+  // The same configuration reuses the cache
+  EXPECT_EQ(wholeBodyIK->getNumNullSpaceCacheHits(), 0u);
+  wholeBodyIK->computeNullSpaces();
+  EXPECT_EQ(wholeBodyIK->getNumNullSpaceCacheHits(), 1u);
+  EXPECT_EQ(stats[0].mNumComputations, 1u);
+
+  // Moving the Skeleton or deactivating a module invalidates the cache
+  robot->setPosition(7, robot->getPosition(7) + 0.1);
+  wholeBodyIK->computeNullSpaces();
+  EXPECT_EQ(stats[0].mNumComputations, 2u);
+
+  robot->getBodyNode(bodies[0])->getIK()->setInactive();
+  const Eigen::MatrixXd& firstNS = wholeBodyIK->computeNullSpaces()[0];
+  EXPECT_EQ(stats[0].mNumComputations, 3u);
+  EXPECT_EQ(stats[0].mRank, 0u);
+  EXPECT_TRUE(equals(firstNS, Eigen::MatrixXd::Identity(nDofs, nDofs).eval()));
+
+  wholeBodyIK->resetLevelStats();
+  EXPECT_EQ(stats[0].mNumComputations, 0u);
+  EXPECT_EQ(wholeBodyIK->getNumNullSpaceCacheHits(), 0u);
+}
+
 #ifdef HAVE_NLOPT
 //==============================================================================
 //TEST(InverseKinematics, FittingTransformation)
@@ -161,6 +161,31 @@ TEST(LocalResourceRetriever, retrieve_ResourceOperations)
   EXPECT_STREQ(content.c_str(), buffer.data());
 }
 
+TEST(LocalResourceRetriever, retrieve_DirectAccess)
+{
+  const std::string content = "Hello World";
+
+  LocalResourceRetriever retriever;
+  auto resource = retriever.retrieve(DART_DATA_PATH "test/hello_world.txt");
+  ASSERT_TRUE(resource != nullptr);
+
+  // Regular files are mapped into memory where the platform supports it.
+  const char* data = resource->getData();
+#ifndef _WIN32
+  ASSERT_TRUE(data != nullptr);
+#endif
+  if (data)
+  {
+    EXPECT_EQ(content, std::string(data, resource->getSize()));
+
+    // Reading does not affect the data pointer.
+    std::vector<char> buffer(content.size(), '\0');
+    ASSERT_EQ(1u, resource->read(buffer.data(), 5, 1));
+    EXPECT_EQ(5u, resource->tell());
+    EXPECT_EQ(data, resource->getData());
+  }
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
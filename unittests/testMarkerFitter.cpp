@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "TestHelpers.h"
+
+#include "dart/dynamics/FreeJoint.h"
+#include "dart/dynamics/RevoluteJoint.h"
+#include "dart/simulation/Recording.h"
+#include "dart/utils/FileInfoC3D.h"
+#include "dart/utils/FileInfoDof.h"
+#include "dart/utils/MarkerFitter.h"
+
+using namespace dart;
+using namespace dynamics;
+using namespace utils;
+
+//==============================================================================
+/// Creates an arm with a floating base and two revolute joints, with three
+/// Markers on each of its bodies
+SkeletonPtr createMarkerArm()
+{
+  SkeletonPtr skeleton = Skeleton::create("arm");
+
+  BodyNode* bn = skeleton->createJointAndBodyNodePair<FreeJoint>(
+        nullptr, FreeJoint::Properties(), BodyNode::Properties(
+          std::string("base"))).second;
+  for(size_t i = 0; i < 2; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mAxis = i == 0 ? Eigen::Vector3d::UnitY()
+                              : Eigen::Vector3d::UnitX();
+    properties.mT_ParentBodyToJoint.translation() =
+        Eigen::Vector3d(0.0, 0.0, 0.5);
+    properties.mName = "joint" + std::to_string(i);
+    bn = skeleton->createJointAndBodyNodePair<RevoluteJoint>(
+          bn, properties, BodyNode::Properties(
+            "link" + std::to_string(i))).second;
+  }
+
+  for(size_t i = 0; i < skeleton->getNumBodyNodes(); ++i)
+  {
+    BodyNode* body = skeleton->getBodyNode(i);
+    const std::string name = std::to_string(i);
+    body->addMarker(new Marker(name + "x", Eigen::Vector3d(0.1, 0.0, 0.2),
+                               body));
+    body->addMarker(new Marker(name + "y", Eigen::Vector3d(0.0, 0.1, 0.3),
+                               body));
+    body->addMarker(new Marker(name + "z", Eigen::Vector3d(0.0, -0.1, 0.4),
+                               body));
+  }
+
+  return skeleton;
+}
+
+//==============================================================================
+/// Records the Markers of _skeleton while it follows a smooth trajectory
+std::vector<Eigen::VectorXd> recordMarkers(const SkeletonPtr& _skeleton,
+                                           size_t _numFrames,
+                                           FileInfoC3D& _markers)
+{
+  std::vector<Eigen::VectorXd> poses;
+  for(size_t i = 0; i < _numFrames; ++i)
+  {
+    const double t = 0.01 * i;
+    Eigen::VectorXd q(_skeleton->getNumDofs());
+    q << 0.3 * std::sin(t), 0.2 * std::cos(t), 0.1 * t,
+         0.5 * t, std::sin(t), 0.2,
+         0.8 * std::sin(2.0 * t), 0.5 * std::cos(t);
+    _skeleton->setPositions(q);
+    poses.push_back(q);
+
+    Eigen::EIGEN_V_VEC3D frame;
+    for(size_t j = 0; j < _skeleton->getNumBodyNodes(); ++j)
+    {
+      const BodyNode* bn = _skeleton->getBodyNode(j);
+      for(size_t k = 0; k < bn->getNumMarkers(); ++k)
+        frame.push_back(bn->getMarker(k)->getWorldPosition());
+    }
+    _markers.addData(frame);
+  }
+
+  _skeleton->resetPositions();
+  return poses;
+}
+
+//==============================================================================
+TEST(MarkerFitter, FitsRecordedPoses)
+{
+  SkeletonPtr skeleton = createMarkerArm();
+  FileInfoC3D recorded;
+  const std::vector<Eigen::VectorXd> poses =
+      recordMarkers(skeleton, 400, recorded);
+
+  // Hide a marker of the floating base in one frame
+  FileInfoC3D markers;
+  for(int i = 0; i < recorded.getNumFrames(); ++i)
+  {
+    Eigen::EIGEN_V_VEC3D frame;
+    for(int j = 0; j < recorded.getNumMarkers(); ++j)
+      frame.push_back(recorded.getDataAt(i, j));
+    if(i == 200)
+      frame[0].setZero();
+    markers.addData(frame);
+  }
+
+  MarkerFitter fitter(skeleton, MarkerFitter::Properties(4, 50, 1e-10));
+  EXPECT_EQ(9u, fitter.getNumMarkers());
+
+  FileInfoDof dofs(skeleton.get());
+  ASSERT_TRUE(fitter.fit(markers, dofs));
+  ASSERT_EQ(400, dofs.getNumFrames());
+  const Eigen::VectorXd zero = Eigen::VectorXd::Zero(skeleton->getNumDofs());
+  EXPECT_TRUE(equals(zero, skeleton->getPositions(), 0.0));
+
+  for(size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_TRUE(equals(poses[i], dofs.getPoseAtFrame(i), 1e-6));
+    EXPECT_NEAR(0.0, fitter.getErrors()[i], 1e-6);
+  }
+
+  // The same poses are found on a single thread
+  fitter.setProperties(MarkerFitter::Properties(1, 50, 1e-10));
+  simulation::Recording recording(std::vector<SkeletonPtr>(1, skeleton));
+  ASSERT_TRUE(fitter.fit(markers, recording));
+  ASSERT_EQ(400, recording.getNumFrames());
+  for(size_t i = 0; i < poses.size(); ++i)
+    EXPECT_TRUE(equals(poses[i], recording.getConfig(i, 0), 1e-6));
+}
+
+//==============================================================================
+TEST(MarkerFitter, Correspondences)
+{
+  SkeletonPtr skeleton = createMarkerArm();
+  FileInfoC3D markers;
+  const std::vector<Eigen::VectorXd> poses =
+      recordMarkers(skeleton, 50, markers);
+
+  // Record the markers in reverse order
+  FileInfoC3D reversed;
+  for(int i = 0; i < markers.getNumFrames(); ++i)
+  {
+    Eigen::EIGEN_V_VEC3D frame;
+    for(int j = markers.getNumMarkers() - 1; j >= 0; --j)
+      frame.push_back(markers.getDataAt(i, j));
+    reversed.addData(frame);
+  }
+
+  MarkerFitter fitter(skeleton);
+  std::vector<int> correspondences;
+  for(int j = 8; j >= 0; --j)
+    correspondences.push_back(j);
+  fitter.setCorrespondences(correspondences);
+
+  std::vector<Eigen::VectorXd> fitted;
+  ASSERT_TRUE(fitter.fit(reversed, fitted));
+  ASSERT_EQ(poses.size(), fitted.size());
+  for(size_t i = 0; i < poses.size(); ++i)
+    EXPECT_TRUE(equals(poses[i], fitted[i], 1e-4));
+
+  correspondences[0] = 9;
+  fitter.setCorrespondences(correspondences);
+  EXPECT_FALSE(fitter.fit(reversed, fitted));
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include <assimp/scene.h>
+
+#include "dart/config.h"
+#include "dart/common/LocalResourceRetriever.h"
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/FreeJoint.h"
+#include "dart/dynamics/MeshCache.h"
+#include "dart/dynamics/MeshShape.h"
+#include "dart/dynamics/Skeleton.h"
+#include "dart/utils/MeshLoading.h"
+
+using namespace dart;
+using namespace dynamics;
+
+//==============================================================================
+/// Create a scene with a single tetrahedron, which has normals and colors
+aiScene* createTetrahedron()
+{
+  aiMesh* mesh = new aiMesh;
+  mesh->mMaterialIndex = 0;
+  mesh->mNumVertices = 4;
+  mesh->mVertices = new aiVector3D[4];
+  mesh->mNormals = new aiVector3D[4];
+  mesh->mColors[0] = new aiColor4D[4];
+  for(size_t i=0; i<4; ++i)
+  {
+    mesh->mVertices[i] = aiVector3D(i == 1, i == 2, i == 3);
+    mesh->mNormals[i] = aiVector3D(0.0f, 0.0f, 1.0f);
+    mesh->mColors[0][i] = aiColor4D(0.25f*i, 0.5f, 0.75f, 1.0f);
+  }
+
+  const unsigned int indices[4][3] = {{0, 2, 1}, {0, 1, 3}, {0, 3, 2},
+                                      {1, 2, 3}};
+  mesh->mNumFaces = 4;
+  mesh->mFaces = new aiFace[4];
+  for(size_t i=0; i<4; ++i)
+  {
+    mesh->mFaces[i].mNumIndices = 3;
+    mesh->mFaces[i].mIndices = new unsigned int[3];
+    for(size_t j=0; j<3; ++j)
+      mesh->mFaces[i].mIndices[j] = indices[i][j];
+  }
+
+  aiMaterial* material = new aiMaterial;
+  const aiColor4D diffuse(0.1f, 0.2f, 0.3f, 1.0f);
+  material->AddProperty(&diffuse, 1, AI_MATKEY_COLOR_DIFFUSE);
+
+  aiScene* scene = new aiScene;
+  scene->mNumMeshes = 1;
+  scene->mMeshes = new aiMesh*[1];
+  scene->mMeshes[0] = mesh;
+  scene->mNumMaterials = 1;
+  scene->mMaterials = new aiMaterial*[1];
+  scene->mMaterials[0] = material;
+
+  scene->mRootNode = new aiNode;
+  scene->mRootNode->mNumMeshes = 1;
+  scene->mRootNode->mMeshes = new unsigned int[1];
+  scene->mRootNode->mMeshes[0] = 0;
+
+  return scene;
+}
+
+//==============================================================================
+TEST(MeshCache, CompiledMeshRoundTrip)
+{
+  const std::string path = "testMeshCache.dartmesh";
+
+  std::unique_ptr<aiScene> original(createTetrahedron());
+  ASSERT_TRUE(MeshCache::writeCompiledMesh(original.get(), path, 42u));
+
+  uint64_t sourceHash = 0;
+  std::unique_ptr<aiScene> compiled(
+        MeshCache::readCompiledMesh(path, &sourceHash));
+  std::remove(path.c_str());
+
+  ASSERT_TRUE(compiled != nullptr);
+  EXPECT_EQ(sourceHash, 42u);
+  ASSERT_EQ(compiled->mNumMeshes, 1u);
+  ASSERT_EQ(compiled->mNumMaterials, 1u);
+  ASSERT_TRUE(compiled->mRootNode != nullptr);
+  ASSERT_EQ(compiled->mRootNode->mNumMeshes, 1u);
+  EXPECT_EQ(compiled->mRootNode->mMeshes[0], 0u);
+
+  const aiMesh* expected = original->mMeshes[0];
+  const aiMesh* actual = compiled->mMeshes[0];
+  ASSERT_EQ(actual->mNumVertices, expected->mNumVertices);
+  ASSERT_EQ(actual->mNumFaces, expected->mNumFaces);
+  ASSERT_TRUE(actual->mNormals != nullptr);
+  ASSERT_TRUE(actual->mColors[0] != nullptr);
+  EXPECT_TRUE(actual->mColors[1] == nullptr);
+
+  for(size_t i=0; i<actual->mNumVertices; ++i)
+  {
+    for(size_t j=0; j<3; ++j)
+    {
+      EXPECT_EQ(actual->mVertices[i][j], expected->mVertices[i][j]);
+      EXPECT_EQ(actual->mNormals[i][j], expected->mNormals[i][j]);
+    }
+    EXPECT_EQ(actual->mColors[0][i].r, expected->mColors[0][i].r);
+  }
+
+  for(size_t i=0; i<actual->mNumFaces; ++i)
+  {
+    ASSERT_EQ(actual->mFaces[i].mNumIndices, 3u);
+    for(size_t j=0; j<3; ++j)
+      EXPECT_EQ(actual->mFaces[i].mIndices[j], expected->mFaces[i].mIndices[j]);
+  }
+
+  aiColor4D diffuse;
+  ASSERT_EQ(aiGetMaterialColor(compiled->mMaterials[0],
+                               AI_MATKEY_COLOR_DIFFUSE, &diffuse), AI_SUCCESS);
+  EXPECT_EQ(diffuse.g, 0.2f);
+}
+
+//==============================================================================
+TEST(MeshCache, InvalidCompiledMesh)
+{
+  EXPECT_TRUE(MeshCache::readCompiledMesh("does_not_exist.dartmesh")
+              == nullptr);
+
+  const std::string path = "testMeshCacheInvalid.dartmesh";
+  std::unique_ptr<aiScene> original(createTetrahedron());
+  ASSERT_TRUE(MeshCache::writeCompiledMesh(original.get(), path));
+
+  // Truncate the file in the middle of the materials
+  FILE* file = std::fopen(path.c_str(), "r+b");
+  ASSERT_TRUE(file != nullptr);
+  char header[96];
+  ASSERT_EQ(std::fread(header, 1, sizeof(header), file), sizeof(header));
+  std::fclose(file);
+
+  file = std::fopen(path.c_str(), "wb");
+  std::fwrite(header, 1, sizeof(header), file);
+  std::fclose(file);
+
+  EXPECT_TRUE(MeshCache::readCompiledMesh(path) == nullptr);
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+TEST(MeshCache, SharesMeshes)
+{
+  const std::string uri = "file://" DART_DATA_PATH "sdf/atlas/r_foot.dae";
+  const auto retriever = std::make_shared<common::LocalResourceRetriever>();
+  MeshCache& cache = MeshCache::getInstance();
+
+  const size_t numMeshes = cache.getNumMeshes();
+  const aiScene* scene = MeshShape::loadMesh(uri, retriever);
+  ASSERT_TRUE(scene != nullptr);
+  EXPECT_EQ(cache.getUseCount(uri, retriever), 1u);
+  EXPECT_EQ(cache.getNumMeshes(), numMeshes + 1);
+
+  {
+    MeshShape shape1(Eigen::Vector3d::Ones(), scene, uri, retriever);
+    MeshShape shape2(Eigen::Vector3d::Ones(),
+                     MeshShape::loadMesh(uri, retriever), uri, retriever);
+    EXPECT_EQ(shape1.getMesh(), shape2.getMesh());
+    EXPECT_EQ(cache.getUseCount(uri, retriever), 2u);
+
+    // The alpha belongs to the shape and does not change the shared mesh
+    shape1.setAlpha(0.5);
+    EXPECT_TRUE(shape1.hasAlpha());
+    EXPECT_EQ(shape1.getRGBA()[3], 0.5);
+    EXPECT_FALSE(shape2.hasAlpha());
+    EXPECT_EQ(shape2.getRGBA()[3], 1.0);
+    EXPECT_EQ(shape1.getMesh(), shape2.getMesh());
+
+    // Another retriever may resolve the same URI differently, so it gets its
+    // own copy of the mesh
+    const auto otherRetriever
+        = std::make_shared<common::LocalResourceRetriever>();
+    const aiScene* otherScene = MeshShape::loadMesh(uri, otherRetriever);
+    ASSERT_TRUE(otherScene != nullptr);
+    EXPECT_NE(otherScene, scene);
+    EXPECT_EQ(cache.getUseCount(uri, retriever), 2u);
+    EXPECT_EQ(cache.getUseCount(uri, otherRetriever), 1u);
+    EXPECT_TRUE(cache.release(otherScene));
+    EXPECT_EQ(cache.getUseCount(uri, otherRetriever), 0u);
+  }
+
+  EXPECT_EQ(cache.getUseCount(uri, retriever), 0u);
+  EXPECT_EQ(cache.getNumMeshes(), numMeshes);
+
+  // Everything that falls back to the default retriever shares its meshes
+  const aiScene* defaultScene1 =
+      MeshShape::loadMesh(DART_DATA_PATH "sdf/atlas/r_foot.dae");
+  const aiScene* defaultScene2 =
+      MeshShape::loadMesh(DART_DATA_PATH "sdf/atlas/r_foot.dae");
+  ASSERT_TRUE(defaultScene1 != nullptr);
+  EXPECT_EQ(defaultScene1, defaultScene2);
+  EXPECT_EQ(cache.getUseCount(
+              uri, common::LocalResourceRetriever::getDefault()), 2u);
+  EXPECT_TRUE(cache.release(defaultScene1));
+  EXPECT_TRUE(cache.release(defaultScene2));
+  EXPECT_EQ(cache.getNumMeshes(), numMeshes);
+
+  // Meshes that are not managed by the cache are left alone
+  std::unique_ptr<aiScene> tetrahedron(createTetrahedron());
+  EXPECT_FALSE(cache.release(tetrahedron.get()));
+}
+
+//==============================================================================
+TEST(MeshCache, AsyncLoading)
+{
+  const std::string uri = "file://" DART_DATA_PATH "sdf/atlas/r_foot.dae";
+  const auto retriever = std::make_shared<common::LocalResourceRetriever>();
+  MeshCache& cache = MeshCache::getInstance();
+
+  // Requests for a mesh that is still being loaded share the same import
+  auto future1 = cache.acquireAsync(uri, retriever);
+  auto future2 = cache.acquireAsync(uri, retriever);
+  const aiScene* scene = future1.get();
+  ASSERT_TRUE(scene != nullptr);
+  EXPECT_EQ(future2.get(), scene);
+  EXPECT_EQ(cache.getUseCount(uri, retriever), 2u);
+  EXPECT_TRUE(cache.release(scene));
+  EXPECT_TRUE(cache.release(scene));
+  EXPECT_EQ(cache.getUseCount(uri, retriever), 0u);
+
+  const std::string missingUri = "file://" DART_DATA_PATH "missing.dae";
+  EXPECT_TRUE(cache.acquireAsync(missingUri, retriever).get() == nullptr);
+  EXPECT_EQ(cache.getUseCount(missingUri, retriever), 0u);
+}
+
+//==============================================================================
+TEST(MeshCache, DeferredMeshShapes)
+{
+  const std::string uri = "file://" DART_DATA_PATH "sdf/atlas/r_foot.dae";
+  const auto retriever = std::make_shared<common::LocalResourceRetriever>();
+  MeshCache& cache = MeshCache::getInstance();
+
+  {
+    MeshShape shape(Eigen::Vector3d::Ones(), nullptr);
+    shape.setMeshAsync(uri, retriever);
+    EXPECT_EQ(shape.getMeshUri(), uri);
+    ASSERT_TRUE(shape.getMesh() != nullptr);
+    EXPECT_TRUE(shape.isReady());
+    EXPECT_GT(shape.getVolume(), 0.0);
+    EXPECT_EQ(cache.getUseCount(uri, retriever), 1u);
+  }
+  EXPECT_EQ(cache.getUseCount(uri, retriever), 0u);
+
+  {
+    MeshShape shape(Eigen::Vector3d::Ones(), nullptr);
+    shape.setMeshLazy(uri, retriever);
+    EXPECT_FALSE(shape.isReady());
+    EXPECT_EQ(cache.getUseCount(uri, retriever), 0u);
+    EXPECT_EQ(shape.getVolume(), 0.0);
+    EXPECT_TRUE(shape.getBoundingBoxDim().isZero());
+
+    ASSERT_TRUE(shape.getMesh() != nullptr);
+    EXPECT_TRUE(shape.isReady());
+    EXPECT_EQ(cache.getUseCount(uri, retriever), 1u);
+  }
+  EXPECT_EQ(cache.getUseCount(uri, retriever), 0u);
+
+  // A shape that is destroyed before its mesh arrives gives the mesh back
+  {
+    MeshShape shape(Eigen::Vector3d::Ones(), nullptr);
+    shape.setMeshAsync(uri, retriever);
+  }
+  EXPECT_EQ(cache.getUseCount(uri, retriever), 0u);
+}
+
+//==============================================================================
+TEST(MeshCache, DeferredInertia)
+{
+  const std::string uri = "file://" DART_DATA_PATH "sdf/atlas/r_foot.dae";
+  const auto retriever = std::make_shared<common::LocalResourceRetriever>();
+  MeshCache& cache = MeshCache::getInstance();
+  const MeshCache::LoadingMode mode = cache.getLoadingMode();
+  cache.setLoadingMode(MeshCache::LOAD_VISUALS_LAZILY);
+
+  SkeletonPtr skeleton = Skeleton::create();
+  const Eigen::Vector3d size(0.1, 0.2, 0.3);
+
+  // The moment of inertia of a deferred visual mesh is computed from that
+  // mesh, just like in the other loading modes
+  BodyNode::Properties properties(std::string("lazy"));
+  properties.mInertia.setMass(2.0);
+  properties.mVizShapes.push_back(
+        utils::createMeshShape(Eigen::Vector3d::Ones(), uri, retriever, true));
+  properties.mColShapes.push_back(std::make_shared<BoxShape>(size));
+
+  Eigen::Matrix3d moment;
+  EXPECT_FALSE(utils::computeMomentOfInertia(
+                 properties.mVizShapes[0], 2.0, moment));
+  BodyNode* lazy = skeleton->createJointAndBodyNodePair<FreeJoint>(
+        nullptr, FreeJoint::Properties(), properties).second;
+
+  // A mesh that fails to load leaves the moment of inertia alone
+  properties.mName = "missing";
+  properties.mVizShapes.clear();
+  properties.mColShapes.clear();
+  properties.mVizShapes.push_back(utils::createMeshShape(
+        Eigen::Vector3d::Ones(), "file://" DART_DATA_PATH "missing.dae",
+        retriever, false));
+  EXPECT_FALSE(utils::computeMomentOfInertia(
+                 properties.mVizShapes[0], 2.0, moment));
+  BodyNode* missing = skeleton->createJointAndBodyNodePair<FreeJoint>(
+        lazy, FreeJoint::Properties(), properties).second;
+  const Eigen::Matrix3d defaultMoment = missing->getInertia().getMoment();
+
+  utils::finishLoadingMeshes(skeleton);
+  cache.setLoadingMode(mode);
+
+  const MeshShape loaded(Eigen::Vector3d::Ones(),
+                         MeshShape::loadMesh(uri, retriever), uri, retriever);
+  ASSERT_TRUE(loaded.getMesh() != nullptr);
+  EXPECT_TRUE(lazy->getInertia().getMoment().isApprox(
+                loaded.computeInertia(2.0)));
+  EXPECT_FALSE(lazy->getInertia().getMoment().isApprox(
+                 BoxShape(size).computeInertia(2.0)));
+  ASSERT_EQ(lazy->getNumVisualizationShapes(), 1u);
+  EXPECT_TRUE(std::static_pointer_cast<MeshShape>(
+                lazy->getVisualizationShape(0))->isReady());
+
+  EXPECT_EQ(missing->getNumVisualizationShapes(), 0u);
+  EXPECT_TRUE(missing->getInertia().getMoment().isApprox(defaultMoment));
+}
+
+//==============================================================================
+TEST(MeshCache, CompiledMeshDirectory)
+{
+  const std::string uri = "file://" DART_DATA_PATH "sdf/atlas/r_foot.dae";
+  const auto retriever = std::make_shared<common::LocalResourceRetriever>();
+  MeshCache& cache = MeshCache::getInstance();
+
+  cache.setCompiledMeshDirectory(".");
+
+  // The first load imports the mesh and compiles it
+  const aiScene* imported = MeshShape::loadMesh(uri, retriever);
+  ASSERT_TRUE(imported != nullptr);
+  std::vector<unsigned int> numVertices;
+  for(size_t i=0; i<imported->mNumMeshes; ++i)
+    numVertices.push_back(imported->mMeshes[i]->mNumVertices);
+  EXPECT_TRUE(cache.release(imported));
+
+  // The second load reads the compiled mesh
+  const aiScene* compiled = MeshShape::loadMesh(uri, retriever);
+  ASSERT_TRUE(compiled != nullptr);
+  ASSERT_EQ(compiled->mNumMeshes, numVertices.size());
+  for(size_t i=0; i<compiled->mNumMeshes; ++i)
+    EXPECT_EQ(compiled->mMeshes[i]->mNumVertices, numVertices[i]);
+  EXPECT_TRUE(cache.release(compiled));
+
+  cache.setCompiledMeshDirectory("");
+  EXPECT_TRUE(cache.getCompiledMeshDirectory().empty());
+
+  std::stringstream path;
+  path << "./" << std::hex << std::setw(16) << std::setfill('0')
+       << MeshCache::computeHash(uri.data(), uri.size()) << ".dartmesh";
+  std::unique_ptr<aiScene> file(MeshCache::readCompiledMesh(path.str()));
+  EXPECT_TRUE(file != nullptr);
+  std::remove(path.str().c_str());
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
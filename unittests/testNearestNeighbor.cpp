@@ -2,47 +2,222 @@
  * @file rrts02-nearestNeighbors.cpp
  * @author Can Erdogan
  * @date Feb 04, 2013
- * @brief Checks if the nearest neighbor computation done by flann is correct.
+ * @brief Checks if the nearest neighbor computation done by the planning index is correct and
+ * compares its speed to a linear scan.
  */
 
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <gtest/gtest.h>
-#include <flann/flann.hpp>
 #include <Eigen/Core>
 #include "TestHelpers.h"
+#include "dart/common/Timer.h"
+#include "dart/planning/NearestNeighbors.h"
+
+using namespace dart;
+using namespace planning;
+
+/* ********************************************************************************************* */
+/// Finds the k nearest points by checking all of them
+std::vector<size_t> bruteForceNearestK(const NearestNeighbors& index,
+    const Eigen::VectorXd& query, size_t k) {
+    std::vector<std::pair<double, size_t> > distances;
+    for(size_t i = 0; i < index.getSize(); i++) {
+        if(!index.isRemoved(i))
+            distances.push_back(std::make_pair(index.distance(query, index.getPoint(i)), i));
+    }
+    std::sort(distances.begin(), distances.end());
+
+    std::vector<size_t> result;
+    for(size_t i = 0; i < std::min(k, distances.size()); i++)
+        result.push_back(distances[i].second);
+    return result;
+}
 
 /* ********************************************************************************************* */
 TEST(NEAREST_NEIGHBOR, 2D) {
 
     // Build the index with the first node
-    flann::Index<flann::L2<double> > index (flann::KDTreeSingleIndexParams(10, true));
+    NearestNeighbors index(2);
     Eigen::VectorXd p1 (2);
     p1 << -3.04159, -3.04159;
-    index.buildIndex(flann::Matrix<double>((double*)p1.data(), 1, p1.size()));
+    index.add(p1);
 
     // Add two more points
     Eigen::Vector2d p2 (-2.96751, -2.97443), p3 (-2.91946, -2.88672);
-    index.addPoints(flann::Matrix<double>((double*)p2.data(), 1, p2.size()));
-    index.addPoints(flann::Matrix<double>((double*)p3.data(), 1, p3.size()));
+    index.add(p2);
+    index.add(p3);
 
     // Check the size of the tree
-    EXPECT_EQ(3, (int)index.size());
+    EXPECT_EQ(3, (int)index.getSize());
 
     // Get the nearest neighbor index for a sample point
     Eigen::Vector2d sample (-2.26654, 2.2874);
-    int nearest;
     double distance;
-    const flann::Matrix<double> queryMatrix((double*)sample.data(), 1, sample.size());
-    flann::Matrix<int> nearestMatrix(&nearest, 1, 1);
-    flann::Matrix<double> distanceMatrix(flann::Matrix<double>(&distance, 1, 1));
-    index.knnSearch(queryMatrix, nearestMatrix, distanceMatrix, 1,
-        flann::SearchParams(flann::FLANN_CHECKS_UNLIMITED));
+    int nearest = index.nearest(sample, &distance);
     EXPECT_EQ(2, nearest);
+    EXPECT_NEAR(distance, (sample - p3).norm(), 1e-12);
 
     // Get the nearest neighbor
-    double* point = index.getPoint(nearest);
-    bool equality = equals(Vector2d(point[0], point[1]), p3, 1e-3);
+    Eigen::Vector2d point = index.getPoint(nearest);
+    bool equality = equals(point, p3, 1e-3);
     EXPECT_TRUE(equality);
+
+    // Removed points are not returned anymore
+    index.remove(2);
+    EXPECT_EQ(1, index.nearest(sample));
+}
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, Queries) {
+
+    const size_t dim = 4;
+    const size_t numPoints = 3000;
+    NearestNeighbors index(dim);
+    srand(0);
+
+    // The last coordinate is a joint angle that wraps around, and the first one matters less
+    Eigen::VectorXd weights = Eigen::VectorXd::Ones(dim);
+    weights[0] = 0.25;
+    index.setWeights(weights);
+    index.setPeriod(dim - 1);
+
+    for(size_t i = 0; i < numPoints; i++) {
+        Eigen::VectorXd point = Eigen::VectorXd::Random(dim);
+        point[dim - 1] *= 6.0;
+        EXPECT_EQ(i, index.add(point));
+
+        // Some of the points are pruned, like in a lazy RRT
+        if(i % 7 == 3) index.remove(i - 2);
+    }
+    EXPECT_EQ(numPoints, index.getSize());
+
+    // Wrapping around makes angles that are a period apart equivalent
+    Eigen::VectorXd a = Eigen::VectorXd::Zero(dim), b = Eigen::VectorXd::Zero(dim);
+    a[dim - 1] = 3.1;
+    b[dim - 1] = -3.1;
+    EXPECT_NEAR(index.distance(a, b), 2.0 * M_PI - 6.2, 1e-12);
+
+    // The displacement takes the same shorter way, and its weighted length is the distance
+    Eigen::VectorXd displacement = index.difference(a, b);
+    EXPECT_NEAR(displacement[dim - 1], 2.0 * M_PI - 6.2, 1e-12);
+    b[0] = 1.0;
+    displacement = index.difference(a, b);
+    EXPECT_NEAR(std::sqrt(displacement.cwiseProduct(displacement).dot(weights)),
+                index.distance(a, b), 1e-12);
+
+    for(size_t n = 0; n < 100; n++) {
+        Eigen::VectorXd query = Eigen::VectorXd::Random(dim);
+        query[dim - 1] *= 10.0;
+
+        // The k nearest neighbors match a linear scan
+        std::vector<size_t> indices;
+        std::vector<double> distances;
+        index.nearestK(query, 10, indices, &distances);
+        std::vector<size_t> expected = bruteForceNearestK(index, query, 10);
+        ASSERT_EQ(expected.size(), indices.size());
+        for(size_t i = 0; i < indices.size(); i++) {
+            EXPECT_NEAR(index.distance(query, index.getPoint(expected[i])), distances[i], 1e-12);
+            EXPECT_NEAR(index.distance(query, index.getPoint(indices[i])), distances[i], 1e-12);
+        }
+
+        // The radius query finds exactly the points within the radius
+        const double radius = distances.back() + 1e-9;
+        index.nearestR(query, radius, indices, &distances);
+        size_t numWithinRadius = 0;
+        for(size_t i = 0; i < index.getSize(); i++) {
+            if(!index.isRemoved(i) && index.distance(query, index.getPoint(i)) <= radius)
+                numWithinRadius++;
+        }
+        EXPECT_EQ(numWithinRadius, indices.size());
+        EXPECT_TRUE(std::is_sorted(distances.begin(), distances.end()));
+    }
+}
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, Copy) {
+
+    // Enough points to fill several blocks, so the copy has to point at its own blocks
+    NearestNeighbors index(3);
+    srand(0);
+    for(size_t i = 0; i < 1000; i++)
+        index.add(Eigen::VectorXd::Random(3));
+    index.setPeriod(2);
+
+    NearestNeighbors copy(index);
+    NearestNeighbors assigned(1);
+    assigned = index;
+    index.clear();
+    for(size_t i = 0; i < 1000; i++)
+        index.add(Eigen::VectorXd::Constant(3, 5.0));
+
+    // The points of the copies are not affected by changes to the original
+    for(NearestNeighbors* other : {&copy, &assigned}) {
+        EXPECT_EQ(1000u, other->getSize());
+        EXPECT_EQ(3u, other->getDimension());
+        EXPECT_DOUBLE_EQ(2.0 * M_PI, other->getPeriod(2));
+
+        srand(0);
+        for(size_t i = 0; i < 1000; i++) {
+            const Eigen::VectorXd point = Eigen::VectorXd::Random(3);
+            EXPECT_TRUE(point.isApprox(other->getPoint(i)));
+            EXPECT_EQ(static_cast<int>(i), other->nearest(point));
+        }
+
+        // New points go into the blocks of the copy
+        EXPECT_EQ(1000u, other->add(Eigen::VectorXd::Constant(3, 9.0)));
+        EXPECT_EQ(1000, other->nearest(Eigen::VectorXd::Constant(3, 9.0)));
+    }
+}
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, Benchmark) {
+
+    const size_t dim = 7;
+    const size_t numNodes = 10000;
+    const double stepSize = 0.05;
+    srand(0);
+
+    std::vector<Eigen::VectorXd> samples(numNodes);
+    for(size_t i = 0; i < numNodes; i++) samples[i] = Eigen::VectorXd::Random(dim);
+
+    // Grow a tree like an RRT does: find the node nearest to a random sample and take a step
+    // from it towards the sample
+    NearestNeighbors index(dim);
+    index.add(Eigen::VectorXd::Zero(dim));
+    std::vector<int> indexResults(numNodes), linearResults(numNodes);
+
+    common::Timer indexTimer("NearestNeighbors");
+    indexTimer.start();
+    for(size_t n = 0; n < numNodes; n++) {
+        indexResults[n] = index.nearest(samples[n]);
+        Eigen::VectorXd nearest = index.getPoint(indexResults[n]);
+        index.add(nearest + stepSize * (samples[n] - nearest).normalized());
+    }
+    indexTimer.stop();
+
+    // Replay the same queries with a linear scan over the nodes that existed at the time
+    common::Timer linearTimer("Linear scan");
+    linearTimer.start();
+    for(size_t n = 0; n < numNodes; n++) {
+        double best = std::numeric_limits<double>::infinity();
+        for(size_t i = 0; i <= n; i++) {
+            double distance = (index.getPoint(i) - samples[n]).squaredNorm();
+            if(distance < best) {
+                best = distance;
+                linearResults[n] = i;
+            }
+        }
+    }
+    linearTimer.stop();
+
+    indexTimer.print();
+    linearTimer.print();
+
+    for(size_t n = 0; n < numNodes; n++)
+        EXPECT_EQ(linearResults[n], indexResults[n]);
 }
 
 /* ********************************************************************************************* */
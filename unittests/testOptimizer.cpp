@@ -39,6 +39,8 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <atomic>
+#include <stdexcept>
 #include <gtest/gtest.h>
 #include <Eigen/Dense>
 #include "TestHelpers.h"
@@ -47,9 +49,12 @@
 #include "dart/optimizer/Function.h"
 #include "dart/optimizer/Problem.h"
 #include "dart/optimizer/GradientDescentSolver.h"
+#include "dart/optimizer/LevenbergMarquardtSolver.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/FreeJoint.h"
+#include "dart/dynamics/RevoluteJoint.h"
 #include "dart/dynamics/InverseKinematics.h"
+#include "dart/dynamics/HierarchicalIK.h"
 #ifdef HAVE_NLOPT
   #include "dart/optimizer/nlopt/NloptSolver.h"
 #endif
@@ -146,6 +151,76 @@ TEST(Optimizer, GradientDescent)
   EXPECT_NEAR(optX[1], 0.0, solver.getTolerance());
 }
 
+//==============================================================================
+/// Residual form of the Rosenbrock function
+class RosenbrockResidual : public LeastSquaresFunction
+{
+public:
+  /// \copydoc LeastSquaresFunction::getNumResiduals
+  virtual size_t getNumResiduals() const override
+  {
+    return 2;
+  }
+
+  /// \copydoc LeastSquaresFunction::evalResidual
+  virtual void evalResidual(const Eigen::VectorXd& _x,
+                            Eigen::VectorXd& _residual) override
+  {
+    _residual.resize(2);
+    _residual[0] = 10.0*(_x[1] - _x[0]*_x[0]);
+    _residual[1] = 1.0 - _x[0];
+  }
+
+  /// \copydoc LeastSquaresFunction::evalJacobian
+  virtual void evalJacobian(const Eigen::VectorXd& _x,
+                            Eigen::MatrixXd& _jacobian) override
+  {
+    _jacobian.resize(2, 2);
+    _jacobian << -20.0*_x[0], 10.0,
+                 -1.0,        0.0;
+  }
+};
+
+//==============================================================================
+TEST(Optimizer, LevenbergMarquardt)
+{
+  std::shared_ptr<Problem> prob = std::make_shared<Problem>(2);
+  prob->setInitialGuess(Eigen::Vector2d(-1.2, 1.0));
+
+  FunctionPtr obj = std::make_shared<RosenbrockResidual>();
+  prob->setObjective(obj);
+
+  // The least-squares form evaluates to 0.5*r^T*r with gradient J^T*r
+  Eigen::VectorXd grad(2);
+  Eigen::Map<Eigen::VectorXd> gradMap(grad.data(), grad.size());
+  obj->evalGradient(Eigen::Vector2d(-1.2, 1.0), gradMap);
+  EXPECT_NEAR(obj->eval(Eigen::Vector2d(-1.2, 1.0)), 12.1, 1e-10);
+  EXPECT_NEAR(grad[0], -107.8, 1e-10);
+  EXPECT_NEAR(grad[1], -44.0, 1e-10);
+
+  LevenbergMarquardtSolver solver(prob);
+  solver.setNumMaxIterations(200);
+  EXPECT_TRUE(solver.solve());
+  Eigen::VectorXd expected = Eigen::Vector2d(1.0, 1.0);
+  EXPECT_TRUE(equals(prob->getOptimalSolution(), expected, 1e-6));
+  EXPECT_NEAR(prob->getOptimumValue(), 0.0, 1e-12);
+  EXPECT_LT(solver.getLastNumIterations(), 200u);
+
+  // The steps must respect the bounds of the Problem
+  prob->setUpperBounds(Eigen::Vector2d(0.5, HUGE_VAL));
+  EXPECT_TRUE(solver.solve());
+  expected = Eigen::Vector2d(0.5, 0.25);
+  EXPECT_TRUE(equals(prob->getOptimalSolution(), expected, 1e-6));
+
+  // Ordinary constraint functions contribute a single residual
+  prob->setUpperBounds(Eigen::Vector2d::Constant(HUGE_VAL));
+  prob->setInitialGuess(Eigen::Vector2d(0.5, 3.0));
+  prob->addEqConstraint(std::make_shared<SampleConstFunc>(1.0, 0.0));
+  EXPECT_TRUE(solver.solve());
+  const Eigen::VectorXd x = prob->getOptimalSolution();
+  EXPECT_NEAR(x[0]*x[0]*x[0], x[1], solver.getTolerance());
+}
+
 //==============================================================================
 #ifdef HAVE_NLOPT
 TEST(Optimizer, BasicNlopt)
@@ -250,6 +325,310 @@ TEST(Optimizer, InverseKinematics)
                      skel->getBodyNode(0)->getTransform().matrix(), 1e-8));
 }
 
+//==============================================================================
+TEST(Optimizer, StopFlag)
+{
+  std::shared_ptr<Problem> prob = std::make_shared<Problem>(2);
+  prob->setLowerBounds(Eigen::Vector2d(-HUGE_VAL, 0));
+  prob->setInitialGuess(Eigen::Vector2d(1.234, 5.678));
+  prob->setObjective(std::make_shared<SampleObjFunc>());
+
+  std::atomic<bool> stop(true);
+  GradientDescentSolver gradientDescent(prob);
+  gradientDescent.setStopFlag(&stop);
+  EXPECT_FALSE(gradientDescent.solve());
+  EXPECT_EQ(gradientDescent.getLastNumIterations(), 0u);
+
+  std::shared_ptr<Problem> lsProb = std::make_shared<Problem>(2);
+  lsProb->setInitialGuess(Eigen::Vector2d(-1.2, 1.0));
+  lsProb->setObjective(std::make_shared<RosenbrockResidual>());
+  LevenbergMarquardtSolver levenbergMarquardt(lsProb);
+  levenbergMarquardt.setStopFlag(&stop);
+  EXPECT_FALSE(levenbergMarquardt.solve());
+
+  // Lowering the flag lets the solvers run to completion again
+  stop = false;
+  EXPECT_TRUE(gradientDescent.solve());
+  levenbergMarquardt.setNumMaxIterations(200);
+  EXPECT_TRUE(levenbergMarquardt.solve());
+}
+
+//==============================================================================
+/// Constraint that always fails to evaluate
+class ThrowingFunc : public Function
+{
+public:
+  /// \copydoc Function::eval
+  virtual double eval(const Eigen::VectorXd&) override
+  {
+    throw std::runtime_error("ThrowingFunc");
+  }
+};
+
+//==============================================================================
+/// IK objective that does nothing but count how often it gets cloned
+class CountingIkFunc : public Function, public InverseKinematics::Function
+{
+public:
+  explicit CountingIkFunc(size_t* _numClones) : mNumClones(_numClones) {}
+
+  /// \copydoc InverseKinematics::Function::clone
+  virtual FunctionPtr clone(InverseKinematics*) const override
+  {
+    ++(*mNumClones);
+    return std::make_shared<CountingIkFunc>(mNumClones);
+  }
+
+  /// \copydoc Function::eval
+  virtual double eval(const Eigen::VectorXd&) override
+  {
+    return 0.0;
+  }
+
+private:
+  size_t* mNumClones;
+};
+
+//==============================================================================
+TEST(Optimizer, ParallelInverseKinematics)
+{
+  // Planar arm made of three revolute joints. Only the position of the end of
+  // the arm is constrained.
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* bn = nullptr;
+  for(size_t i=0; i < 3; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mName = "joint" + std::to_string(i);
+    properties.mAxis = Eigen::Vector3d::UnitZ();
+    properties.mT_ParentBodyToJoint.translation() =
+        Eigen::Vector3d(bn? 1.0 : 0.0, 0.0, 0.0);
+    properties.mPositionLowerLimit = -0.9*M_PI;
+    properties.mPositionUpperLimit =  0.9*M_PI;
+    bn = skel->createJointAndBodyNodePair<RevoluteJoint>(
+          bn, properties, BodyNode::Properties("link" + std::to_string(i)))
+        .second;
+  }
+
+  std::shared_ptr<InverseKinematics> ik = bn->getIK(true);
+  ik->setOffset(Eigen::Vector3d(1.0, 0.0, 0.0));
+
+  Eigen::Vector6d lower = Eigen::Vector6d::Constant(-1e-8);
+  Eigen::Vector6d upper = Eigen::Vector6d::Constant( 1e-8);
+  lower.head<3>().setConstant(-HUGE_VAL);
+  upper.head<3>().setConstant( HUGE_VAL);
+  ik->getErrorMethod().setBounds(lower, upper);
+  ik->getSolver()->setNumMaxIterations(200);
+
+  ik->setParallelProperties(InverseKinematics::ParallelProperties(
+                              2, 32, InverseKinematics::FIRST_SOLUTION));
+
+  const Eigen::Vector3d target(-1.2, 1.5, 0.0);
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translation() = target;
+  ik->getTarget()->setTransform(tf);
+
+  const Eigen::VectorXd original = skel->getPositions();
+  Eigen::VectorXd solution;
+  EXPECT_TRUE(ik->solveParallel(solution, false));
+  EXPECT_TRUE(equals(skel->getPositions(), original));
+  EXPECT_EQ(solution.size(), 3);
+
+  skel->setPositions(solution);
+  Eigen::Vector3d reached = bn->getWorldTransform()*ik->getOffset();
+  EXPECT_TRUE(equals(reached, target, 1e-6));
+  for(size_t i=0; i < 3; ++i)
+  {
+    EXPECT_LE(std::abs(solution[i]), 0.9*M_PI + 1e-12);
+  }
+
+  // Solving again reuses the workers and applies the solution
+  skel->setPositions(original);
+  ik->setParallelProperties(InverseKinematics::ParallelProperties(
+                              2, 32, InverseKinematics::BEST_SOLUTION));
+  EXPECT_TRUE(ik->solveParallel(true));
+  reached = bn->getWorldTransform()*ik->getOffset();
+  EXPECT_TRUE(equals(reached, target, 1e-6));
+  EXPECT_TRUE(equals(ik->getProblem()->getOptimalSolution(),
+                     skel->getPositions()));
+
+  // A target that is out of reach cannot be solved, and the Skeleton must be
+  // left alone
+  skel->setPositions(original);
+  tf.translation() = Eigen::Vector3d(5.0, 0.0, 0.0);
+  ik->getTarget()->setTransform(tf);
+  EXPECT_FALSE(ik->solveParallel(true));
+  EXPECT_TRUE(equals(skel->getPositions(), original));
+
+  // Replacing the ErrorMethod after the workers were created must reach them
+  ik->setErrorMethod<InverseKinematics::TaskSpaceRegion>(
+        InverseKinematics::ErrorMethod::Properties(
+          InverseKinematics::ErrorMethod::Bounds(
+            Eigen::Vector6d::Constant(-HUGE_VAL),
+            Eigen::Vector6d::Constant( HUGE_VAL))));
+  EXPECT_TRUE(ik->solveParallel(solution, false));
+
+  // The workers only clone the objectives again after they were replaced
+  size_t numClones = 0;
+  ik->setObjective(std::make_shared<CountingIkFunc>(&numClones));
+  EXPECT_TRUE(ik->solveParallel(solution, false));
+  EXPECT_EQ(numClones, 2u);
+  EXPECT_TRUE(ik->solveParallel(solution, false));
+  EXPECT_EQ(numClones, 2u);
+  ik->setObjective(std::make_shared<CountingIkFunc>(&numClones));
+  EXPECT_TRUE(ik->solveParallel(solution, false));
+  EXPECT_EQ(numClones, 4u);
+
+  // An exception thrown by a worker reaches the caller once every worker has
+  // finished, and the Skeleton is left alone
+  ik->getProblem()->addEqConstraint(std::make_shared<ThrowingFunc>());
+  ik->clearParallelWorkers();
+  EXPECT_THROW(ik->solveParallel(true), std::runtime_error);
+  EXPECT_TRUE(equals(skel->getPositions(), original));
+}
+
+//==============================================================================
+TEST(Optimizer, LevenbergMarquardtInverseKinematics)
+{
+  SkeletonPtr skel = Skeleton::create();
+  skel->createJointAndBodyNodePair<FreeJoint>();
+
+  std::shared_ptr<InverseKinematics> ik = skel->getBodyNode(0)->getIK(true);
+  ik->setSolver(std::make_shared<LevenbergMarquardtSolver>());
+
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translation() = Eigen::Vector3d(0.0, 0.0, 0.8);
+  tf.rotate(Eigen::AngleAxisd(M_PI/8, Eigen::Vector3d(0, 1, 0)));
+  ik->getTarget()->setTransform(tf);
+
+  ik->getErrorMethod().setBounds(Eigen::Vector6d::Constant(-1e-8),
+                                Eigen::Vector6d::Constant( 1e-8));
+
+  ik->getSolver()->setNumMaxIterations(100);
+  EXPECT_TRUE(ik->solve());
+  EXPECT_TRUE(equals(ik->getTarget()->getTransform().matrix(),
+                     skel->getBodyNode(0)->getTransform().matrix(), 1e-8));
+
+  // Planar arm made of three revolute joints, solved through the whole-body
+  // IK module
+  skel = Skeleton::create();
+  BodyNode* bn = nullptr;
+  for(size_t i=0; i < 3; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mName = "joint" + std::to_string(i);
+    properties.mAxis = Eigen::Vector3d::UnitZ();
+    properties.mT_ParentBodyToJoint.translation() =
+        Eigen::Vector3d(bn? 1.0 : 0.0, 0.0, 0.0);
+    properties.mPositionLowerLimit = -0.9*M_PI;
+    properties.mPositionUpperLimit =  0.9*M_PI;
+    bn = skel->createJointAndBodyNodePair<RevoluteJoint>(
+          bn, properties, BodyNode::Properties("link" + std::to_string(i)))
+        .second;
+  }
+  skel->setPositions(Eigen::Vector3d(0.3, 0.3, 0.3));
+
+  ik = bn->getIK(true);
+  ik->setOffset(Eigen::Vector3d(1.0, 0.0, 0.0));
+
+  Eigen::Vector6d lower = Eigen::Vector6d::Constant(-1e-8);
+  Eigen::Vector6d upper = Eigen::Vector6d::Constant( 1e-8);
+  lower.head<3>().setConstant(-HUGE_VAL);
+  upper.head<3>().setConstant( HUGE_VAL);
+  ik->getErrorMethod().setBounds(lower, upper);
+
+  const Eigen::Vector3d target(1.0, 1.5, 0.0);
+  tf.setIdentity();
+  tf.translation() = target;
+  ik->getTarget()->setTransform(tf);
+
+  std::shared_ptr<HierarchicalIK> wholeBodyIK = skel->getIK(true);
+  wholeBodyIK->setSolver(std::make_shared<LevenbergMarquardtSolver>());
+  wholeBodyIK->getSolver()->setNumMaxIterations(100);
+  EXPECT_TRUE(wholeBodyIK->solve());
+
+  const Eigen::Vector3d reached = bn->getWorldTransform()*ik->getOffset();
+  EXPECT_TRUE(equals(reached, target, 1e-6));
+  for(size_t i=0; i < 3; ++i)
+  {
+    EXPECT_LE(std::abs(skel->getPosition(i)), 0.9*M_PI + 1e-12);
+  }
+
+  // The least-squares Solver cannot keep the priorities of several levels, so
+  // it must refuse them and leave the Skeleton alone
+  const Eigen::VectorXd solved = skel->getPositions();
+  std::shared_ptr<InverseKinematics> lowerIK =
+      skel->getBodyNode(1)->getIK(true);
+  lowerIK->setHierarchyLevel(1);
+  lowerIK->getTarget()->setTransform(
+        skel->getBodyNode(0)->getWorldTransform());
+  EXPECT_FALSE(wholeBodyIK->solve());
+  EXPECT_TRUE(equals(skel->getPositions(), solved));
+
+  lowerIK->setActive(false);
+  EXPECT_TRUE(wholeBodyIK->solve());
+}
+
+//==============================================================================
+TEST(Optimizer, InverseKinematicsErrorClamp)
+{
+  SkeletonPtr skel = Skeleton::create();
+  skel->createJointAndBodyNodePair<FreeJoint>();
+  std::shared_ptr<InverseKinematics> ik = skel->getBodyNode(0)->getIK(true);
+
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translation() = Eigen::Vector3d(10.0, 0.0, 0.0);
+  ik->getTarget()->setTransform(tf);
+
+  // The TaskSpaceRegion clamps the length of the error that every Solver sees
+  // by default, while least-squares Solvers get the true error
+  InverseKinematics::ErrorMethod& method = ik->getErrorMethod();
+  const Eigen::VectorXd q = ik->getPositions();
+  EXPECT_NEAR(method.computeError().norm(), DefaultIKErrorClamp, 1e-12);
+  EXPECT_NEAR(method.evalError(q).norm(), DefaultIKErrorClamp, 1e-12);
+  EXPECT_NEAR(method.evalUnclampedError(q).norm(), 10.0, 1e-12);
+}
+
+//==============================================================================
+TEST(Optimizer, DefaultInverseKinematicsSolver)
+{
+  SkeletonPtr skel = Skeleton::create();
+  skel->createJointAndBodyNodePair<FreeJoint>();
+
+  EXPECT_TRUE(std::dynamic_pointer_cast<GradientDescentSolver>(
+                skel->getBodyNode(0)->createIK()->getSolver()) != nullptr);
+
+  InverseKinematics::setDefaultSolverType(
+        InverseKinematics::LEVENBERG_MARQUARDT_SOLVER);
+  HierarchicalIK::setDefaultSolverType(
+        InverseKinematics::LEVENBERG_MARQUARDT_SOLVER);
+
+  std::shared_ptr<InverseKinematics> ik = skel->getBodyNode(0)->createIK();
+  std::shared_ptr<HierarchicalIK> wholeBodyIK = skel->createIK();
+
+  InverseKinematics::setDefaultSolverType(
+        InverseKinematics::GRADIENT_DESCENT_SOLVER);
+  HierarchicalIK::setDefaultSolverType(
+        InverseKinematics::GRADIENT_DESCENT_SOLVER);
+
+  EXPECT_TRUE(std::dynamic_pointer_cast<LevenbergMarquardtSolver>(
+                ik->getSolver()) != nullptr);
+  EXPECT_TRUE(std::dynamic_pointer_cast<LevenbergMarquardtSolver>(
+                wholeBodyIK->getSolver()) != nullptr);
+  EXPECT_TRUE(ik->getSolver()->getProblem() == ik->getProblem());
+  EXPECT_TRUE(wholeBodyIK->getSolver()->getProblem()
+              == wholeBodyIK->getProblem());
+
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translation() = Eigen::Vector3d(0.0, 0.0, 0.8);
+  ik->getTarget()->setTransform(tf);
+  ik->getErrorMethod().setBounds(Eigen::Vector6d::Constant(-1e-8),
+                                Eigen::Vector6d::Constant( 1e-8));
+  EXPECT_TRUE(ik->solve());
+  EXPECT_TRUE(equals(ik->getTarget()->getTransform().matrix(),
+                     skel->getBodyNode(0)->getTransform().matrix(), 1e-8));
+}
+
 //==============================================================================
 bool compareStringAndFile(const std::string& content,
                           const std::string& fileName)
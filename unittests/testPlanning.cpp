@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dart/config.h"
+#include "dart/dynamics/dynamics.h"
+#include "dart/simulation/simulation.h"
+#include "dart/utils/SkelParser.h"
+#include "dart/planning/EdgeValidator.h"
+#include "dart/planning/LazyRRT.h"
+#include "dart/planning/PathFollowingTrajectory.h"
+#include "dart/planning/PathPlanner.h"
+
+using namespace dart;
+using namespace dynamics;
+using namespace simulation;
+using namespace planning;
+
+//==============================================================================
+SkeletonPtr createSlider()
+{
+  SkeletonPtr slider = Skeleton::create("slider");
+
+  PrismaticJoint::Properties properties;
+  properties.mAxis = Eigen::Vector3d::UnitX();
+  BodyNode* bn = slider->createJointAndBodyNodePair<PrismaticJoint>(
+        nullptr, properties).second;
+  bn->addCollisionShape(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1)));
+
+  return slider;
+}
+
+//==============================================================================
+SkeletonPtr createObstacle(double _x)
+{
+  SkeletonPtr obstacle = Skeleton::create("obstacle");
+
+  BodyNode* bn = obstacle->createJointAndBodyNodePair<FreeJoint>().second;
+  bn->addCollisionShape(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1)));
+
+  Eigen::Vector6d positions = Eigen::Vector6d::Zero();
+  positions[3] = _x;
+  obstacle->setPositions(positions);
+
+  return obstacle;
+}
+
+//==============================================================================
+SkeletonPtr createPendulum()
+{
+  SkeletonPtr pendulum = Skeleton::create("pendulum");
+
+  RevoluteJoint::Properties properties;
+  properties.mAxis = Eigen::Vector3d::UnitZ();
+  properties.mPositionLowerLimit = -DART_PI;
+  properties.mPositionUpperLimit = DART_PI;
+  BodyNode* bn = pendulum->createJointAndBodyNodePair<RevoluteJoint>(
+        nullptr, properties).second;
+
+  // The box swings on a circle of radius 0.5 about the joint
+  ShapePtr box = std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1));
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translation() = Eigen::Vector3d(0.5, 0.0, 0.0);
+  box->setLocalTransform(tf);
+  bn->addCollisionShape(box);
+
+  return pendulum;
+}
+
+//==============================================================================
+size_t findFirstCollisionSerially(const WorldPtr& _world,
+                                  const SkeletonPtr& _robot,
+                                  const std::vector<size_t>& _dofs,
+                                  const std::vector<Eigen::VectorXd>& _states)
+{
+  const Eigen::VectorXd savedPositions = _robot->getPositions(_dofs);
+
+  size_t result = _states.size();
+  for(size_t i=0; i < _states.size(); ++i)
+  {
+    _robot->setPositions(_dofs, _states[i]);
+    if(_world->checkCollision(_robot, _dofs))
+    {
+      result = i;
+      break;
+    }
+  }
+
+  _robot->setPositions(_dofs, savedPositions);
+  return result;
+}
+
+//==============================================================================
+TEST(EdgeValidator, FindFirstCollision)
+{
+  WorldPtr world(new World);
+  SkeletonPtr robot = createSlider();
+  SkeletonPtr obstacle = createObstacle(0.5);
+  world->addSkeleton(robot);
+  world->addSkeleton(obstacle);
+
+  const std::vector<size_t> dofs(1, 0);
+  const Eigen::VectorXd start = Eigen::VectorXd::Constant(1, 0.0);
+  const Eigen::VectorXd goal = Eigen::VectorXd::Constant(1, 1.0);
+  const Eigen::VectorXd shortGoal = Eigen::VectorXd::Constant(1, 0.3);
+
+  for(size_t numThreads = 1; numThreads <= 4; ++numThreads)
+  {
+    EdgeValidator validator(world, robot, dofs, 0.05, numThreads);
+    EXPECT_EQ(validator.getNumThreads(), numThreads);
+
+    // The states are evenly spaced and do not include the endpoints
+    std::vector<Eigen::VectorXd> states;
+    validator.discretize(start, goal, states);
+    ASSERT_EQ(states.size(), 19u);
+    EXPECT_NEAR(states.front()[0], 0.05, 1e-12);
+    EXPECT_NEAR(states.back()[0], 0.95, 1e-12);
+
+    // The first collision matches the one found by checking the states in
+    // order in the original world
+    const size_t expected
+        = findFirstCollisionSerially(world, robot, dofs, states);
+    EXPECT_LT(expected, states.size());
+    EXPECT_EQ(validator.findFirstCollision(states), expected);
+
+    // A colliding segment does not touch the intermediate points
+    std::vector<Eigen::VectorXd> intermediatePoints(2, start);
+    EXPECT_FALSE(validator.isSegmentCollisionFree(start, goal,
+                                                  &intermediatePoints));
+    EXPECT_EQ(intermediatePoints.size(), 2u);
+
+    // A collision-free segment returns the states that were checked
+    EXPECT_TRUE(validator.isSegmentCollisionFree(start, shortGoal,
+                                                 &intermediatePoints));
+    EXPECT_EQ(intermediatePoints.size(), 5u);
+
+    // Moving an obstacle in the original world is picked up by the clones
+    Eigen::Vector6d positions = obstacle->getPositions();
+    positions[3] = 2.0;
+    obstacle->setPositions(positions);
+    EXPECT_TRUE(validator.isSegmentCollisionFree(start, goal));
+    positions[3] = 0.5;
+    obstacle->setPositions(positions);
+    EXPECT_FALSE(validator.isSegmentCollisionFree(start, goal));
+
+    // The robot of the original world is never moved
+    EXPECT_EQ(robot->getPosition(0), 0.0);
+  }
+}
+
+//==============================================================================
+TEST(LazyRRT, ValidatePath)
+{
+  WorldPtr world(new World);
+  SkeletonPtr robot = createSlider();
+  world->addSkeleton(robot);
+  world->addSkeleton(createObstacle(0.5));
+
+  const std::vector<size_t> dofs(1, 0);
+  const Eigen::VectorXd start = Eigen::VectorXd::Constant(1, 0.0);
+  const Eigen::VectorXd goal = Eigen::VectorXd::Constant(1, 1.0);
+
+  std::shared_ptr<EdgeValidator> validators[2]
+      = { nullptr, std::make_shared<EdgeValidator>(world, robot, dofs, 0.1) };
+
+  for(size_t v = 0; v < 2; ++v)
+  {
+    LazyRRT rrt(world, robot, dofs, start, 0.1, validators[v]);
+
+    // Without collision checks the tree grows straight through the obstacle
+    EXPECT_TRUE(rrt.connect(goal));
+    const size_t numNodes = rrt.getSize();
+    ASSERT_GT(numNodes, 2u);
+
+    std::vector<Eigen::VectorXd> states;
+    for(size_t i = 1; i < numNodes; ++i)
+      states.push_back(rrt.getConfig(i));
+    const size_t expected
+        = findFirstCollisionSerially(world, robot, dofs, states) + 1;
+    ASSERT_LT(expected, numNodes);
+
+    // The nodes in front of the first collision are kept, the rest is pruned
+    EXPECT_FALSE(rrt.validatePath(numNodes - 1));
+    for(size_t i = 0; i < numNodes; ++i)
+    {
+      EXPECT_EQ(rrt.isValidated(i), i < expected);
+      EXPECT_EQ(rrt.isRemoved(i), i >= expected);
+    }
+
+    // The path to a validated node needs no more checks
+    EXPECT_TRUE(rrt.validatePath(expected - 1));
+    EXPECT_EQ(robot->getPosition(0), 0.0);
+  }
+}
+
+//==============================================================================
+TEST(RRT, PeriodicDof)
+{
+  // The obstacle blocks the pendulum at an angle of 0, so the only way from
+  // start to goal goes across the angle of pi
+  WorldPtr world(new World);
+  SkeletonPtr robot = createPendulum();
+  world->addSkeleton(robot);
+  world->addSkeleton(createObstacle(0.5));
+
+  const std::vector<size_t> dofs(1, 0);
+  const Eigen::VectorXd start = Eigen::VectorXd::Constant(1, -2.5);
+  const Eigen::VectorXd goal = Eigen::VectorXd::Constant(1, 2.5);
+  const double stepSize = 0.1;
+
+  RRT blocked(world, robot, dofs, start, stepSize);
+  EXPECT_FALSE(blocked.connect(goal));
+
+  // When the angle wraps around, the steps take the shorter way that the
+  // nearest neighbor queries measure
+  RRT rrt(world, robot, dofs, start, stepSize);
+  rrt.getNearestNeighbors().setPeriod(0);
+  EXPECT_NEAR(rrt.getGap(goal), 2.0*DART_PI - 5.0, 1e-12);
+  EXPECT_TRUE(rrt.connect(goal));
+  EXPECT_EQ(rrt.getSize(), 13u);
+
+  for(size_t i = 1; i < rrt.getSize(); ++i)
+  {
+    const Eigen::VectorXd config = rrt.getConfig(i);
+    const Eigen::VectorXd parent = rrt.getConfig(rrt.parentVector[i]);
+    EXPECT_NEAR(config[0] - parent[0], -stepSize, 1e-12);
+    EXPECT_FALSE(rrt.checkCollisions(config));
+  }
+  EXPECT_LT(rrt.getGap(goal), stepSize);
+
+  // Weights scale the length of the steps under the metric
+  RRT weighted(world, robot, dofs, start, stepSize);
+  weighted.getNearestNeighbors().setPeriod(0);
+  weighted.getNearestNeighbors().setWeights(Eigen::VectorXd::Constant(1, 4.0));
+  EXPECT_EQ(weighted.tryStep(goal), RRT::STEP_PROGRESS);
+  EXPECT_NEAR(weighted.getConfig(1)[0], -2.5 - 0.5*stepSize, 1e-12);
+}
+
+//==============================================================================
+TEST(PathFollowingTrajectory, BatchedEvaluation)
+{
+  std::srand(0);
+  std::list<Eigen::VectorXd> waypoints;
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(3);
+  for(size_t i = 0; i < 500; ++i)
+  {
+    waypoints.push_back(q);
+    q += 0.3 * Eigen::VectorXd::Random(3);
+  }
+
+  const Eigen::VectorXd maxVelocity = Eigen::VectorXd::Constant(3, 1.0);
+  const Eigen::VectorXd maxAcceleration = Eigen::VectorXd::Constant(3, 1.0);
+  PathFollowingTrajectory trajectory(
+        Path(waypoints, 0.05), maxVelocity, maxAcceleration);
+  ASSERT_TRUE(trajectory.isValid());
+  const double duration = trajectory.getDuration();
+  ASSERT_GT(duration, 0.0);
+
+  EXPECT_TRUE(trajectory.getPosition(0.0).isApprox(waypoints.front()));
+  EXPECT_TRUE(trajectory.getPosition(duration).isApprox(waypoints.back()));
+
+  // Sorted timestamps followed by scattered ones, which defeat the cached
+  // segment and have to be looked up by binary search
+  const int numSamples = 2000;
+  Eigen::VectorXd timestamps(2 * numSamples);
+  for(int i = 0; i < numSamples; ++i)
+  {
+    timestamps[i] = duration * i / (numSamples - 1);
+    timestamps[numSamples + i] = duration * ((i * 7919) % numSamples)
+        / (numSamples - 1);
+  }
+
+  Eigen::MatrixXd positions;
+  Eigen::MatrixXd velocities;
+  trajectory.getPositions(timestamps, positions);
+  trajectory.getVelocities(timestamps, velocities);
+  ASSERT_EQ(positions.cols(), timestamps.size());
+  ASSERT_EQ(velocities.cols(), timestamps.size());
+
+  for(int i = 0; i < timestamps.size(); ++i)
+  {
+    EXPECT_TRUE(positions.col(i).isApprox(
+                  trajectory.getPosition(timestamps[i])));
+    EXPECT_TRUE(velocities.col(i).isApprox(
+                  trajectory.getVelocity(timestamps[i])));
+    for(int j = 0; j < 3; ++j)
+      EXPECT_LE(std::abs(velocities(j, i)), maxVelocity[j] + 1e-3);
+  }
+}
+
+//==============================================================================
+bool isPathValid(const WorldPtr& _world, const SkeletonPtr& _robot,
+                 const std::vector<size_t>& _dofs,
+                 const std::list<Eigen::VectorXd>& _path, double _stepSize)
+{
+  const Eigen::VectorXd positions = _robot->getPositions();
+
+  bool valid = true;
+  const Eigen::VectorXd* previous = nullptr;
+  for(const Eigen::VectorXd& state : _path)
+  {
+    if(previous && (state - *previous).norm() > _stepSize + 1e-9)
+      valid = false;
+    previous = &state;
+
+    _robot->setPositions(_dofs, state);
+    if(_world->checkCollision(_robot, _dofs))
+      valid = false;
+  }
+
+  _robot->setPositions(positions);
+  return valid;
+}
+
+//==============================================================================
+WorldPtr readPlanningBenchmark(std::vector<size_t>& _dofs,
+                               Eigen::VectorXd& _start, Eigen::VectorXd& _goal)
+{
+  WorldPtr world = utils::SkelParser::readWorld(
+        DART_DATA_PATH"skel/planning_benchmark.skel");
+
+  // The arm starts above the shelves and has to get below them
+  _dofs = {0, 1, 2, 3};
+  _start = Eigen::Vector4d(0.5, 0.0, 0.0, 0.0);
+  _goal = Eigen::Vector4d(-0.5, 0.0, 0.0, 0.0);
+
+  return world;
+}
+
+//==============================================================================
+TEST(PathPlanner, ParallelBidirectionalRrt)
+{
+  std::vector<size_t> dofs;
+  Eigen::VectorXd start, goal;
+  WorldPtr world = readPlanningBenchmark(dofs, start, goal);
+  ASSERT_TRUE(world != nullptr);
+  SkeletonPtr arm = world->getSkeleton("arm");
+  ASSERT_TRUE(arm != nullptr);
+
+  const double stepSize = 0.1;
+  for(size_t numThreads : {1u, 4u})
+  {
+    PathPlanner<> planner(world, true, true, stepSize, 1e5);
+    if(numThreads > 1)
+    {
+      planner.edgeValidator = std::make_shared<EdgeValidator>(
+            world, arm, dofs, stepSize, numThreads);
+    }
+
+    std::list<Eigen::VectorXd> path;
+    ASSERT_TRUE(planner.planPath(arm, dofs, start, goal, path));
+    ASSERT_GE(path.size(), 2u);
+    EXPECT_TRUE(path.front().isApprox(start));
+    EXPECT_TRUE(path.back().isApprox(goal));
+    EXPECT_TRUE(isPathValid(world, arm, dofs, path, stepSize));
+  }
+
+  // The lazy trees check the nodes again once the trees have met
+  PathPlanner<LazyRRT> planner(world, true, true, stepSize, 1e5);
+  planner.edgeValidator = std::make_shared<EdgeValidator>(
+        world, arm, dofs, stepSize, 4);
+  std::list<Eigen::VectorXd> path;
+  ASSERT_TRUE(planner.planPath(arm, dofs, start, goal, path));
+  EXPECT_TRUE(isPathValid(world, arm, dofs, path, stepSize));
+}
+
+//==============================================================================
+TEST(PathPlanner, ParallelCollisionFreePath)
+{
+  // A box moves in the plane around an obstacle that blocks the straight line
+  // from start to goal
+  WorldPtr world(new World);
+  SkeletonPtr robot = Skeleton::create("robot");
+  BodyNode* bn = robot->createJointAndBodyNodePair<TranslationalJoint>().second;
+  bn->addCollisionShape(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1)));
+  for(size_t i = 0; i < 2; ++i)
+  {
+    robot->getDof(i)->setPositionLowerLimit(-1.0);
+    robot->getDof(i)->setPositionUpperLimit(1.0);
+  }
+  world->addSkeleton(robot);
+  world->addSkeleton(createObstacle(0.0));
+
+  const std::vector<size_t> dofs = {0, 1};
+  const Eigen::VectorXd start = Eigen::Vector2d(-0.5, 0.0);
+  const Eigen::VectorXd goal = Eigen::Vector2d(0.5, 0.0);
+  const double stepSize = 0.05;
+
+  PathPlanner<> planner(world, true, true, stepSize, 1e5);
+  planner.edgeValidator = std::make_shared<EdgeValidator>(
+        world, robot, dofs, stepSize, 2);
+
+  std::list<Eigen::VectorXd> path;
+  ASSERT_TRUE(planner.planPath(robot, dofs, start, goal, path));
+  ASSERT_GE(path.size(), 2u);
+  EXPECT_TRUE(path.front().isApprox(start));
+  EXPECT_TRUE(path.back().isApprox(goal));
+  EXPECT_TRUE(isPathValid(world, robot, dofs, path, stepSize));
+
+  // The robot of the original world is never moved
+  EXPECT_TRUE(robot->getPositions().isZero());
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -178,6 +178,46 @@ TEST(Signal, ConnectionLifeTime)
   EXPECT_FALSE(connection1.isConnected());
 }
 
+//==============================================================================
+TEST(Signal, ConnectionOrder)
+{
+  Signal<void(int)> signal;
+  EXPECT_TRUE(signal.isEmpty());
+
+  std::vector<int> calls;
+  Connection connection0 = signal.connect([&](int) { calls.push_back(0); });
+  Connection connection1 = signal.connect([&](int) { calls.push_back(1); });
+  Connection connection2 = signal.connect([&](int) { calls.push_back(2); });
+  EXPECT_FALSE(signal.isEmpty());
+
+  // Slots are called in the order they were connected
+  signal.raise(0);
+  EXPECT_EQ(calls, std::vector<int>({0, 1, 2}));
+
+  // Disconnected slots are skipped and then removed
+  calls.clear();
+  connection1.disconnect();
+  signal.raise(0);
+  EXPECT_EQ(calls, std::vector<int>({0, 2}));
+  EXPECT_EQ(signal.getNumConnections(), 2u);
+
+  // Slots may connect new slots while the signal is being raised
+  calls.clear();
+  Connection connection3;
+  Connection connection4 = signal.connect([&](int)
+  {
+    calls.push_back(4);
+    if (!connection3.isConnected())
+      connection3 = signal.connect([&](int) { calls.push_back(3); });
+  });
+  signal.raise(0);
+  signal.raise(0);
+  EXPECT_EQ(calls, std::vector<int>({0, 2, 4, 3, 0, 2, 4, 3}));
+
+  signal.disconnectAll();
+  EXPECT_TRUE(signal.isEmpty());
+}
+
 //==============================================================================
 float product(float x, float y) { return x * y; }
 float quotient(float x, float y) { return x / y; }
@@ -331,6 +371,90 @@ TEST(Signal, FrameSignals)
   F3.setParentFrame(&F1);
 }
 
+//==============================================================================
+TEST(Signal, NestedRaise)
+{
+  Signal<void()> signal;
+  int numCalls1 = 0;
+  int numCalls2 = 0;
+  int numCalls3 = 0;
+
+  // The first slot disconnects itself and raises the signal again before the
+  // outer raise has visited the other slots
+  Connection connection1;
+  connection1 = signal.connect([&]()
+  {
+    ++numCalls1;
+    connection1.disconnect();
+    signal.raise();
+  });
+  signal.connect([&]() { ++numCalls2; });
+  signal.connect([&]() { ++numCalls3; });
+
+  signal.raise();
+  EXPECT_EQ(numCalls1, 1);
+  EXPECT_EQ(numCalls2, 2);
+  EXPECT_EQ(numCalls3, 2);
+  EXPECT_EQ(signal.getNumConnections(), 2u);
+
+  signal.raise();
+  EXPECT_EQ(numCalls1, 1);
+  EXPECT_EQ(numCalls2, 3);
+  EXPECT_EQ(numCalls3, 3);
+}
+
+//==============================================================================
+/// Restores the Entity change signals when a test leaves its scope, so a
+/// failing assertion cannot leave them disabled for the other tests
+struct ChangeSignalsGuard
+{
+  ChangeSignalsGuard() : mEnabled(Entity::isEnabledChangeSignals()) {}
+
+  ~ChangeSignalsGuard()
+  {
+    if (mEnabled)
+      Entity::enableChangeSignals();
+    else
+      Entity::disableChangeSignals();
+  }
+
+  bool mEnabled;
+};
+
+//==============================================================================
+TEST(Signal, ChangeSignalsSwitch)
+{
+  ChangeSignalsGuard guard;
+
+  SimpleFrame F1(Frame::World(), "F1");
+  SimpleFrame F2(&F1, "F2");
+
+  int numUpdates = 0;
+  ScopedConnection connection(F2.onTransformUpdated.connect(
+      [&](const Entity*) { ++numUpdates; }));
+
+  // Changes only propagate to F2 when its transform is up to date
+  F2.getWorldTransform();
+  F1.setRelativeTransform(Isometry3d::Identity());
+  EXPECT_EQ(numUpdates, 1);
+
+  Entity::disableChangeSignals();
+  EXPECT_FALSE(Entity::isEnabledChangeSignals());
+
+  // Disabling the signals must not affect the kinematic updates themselves
+  Isometry3d tf(Isometry3d::Identity());
+  tf.translate(Vector3d(0.0, 0.0, 1.0));
+  F2.getWorldTransform();
+  F1.setRelativeTransform(tf);
+  EXPECT_EQ(numUpdates, 1);
+  EXPECT_TRUE(F2.getWorldTransform().isApprox(tf));
+
+  Entity::enableChangeSignals();
+  EXPECT_TRUE(Entity::isEnabledChangeSignals());
+  F1.setRelativeTransform(Isometry3d::Identity());
+  EXPECT_EQ(numUpdates, 2);
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -41,6 +41,7 @@
 #include "dart/dynamics/SoftBodyNode.h"
 #include "dart/dynamics/RevoluteJoint.h"
 #include "dart/dynamics/PlanarJoint.h"
+#include "dart/dynamics/MeshShape.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
 #include "dart/simulation/World.h"
@@ -133,6 +134,32 @@ TEST(SkelParser, SinglePendulum)
   world->step();
 }
 
+//==============================================================================
+TEST(SkelParser, SharesMeshesBetweenWorlds)
+{
+  // Both Worlds are parsed with the default retriever, so the MeshCache must
+  // give them the same mesh
+  WorldPtr world1 = SkelParser::readWorld(DART_DATA_PATH"skel/shapes.skel");
+  WorldPtr world2 = SkelParser::readWorld(DART_DATA_PATH"skel/shapes.skel");
+  ASSERT_TRUE(world1 != nullptr);
+  ASSERT_TRUE(world2 != nullptr);
+
+  BodyNode* bn1 = world1->getSkeleton("mesh skeleton")->getBodyNode("mesh");
+  BodyNode* bn2 = world2->getSkeleton("mesh skeleton")->getBodyNode("mesh");
+  ASSERT_TRUE(bn1 != nullptr);
+  ASSERT_TRUE(bn2 != nullptr);
+
+  std::shared_ptr<MeshShape> mesh1 =
+      std::dynamic_pointer_cast<MeshShape>(bn1->getVisualizationShape(0));
+  std::shared_ptr<MeshShape> mesh2 =
+      std::dynamic_pointer_cast<MeshShape>(bn2->getVisualizationShape(0));
+  ASSERT_TRUE(mesh1 != nullptr);
+  ASSERT_TRUE(mesh2 != nullptr);
+
+  ASSERT_TRUE(mesh1->getMesh() != nullptr);
+  EXPECT_EQ(mesh1->getMesh(), mesh2->getMesh());
+}
+
 //==============================================================================
 TEST(SkelParser, SerialChain)
 {
@@ -35,6 +35,7 @@
  */
 
 #include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 #include "TestHelpers.h"
 
@@ -936,6 +937,140 @@ TEST(Skeleton, Linkage)
                     "c3b1", "c1b3", "c5b1", "c5b2", "c1b2", "c1b1");
 }
 
+TEST(Skeleton, ConcurrentConstQueries)
+{
+  // Build this test with ENABLE_THREAD_SANITIZER to have any data race among
+  // the reader threads reported as an error.
+  const size_t numThreads = 4;
+
+  SkeletonPtr skel = constructLinkageTestSkeleton();
+  skel->getBodyNode("c4b3")->createEndEffector("ee");
+  Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+  tf.translate(Eigen::Vector3d(0.1, 0.2, 0.3));
+  SimpleFrame offset(skel->getBodyNode("c2b3"), "offset", tf);
+  offset.setClassicDerivatives(Eigen::Vector3d::Ones(), Eigen::Vector3d::Ones());
+
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setAccelerations(Eigen::VectorXd::Random(skel->getNumDofs()));
+
+  skel->computeAllCaches();
+
+  ConstSkeletonPtr constSkel = skel;
+  const Frame* constOffset = &offset;
+  auto query = [&constSkel, constOffset](std::vector<Eigen::MatrixXd>& _results)
+  {
+    _results.clear();
+    for(size_t i=0; i < constSkel->getNumBodyNodes(); ++i)
+    {
+      const BodyNode* bn = constSkel->getBodyNode(i);
+      _results.push_back(bn->getWorldTransform().matrix());
+      _results.push_back(bn->getSpatialVelocity());
+      _results.push_back(bn->getSpatialAcceleration());
+      _results.push_back(bn->getWorldJacobian());
+      _results.push_back(bn->getJacobianClassicDeriv());
+      _results.push_back(bn->getArticulatedInertia());
+    }
+
+    const EndEffector* ee = constSkel->getEndEffector(0);
+    _results.push_back(ee->getWorldTransform().matrix());
+    _results.push_back(ee->getJacobian());
+    _results.push_back(constOffset->getWorldTransform().matrix());
+    _results.push_back(constOffset->getSpatialAcceleration());
+
+    _results.push_back(constSkel->getMassMatrix());
+    _results.push_back(constSkel->getInvMassMatrix());
+    _results.push_back(constSkel->getCoriolisAndGravityForces());
+  };
+
+  std::vector<Eigen::MatrixXd> expected;
+  query(expected);
+
+  std::vector<std::vector<Eigen::MatrixXd>> results(numThreads);
+  std::vector<std::thread> threads;
+  for(size_t i=0; i < numThreads; ++i)
+    threads.push_back(std::thread(query, std::ref(results[i])));
+
+  for(std::thread& thread : threads)
+    thread.join();
+
+  for(const std::vector<Eigen::MatrixXd>& result : results)
+  {
+    ASSERT_EQ(expected.size(), result.size());
+    for(size_t i=0; i < expected.size(); ++i)
+      EXPECT_TRUE(expected[i] == result[i]);
+  }
+
+  // Changing the state invalidates the caches, and computeAllCaches() must
+  // bring every getter back up to date
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  std::vector<Eigen::MatrixXd> outdated = expected;
+  skel->computeAllCaches();
+  query(expected);
+  EXPECT_FALSE(outdated.front() == expected.front());
+
+  SkeletonPtr fresh = skel->clone();
+  fresh->setPositions(skel->getPositions());
+  fresh->setVelocities(skel->getVelocities());
+  fresh->setAccelerations(skel->getAccelerations());
+  EXPECT_TRUE(equals(fresh->getMassMatrix(), skel->getMassMatrix()));
+  for(size_t i=0; i < skel->getNumBodyNodes(); ++i)
+  {
+    EXPECT_TRUE(equals(fresh->getBodyNode(i)->getWorldTransform().matrix(),
+                       skel->getBodyNode(i)->getWorldTransform().matrix()));
+    EXPECT_TRUE(equals(fresh->getBodyNode(i)->getSpatialAcceleration(),
+                       skel->getBodyNode(i)->getSpatialAcceleration()));
+  }
+}
+
+//==============================================================================
+TEST(Skeleton, FusedForwardKinematics)
+{
+  SkeletonPtr skel = constructLinkageTestSkeleton();
+  SkeletonPtr lazy = skel->clone();
+
+  const bool flags[3][3] = { {true,  false, false},
+                             {true,  true,  false},
+                             {false, false, true } };
+
+  for(size_t i=0; i < 3; ++i)
+  {
+    Eigen::VectorXd q = Eigen::VectorXd::Random(skel->getNumDofs());
+    Eigen::VectorXd dq = Eigen::VectorXd::Random(skel->getNumDofs());
+    Eigen::VectorXd ddq = Eigen::VectorXd::Random(skel->getNumDofs());
+
+    skel->setPositions(q);
+    skel->setVelocities(dq);
+    skel->setAccelerations(ddq);
+
+    lazy->setPositions(q);
+    lazy->setVelocities(dq);
+    lazy->setAccelerations(ddq);
+
+    skel->computeForwardKinematics(flags[i][0], flags[i][1], flags[i][2]);
+
+    for(size_t j=0; j < skel->getNumBodyNodes(); ++j)
+    {
+      const BodyNode* bn = skel->getBodyNode(j);
+      const BodyNode* lazyBn = lazy->getBodyNode(j);
+
+      EXPECT_EQ(flags[i][0], !bn->needsTransformUpdate());
+      // Accelerations depend on velocities, so those get computed as well
+      EXPECT_EQ(flags[i][1] || flags[i][2], !bn->needsVelocityUpdate());
+      EXPECT_EQ(flags[i][2], !bn->needsAccelerationUpdate());
+
+      EXPECT_TRUE(equals(lazyBn->getWorldTransform().matrix(),
+                         bn->getWorldTransform().matrix()));
+      EXPECT_TRUE(equals(lazyBn->getSpatialVelocity(),
+                         bn->getSpatialVelocity()));
+      EXPECT_TRUE(equals(lazyBn->getPartialAcceleration(),
+                         bn->getPartialAcceleration()));
+      EXPECT_TRUE(equals(lazyBn->getSpatialAcceleration(),
+                         bn->getSpatialAcceleration()));
+    }
+  }
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
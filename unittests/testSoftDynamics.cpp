@@ -34,6 +34,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <limits>
 #include <vector>
 #include <string>
 
@@ -43,11 +44,13 @@
 
 #include "dart/common/Console.h"
 #include "dart/math/Helpers.h"
+#include "dart/dynamics/FreeJoint.h"
 #include "dart/dynamics/Joint.h"
 
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/SoftBodyNode.h"
 #include "dart/dynamics/PointMass.h"
+#include "dart/dynamics/SoftMeshShape.h"
 #include "dart/simulation/World.h"
 #include "dart/utils/SkelParser.h"
 
@@ -462,6 +465,119 @@ TEST_F(SoftDynamicsTest, compareEquationsOfMotion)
 //  }
 }
 
+//==============================================================================
+TEST(SoftMeshShape, SharesPointMassPositions)
+{
+  using namespace dart::dynamics;
+
+  SkeletonPtr skel = Skeleton::create();
+  SoftBodyNode::Properties properties(
+        BodyNode::Properties(std::string("soft box")),
+        SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d::Ones(), Eigen::Isometry3d::Identity(), 1.0));
+  SoftBodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+        nullptr, FreeJoint::Properties(), properties).second;
+
+  std::shared_ptr<SoftMeshShape> shape;
+  for (size_t i = 0; i < bn->getNumCollisionShapes(); ++i)
+  {
+    shape = std::dynamic_pointer_cast<SoftMeshShape>(bn->getCollisionShape(i));
+    if (shape)
+      break;
+  }
+  ASSERT_TRUE(shape != nullptr);
+
+  // The shape views the positions of the point masses without copying them
+  const std::vector<Eigen::Vector3d>& vertices = shape->getVertices();
+  EXPECT_EQ(&bn->getPointMassLocalPositions(), &vertices);
+  ASSERT_EQ(bn->getNumPointMasses(), vertices.size());
+  for (size_t i = 0; i < bn->getNumPointMasses(); ++i)
+  {
+    EXPECT_EQ(&bn->getPointMass(i)->getLocalPosition(), &vertices[i]);
+    EXPECT_TRUE(vertices[i].isApprox(
+                  bn->getPointMass(i)->getRestingPosition()));
+  }
+
+  // Moving the body as a whole does not change the vertices
+  const size_t version = shape->getVertexVersion();
+  Eigen::Vector6d q = Eigen::Vector6d::Zero();
+  q[3] = 1.0;
+  skel->getJoint(0)->setPositions(q);
+  EXPECT_EQ(version, shape->getVertexVersion());
+
+  // Deforming the body marks the moved vertices as dirty
+  bn->getPointMass(3)->setPositions(Eigen::Vector3d(0.0, 0.1, 0.0));
+  bn->getPointMass(5)->setPositions(Eigen::Vector3d(0.1, 0.0, 0.0));
+  EXPECT_EQ(version + 1, shape->getVertexVersion());
+  EXPECT_EQ(3u, shape->getDirtyVertices().first);
+  EXPECT_EQ(6u, shape->getDirtyVertices().second);
+  EXPECT_TRUE(vertices[5].isApprox(bn->getPointMass(5)->getRestingPosition()
+                                   + Eigen::Vector3d(0.1, 0.0, 0.0)));
+
+  // The Assimp copy is only brought up to date on request
+  shape->update();
+  const aiVector3D& vertex = shape->getAssimpMesh()->mVertices[5];
+  EXPECT_NEAR(vertices[5][0], vertex.x, 1e-6);
+  EXPECT_NEAR(vertices[5][1], vertex.y, 1e-6);
+  EXPECT_NEAR(vertices[5][2], vertex.z, 1e-6);
+
+  // Vertex changes are not tracked without DYNAMIC_VERTICES
+  shape->setDataVariance(Shape::STATIC);
+  bn->getPointMass(0)->setPositions(Eigen::Vector3d(0.0, 0.0, 0.1));
+  EXPECT_EQ(version + 1, shape->getVertexVersion());
+}
+
+//==============================================================================
+TEST(SoftBodyNode, NearestPointMass)
+{
+  using namespace dart::dynamics;
+
+  SkeletonPtr skel = Skeleton::create();
+  SoftBodyNode::Properties properties(
+        BodyNode::Properties(std::string("soft ellipsoid")),
+        SoftBodyNodeHelper::makeEllipsoidProperties(
+          Eigen::Vector3d(0.6, 0.4, 0.2), 12, 8, 1.0));
+  SoftBodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+        nullptr, FreeJoint::Properties(), properties).second;
+
+  Eigen::Vector6d q = Eigen::Vector6d::Zero();
+  q << 0.3, -0.2, 0.5, 1.0, 2.0, -1.0;
+  skel->getJoint(0)->setPositions(q);
+
+  for (size_t step = 0; step < 2; ++step)
+  {
+    for (size_t i = 0; i < 200; ++i)
+    {
+      const Eigen::Vector3d point = skel->getJoint(0)->getPositions().tail<3>()
+          + Eigen::Vector3d(math::random(-0.5, 0.5),
+                            math::random(-0.5, 0.5),
+                            math::random(-0.5, 0.5));
+
+      // Compare against a search over every point mass
+      double minDistSq = std::numeric_limits<double>::infinity();
+      for (size_t j = 0; j < bn->getNumPointMasses(); ++j)
+      {
+        minDistSq = std::min(minDistSq, (bn->getPointMass(j)->getWorldPosition()
+                                         - point).squaredNorm());
+      }
+
+      const PointMass* nearest = bn->getNearestPointMass(point);
+      ASSERT_TRUE(nearest != nullptr);
+      EXPECT_DOUBLE_EQ(minDistSq,
+                       (nearest->getWorldPosition() - point).squaredNorm());
+    }
+
+    // Deform the body so the spatial index has to be rebuilt
+    for (size_t j = 0; j < bn->getNumPointMasses(); j += 3)
+    {
+      bn->getPointMass(j)->setPositions(
+            Eigen::Vector3d(math::random(-0.2, 0.2),
+                            math::random(-0.2, 0.2),
+                            math::random(-0.2, 0.2)));
+    }
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "dart/common/ThreadPool.h"
+
+using namespace dart::common;
+
+//==============================================================================
+TEST(ThreadPool, RunsAllTasks)
+{
+  ThreadPool pool(3);
+  EXPECT_EQ(pool.getNumThreads(), 3u);
+
+  std::atomic<int> counter(0);
+  std::vector<std::future<int>> results;
+  for(int i=0; i < 100; ++i)
+  {
+    results.push_back(pool.submit([&counter, i]()
+    {
+      ++counter;
+      return i*i;
+    }));
+  }
+
+  for(int i=0; i < 100; ++i)
+    EXPECT_EQ(results[i].get(), i*i);
+
+  EXPECT_EQ(counter.load(), 100);
+}
+
+//==============================================================================
+TEST(ThreadPool, Wait)
+{
+  std::atomic<int> counter(0);
+  {
+    ThreadPool pool(2);
+    for(int i=0; i < 20; ++i)
+    {
+      pool.submit([&counter]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++counter;
+      });
+    }
+
+    pool.wait();
+    EXPECT_EQ(counter.load(), 20);
+
+    // Tasks that are still queued when the pool is destroyed must be run
+    for(int i=0; i < 20; ++i)
+      pool.submit([&counter]() { ++counter; });
+  }
+
+  EXPECT_EQ(counter.load(), 40);
+}
+
+//==============================================================================
+TEST(ThreadPool, Exceptions)
+{
+  ThreadPool pool(1);
+  std::future<void> result = pool.submit([]()
+  {
+    throw std::runtime_error("task failure");
+  });
+
+  EXPECT_THROW(result.get(), std::runtime_error);
+
+  // The worker thread must survive the exception
+  std::future<int> next = pool.submit([]() { return 5; });
+  EXPECT_EQ(next.get(), 5);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
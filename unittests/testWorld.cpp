@@ -42,8 +42,11 @@
 #include "dart/math/Geometry.h"
 #include "dart/utils/SkelParser.h"
 #include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/FreeJoint.h"
+#include "dart/dynamics/PointMass.h"
 #include "dart/dynamics/RevoluteJoint.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/dynamics/SoftBodyNode.h"
 #include "dart/simulation/World.h"
 
 using namespace dart;
@@ -259,6 +262,70 @@ TEST(World, Cloning)
   }
 }
 
+//==============================================================================
+TEST(World, ParallelStepping)
+{
+  using namespace dart::dynamics;
+
+  dart::simulation::WorldPtr serial(new dart::simulation::World);
+  for(size_t i=0; i<4; ++i)
+  {
+    SkeletonPtr skel = Skeleton::create("soft_box_" + std::to_string(i));
+    SoftBodyNode::Properties properties(BodyNode::Properties(),
+          SoftBodyNodeHelper::makeBoxProperties(
+            Eigen::Vector3d(0.5, 0.4, 0.3), Eigen::Isometry3d::Identity(),
+            Eigen::Vector3i(4, 4, 4), 1.0));
+    skel->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+          nullptr, FreeJoint::Properties(), properties);
+    serial->addSkeleton(skel);
+  }
+
+  dart::simulation::WorldPtr parallel = serial->clone();
+  parallel->setNumThreads(4);
+  EXPECT_EQ(parallel->getNumThreads(), 4u);
+
+  for(size_t i=0; i<serial->getNumSkeletons(); ++i)
+  {
+    Eigen::VectorXd velocities = Eigen::VectorXd::Constant(6, 0.2 * (i+1));
+    serial->getSkeleton(i)->setVelocities(velocities);
+    parallel->getSkeleton(i)->setVelocities(velocities);
+
+    SoftBodyNode* bn1 = serial->getSkeleton(i)->getSoftBodyNode(0);
+    SoftBodyNode* bn2 = parallel->getSkeleton(i)->getSoftBodyNode(0);
+    for(size_t j=0; j<bn1->getNumPointMasses(); ++j)
+    {
+      Eigen::Vector3d dq = random(-0.1, 0.1) * Eigen::Vector3d::Ones();
+      bn1->getPointMass(j)->setVelocities(dq);
+      bn2->getPointMass(j)->setVelocities(dq);
+    }
+  }
+
+  for(size_t i=0; i<100; ++i)
+  {
+    serial->step();
+    parallel->step();
+  }
+
+  // The Skeletons are independent during the unconstrained step, so the
+  // results must match exactly
+  for(size_t i=0; i<serial->getNumSkeletons(); ++i)
+  {
+    SkeletonPtr skel1 = serial->getSkeleton(i);
+    SkeletonPtr skel2 = parallel->getSkeleton(i);
+    EXPECT_TRUE(equals(skel1->getPositions(), skel2->getPositions(), 0));
+    EXPECT_TRUE(equals(skel1->getVelocities(), skel2->getVelocities(), 0));
+
+    SoftBodyNode* bn1 = skel1->getSoftBodyNode(0);
+    SoftBodyNode* bn2 = skel2->getSoftBodyNode(0);
+    for(size_t j=0; j<bn1->getNumPointMasses(); ++j)
+    {
+      const Eigen::Vector3d& q1 = bn1->getPointMass(j)->getPositions();
+      const Eigen::Vector3d& q2 = bn2->getPointMass(j)->getPositions();
+      EXPECT_TRUE(equals(q1, q2, 0));
+    }
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {